@@ -1,11 +1,15 @@
 // JLibrary
 // Array.ixx
 // Created on 2022-01-08 by Justyn Durnford
-// Last modified on 2022-09-12 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
 // Module file for the Array template class.
 
 module;
 
+#include "Arithmetic.hpp"
+#include "Simd.hpp"
+#include "Uninitialized.hpp"
+
 #include <algorithm>
 #include <compare>
 #include <concepts>
@@ -13,7 +17,12 @@ module;
 #include <initializer_list>
 #include <iostream>
 #include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 export module Array;
 
@@ -22,15 +31,22 @@ import MiscTemplateFunctions;
 export namespace jlib
 {
 	// This template class serves as a resizable container.
-	// Elements cannot be added or removed dynamically, but
-	// the Array can be resized manually. It does not allocate extra 
-	// memory, so if the Array is resized more than a few times,
-	// it may be in your best interest to use a std::vector instead.
-	template <typename T> class Array
+	// The Array can be resized manually, and it can also be grown one
+	// element at a time with push_back/emplace_back. Like std::vector,
+	// it keeps track of a capacity separate from its size and grows
+	// that capacity geometrically, so appending n elements only moves
+	// O(n) elements in total. Elements are moved, not copied, whenever
+	// the Array has to relocate them.
+	// 
+	// Memory is obtained from the Allocator, which defaults to std::allocator.
+	// jlib::pmr::Array uses a std::pmr::polymorphic_allocator, so an Array can
+	// be placed in any std::pmr::memory_resource such as a jlib::FrameArena.
+	template <typename T, typename Allocator = std::allocator<T>> class Array
 	{
 		public:
 
 		using value_type = T;
+		using allocator_type = Allocator;
 		using size_type = std::size_t;
 		using difference_type = std::ptrdiff_t;
 		using pointer = value_type*;
@@ -44,142 +60,318 @@ export namespace jlib
 
 		private:
 
+		using alloc_traits = std::allocator_traits<Allocator>;
+
+		Allocator _allocator;
 		pointer _data;
 		size_type _size;
+		size_type _capacity;
 
-		// This function allocates memory for the container.
+		// Returns uninitialized storage large enough for capacity elements.
+		// Returns nullptr if capacity is 0.
 		// It may throw if it fails to do this.
-		void allocate(size_type size)
+		pointer allocateStorage(size_type capacity)
+		{
+			if (capacity == 0)
+				return nullptr;
+
+			return alloc_traits::allocate(_allocator, capacity);
+		}
+
+		// Releases storage for capacity elements obtained from allocateStorage.
+		void deallocateStorage(pointer ptr, size_type capacity) noexcept
 		{
+			if (ptr != nullptr)
+				alloc_traits::deallocate(_allocator, ptr, capacity);
+		}
+
+		// Returns the capacity the Array should grow to in order
+		// to hold at least min_capacity elements.
+		constexpr size_type growthCapacity(size_type min_capacity) const noexcept
+		{
+			size_type new_capacity = _capacity + _capacity / 2;
+
+			if (new_capacity < min_capacity)
+				new_capacity = min_capacity;
+			if (new_capacity < 4)
+				new_capacity = 4;
+
+			return new_capacity;
+		}
+
+		// This function allocates memory for size elements and
+		// initializes them with the given function, which is passed
+		// the uninitialized storage.
+		// It may throw if it fails to do this.
+		template <typename Function>
+		void allocateWith(size_type size, Function construct)
+		{
+			_data = nullptr;
+			_size = 0;
+			_capacity = 0;
+
 			if (size == 0)
+				return;
+
+			pointer new_data = allocateStorage(size);
+
+			try
 			{
-				_data = nullptr;
-				_size = 0;
+				construct(new_data);
 			}
-			else
+			catch (...)
 			{
-				try
-				{
-					_data = new value_type[size];
-					_size = size;
-				}
-				catch (...)
-				{
-					_data = nullptr;
-					_size = 0;
-					throw;
-				}
+				deallocateStorage(new_data, size);
+				throw;
 			}
+
+			_data = new_data;
+			_size = size;
+			_capacity = size;
+		}
+
+		// This function allocates memory for the container
+		// and value-initializes size elements.
+		// It may throw if it fails to do this.
+		void allocate(size_type size)
+		{
+			allocateWith(size, [size](pointer ptr) { std::uninitialized_value_construct_n(ptr, size); });
+		}
+
+		// This function allocates memory for the container
+		// and copies the range [first, first + size) into it.
+		// It may throw if it fails to do this.
+		void allocateCopy(const_pointer first, size_type size)
+		{
+			allocateWith(size, [first, size](pointer ptr) { std::uninitialized_copy_n(first, size, ptr); });
+		}
+
+		// Destroys every element and releases the memory
+		// currently used by the container.
+		void deallocate() noexcept
+		{
+			std::destroy_n(_data, _size);
+			deallocateStorage(_data, _capacity);
+			_data = nullptr;
+			_size = 0;
+			_capacity = 0;
+		}
+
+		// Takes ownership of the memory of another Array.
+		// The memory of this Array must already be released.
+		void steal(Array& other) noexcept
+		{
+			_data = other._data;
+			_size = other._size;
+			_capacity = other._capacity;
+			other._data = nullptr;
+			other._size = 0;
+			other._capacity = 0;
 		}
 
-		// This function deallocates the memory currently used
-		// by the container and reallocates sufficient memory
-		// for the new requested size.
+		// This function moves the elements of the container
+		// into newly allocated storage for new_capacity elements.
+		// Elements are copied instead only if moving them may throw
+		// and they can be copied, so the Array is left unchanged on failure.
 		// It may throw if it fails to do this.
-		void reallocate(size_type size)
+		void relocate(size_type new_capacity)
 		{
-			if (size != _size)
+			pointer new_data = allocateStorage(new_capacity);
+
+			try
+			{
+				if constexpr (std::is_nothrow_move_constructible_v<value_type> || !std::is_copy_constructible_v<value_type>)
+					std::uninitialized_move_n(_data, _size, new_data);
+				else
+					std::uninitialized_copy_n(_data, _size, new_data);
+			}
+			catch (...)
 			{
-				delete[] _data;
-				allocate(size);
+				deallocateStorage(new_data, new_capacity);
+				throw;
 			}
+
+			std::destroy_n(_data, _size);
+			deallocateStorage(_data, _capacity);
+			_data = new_data;
+			_capacity = new_capacity;
+		}
+
+		// Replaces the contents of the container with a copy of
+		// the range [first, first + size), reusing the current
+		// memory if it is large enough.
+		// It may throw if it fails to do this.
+		void assignCopy(const_pointer first, size_type size)
+		{
+			if (size > _capacity)
+			{
+				Array temp(first, first + size, _allocator);
+				swapWith(temp);
+				return;
+			}
+
+			if (size <= _size)
+			{
+				std::copy(first, first + size, _data);
+				std::destroy(_data + size, _data + _size);
+			}
+			else
+			{
+				std::copy(first, first + _size, _data);
+				std::uninitialized_copy(first + _size, first + size, _data + _size);
+			}
+
+			_size = size;
 		}
 
 		public:
 
 		// Default constructor.
-		Array()
+		Array() : _allocator()
+		{
+			allocate(0);
+		}
+
+		// Allocator constructor.
+		explicit Array(const Allocator& alloc) : _allocator(alloc)
 		{
 			allocate(0);
 		}
 
 		// Size constructor.
-		Array(size_type size)
+		// Every element is value-initialized.
+		Array(size_type size, const Allocator& alloc = Allocator()) : _allocator(alloc)
 		{
 			allocate(size);
 		}
 
+		// Uninitialized size constructor.
+		// Allocates memory for size elements without value-initializing them.
+		// Trivial elements are left untouched, so their contents must be
+		// written before they are read.
+		Array(size_type size, uninitialized_t, const Allocator& alloc = Allocator()) : _allocator(alloc)
+		{
+			allocateWith(size, [size](pointer ptr) { std::uninitialized_default_construct_n(ptr, size); });
+		}
+
 		// Size and value constructor.
-		Array(size_type size, const_reference value)
+		Array(size_type size, const_reference value, const Allocator& alloc = Allocator()) : _allocator(alloc)
 		{
-			allocate(size);
-			std::fill(_data, _data + _size, value);
+			allocateWith(size, [size, &value](pointer ptr) { std::uninitialized_fill_n(ptr, size, value); });
 		}
 
 		// Constructs the Array with the contents in the range[begin, end).
 		// This DOES NOT move the contents from the given range, it simply
 		// copies its contents into the new Array.
-		Array(const_pointer begin, const_pointer end)
+		Array(const_pointer begin, const_pointer end, const Allocator& alloc = Allocator()) : _allocator(alloc)
 		{
-			size_type size = end - begin;
-			allocate(size);
-			std::copy(begin, end, _data);
+			allocateCopy(begin, end - begin);
 		}
 
 		// std::initializer_list constructor.
-		Array(std::initializer_list<T> elems)
+		Array(std::initializer_list<T> elems, const Allocator& alloc = Allocator()) : _allocator(alloc)
 		{
-			allocate(elems.size());
-			std::copy(elems.begin(), elems.end(), _data);
+			allocateCopy(elems.begin(), elems.size());
 		}
 
 		// Copy constructor.
-		Array(const Array& other)
+		Array(const Array& other) : _allocator(alloc_traits::select_on_container_copy_construction(other._allocator))
+		{
+			allocateCopy(other._data, other._size);
+		}
+
+		// Copy constructor with a different allocator.
+		Array(const Array& other, const Allocator& alloc) : _allocator(alloc)
 		{
-			allocate(other._size);
-			std::copy(other._data, other._data + _size, _data);
+			allocateCopy(other._data, other._size);
 		}
 
 		// Constructs the Array from another type of Array.
 		// This constructor doesn't replace the copy constructor,
 		// it's called only when U != T.
-		template <typename U>
-		explicit Array(const Array<U>& other)
+		template <typename U, typename OtherAllocator>
+		explicit Array(const Array<U, OtherAllocator>& other, const Allocator& alloc = Allocator()) : _allocator(alloc)
 		{
 			allocate(other.size());
 			jlib::copy(other.data(), other.data() + _size, _data);
 		}
 
 		// Move constructor.
-		Array(Array&& other) noexcept
+		Array(Array&& other) noexcept : _allocator(std::move(other._allocator))
 		{
-			_data = other._data;
-			_size = other._size;
-			other._data = nullptr;
-			other._size = 0;
+			steal(other);
 		}
 
 		// std::initializer_list assignment operator.
 		Array& operator = (std::initializer_list<T> elems)
 		{
-			reallocate(elems.size());
-			std::copy(elems.begin(), elems.end(), _data);
+			assignCopy(elems.begin(), elems.size());
 			return *this;
 		}
 
 		// Copy assignment operator.
 		Array& operator = (const Array& other)
 		{
-			reallocate(other._size);
-			std::copy(other._data, other._data + _size, _data);
+			if (this == &other)
+				return *this;
+
+			if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+			{
+				if (_allocator != other._allocator)
+					deallocate();
+
+				_allocator = other._allocator;
+			}
+
+			assignCopy(other._data, other._size);
 			return *this;
 		}
 
 		// Move assignment operator.
-		Array& operator = (Array&& other) noexcept
+		// If the allocators differ and cannot be propagated, the
+		// elements are moved one by one into this Array's memory.
+		Array& operator = (Array&& other) noexcept(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value)
 		{
-			delete[] _data;
-			_data = other._data;
-			_size = other._size;
-			other._data = nullptr;
-			other._size = 0;
+			if (this == &other)
+				return *this;
+
+			if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+			{
+				deallocate();
+				_allocator = std::move(other._allocator);
+				steal(other);
+			}
+			else
+			{
+				if (_allocator == other._allocator)
+				{
+					deallocate();
+					steal(other);
+				}
+				else
+				{
+					Array temp(_allocator);
+					temp.reserve(other._size);
+					std::uninitialized_move_n(other._data, other._size, temp._data);
+					temp._size = other._size;
+					swapWith(temp);
+					other.deallocate();
+				}
+			}
+
 			return *this;
 		}
 
 		// Destructor.
 		~Array() noexcept
 		{
-			delete[] _data;
+			deallocate();
+		}
+
+		// Returns a copy of the allocator used by the Array.
+		constexpr allocator_type get_allocator() const noexcept
+		{
+			return _allocator;
 		}
 
 		// Returns the size of the Array.
@@ -188,10 +380,17 @@ export namespace jlib
 			return _size;
 		}
 
+		// Returns the number of elements the Array can hold
+		// before it needs to allocate more memory.
+		constexpr size_type capacity() const noexcept
+		{
+			return _capacity;
+		}
+
 		// Returns true if the Array is empty.
 		constexpr bool isEmpty() const noexcept
 		{
-			return _size != 0;
+			return _size == 0;
 		}
 
 		// Returns the first element of the Array.
@@ -359,50 +558,144 @@ export namespace jlib
 		// Sets every element to the given value.
 		constexpr void setAll(const_reference value)
 		{
-			for (size_type i = 0; i < _size; ++i)
-				_data[i] = value;
+			if (std::is_constant_evaluated())
+				std::fill(_data, _data + _size, value);
+			else
+				simd::fill_n(_data, _size, value);
 		}
 
-		// Empties the Array.
-		constexpr void clear() noexcept
+		// Empties the Array and releases its memory.
+		void clear() noexcept
 		{
-			delete[] _data;
-			_data = nullptr;
-			_size = 0;
+			deallocate();
 		}
 
-		// Resizes the Array with the copied elements.
+		// Ensures the Array can hold at least new_capacity elements
+		// without allocating more memory. Does nothing if the capacity
+		// is already large enough.
 		// It may throw if it fails to do this.
-		void resize(size_type new_size)
+		void reserve(size_type new_capacity)
+		{
+			if (new_capacity > _capacity)
+				relocate(new_capacity);
+		}
+
+		// Reduces the capacity of the Array to its size.
+		// It may throw if it fails to do this.
+		void shrink_to_fit()
 		{
-			if (new_size == 0)
+			if (_capacity == _size)
 				return;
 
-			if (new_size == 0)
+			if (_size == 0)
 			{
-				delete[] _data;
-				_data = nullptr;
-				_size = 0;
+				deallocate();
 				return;
 			}
 
-			try
+			relocate(_size);
+		}
+
+		// Appends a copy of the given value to the end of the Array.
+		// It may throw if it fails to do this.
+		void push_back(const_reference value)
+		{
+			emplace_back(value);
+		}
+
+		// Moves the given value to the end of the Array.
+		// It may throw if it fails to do this.
+		void push_back(value_type&& value)
+		{
+			emplace_back(std::move(value));
+		}
+
+		// Constructs a new element at the end of the Array from the given arguments.
+		// Returns a reference to the new element.
+		// It may throw if it fails to do this.
+		template <typename... Args>
+		reference emplace_back(Args&&... args)
+		{
+			if (_size == _capacity)
 			{
-				pointer new_data = new value_type[new_size];
-				std::copy(_data, _data + new_size, new_data);
-				delete[] _data;
-				_data = new_data;
+				// The arguments may refer to an element of this Array,
+				// so the new element is built before relocating.
+				value_type value(std::forward<Args>(args)...);
+				relocate(growthCapacity(_size + 1));
+				std::construct_at(_data + _size, std::move(value));
+			}
+			else
+				std::construct_at(_data + _size, std::forward<Args>(args)...);
+
+			++_size;
+			return _data[_size - 1];
+		}
+
+		// Removes the last element of the Array.
+		// Does NOT check if the Array is empty.
+		void pop_back() noexcept
+		{
+			--_size;
+			std::destroy_at(_data + _size);
+		}
+
+		// Resizes the Array, keeping the first min(size(), new_size) elements.
+		// New elements are value-initialized. Memory is only reallocated if
+		// new_size exceeds the capacity of the Array, and then grows it by 1.5x
+		// like push_back.
+		// It may throw if it fails to do this.
+		void resize(size_type new_size)
+		{
+			if (new_size <= _size)
+			{
+				std::destroy(_data + new_size, _data + _size);
 				_size = new_size;
-				new_data = nullptr;
+				return;
 			}
-			catch (...) { throw; }
+
+			if (new_size > _capacity)
+				relocate(growthCapacity(new_size));
+
+			std::uninitialized_value_construct(_data + _size, _data + new_size);
+			_size = new_size;
+		}
+
+		// Resizes the Array, keeping the first min(size(), new_size) elements.
+		// New elements are copies of the given value. Memory is only reallocated
+		// if new_size exceeds the capacity of the Array, and then grows it by 1.5x
+		// like push_back.
+		// It may throw if it fails to do this.
+		void resize(size_type new_size, const_reference value)
+		{
+			if (new_size <= _size)
+			{
+				std::destroy(_data + new_size, _data + _size);
+				_size = new_size;
+				return;
+			}
+
+			if (new_size > _capacity)
+			{
+				value_type copy(value);
+				relocate(growthCapacity(new_size));
+				std::uninitialized_fill(_data + _size, _data + new_size, copy);
+			}
+			else
+				std::uninitialized_fill(_data + _size, _data + new_size, value);
+
+			_size = new_size;
 		}
 
 		// Swaps the contents of this Array with another Array.
+		// If the allocators are not swapped, they must compare equal.
 		void swapWith(Array& other) noexcept
 		{
+			if constexpr (alloc_traits::propagate_on_container_swap::value)
+				std::swap(_allocator, other._allocator);
+
 			std::swap(_data, other._data);
 			std::swap(_size, other._size);
+			std::swap(_capacity, other._capacity);
 		}
 
 		// Returns the element at the given index the Array.
@@ -426,8 +719,8 @@ export namespace jlib
 	// Prints the contents of the Array using the std::cout ostream.
 	// This code will not compile if type T does not overload the 
 	// std::ostream insertion operator <<.
-	template <typename T>
-	void print_array(const Array<T>& arr)
+	template <typename T, typename Allocator>
+	void print_array(const Array<T, Allocator>& arr)
 	{
 		jlib::print_array(arr.data(), arr.size());
 	}
@@ -435,50 +728,86 @@ export namespace jlib
 	// Prints the contents of the Array using the std::wcout wostream.
 	// This code will not compile if type T does not overload the 
 	// std::wostream insertion operator <<.
-	template <typename T>
-	void print_array_wide(const Array<T>& arr)
+	template <typename T, typename Allocator>
+	void print_array_wide(const Array<T, Allocator>& arr)
 	{
 		jlib::print_array_wide(arr.data(), arr.size());
 	}
 
+	// Returns the smallest element of the Array.
+	// The Array must not be empty.
+	template <arithmetic T, typename Allocator>
+	T min_value(const Array<T, Allocator>& arr)
+	{
+		return jlib::min_value(arr.data(), arr.dataEnd());
+	}
+
+	// Returns the largest element of the Array.
+	// The Array must not be empty.
+	template <arithmetic T, typename Allocator>
+	T max_value(const Array<T, Allocator>& arr)
+	{
+		return jlib::max_value(arr.data(), arr.dataEnd());
+	}
+
+	// Returns the sum of the elements of the Array.
+	// Integers are summed and returned as a 64-bit integer.
+	template <arithmetic T, typename Allocator>
+	auto add_all(const Array<T, Allocator>& arr, Summation method = Summation::Pairwise)
+	{
+		return jlib::add_all(arr.data(), arr.dataEnd(), method);
+	}
+
+	// Returns the average of the elements of the Array.
+	// The Array must not be empty.
+	template <arithmetic T, typename Allocator>
+	float average(const Array<T, Allocator>& arr)
+	{
+		return jlib::average(arr.data(), arr.dataEnd());
+	}
+
+	// Returns the population variance of the elements of the Array.
+	// The Array must not be empty.
+	template <arithmetic T, typename Allocator>
+	double variance(const Array<T, Allocator>& arr)
+	{
+		return jlib::variance(arr.data(), arr.dataEnd());
+	}
+
+	// Returns the sum of the products of the elements of the Arrays.
+	// Throws a std::invalid_argument if the Arrays have different sizes.
+	template <arithmetic T, typename Allocator>
+	auto dot(const Array<T, Allocator>& A, const Array<T, Allocator>& B)
+	{
+		if (A.size() != B.size())
+			throw std::invalid_argument("ERROR: Array sizes do not match.");
+
+		return jlib::dot(A.data(), A.dataEnd(), B.data());
+	}
+
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	///////////////////////////////////////////////////////////////////////////////////////////////
 
 	// Overload of binary operator ==
-	template <std::totally_ordered T>
-	bool operator == (const Array<T>& A, const Array<T>& B)
+	template <std::totally_ordered T, typename Allocator>
+	bool operator == (const Array<T, Allocator>& A, const Array<T, Allocator>& B)
 	{
 		if (A.size() != B.size())
 			return false;
 
-		for (std::size_t i = 0; i < A.size(); ++i)
-		{
-			if (A[i] != B[i])
-				return false;
-		}
-
-		return true;
+		return simd::equal_n(A.data(), B.data(), A.size());
 	}
 
 	// Overload of binary operator !=
-	template <std::totally_ordered T>
-	bool operator != (const Array<T>& A, const Array<T>& B)
+	template <std::totally_ordered T, typename Allocator>
+	bool operator != (const Array<T, Allocator>& A, const Array<T, Allocator>& B)
 	{
-		if (A.size() != B.size())
-			return true;
-
-		for (std::size_t i = 0; i < A.size(); ++i)
-		{
-			if (A[i] != B[i])
-				return true;
-		}
-
-		return false;
+		return !(A == B);
 	}
 
 	// Overload of binary operator <
-	template <std::totally_ordered T>
-	bool operator < (const Array<T>& A, const Array<T>& B)
+	template <std::totally_ordered T, typename Allocator>
+	bool operator < (const Array<T, Allocator>& A, const Array<T, Allocator>& B)
 	{
 		if (A.size() < B.size())
 			return true;
@@ -493,8 +822,8 @@ export namespace jlib
 	}
 
 	// Overload of binary operator <=
-	template <std::totally_ordered T>
-	bool operator <= (const Array<T>& A, const Array<T>& B)
+	template <std::totally_ordered T, typename Allocator>
+	bool operator <= (const Array<T, Allocator>& A, const Array<T, Allocator>& B)
 	{
 		if (A.size() < B.size())
 			return true;
@@ -509,8 +838,8 @@ export namespace jlib
 	}
 
 	// Overload of binary operator >
-	template <std::totally_ordered T>
-	bool operator > (const Array<T>& A, const Array<T>& B)
+	template <std::totally_ordered T, typename Allocator>
+	bool operator > (const Array<T, Allocator>& A, const Array<T, Allocator>& B)
 	{
 		if (A.size() > B.size())
 			return true;
@@ -525,8 +854,8 @@ export namespace jlib
 	}
 
 	// Overload of binary operator >=
-	template <std::totally_ordered T>
-	bool operator >= (const Array<T>& A, const Array<T>& B)
+	template <std::totally_ordered T, typename Allocator>
+	bool operator >= (const Array<T, Allocator>& A, const Array<T, Allocator>& B)
 	{
 		if (A.size() > B.size())
 			return true;
@@ -541,8 +870,8 @@ export namespace jlib
 	}
 
 	// Overload of binary operator <=>
-	template <std::totally_ordered T>
-	std::strong_ordering operator <=> (const Array<T>& A, const Array<T>& B)
+	template <std::totally_ordered T, typename Allocator>
+	std::strong_ordering operator <=> (const Array<T, Allocator>& A, const Array<T, Allocator>& B)
 	{
 		if (A.size() < B.size())
 			return std::strong_ordering::less;
@@ -561,8 +890,8 @@ export namespace jlib
 	}
 
 	// Overload of std::ostream operator <<
-	template <typename T>
-	std::ostream& operator << (std::ostream& os, const Array<T>& A)
+	template <typename T, typename Allocator>
+	std::ostream& operator << (std::ostream& os, const Array<T, Allocator>& A)
 	{
 		os << "{ ";
 
@@ -570,11 +899,12 @@ export namespace jlib
 			os << A[i] << ", ";
 
 		os << A[A.size() - 1] << " }\n";
+		return os;
 	}
 
 	// Overload of std::wostream operator <<
-	template <typename T>
-	std::wostream& operator << (std::wostream& wos, const Array<T>& A)
+	template <typename T, typename Allocator>
+	std::wostream& operator << (std::wostream& wos, const Array<T, Allocator>& A)
 	{
 		wos << L"{ ";
 
@@ -582,5 +912,12 @@ export namespace jlib
 			wos << A[i] << L", ";
 
 		wos << A[A.size() - 1] << L" }\n";
+		return wos;
+	}
+
+	namespace pmr
+	{
+		// Array that obtains its memory from a std::pmr::memory_resource.
+		template <typename T> using Array = jlib::Array<T, std::pmr::polymorphic_allocator<T>>;
 	}
 }
\ No newline at end of file
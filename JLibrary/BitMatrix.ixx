@@ -1,144 +1,1186 @@
 // JLibrary
 // BitMatrix.ixx
 // Created on July 05 2022 by Justyn Durnford
-// Last modified on July 25 2022 by Justyn Durnford
-// Module file for the BitMatrix class.
+// Last modified on 2026-10-17 by Justyn Durnford
+// Module file for the FixedBitMatrix and DynamicBitMatrix classes.
+// FixedBitMatrix was called BitMatrix and kept its bits in a std::bitset,
+// which data() returned. data() now returns the 64-bit words of the rows.
+// Code that used the std::bitset can convert with toBitset() and the
+// std::bitset constructor.
 
 module;
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <bitset>
 #include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <new>
+#include <numeric>
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 export module BitMatrix;
 
+namespace jlib
+{
+	// Both matrices store every row as whole 64-bit words, with bit
+	// c of a row in bit (c % 64) of word (c / 64). The unused bits
+	// of the last word of each row are always 0, so the word loops
+	// below never have to mask them out when reading.
+
+	// Returns the number of 64-bit words needed for the given number of bits.
+	constexpr std::size_t _word_count(std::size_t bits) noexcept
+	{
+		return (bits + 63) / 64;
+	}
+
+	// Returns the mask of the used bits of the last word of a row.
+	constexpr std::uint64_t _tail_mask(std::size_t bits) noexcept
+	{
+		return bits % 64 == 0 ? ~std::uint64_t(0) : (std::uint64_t(1) << (bits % 64)) - 1;
+	}
+
+	// Returns the number of set bits in the words.
+	constexpr std::size_t _popcount(const std::uint64_t* words, std::size_t count) noexcept
+	{
+		std::size_t total = 0;
+
+		for (std::size_t i = 0; i < count; ++i)
+			total += static_cast<std::size_t>(std::popcount(words[i]));
+
+		return total;
+	}
+
+	// Returns the index of the first set bit of the row at or after from,
+	// or bits if there is none.
+	constexpr std::size_t _find_next(const std::uint64_t* words, std::size_t bits, std::size_t from) noexcept
+	{
+		if (from >= bits)
+			return bits;
+
+		const std::size_t count = _word_count(bits);
+		std::size_t w = from / 64;
+		std::uint64_t word = words[w] & (~std::uint64_t(0) << (from % 64));
+
+		while (word == 0)
+		{
+			if (++w == count)
+				return bits;
+
+			word = words[w];
+		}
+
+		return (w * 64) + static_cast<std::size_t>(std::countr_zero(word));
+	}
+
+	// Moves every bit of the row n places towards the higher indices.
+	// Bits moved past the end are lost and 0s are moved in.
+	constexpr void _shift_up(std::uint64_t* words, std::size_t bits, std::size_t n) noexcept
+	{
+		const std::size_t count = _word_count(bits);
+
+		if (n >= bits)
+		{
+			std::fill(words, words + count, std::uint64_t(0));
+			return;
+		}
+
+		const std::size_t word_shift = n / 64;
+		const std::size_t bit_shift = n % 64;
+
+		for (std::size_t i = count; i-- > word_shift;)
+		{
+			std::uint64_t value = words[i - word_shift] << bit_shift;
+
+			if (bit_shift != 0 && i > word_shift)
+				value |= words[i - word_shift - 1] >> (64 - bit_shift);
+
+			words[i] = value;
+		}
+
+		std::fill(words, words + word_shift, std::uint64_t(0));
+		words[count - 1] &= _tail_mask(bits);
+	}
+
+	// Moves every bit of the row n places towards the lower indices.
+	// Bits moved past the start are lost and 0s are moved in.
+	constexpr void _shift_down(std::uint64_t* words, std::size_t bits, std::size_t n) noexcept
+	{
+		const std::size_t count = _word_count(bits);
+
+		if (n >= bits)
+		{
+			std::fill(words, words + count, std::uint64_t(0));
+			return;
+		}
+
+		const std::size_t word_shift = n / 64;
+		const std::size_t bit_shift = n % 64;
+
+		for (std::size_t i = 0; i + word_shift < count; ++i)
+		{
+			std::uint64_t value = words[i + word_shift] >> bit_shift;
+
+			if (bit_shift != 0 && i + word_shift + 1 < count)
+				value |= words[i + word_shift + 1] << (64 - bit_shift);
+
+			words[i] = value;
+		}
+
+		std::fill(words + (count - word_shift), words + count, std::uint64_t(0));
+	}
+
+	// Sets dest to dest | src, word by word.
+	constexpr void _or_words(std::uint64_t* dest, const std::uint64_t* src, std::size_t count) noexcept
+	{
+		for (std::size_t i = 0; i < count; ++i)
+			dest[i] |= src[i];
+	}
+
+	// Computes row i of C = A * B over the boolean semiring, where A has
+	// inner columns and C has words words per row. Row i of C is the OR
+	// of the rows of B selected by the set bits of row i of A, so only
+	// the set bits of A are visited.
+	constexpr void _multiply_row(const std::uint64_t* a, std::size_t inner, const std::uint64_t* B,
+								 std::size_t b_stride, std::uint64_t* c, std::size_t words) noexcept
+	{
+		std::fill(c, c + words, std::uint64_t(0));
+
+		for (std::size_t k = _find_next(a, inner, 0); k < inner; k = _find_next(a, inner, k + 1))
+			_or_words(c, B + (k * b_stride), words);
+	}
+
+	// Replaces the square matrix with its transitive closure using
+	// Warshall's algorithm: after step k, row i can reach everything
+	// that row k can reach if row i can reach k. Each step ORs whole rows.
+	// If parallel is true, the rows of each step are split across threads.
+	inline void _transitive_closure(std::uint64_t* M, std::size_t n, std::size_t stride, bool parallel)
+	{
+		const std::size_t words = _word_count(n);
+		std::vector<std::size_t> rows;
+
+		if (parallel)
+		{
+			rows.resize(n);
+			std::iota(rows.begin(), rows.end(), std::size_t(0));
+		}
+
+		for (std::size_t k = 0; k < n; ++k)
+		{
+			const std::uint64_t* row_k = M + (k * stride);
+			const std::size_t k_word = k / 64;
+			const std::uint64_t k_bit = std::uint64_t(1) << (k % 64);
+
+			auto step = [&](std::size_t i)
+			{
+				std::uint64_t* row_i = M + (i * stride);
+
+				if (i != k && (row_i[k_word] & k_bit) != 0)
+					_or_words(row_i, row_k, words);
+			};
+
+			if (parallel)
+				std::for_each(std::execution::par, rows.begin(), rows.end(), step);
+			else
+			{
+				for (std::size_t i = 0; i < n; ++i)
+					step(i);
+			}
+		}
+	}
+
+	// Matrices with fewer word operations per step than this run on a single thread.
+	inline constexpr std::size_t _parallel_bit_matrix = std::size_t(1) << 16;
+}
+
 export namespace jlib
 {
-	// 
-	template <std::size_t R, std::size_t C> class BitMatrix
+	// Utility template class for representing a matrix of bits
+	// with dimensions known at compile time.
+	//
+	// Every row is stored as whole 64-bit words, so the row and matrix
+	// operations below work on 64 bits at a time.
+	// Bit [row][col] has the index (row * C) + col.
+	template <std::size_t R, std::size_t C> class FixedBitMatrix
 	{
-		std::bitset<R* C> _data;
+		public:
+
+		// Number of 64-bit words in every row.
+		static constexpr std::size_t wordsPerRow = _word_count(C);
+
+		private:
+
+		std::array<std::uint64_t, R * wordsPerRow> _words;
+
+		// Returns a pointer to the words of the given row.
+		constexpr std::uint64_t* row(std::size_t row) noexcept
+		{
+			return _words.data() + (row * wordsPerRow);
+		}
+
+		// Returns a pointer to the words of the given row.
+		constexpr const std::uint64_t* row(std::size_t row) const noexcept
+		{
+			return _words.data() + (row * wordsPerRow);
+		}
+
+		// Throws a std::out_of_range if given an invalid row index.
+		static constexpr void checkRow(std::size_t row)
+		{
+			if (row >= R)
+				throw std::out_of_range("Invalid row index");
+		}
+
+		// Throws a std::out_of_range if given an invalid column index.
+		static constexpr void checkCol(std::size_t col)
+		{
+			if (col >= C)
+				throw std::out_of_range("Invalid column index");
+		}
 
 		public:
 
 		// Default constructor.
-		BitMatrix() = default;
+		// Sets every bit of the FixedBitMatrix to 0.
+		constexpr FixedBitMatrix() : _words()
+		{
+
+		}
 
 		// boolean constructor.
-		// Sets every bit of the BitMatrix to the given boolean.
-		BitMatrix(bool value)
+		// Sets every bit of the FixedBitMatrix to the given boolean.
+		constexpr FixedBitMatrix(bool value) : _words()
+		{
+			fill(value);
+		}
+
+		// std::bitset constructor.
+		// Bit (row * C) + col of bits becomes bit [row][col].
+		explicit FixedBitMatrix(const std::bitset<R * C>& bits) : _words()
 		{
-			_data.set(value);
+			for (std::size_t r = 0; r < R; ++r)
+			{
+				for (std::size_t c = 0; c < C; ++c)
+				{
+					if (bits[(r * C) + c])
+						row(r)[c / 64] |= std::uint64_t(1) << (c % 64);
+				}
+			}
 		}
 
-		// Returns the number of rows in the BitMatrix.
+		// Returns the number of rows in the FixedBitMatrix.
 		constexpr std::size_t rowCount() const noexcept
 		{
 			return R;
 		}
 
-		// Returns the number of columns in the BitMatrix.
+		// Returns the number of columns in the FixedBitMatrix.
 		constexpr std::size_t colCount() const noexcept
 		{
 			return C;
 		}
 
-		// Returns the number of bits in the BitMatrix.
+		// Returns the number of bits in the FixedBitMatrix.
 		constexpr std::size_t size() const noexcept
 		{
 			return R * C;
 		}
 
-		// Returns the underlying std::bitset.
-		constexpr std::bitset<R * C>& data() noexcept
+		// Returns a pointer to the words of the FixedBitMatrix.
+		// Row r starts at word r * wordsPerRow. The unused bits
+		// of the last word of each row must be left as 0.
+		constexpr std::uint64_t* data() noexcept
 		{
-			return _data;
+			return _words.data();
 		}
 
-		// Returns the underlying std::bitset.
-		constexpr const std::bitset<R * C>& data() const noexcept
+		// Returns a pointer to the words of the FixedBitMatrix.
+		constexpr const std::uint64_t* data() const noexcept
 		{
-			return _data;
+			return _words.data();
 		}
 
-		// Returns the bit at the given index of the BitMatrix.
+		// Returns the bits of the FixedBitMatrix as a std::bitset,
+		// with bit [row][col] at index (row * C) + col.
+		std::bitset<R * C> toBitset() const
+		{
+			std::bitset<R * C> bits;
+
+			for (std::size_t r = 0; r < R; ++r)
+			{
+				for (std::size_t c = 0; c < C; ++c)
+					bits[(r * C) + c] = (*this)(r, c);
+			}
+
+			return bits;
+		}
+
+		// Returns the bit at the given index of the FixedBitMatrix.
 		// Throws a std::out_of_range if given an invalid index.
-		constexpr bool at(std::size_t n)
+		constexpr bool at(std::size_t n) const
 		{
 			if (n >= R * C)
 				throw std::out_of_range("Invalid BitMatrix index");
 
-			return _data[n];
+			return (*this)[n];
 		}
 
-		// Returns the bit at the given index of the BitMatrix.
+		// Returns the bit at [row][col].
 		// Throws a std::out_of_range if given an invalid index.
-		constexpr const bool at(std::size_t n) const
+		constexpr bool at(std::size_t row, std::size_t col) const
+		{
+			checkRow(row);
+			checkCol(col);
+
+			return (*this)(row, col);
+		}
+
+		// Sets the bit at the given index to the given value.
+		// Throws a std::out_of_range if given an invalid index.
+		constexpr void set(std::size_t n, bool value)
 		{
 			if (n >= R * C)
 				throw std::out_of_range("Invalid BitMatrix index");
 
-			return _data[n];
+			set(n / C, n % C, value);
 		}
 
-		// Returns the bit at [row][col].
+		// Sets the bit at [row][col] to the given value.
 		// Throws a std::out_of_range if given an invalid index.
-		constexpr bool at(std::size_t row, std::size_t col)
+		constexpr void set(std::size_t row, std::size_t col, bool value)
 		{
-			if (row >= R)
+			checkRow(row);
+			checkCol(col);
+
+			std::uint64_t& word = this->row(row)[col / 64];
+			const std::uint64_t bit = std::uint64_t(1) << (col % 64);
+			word = value ? (word | bit) : (word & ~bit);
+		}
+
+		// Flips the bit at [row][col].
+		// Throws a std::out_of_range if given an invalid index.
+		constexpr void flip(std::size_t row, std::size_t col)
+		{
+			checkRow(row);
+			checkCol(col);
+
+			this->row(row)[col / 64] ^= std::uint64_t(1) << (col % 64);
+		}
+
+		// Sets every bit of the FixedBitMatrix to the given value.
+		constexpr void fill(bool value) noexcept
+		{
+			for (std::size_t r = 0; r < R; ++r)
+			{
+				std::uint64_t* words = row(r);
+				std::fill(words, words + wordsPerRow, value ? ~std::uint64_t(0) : std::uint64_t(0));
+
+				if constexpr (wordsPerRow != 0)
+					words[wordsPerRow - 1] &= _tail_mask(C);
+			}
+		}
+
+		// Sets every bit of the FixedBitMatrix to 0.
+		constexpr void clear() noexcept
+		{
+			_words.fill(0);
+		}
+
+		// Returns the number of set bits in the FixedBitMatrix.
+		constexpr std::size_t popcount() const noexcept
+		{
+			return _popcount(_words.data(), _words.size());
+		}
+
+		// Returns the number of set bits in the given row.
+		// Throws a std::out_of_range if given an invalid row index.
+		constexpr std::size_t rowPopcount(std::size_t row) const
+		{
+			checkRow(row);
+			return _popcount(this->row(row), wordsPerRow);
+		}
+
+		// Returns the number of set bits in the given column.
+		// Throws a std::out_of_range if given an invalid column index.
+		constexpr std::size_t colPopcount(std::size_t col) const
+		{
+			checkCol(col);
+
+			std::size_t total = 0;
+
+			for (std::size_t r = 0; r < R; ++r)
+				total += static_cast<std::size_t>((row(r)[col / 64] >> (col % 64)) & 1);
+
+			return total;
+		}
+
+		// Returns true if any bit is set.
+		constexpr bool any() const noexcept
+		{
+			return std::any_of(_words.begin(), _words.end(), [](std::uint64_t word) { return word != 0; });
+		}
+
+		// Returns true if no bit is set.
+		constexpr bool none() const noexcept
+		{
+			return !any();
+		}
+
+		// Returns the column of the first set bit of the given row,
+		// or colCount() if the row has no set bits.
+		// Throws a std::out_of_range if given an invalid row index.
+		constexpr std::size_t findFirstInRow(std::size_t row) const
+		{
+			checkRow(row);
+			return _find_next(this->row(row), C, 0);
+		}
+
+		// Returns the column of the first set bit of the given row after col,
+		// or colCount() if there is none.
+		// Throws a std::out_of_range if given an invalid row index.
+		constexpr std::size_t findNextInRow(std::size_t row, std::size_t col) const
+		{
+			checkRow(row);
+			return _find_next(this->row(row), C, col + 1);
+		}
+
+		// Sets row dest to row dest & row src.
+		// Throws a std::out_of_range if given an invalid row index.
+		constexpr void rowAnd(std::size_t dest, std::size_t src)
+		{
+			checkRow(dest);
+			checkRow(src);
+
+			for (std::size_t i = 0; i < wordsPerRow; ++i)
+				row(dest)[i] &= row(src)[i];
+		}
+
+		// Sets row dest to row dest | row src.
+		// Throws a std::out_of_range if given an invalid row index.
+		constexpr void rowOr(std::size_t dest, std::size_t src)
+		{
+			checkRow(dest);
+			checkRow(src);
+
+			_or_words(row(dest), row(src), wordsPerRow);
+		}
+
+		// Sets row dest to row dest ^ row src.
+		// Throws a std::out_of_range if given an invalid row index.
+		constexpr void rowXor(std::size_t dest, std::size_t src)
+		{
+			checkRow(dest);
+			checkRow(src);
+
+			for (std::size_t i = 0; i < wordsPerRow; ++i)
+				row(dest)[i] ^= row(src)[i];
+		}
+
+		// Flips every bit of the given row.
+		// Throws a std::out_of_range if given an invalid row index.
+		constexpr void rowFlip(std::size_t row)
+		{
+			checkRow(row);
+
+			std::uint64_t* words = this->row(row);
+
+			for (std::size_t i = 0; i < wordsPerRow; ++i)
+				words[i] = ~words[i];
+
+			if constexpr (wordsPerRow != 0)
+				words[wordsPerRow - 1] &= _tail_mask(C);
+		}
+
+		// Moves every bit n columns to the right, or to the left if n is negative.
+		// Bits moved out of a row are lost and 0s are moved in.
+		constexpr void shiftCols(std::ptrdiff_t n) noexcept
+		{
+			for (std::size_t r = 0; r < R; ++r)
+			{
+				if (n >= 0)
+					_shift_up(row(r), C, static_cast<std::size_t>(n));
+				else
+					_shift_down(row(r), C, static_cast<std::size_t>(-n));
+			}
+		}
+
+		// Moves every row n rows down, or up if n is negative.
+		// Rows moved out of the FixedBitMatrix are lost and rows of 0s are moved in.
+		constexpr void shiftRows(std::ptrdiff_t n) noexcept
+		{
+			const std::size_t shift = std::min(static_cast<std::size_t>(n < 0 ? -n : n), R) * wordsPerRow;
+
+			if (n >= 0)
+			{
+				std::copy_backward(_words.begin(), _words.end() - shift, _words.end());
+				std::fill(_words.begin(), _words.begin() + shift, std::uint64_t(0));
+			}
+			else
+			{
+				std::copy(_words.begin() + shift, _words.end(), _words.begin());
+				std::fill(_words.end() - shift, _words.end(), std::uint64_t(0));
+			}
+		}
+
+		// Flips every bit of the FixedBitMatrix.
+		constexpr void flip() noexcept
+		{
+			for (std::size_t r = 0; r < R; ++r)
+				rowFlip(r);
+		}
+
+		// Overload of operator &=
+		constexpr FixedBitMatrix& operator &= (const FixedBitMatrix& other) noexcept
+		{
+			for (std::size_t i = 0; i < _words.size(); ++i)
+				_words[i] &= other._words[i];
+
+			return *this;
+		}
+
+		// Overload of operator |=
+		constexpr FixedBitMatrix& operator |= (const FixedBitMatrix& other) noexcept
+		{
+			_or_words(_words.data(), other._words.data(), _words.size());
+			return *this;
+		}
+
+		// Overload of operator ^=
+		constexpr FixedBitMatrix& operator ^= (const FixedBitMatrix& other) noexcept
+		{
+			for (std::size_t i = 0; i < _words.size(); ++i)
+				_words[i] ^= other._words[i];
+
+			return *this;
+		}
+
+		// Returns the bit at the given index of the FixedBitMatrix.
+		// Does NOT perform bounds-checking.
+		constexpr bool operator [] (std::size_t n) const
+		{
+			return (*this)(n / C, n % C);
+		}
+
+		// Returns the bit at [row][col].
+		// Does NOT perform bounds-checking.
+		constexpr bool operator () (std::size_t row, std::size_t col) const
+		{
+			return ((this->row(row)[col / 64] >> (col % 64)) & 1) != 0;
+		}
+
+		// Overload of binary operator ==
+		friend constexpr bool operator == (const FixedBitMatrix& A, const FixedBitMatrix& B) noexcept
+		{
+			return A._words == B._words;
+		}
+	};
+
+	// Overload of binary operator &
+	template <std::size_t R, std::size_t C>
+	constexpr FixedBitMatrix<R, C> operator & (const FixedBitMatrix<R, C>& A, const FixedBitMatrix<R, C>& B) noexcept
+	{
+		FixedBitMatrix<R, C> M(A);
+		return M &= B;
+	}
+
+	// Overload of binary operator |
+	template <std::size_t R, std::size_t C>
+	constexpr FixedBitMatrix<R, C> operator | (const FixedBitMatrix<R, C>& A, const FixedBitMatrix<R, C>& B) noexcept
+	{
+		FixedBitMatrix<R, C> M(A);
+		return M |= B;
+	}
+
+	// Overload of binary operator ^
+	template <std::size_t R, std::size_t C>
+	constexpr FixedBitMatrix<R, C> operator ^ (const FixedBitMatrix<R, C>& A, const FixedBitMatrix<R, C>& B) noexcept
+	{
+		FixedBitMatrix<R, C> M(A);
+		return M ^= B;
+	}
+
+	// Overload of unary operator ~
+	template <std::size_t R, std::size_t C>
+	constexpr FixedBitMatrix<R, C> operator ~ (const FixedBitMatrix<R, C>& A) noexcept
+	{
+		FixedBitMatrix<R, C> M(A);
+		M.flip();
+		return M;
+	}
+
+	// Overload of binary operator *
+	// Returns the boolean matrix product of A and B, where bit [i][j]
+	// is set if bit [i][k] of A and bit [k][j] of B are set for any k.
+	template <std::size_t R, std::size_t K, std::size_t C>
+	constexpr FixedBitMatrix<R, C> operator * (const FixedBitMatrix<R, K>& A, const FixedBitMatrix<K, C>& B) noexcept
+	{
+		FixedBitMatrix<R, C> M;
+
+		for (std::size_t r = 0; r < R; ++r)
+		{
+			_multiply_row(A.data() + (r * A.wordsPerRow), K, B.data(), B.wordsPerRow,
+						  M.data() + (r * M.wordsPerRow), M.wordsPerRow);
+		}
+
+		return M;
+	}
+
+	// Returns the transitive closure of the square FixedBitMatrix.
+	// Bit [i][j] of the result is set if j can be reached from i
+	// by following one or more set bits.
+	template <std::size_t N>
+	FixedBitMatrix<N, N> transitive_closure(const FixedBitMatrix<N, N>& A)
+	{
+		FixedBitMatrix<N, N> M(A);
+		_transitive_closure(M.data(), N, M.wordsPerRow, false);
+		return M;
+	}
+
+	// Deprecated: former name of FixedBitMatrix, kept so existing code
+	// still compiles. Use FixedBitMatrix, or DynamicBitMatrix for dimensions
+	// chosen at runtime. data() now returns the 64-bit words of the rows
+	// instead of a std::bitset; toBitset() returns the std::bitset.
+	template <std::size_t R, std::size_t C> using BitMatrix = FixedBitMatrix<R, C>;
+
+	// Class that represents a matrix of bits with dimensions
+	// chosen at runtime.
+	//
+	// Every row is stored as whole 64-bit words and starts on a 64-byte
+	// boundary, so the row and matrix operations below work on 64 bits
+	// at a time and a row never shares a cache line with another row.
+	// Bit [row][col] has the index (row * colCount()) + col.
+	class DynamicBitMatrix
+	{
+		std::uint64_t* _words;
+		std::size_t _rows;
+		std::size_t _cols;
+		std::size_t _stride;
+
+		// Returns the number of words from the start of a row to the next,
+		// which is rounded up to a whole number of 64-byte cache lines.
+		static constexpr std::size_t strideFor(std::size_t cols) noexcept
+		{
+			return (_word_count(cols) + 7) & ~std::size_t(7);
+		}
+
+		// Allocates zeroed, 64-byte aligned memory for the words.
+		void allocate()
+		{
+			const std::size_t count = _rows * _stride;
+			_words = nullptr;
+
+			if (count != 0)
+			{
+				_words = static_cast<std::uint64_t*>(::operator new(count * sizeof(std::uint64_t), std::align_val_t(64)));
+				std::fill(_words, _words + count, std::uint64_t(0));
+			}
+		}
+
+		// Releases the memory of the words.
+		void deallocate() noexcept
+		{
+			if (_words != nullptr)
+				::operator delete(_words, std::align_val_t(64));
+
+			_words = nullptr;
+		}
+
+		// Throws a std::out_of_range if given an invalid row index.
+		void checkRow(std::size_t row) const
+		{
+			if (row >= _rows)
 				throw std::out_of_range("Invalid row index");
-			if (col >= C)
+		}
+
+		// Throws a std::out_of_range if given an invalid column index.
+		void checkCol(std::size_t col) const
+		{
+			if (col >= _cols)
 				throw std::out_of_range("Invalid column index");
+		}
+
+		// Throws a std::invalid_argument if the dimensions of other do not match.
+		void checkSize(const DynamicBitMatrix& other) const
+		{
+			if (_rows != other._rows || _cols != other._cols)
+				throw std::invalid_argument("ERROR: DynamicBitMatrix dimensions do not match.");
+		}
+
+		public:
+
+		// Default constructor.
+		// Creates an empty 0 x 0 DynamicBitMatrix.
+		DynamicBitMatrix() noexcept : _words(nullptr), _rows(0), _cols(0), _stride(0)
+		{
+
+		}
+
+		// Size constructor.
+		// Sets every bit of the rows x cols DynamicBitMatrix to the given value.
+		DynamicBitMatrix(std::size_t rows, std::size_t cols, bool value = false) : _rows(rows), _cols(cols), _stride(strideFor(cols))
+		{
+			allocate();
+
+			if (value)
+				fill(true);
+		}
+
+		// FixedBitMatrix constructor.
+		template <std::size_t R, std::size_t C>
+		explicit DynamicBitMatrix(const FixedBitMatrix<R, C>& other) : DynamicBitMatrix(R, C)
+		{
+			for (std::size_t r = 0; r < R; ++r)
+				std::copy(other.data() + (r * other.wordsPerRow), other.data() + ((r + 1) * other.wordsPerRow), rowData(r));
+		}
+
+		// Copy constructor.
+		DynamicBitMatrix(const DynamicBitMatrix& other) : _rows(other._rows), _cols(other._cols), _stride(other._stride)
+		{
+			allocate();
+			std::copy(other._words, other._words + (_rows * _stride), _words);
+		}
+
+		// Move constructor.
+		DynamicBitMatrix(DynamicBitMatrix&& other) noexcept
+			: _words(std::exchange(other._words, nullptr)), _rows(std::exchange(other._rows, 0)),
+			  _cols(std::exchange(other._cols, 0)), _stride(std::exchange(other._stride, 0))
+		{
+
+		}
+
+		// Copy assignment operator.
+		DynamicBitMatrix& operator = (const DynamicBitMatrix& other)
+		{
+			if (this != &other)
+			{
+				DynamicBitMatrix copy(other);
+				swapWith(copy);
+			}
 
-			return _data[(row * C) + col];
+			return *this;
+		}
+
+		// Move assignment operator.
+		DynamicBitMatrix& operator = (DynamicBitMatrix&& other) noexcept
+		{
+			if (this != &other)
+			{
+				deallocate();
+				_words = std::exchange(other._words, nullptr);
+				_rows = std::exchange(other._rows, 0);
+				_cols = std::exchange(other._cols, 0);
+				_stride = std::exchange(other._stride, 0);
+			}
+
+			return *this;
+		}
+
+		// Destructor.
+		~DynamicBitMatrix() noexcept
+		{
+			deallocate();
+		}
+
+		// Returns the number of rows in the DynamicBitMatrix.
+		std::size_t rowCount() const noexcept
+		{
+			return _rows;
+		}
+
+		// Returns the number of columns in the DynamicBitMatrix.
+		std::size_t colCount() const noexcept
+		{
+			return _cols;
+		}
+
+		// Returns the number of bits in the DynamicBitMatrix.
+		std::size_t size() const noexcept
+		{
+			return _rows * _cols;
+		}
+
+		// Returns the number of 64-bit words from the start of a row to the next.
+		std::size_t stride() const noexcept
+		{
+			return _stride;
+		}
+
+		// Returns a pointer to the 64-byte aligned words of the given row.
+		// The unused bits of the last word of the row must be left as 0.
+		// Does NOT perform bounds-checking.
+		std::uint64_t* rowData(std::size_t row) noexcept
+		{
+			return _words + (row * _stride);
+		}
+
+		// Returns a pointer to the 64-byte aligned words of the given row.
+		// Does NOT perform bounds-checking.
+		const std::uint64_t* rowData(std::size_t row) const noexcept
+		{
+			return _words + (row * _stride);
+		}
+
+		// Returns the bit at the given index of the DynamicBitMatrix.
+		// Throws a std::out_of_range if given an invalid index.
+		bool at(std::size_t n) const
+		{
+			if (n >= size())
+				throw std::out_of_range("Invalid DynamicBitMatrix index");
+
+			return (*this)[n];
 		}
 
 		// Returns the bit at [row][col].
 		// Throws a std::out_of_range if given an invalid index.
-		constexpr const bool at(std::size_t row, std::size_t col) const
+		bool at(std::size_t row, std::size_t col) const
 		{
-			if (row >= R)
-				throw std::out_of_range("Invalid row index");
-			if (col >= C)
-				throw std::out_of_range("Invalid column index");
+			checkRow(row);
+			checkCol(col);
 
-			return _data[(row * C) + col];
+			return (*this)(row, col);
 		}
 
 		// Sets the bit at the given index to the given value.
 		// Throws a std::out_of_range if given an invalid index.
-		constexpr void set(std::size_t n, bool value)
+		void set(std::size_t n, bool value)
 		{
-			if (n >= R * C)
-				throw std::out_of_range("Invalid BitMatrix index");
+			if (n >= size())
+				throw std::out_of_range("Invalid DynamicBitMatrix index");
 
-			_data[n] = value;
+			set(n / _cols, n % _cols, value);
 		}
 
 		// Sets the bit at [row][col] to the given value.
 		// Throws a std::out_of_range if given an invalid index.
-		constexpr void set(std::size_t row, std::size_t col, bool value)
+		void set(std::size_t row, std::size_t col, bool value)
 		{
-			if (row >= R)
-				throw std::out_of_range("Invalid row index");
-			if (col >= C)
-				throw std::out_of_range("Invalid column index");
+			checkRow(row);
+			checkCol(col);
+
+			std::uint64_t& word = rowData(row)[col / 64];
+			const std::uint64_t bit = std::uint64_t(1) << (col % 64);
+			word = value ? (word | bit) : (word & ~bit);
+		}
+
+		// Flips the bit at [row][col].
+		// Throws a std::out_of_range if given an invalid index.
+		void flip(std::size_t row, std::size_t col)
+		{
+			checkRow(row);
+			checkCol(col);
 
-			_data[(row * C) + col] = value;
+			rowData(row)[col / 64] ^= std::uint64_t(1) << (col % 64);
 		}
 
-		// Returns the bit at the given index of the BitMatrix.
+		// Sets every bit of the DynamicBitMatrix to the given value.
+		void fill(bool value) noexcept
+		{
+			const std::size_t words = _word_count(_cols);
+
+			for (std::size_t r = 0; r < _rows; ++r)
+			{
+				std::uint64_t* row = rowData(r);
+				std::fill(row, row + words, value ? ~std::uint64_t(0) : std::uint64_t(0));
+
+				if (words != 0)
+					row[words - 1] &= _tail_mask(_cols);
+			}
+		}
+
+		// Sets every bit of the DynamicBitMatrix to 0.
+		void clear() noexcept
+		{
+			std::fill(_words, _words + (_rows * _stride), std::uint64_t(0));
+		}
+
+		// Returns the number of set bits in the DynamicBitMatrix.
+		std::size_t popcount() const noexcept
+		{
+			return _popcount(_words, _rows * _stride);
+		}
+
+		// Returns the number of set bits in the given row.
+		// Throws a std::out_of_range if given an invalid row index.
+		std::size_t rowPopcount(std::size_t row) const
+		{
+			checkRow(row);
+			return _popcount(rowData(row), _word_count(_cols));
+		}
+
+		// Returns the number of set bits in the given column.
+		// Throws a std::out_of_range if given an invalid column index.
+		std::size_t colPopcount(std::size_t col) const
+		{
+			checkCol(col);
+
+			std::size_t total = 0;
+
+			for (std::size_t r = 0; r < _rows; ++r)
+				total += static_cast<std::size_t>((rowData(r)[col / 64] >> (col % 64)) & 1);
+
+			return total;
+		}
+
+		// Returns true if any bit is set.
+		bool any() const noexcept
+		{
+			return std::any_of(_words, _words + (_rows * _stride), [](std::uint64_t word) { return word != 0; });
+		}
+
+		// Returns true if no bit is set.
+		bool none() const noexcept
+		{
+			return !any();
+		}
+
+		// Returns the column of the first set bit of the given row,
+		// or colCount() if the row has no set bits.
+		// Throws a std::out_of_range if given an invalid row index.
+		std::size_t findFirstInRow(std::size_t row) const
+		{
+			checkRow(row);
+			return _find_next(rowData(row), _cols, 0);
+		}
+
+		// Returns the column of the first set bit of the given row after col,
+		// or colCount() if there is none.
+		// Throws a std::out_of_range if given an invalid row index.
+		std::size_t findNextInRow(std::size_t row, std::size_t col) const
+		{
+			checkRow(row);
+			return _find_next(rowData(row), _cols, col + 1);
+		}
+
+		// Sets row dest to row dest & row src.
+		// Throws a std::out_of_range if given an invalid row index.
+		void rowAnd(std::size_t dest, std::size_t src)
+		{
+			checkRow(dest);
+			checkRow(src);
+
+			for (std::size_t i = 0; i < _stride; ++i)
+				rowData(dest)[i] &= rowData(src)[i];
+		}
+
+		// Sets row dest to row dest | row src.
+		// Throws a std::out_of_range if given an invalid row index.
+		void rowOr(std::size_t dest, std::size_t src)
+		{
+			checkRow(dest);
+			checkRow(src);
+
+			_or_words(rowData(dest), rowData(src), _stride);
+		}
+
+		// Sets row dest to row dest ^ row src.
+		// Throws a std::out_of_range if given an invalid row index.
+		void rowXor(std::size_t dest, std::size_t src)
+		{
+			checkRow(dest);
+			checkRow(src);
+
+			for (std::size_t i = 0; i < _stride; ++i)
+				rowData(dest)[i] ^= rowData(src)[i];
+		}
+
+		// Flips every bit of the given row.
+		// Throws a std::out_of_range if given an invalid row index.
+		void rowFlip(std::size_t row)
+		{
+			checkRow(row);
+
+			const std::size_t words = _word_count(_cols);
+			std::uint64_t* data = rowData(row);
+
+			for (std::size_t i = 0; i < words; ++i)
+				data[i] = ~data[i];
+
+			if (words != 0)
+				data[words - 1] &= _tail_mask(_cols);
+		}
+
+		// Moves every bit n columns to the right, or to the left if n is negative.
+		// Bits moved out of a row are lost and 0s are moved in.
+		void shiftCols(std::ptrdiff_t n) noexcept
+		{
+			for (std::size_t r = 0; r < _rows; ++r)
+			{
+				if (n >= 0)
+					_shift_up(rowData(r), _cols, static_cast<std::size_t>(n));
+				else
+					_shift_down(rowData(r), _cols, static_cast<std::size_t>(-n));
+			}
+		}
+
+		// Moves every row n rows down, or up if n is negative.
+		// Rows moved out of the DynamicBitMatrix are lost and rows of 0s are moved in.
+		void shiftRows(std::ptrdiff_t n) noexcept
+		{
+			const std::size_t total = _rows * _stride;
+			const std::size_t shift = std::min(static_cast<std::size_t>(n < 0 ? -n : n), _rows) * _stride;
+
+			if (n >= 0)
+			{
+				std::copy_backward(_words, _words + (total - shift), _words + total);
+				std::fill(_words, _words + shift, std::uint64_t(0));
+			}
+			else
+			{
+				std::copy(_words + shift, _words + total, _words);
+				std::fill(_words + (total - shift), _words + total, std::uint64_t(0));
+			}
+		}
+
+		// Flips every bit of the DynamicBitMatrix.
+		void flip() noexcept
+		{
+			for (std::size_t r = 0; r < _rows; ++r)
+				rowFlip(r);
+		}
+
+		// Swaps the contents of this DynamicBitMatrix with another DynamicBitMatrix.
+		void swapWith(DynamicBitMatrix& other) noexcept
+		{
+			std::swap(_words, other._words);
+			std::swap(_rows, other._rows);
+			std::swap(_cols, other._cols);
+			std::swap(_stride, other._stride);
+		}
+
+		// Overload of operator &=
+		// Throws a std::invalid_argument if the dimensions do not match.
+		DynamicBitMatrix& operator &= (const DynamicBitMatrix& other)
+		{
+			checkSize(other);
+
+			for (std::size_t i = 0; i < _rows * _stride; ++i)
+				_words[i] &= other._words[i];
+
+			return *this;
+		}
+
+		// Overload of operator |=
+		// Throws a std::invalid_argument if the dimensions do not match.
+		DynamicBitMatrix& operator |= (const DynamicBitMatrix& other)
+		{
+			checkSize(other);
+			_or_words(_words, other._words, _rows * _stride);
+			return *this;
+		}
+
+		// Overload of operator ^=
+		// Throws a std::invalid_argument if the dimensions do not match.
+		DynamicBitMatrix& operator ^= (const DynamicBitMatrix& other)
+		{
+			checkSize(other);
+
+			for (std::size_t i = 0; i < _rows * _stride; ++i)
+				_words[i] ^= other._words[i];
+
+			return *this;
+		}
+
+		// Returns the bit at the given index of the DynamicBitMatrix.
 		// Does NOT perform bounds-checking.
-		constexpr bool operator [] (std::size_t n) const
+		bool operator [] (std::size_t n) const
 		{
-			return _data[n];
+			return (*this)(n / _cols, n % _cols);
 		}
 
 		// Returns the bit at [row][col].
 		// Does NOT perform bounds-checking.
-		constexpr bool operator () (std::size_t row, std::size_t col) const
+		bool operator () (std::size_t row, std::size_t col) const
 		{
-			return _data[(row * C) + col];
+			return ((rowData(row)[col / 64] >> (col % 64)) & 1) != 0;
+		}
+
+		// Overload of binary operator ==
+		friend bool operator == (const DynamicBitMatrix& A, const DynamicBitMatrix& B) noexcept
+		{
+			return A._rows == B._rows && A._cols == B._cols && std::equal(A._words, A._words + (A._rows * A._stride), B._words);
+		}
+
+		// Overload of binary operator &
+		// Throws a std::invalid_argument if the dimensions do not match.
+		friend DynamicBitMatrix operator & (const DynamicBitMatrix& A, const DynamicBitMatrix& B)
+		{
+			DynamicBitMatrix M(A);
+			return M &= B;
+		}
+
+		// Overload of binary operator |
+		// Throws a std::invalid_argument if the dimensions do not match.
+		friend DynamicBitMatrix operator | (const DynamicBitMatrix& A, const DynamicBitMatrix& B)
+		{
+			DynamicBitMatrix M(A);
+			return M |= B;
+		}
+
+		// Overload of binary operator ^
+		// Throws a std::invalid_argument if the dimensions do not match.
+		friend DynamicBitMatrix operator ^ (const DynamicBitMatrix& A, const DynamicBitMatrix& B)
+		{
+			DynamicBitMatrix M(A);
+			return M ^= B;
+		}
+
+		// Overload of unary operator ~
+		friend DynamicBitMatrix operator ~ (const DynamicBitMatrix& A)
+		{
+			DynamicBitMatrix M(A);
+			M.flip();
+			return M;
+		}
+
+		// Overload of binary operator *
+		// Returns the boolean matrix product of A and B, where bit [i][j]
+		// is set if bit [i][k] of A and bit [k][j] of B are set for any k.
+		// Large products are split across threads by rows.
+		// Throws a std::invalid_argument if A.colCount() != B.rowCount().
+		friend DynamicBitMatrix operator * (const DynamicBitMatrix& A, const DynamicBitMatrix& B)
+		{
+			if (A._cols != B._rows)
+				throw std::invalid_argument("ERROR: DynamicBitMatrix dimensions do not match.");
+
+			DynamicBitMatrix M(A._rows, B._cols);
+
+			auto row = [&](std::size_t r)
+			{
+				_multiply_row(A.rowData(r), A._cols, B._words, B._stride, M.rowData(r), M._stride);
+			};
+
+			if (A._rows * A._cols * M._stride >= _parallel_bit_matrix * 64)
+			{
+				std::vector<std::size_t> rows(A._rows);
+				std::iota(rows.begin(), rows.end(), std::size_t(0));
+				std::for_each(std::execution::par, rows.begin(), rows.end(), row);
+			}
+			else
+			{
+				for (std::size_t r = 0; r < A._rows; ++r)
+					row(r);
+			}
+
+			return M;
+		}
+
+		// Returns the transitive closure of the square DynamicBitMatrix.
+		// Bit [i][j] of the result is set if j can be reached from i
+		// by following one or more set bits.
+		// The rows of large matrices are updated in parallel.
+		// Throws a std::invalid_argument if A is not square.
+		friend DynamicBitMatrix transitive_closure(const DynamicBitMatrix& A)
+		{
+			if (A._rows != A._cols)
+				throw std::invalid_argument("ERROR: DynamicBitMatrix is not square.");
+
+			DynamicBitMatrix M(A);
+			_transitive_closure(M._words, M._rows, M._stride, M._rows * M._stride >= _parallel_bit_matrix);
+			return M;
 		}
 	};
 }
\ No newline at end of file
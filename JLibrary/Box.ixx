@@ -1,7 +1,7 @@
 // JLibrary
 // Box.ixx
 // Created on 2022-02-22 by Justyn Durnford
-// Last modified on 2022-02-22 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
 // Module file for the Box template class.
 
 module;
@@ -187,6 +187,22 @@ export namespace jlib
 		}
 	};
 
+	// Checks if there is an intersection between the given Boxes.
+	template <arithmetic T>
+	bool intersection(const Box<T>& A, const Box<T>& B)
+	{
+		if (std::max(A.vertex.x, A.vertex.x + A.length) < std::min(B.vertex.x, B.vertex.x + B.length) ||
+			std::max(B.vertex.x, B.vertex.x + B.length) < std::min(A.vertex.x, A.vertex.x + A.length))
+			return false;
+		if (std::max(A.vertex.y, A.vertex.y + A.width) < std::min(B.vertex.y, B.vertex.y + B.width) ||
+			std::max(B.vertex.y, B.vertex.y + B.width) < std::min(A.vertex.y, A.vertex.y + A.width))
+			return false;
+		if (std::max(A.vertex.z, A.vertex.z + A.height) < std::min(B.vertex.z, B.vertex.z + B.height) ||
+			std::max(B.vertex.z, B.vertex.z + B.height) < std::min(A.vertex.z, A.vertex.z + A.height))
+			return false;
+		return true;
+	}
+
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	///////////////////////////////////////////////////////////////////////////////////////////////
 
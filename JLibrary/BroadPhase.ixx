@@ -0,0 +1,726 @@
+// JLibrary
+// BroadPhase.ixx
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Module file for the SweepAndPrune and SpatialHash broad-phase classes.
+
+module;
+
+#include "Arithmetic.hpp"
+#include "IntegerTypedefs.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+export module BroadPhase;
+
+import Box;
+import Circle;
+import Rect;
+import Square;
+
+export namespace jlib
+{
+	// Axis-aligned bounding box in D-dimensional space.
+	// min[i] <= max[i] along every axis i.
+	template <arithmetic T, std::size_t D> struct BoundingBox
+	{
+		std::array<T, D> min;
+		std::array<T, D> max;
+	};
+
+	// Returns the bounding box of the given Rect.
+	template <arithmetic T>
+	BoundingBox<T, 2> bounding_box(const Rect<T>& rect)
+	{
+		return BoundingBox<T, 2>{ { std::min(rect.vertex.x, static_cast<T>(rect.vertex.x + rect.length)),
+									std::min(rect.vertex.y, static_cast<T>(rect.vertex.y + rect.height)) },
+								  { std::max(rect.vertex.x, static_cast<T>(rect.vertex.x + rect.length)),
+									std::max(rect.vertex.y, static_cast<T>(rect.vertex.y + rect.height)) } };
+	}
+
+	// Returns the bounding box of the given Square.
+	template <arithmetic T>
+	BoundingBox<T, 2> bounding_box(const Square<T>& square)
+	{
+		return BoundingBox<T, 2>{ { std::min(square.x, static_cast<T>(square.x + square.l)),
+									std::min(square.y, static_cast<T>(square.y + square.l)) },
+								  { std::max(square.x, static_cast<T>(square.x + square.l)),
+									std::max(square.y, static_cast<T>(square.y + square.l)) } };
+	}
+
+	// Returns the bounding box of the given Circle.
+	template <arithmetic T>
+	BoundingBox<T, 2> bounding_box(const Circle<T>& circle)
+	{
+		const T r = std::abs(circle.radius);
+
+		return BoundingBox<T, 2>{ { static_cast<T>(circle.center.x - r), static_cast<T>(circle.center.y - r) },
+								  { static_cast<T>(circle.center.x + r), static_cast<T>(circle.center.y + r) } };
+	}
+
+	// Returns the bounding box of the given Box.
+	template <arithmetic T>
+	BoundingBox<T, 3> bounding_box(const Box<T>& box)
+	{
+		return BoundingBox<T, 3>{ { std::min(box.vertex.x, static_cast<T>(box.vertex.x + box.length)),
+									std::min(box.vertex.y, static_cast<T>(box.vertex.y + box.width)),
+									std::min(box.vertex.z, static_cast<T>(box.vertex.z + box.height)) },
+								  { std::max(box.vertex.x, static_cast<T>(box.vertex.x + box.length)),
+									std::max(box.vertex.y, static_cast<T>(box.vertex.y + box.width)),
+									std::max(box.vertex.z, static_cast<T>(box.vertex.z + box.height)) } };
+	}
+
+	// Returns true if the given bounding boxes overlap or touch.
+	template <arithmetic T, std::size_t D>
+	constexpr bool overlaps(const BoundingBox<T, D>& A, const BoundingBox<T, D>& B) noexcept
+	{
+		for (std::size_t i = 0; i < D; ++i)
+		{
+			if (A.max[i] < B.min[i] || B.max[i] < A.min[i])
+				return false;
+		}
+
+		return true;
+	}
+}
+
+namespace jlib
+{
+	// Storage of the bounding boxes of the entries of a broad-phase,
+	// with ids that are reused after an entry is erased.
+	template <typename T, std::size_t D> class _BroadPhaseEntries
+	{
+		std::vector<BoundingBox<T, D>> _boxes;
+		std::vector<bool> _used;
+		std::vector<std::size_t> _free;
+
+		public:
+
+		// Stores the bounding box and returns its id.
+		std::size_t insert(const BoundingBox<T, D>& box)
+		{
+			if (!_free.empty())
+			{
+				const std::size_t id = _free.back();
+				_free.pop_back();
+				_boxes[id] = box;
+				_used[id] = true;
+				return id;
+			}
+
+			_boxes.push_back(box);
+			_used.push_back(true);
+			return _boxes.size() - 1;
+		}
+
+		// Frees the given id.
+		void erase(std::size_t id)
+		{
+			_used[id] = false;
+			_free.push_back(id);
+		}
+
+		// Removes every entry.
+		void clear() noexcept
+		{
+			_boxes.clear();
+			_used.clear();
+			_free.clear();
+		}
+
+		// Throws a std::out_of_range if id is not in use.
+		void check(std::size_t id) const
+		{
+			if (!contains(id))
+				throw std::out_of_range("ERROR: Invalid broad-phase id.");
+		}
+
+		// Returns true if id is in use.
+		bool contains(std::size_t id) const noexcept
+		{
+			return id < _used.size() && _used[id];
+		}
+
+		// Returns the number of entries in use.
+		std::size_t size() const noexcept
+		{
+			return _boxes.size() - _free.size();
+		}
+
+		// Returns the bounding box of the entry with the given id.
+		// Does NOT perform bounds-checking.
+		BoundingBox<T, D>& operator [] (std::size_t id)
+		{
+			return _boxes[id];
+		}
+
+		// Returns the bounding box of the entry with the given id.
+		// Does NOT perform bounds-checking.
+		const BoundingBox<T, D>& operator [] (std::size_t id) const
+		{
+			return _boxes[id];
+		}
+	};
+
+	// Entry of the sorted list of a SweepAndPrune.
+	template <typename T>
+	struct _SweepEntry
+	{
+		T min;
+		std::size_t id;
+	};
+
+	// Hash of the coordinates of a cell of a SpatialHash.
+	template <std::size_t D>
+	struct _CellHash
+	{
+		std::size_t operator () (const std::array<std::int64_t, D>& cell) const noexcept
+		{
+			// Multiplies each coordinate by a large odd constant so that
+			// neighboring cells do not collide in the low bits.
+			constexpr std::uint64_t factors[3] = { 0x9e3779b97f4a7c15, 0xc2b2ae3d27d4eb4f, 0x165667b19e3779f9 };
+			std::uint64_t h = 0;
+
+			for (std::size_t i = 0; i < D; ++i)
+				h ^= static_cast<std::uint64_t>(cell[i]) * factors[i % 3];
+
+			return static_cast<std::size_t>(h ^ (h >> 29));
+		}
+	};
+}
+
+export namespace jlib
+{
+	// Broad-phase collision detection by sweep and prune.
+	//
+	// The entries are kept sorted by the lower bound of their boxes along
+	// one axis. findPairs() sweeps along that axis and only compares
+	// entries whose extents along it overlap. Between calls, the order is
+	// repaired with an insertion sort, which is close to linear when the
+	// entries move a little from frame to frame. The axis is the one along
+	// which the centers of the boxes are the most spread out.
+	//
+	// The pairs found are candidates, to be confirmed with the
+	// intersection functions of the shapes.
+	template <arithmetic T, std::size_t D> class SweepAndPrune
+	{
+		public:
+
+		using box_type = BoundingBox<T, D>;
+		using size_type = std::size_t;
+
+		private:
+
+		_BroadPhaseEntries<T, D> _entries;
+		std::vector<_SweepEntry<T>> _sorted;
+		std::vector<box_type> _sweep;
+		size_type _axis;
+		size_type _inserted;
+		bool _reorder;
+
+		// Returns the axis along which the centers of the boxes vary the most.
+		size_type widestAxis() const
+		{
+			std::array<double, D> sum{};
+			std::array<double, D> sum_squared{};
+
+			for (const _SweepEntry<T>& entry : _sorted)
+			{
+				const box_type& box = _entries[entry.id];
+
+				for (size_type i = 0; i < D; ++i)
+				{
+					const double center = (static_cast<double>(box.min[i]) + static_cast<double>(box.max[i])) * 0.5;
+					sum[i] += center;
+					sum_squared[i] += center * center;
+				}
+			}
+
+			size_type axis = 0;
+			double best = -1.0;
+
+			for (size_type i = 0; i < D; ++i)
+			{
+				const double variance = sum_squared[i] - (sum[i] * sum[i]) / static_cast<double>(_sorted.size());
+
+				if (variance > best)
+				{
+					best = variance;
+					axis = i;
+				}
+			}
+
+			return axis;
+		}
+
+		// Brings the sorted list up to date with the boxes.
+		void sort()
+		{
+			if (_sorted.empty())
+				return;
+
+			const size_type axis = widestAxis();
+
+			if (axis != _axis)
+			{
+				_axis = axis;
+				_reorder = true;
+			}
+
+			for (_SweepEntry<T>& entry : _sorted)
+				entry.min = _entries[entry.id].min[_axis];
+
+			auto less = [](const _SweepEntry<T>& A, const _SweepEntry<T>& B)
+			{
+				return A.min < B.min;
+			};
+
+			// New entries start at the end of the list, so many of
+			// them at once are cheaper to sort from scratch.
+			const bool reorder = _reorder || _inserted * 8 > _sorted.size();
+			_reorder = false;
+			_inserted = 0;
+
+			if (reorder)
+			{
+				std::sort(_sorted.begin(), _sorted.end(), less);
+				return;
+			}
+
+			// Falls back to std::sort if the boxes moved too much
+			// for the insertion sort to be cheap.
+			const size_type budget = 8 * _sorted.size() + 64;
+			size_type moves = 0;
+
+			for (size_type i = 1; i < _sorted.size(); ++i)
+			{
+				const _SweepEntry<T> entry = _sorted[i];
+				size_type j = i;
+
+				while (j > 0 && entry.min < _sorted[j - 1].min)
+				{
+					_sorted[j] = _sorted[j - 1];
+					--j;
+					++moves;
+				}
+
+				_sorted[j] = entry;
+
+				if (moves > budget)
+				{
+					std::sort(_sorted.begin(), _sorted.end(), less);
+					return;
+				}
+			}
+		}
+
+		public:
+
+		// Default constructor.
+		SweepAndPrune() : _axis(0), _inserted(0), _reorder(false)
+		{
+
+		}
+
+		// Returns the number of entries.
+		size_type size() const noexcept
+		{
+			return _entries.size();
+		}
+
+		// Returns true if there are no entries.
+		bool empty() const noexcept
+		{
+			return _entries.size() == 0;
+		}
+
+		// Returns true if id refers to an entry.
+		bool contains(size_type id) const noexcept
+		{
+			return _entries.contains(id);
+		}
+
+		// Returns the bounding box of the entry with the given id.
+		// Throws a std::out_of_range if given an invalid id.
+		const box_type& at(size_type id) const
+		{
+			_entries.check(id);
+			return _entries[id];
+		}
+
+		// Adds an entry with the given bounding box and returns its id.
+		// Ids of erased entries are reused.
+		size_type insert(const box_type& box)
+		{
+			const size_type id = _entries.insert(box);
+			_sorted.push_back(_SweepEntry<T>{ box.min[_axis], id });
+			++_inserted;
+
+			return id;
+		}
+
+		// Adds an entry with the bounding box of the given shape and returns its id.
+		template <typename Shape>
+		size_type insert(const Shape& shape)
+		{
+			return insert(bounding_box(shape));
+		}
+
+		// Moves the entry with the given id to the given bounding box.
+		// Throws a std::out_of_range if given an invalid id.
+		void update(size_type id, const box_type& box)
+		{
+			_entries.check(id);
+			_entries[id] = box;
+		}
+
+		// Moves the entry with the given id to the bounding box of the given shape.
+		// Throws a std::out_of_range if given an invalid id.
+		template <typename Shape>
+		void update(size_type id, const Shape& shape)
+		{
+			update(id, bounding_box(shape));
+		}
+
+		// Removes the entry with the given id.
+		// Throws a std::out_of_range if given an invalid id.
+		void erase(size_type id)
+		{
+			_entries.check(id);
+			_entries.erase(id);
+			_sorted.erase(std::find_if(_sorted.begin(), _sorted.end(), [id](const _SweepEntry<T>& entry) { return entry.id == id; }));
+		}
+
+		// Removes every entry.
+		void clear() noexcept
+		{
+			_entries.clear();
+			_sorted.clear();
+			_inserted = 0;
+			_reorder = false;
+		}
+
+		// Calls function(A, B) once for every pair of entries whose bounding
+		// boxes overlap, with A < B. The order of the pairs is unspecified.
+		template <typename Function>
+		void findPairs(Function&& function)
+		{
+			sort();
+
+			// The sweep reads the boxes in sorted order,
+			// so they are copied into that order first.
+			_sweep.resize(_sorted.size());
+
+			for (size_type i = 0; i < _sorted.size(); ++i)
+				_sweep[i] = _entries[_sorted[i].id];
+
+			for (size_type i = 0; i < _sweep.size(); ++i)
+			{
+				const box_type& A = _sweep[i];
+				const T end = A.max[_axis];
+
+				for (size_type j = i + 1; j < _sweep.size() && _sweep[j].min[_axis] <= end; ++j)
+				{
+					if (overlaps(A, _sweep[j]))
+					{
+						const size_type a = _sorted[i].id;
+						const size_type b = _sorted[j].id;
+
+						if (a < b)
+							function(a, b);
+						else
+							function(b, a);
+					}
+				}
+			}
+		}
+
+		// Returns every pair of entries whose bounding boxes overlap, with
+		// the smaller id first. The order of the pairs is unspecified.
+		std::vector<std::pair<size_type, size_type>> findPairs()
+		{
+			std::vector<std::pair<size_type, size_type>> pairs;
+			findPairs([&](size_type A, size_type B) { pairs.emplace_back(A, B); });
+			return pairs;
+		}
+	};
+
+	// Broad-phase collision detection with a uniform grid.
+	//
+	// Space is split into cubes of the given cell size, and every entry is
+	// listed in each of the cells its bounding box touches. Only entries
+	// that share a cell are compared. Updates that keep an entry in the
+	// same cells only store the new bounding box.
+	//
+	// The cell size should be around the size of a typical entry. Entries
+	// much larger than a cell are listed in many cells, which makes them
+	// expensive to update.
+	//
+	// The pairs found are candidates, to be confirmed with the
+	// intersection functions of the shapes.
+	template <arithmetic T, std::size_t D> class SpatialHash
+	{
+		public:
+
+		using box_type = BoundingBox<T, D>;
+		using cell_type = std::array<std::int64_t, D>;
+		using size_type = std::size_t;
+
+		private:
+
+		// Range of cells [first, last] along each axis touched by an entry.
+		struct CellRange
+		{
+			cell_type first;
+			cell_type last;
+		};
+
+		using map_type = std::unordered_map<cell_type, std::vector<size_type>, _CellHash<D>>;
+
+		_BroadPhaseEntries<T, D> _entries;
+		std::vector<CellRange> _ranges;
+		map_type _cells;
+		double _cellSize;
+		double _inverseCellSize;
+
+		// Returns the coordinate of the cell that contains the coordinate n.
+		std::int64_t cellCoordinate(T n) const noexcept
+		{
+			return static_cast<std::int64_t>(std::floor(static_cast<double>(n) * _inverseCellSize));
+		}
+
+		// Returns the range of cells the given bounding box touches.
+		CellRange cellRange(const box_type& box) const noexcept
+		{
+			CellRange range;
+
+			for (size_type i = 0; i < D; ++i)
+			{
+				range.first[i] = cellCoordinate(box.min[i]);
+				range.last[i] = cellCoordinate(box.max[i]);
+			}
+
+			return range;
+		}
+
+		// Calls function(cell) for every cell in the given range.
+		template <typename Function>
+		static void forEachCell(const CellRange& range, Function&& function)
+		{
+			cell_type cell = range.first;
+
+			while (true)
+			{
+				function(cell);
+
+				size_type i = 0;
+
+				for (; i < D; ++i)
+				{
+					if (cell[i] < range.last[i])
+					{
+						++cell[i];
+						break;
+					}
+
+					cell[i] = range.first[i];
+				}
+
+				if (i == D)
+					return;
+			}
+		}
+
+		// Lists id in every cell of the given range.
+		void link(size_type id, const CellRange& range)
+		{
+			forEachCell(range, [&](const cell_type& cell) { _cells[cell].push_back(id); });
+		}
+
+		// Removes id from every cell of the given range.
+		void unlink(size_type id, const CellRange& range)
+		{
+			forEachCell(range, [&](const cell_type& cell)
+			{
+				auto iter = _cells.find(cell);
+				std::vector<size_type>& ids = iter->second;
+
+				*std::find(ids.begin(), ids.end(), id) = ids.back();
+				ids.pop_back();
+
+				if (ids.empty())
+					_cells.erase(iter);
+			});
+		}
+
+		public:
+
+		// Constructs an empty SpatialHash with the given cell size.
+		// Throws a std::invalid_argument if cellSize is not positive.
+		explicit SpatialHash(double cellSize)
+		{
+			if (!(cellSize > 0.0))
+				throw std::invalid_argument("ERROR: The cell size must be positive.");
+
+			_cellSize = cellSize;
+			_inverseCellSize = 1.0 / cellSize;
+		}
+
+		// Returns the size of the cells.
+		double cellSize() const noexcept
+		{
+			return _cellSize;
+		}
+
+		// Returns the number of entries.
+		size_type size() const noexcept
+		{
+			return _entries.size();
+		}
+
+		// Returns true if there are no entries.
+		bool empty() const noexcept
+		{
+			return _entries.size() == 0;
+		}
+
+		// Returns the number of cells that hold at least 1 entry.
+		size_type cellCount() const noexcept
+		{
+			return _cells.size();
+		}
+
+		// Returns true if id refers to an entry.
+		bool contains(size_type id) const noexcept
+		{
+			return _entries.contains(id);
+		}
+
+		// Returns the bounding box of the entry with the given id.
+		// Throws a std::out_of_range if given an invalid id.
+		const box_type& at(size_type id) const
+		{
+			_entries.check(id);
+			return _entries[id];
+		}
+
+		// Adds an entry with the given bounding box and returns its id.
+		// Ids of erased entries are reused.
+		size_type insert(const box_type& box)
+		{
+			const size_type id = _entries.insert(box);
+			const CellRange range = cellRange(box);
+
+			if (id == _ranges.size())
+				_ranges.push_back(range);
+			else
+				_ranges[id] = range;
+
+			link(id, range);
+			return id;
+		}
+
+		// Adds an entry with the bounding box of the given shape and returns its id.
+		template <typename Shape>
+		size_type insert(const Shape& shape)
+		{
+			return insert(bounding_box(shape));
+		}
+
+		// Moves the entry with the given id to the given bounding box.
+		// Throws a std::out_of_range if given an invalid id.
+		void update(size_type id, const box_type& box)
+		{
+			_entries.check(id);
+			_entries[id] = box;
+
+			const CellRange range = cellRange(box);
+
+			if (range.first != _ranges[id].first || range.last != _ranges[id].last)
+			{
+				unlink(id, _ranges[id]);
+				link(id, range);
+				_ranges[id] = range;
+			}
+		}
+
+		// Moves the entry with the given id to the bounding box of the given shape.
+		// Throws a std::out_of_range if given an invalid id.
+		template <typename Shape>
+		void update(size_type id, const Shape& shape)
+		{
+			update(id, bounding_box(shape));
+		}
+
+		// Removes the entry with the given id.
+		// Throws a std::out_of_range if given an invalid id.
+		void erase(size_type id)
+		{
+			_entries.check(id);
+			unlink(id, _ranges[id]);
+			_entries.erase(id);
+		}
+
+		// Removes every entry.
+		void clear() noexcept
+		{
+			_entries.clear();
+			_ranges.clear();
+			_cells.clear();
+		}
+
+		// Calls function(A, B) once for every pair of entries whose bounding
+		// boxes overlap, with A < B. The order of the pairs is unspecified.
+		template <typename Function>
+		void findPairs(Function&& function) const
+		{
+			for (const auto& [cell, ids] : _cells)
+			{
+				for (size_type i = 0; i < ids.size(); ++i)
+				{
+					const box_type& A = _entries[ids[i]];
+
+					for (size_type j = i + 1; j < ids.size(); ++j)
+					{
+						const box_type& B = _entries[ids[j]];
+
+						if (!overlaps(A, B))
+							continue;
+
+						// Entries that share several cells are only reported by
+						// the cell that holds the lower corner of their overlap.
+						bool first = true;
+
+						for (size_type k = 0; k < D && first; ++k)
+							first = cellCoordinate(std::max(A.min[k], B.min[k])) == cell[k];
+
+						if (first)
+						{
+							if (ids[i] < ids[j])
+								function(ids[i], ids[j]);
+							else
+								function(ids[j], ids[i]);
+						}
+					}
+				}
+			}
+		}
+
+		// Returns every pair of entries whose bounding boxes overlap, with
+		// the smaller id first. The order of the pairs is unspecified.
+		std::vector<std::pair<size_type, size_type>> findPairs() const
+		{
+			std::vector<std::pair<size_type, size_type>> pairs;
+			findPairs([&](size_type A, size_type B) { pairs.emplace_back(A, B); });
+			return pairs;
+		}
+	};
+}
\ No newline at end of file
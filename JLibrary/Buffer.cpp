@@ -1,11 +1,12 @@
 // JLibrary
 // Buffer.cpp
 // Created on 2022-04-11 by Justyn Durnford
-// Last modified on 2022-07-02 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
 // Source file for the Buffer class.
 
 #include "Buffer.hpp"
 #include "Hexadecimal.hpp"
+#include "Simd.hpp"
 #include "String.hpp"
 
 #include <cstddef>
@@ -18,6 +19,10 @@ using std::memset;
 
 #include <iostream>
 using std::cout;
+
+#include <memory_resource>
+using std::pmr::get_default_resource;
+using std::pmr::memory_resource;
 using std::ostream;
 
 #include <stdexcept>
@@ -35,41 +40,80 @@ namespace jlib
 
 	void Buffer::_allocate(size_t size)
 	{
-		_data = new byte[size];
+		if (size == 0)
+			_data = nullptr;
+		else
+			_data = static_cast<byte*>(_resource->allocate(size, alignment));
+
 		_size = size;
 	}
 
+	void Buffer::_deallocate() noexcept
+	{
+		if (_data != nullptr)
+			_resource->deallocate(_data, _size, alignment);
+
+		_data = nullptr;
+		_size = 0;
+	}
+
 	Buffer::Buffer()
 	{
 		_data = nullptr;
 		_size = 0;
+		_resource = get_default_resource();
+	}
+
+	Buffer::Buffer(memory_resource* resource)
+	{
+		_data = nullptr;
+		_size = 0;
+		_resource = resource;
 	}
 
 	Buffer::Buffer(size_t size)
 	{
+		_resource = get_default_resource();
+		_allocate(size);
+	}
+
+	Buffer::Buffer(size_t size, uninitialized_t, memory_resource* resource)
+	{
+		_resource = resource;
 		_allocate(size);
 	}
 
-	Buffer::Buffer(size_t size, unsigned char value)
+	Buffer::Buffer(size_t size, unsigned char value, memory_resource* resource)
 	{
+		_resource = resource;
 		_allocate(size);
 		memset(_data, value, _size);
 	}
 
-	Buffer::Buffer(const string& str)
+	Buffer::Buffer(const string& str, memory_resource* resource)
 	{
+		_resource = resource;
 		_allocate(str.size());
 		memcpy(_data, str.c_str(), _size);
 	}
 
-	Buffer::Buffer(const void* src, size_t size)
+	Buffer::Buffer(const void* src, size_t size, memory_resource* resource)
 	{
+		_resource = resource;
 		_allocate(size);
 		memcpy(_data, src, _size);
 	}
 
 	Buffer::Buffer(const Buffer& other)
 	{
+		_resource = get_default_resource();
+		_allocate(other._size);
+		memcpy(_data, other._data, _size);
+	}
+
+	Buffer::Buffer(const Buffer& other, memory_resource* resource)
+	{
+		_resource = resource;
 		_allocate(other._size);
 		memcpy(_data, other._data, _size);
 	}
@@ -78,29 +122,45 @@ namespace jlib
 	{
 		_data = other._data;
 		_size = other._size;
+		_resource = other._resource;
 		other._data = nullptr;
+		other._size = 0;
 	}
 
 	Buffer& Buffer::operator = (const Buffer& other)
 	{
-		_size = other._size;
-		memcpy(_data, other._data, _size);
+		if (this != &other)
+		{
+			if (_size != other._size)
+			{
+				_deallocate();
+				_allocate(other._size);
+			}
+
+			memcpy(_data, other._data, _size);
+		}
+
 		return *this;
 	}
 
 	Buffer& Buffer::operator = (Buffer&& other) noexcept
 	{
-		delete[] _data;
-		_data = other._data;
-		_size = other._size;
-		other._data = nullptr;
+		if (this != &other)
+		{
+			_deallocate();
+			_data = other._data;
+			_size = other._size;
+			_resource = other._resource;
+			other._data = nullptr;
+			other._size = 0;
+		}
 
 		return *this;
 	}
 
 	Buffer::~Buffer() noexcept
 	{
-		delete[] _data;
+		_deallocate();
 	}
 
 	byte* Buffer::pointer() noexcept
@@ -118,6 +178,11 @@ namespace jlib
 		return _size;
 	}
 
+	memory_resource* Buffer::resource() const noexcept
+	{
+		return _resource;
+	}
+
 	byte* Buffer::begin() noexcept
 	{
 		return _data;
@@ -234,6 +299,19 @@ namespace jlib
 		cout << buffer.toString() << '\n';
 	}
 
+	bool operator == (const Buffer& A, const Buffer& B) noexcept
+	{
+		if (A.size() != B.size())
+			return false;
+
+		return simd::equal_n(A.pointer(), B.pointer(), A.size());
+	}
+
+	bool operator != (const Buffer& A, const Buffer& B) noexcept
+	{
+		return !(A == B);
+	}
+
 	ostream& operator << (ostream& os, const Buffer& A)
 	{
 		os << A.toString();
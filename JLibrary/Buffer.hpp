@@ -1,58 +1,86 @@
 // JLibrary
 // Buffer.hpp
 // Created on 2022-04-11 by Justyn Durnford
-// Last modified on 2022-09-15 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
 // Header file for the Buffer class.
 
 #pragma once
 
+#include "Uninitialized.hpp"
+
 #include <cstddef>
 #include <iostream>
+#include <memory_resource>
 #include <stdexcept>
 #include <string>
 
 namespace jlib
 {
 	// Class that represents a memory buffer.
+	// The memory is obtained from a std::pmr::memory_resource, which
+	// defaults to std::pmr::get_default_resource().
 	class Buffer
 	{
 		std::byte* _data;
 		std::size_t _size;
+		std::pmr::memory_resource* _resource;
 
 		// Returns the minimum byte count between _size and byte_count.
 		constexpr std::size_t _minCount(std::size_t byte_count) const noexcept;
 
-		// Allocates memory for the buffer.
+		// Allocates uninitialized memory for the buffer.
 		void _allocate(std::size_t size);
 
+		// Releases the memory of the buffer.
+		void _deallocate() noexcept;
+
 		public:
 
+		// Alignment in bytes of the memory allocated by a Buffer.
+		static constexpr std::size_t alignment = 64;
+
 		// Default constructor.
 		// Sets the buffer to nullptr.
 		Buffer();
 
+		// Memory resource constructor.
+		// Sets the buffer to nullptr.
+		// Memory is later obtained from the given resource.
+		explicit Buffer(std::pmr::memory_resource* resource);
+
 		// Size constructor.
 		// Sets the size of the buffer to size.
+		// The contents are left uninitialized; use Buffer(size, 0)
+		// for a zero-filled buffer.
 		Buffer(std::size_t size);
 
+		// Uninitialized size constructor.
+		// Sets the size of the buffer to size without
+		// initializing its contents.
+		Buffer(std::size_t size, uninitialized_t, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
 		// Size and byte constructor.
 		// Sets the size of the buffer to size.
 		// Sets each byte of the buffer to value.
-		Buffer(std::size_t size, unsigned char value);
+		Buffer(std::size_t size, unsigned char value, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
 		// Constructs the Buffer with the contents of the given string.
 		// This DOES NOT move the contents from the given range, it simply
 		// copies its contents into the new Buffer.
-		Buffer(const std::string& str);
+		Buffer(const std::string& str, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
 		// Constructs the Buffer with the contents in the range[src, src + size).
 		// This DOES NOT move the contents from the given range, it simply
 		// copies its contents into the new Buffer.
-		Buffer(const void* src, std::size_t size);
+		Buffer(const void* src, std::size_t size, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
 		// Copy constructor.
+		// The copy uses std::pmr::get_default_resource().
 		Buffer(const Buffer& other);
 
+		// Copy constructor with a different memory resource.
+		Buffer(const Buffer& other, std::pmr::memory_resource* resource);
+
 		// Move constructor.
 		Buffer(Buffer&& other) noexcept;
 
@@ -60,6 +88,7 @@ namespace jlib
 		Buffer& operator = (const Buffer& other);
 
 		// Move assignment operator.
+		// The buffer takes the memory resource of other along with its memory.
 		Buffer& operator = (Buffer&& other) noexcept;
 
 		// Destructor.
@@ -74,6 +103,9 @@ namespace jlib
 		// Returns the size of the buffer.
 		std::size_t size() const noexcept;
 
+		// Returns the memory resource used by the buffer.
+		std::pmr::memory_resource* resource() const noexcept;
+
 		// Returns a pointer to the start of the buffer.
 		std::byte* begin() noexcept;
 
@@ -177,6 +209,13 @@ namespace jlib
 	// Prints the buffer to std::cout in hex format with a new line.
 	void println(const Buffer& buffer);
 
+	// Overload of binary operator ==
+	// Compares the size and the contents of the buffers.
+	bool operator == (const Buffer& A, const Buffer& B) noexcept;
+
+	// Overload of binary operator !=
+	bool operator != (const Buffer& A, const Buffer& B) noexcept;
+
 	// Overload of std::ostream operator <<
 	std::ostream& operator << (std::ostream& os, const Buffer& A);
 }
\ No newline at end of file
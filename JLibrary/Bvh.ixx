@@ -0,0 +1,1027 @@
+// JLibrary
+// Bvh.ixx
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Module file for the Bvh template class.
+
+module;
+
+#include "IntegerTypedefs.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <execution>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+export module Bvh;
+
+import Box;
+import Sphere;
+import Vector3;
+
+namespace jlib
+{
+	template <typename T>
+	using _Vec3 = std::array<T, 3>;
+
+	template <typename T>
+	constexpr _Vec3<T> _sub(const _Vec3<T>& A, const _Vec3<T>& B) noexcept
+	{
+		return _Vec3<T>{ A[0] - B[0], A[1] - B[1], A[2] - B[2] };
+	}
+
+	template <typename T>
+	constexpr _Vec3<T> _cross(const _Vec3<T>& A, const _Vec3<T>& B) noexcept
+	{
+		return _Vec3<T>{ A[1] * B[2] - A[2] * B[1], A[2] * B[0] - A[0] * B[2], A[0] * B[1] - A[1] * B[0] };
+	}
+
+	template <typename T>
+	constexpr T _dot(const _Vec3<T>& A, const _Vec3<T>& B) noexcept
+	{
+		return A[0] * B[0] + A[1] * B[1] + A[2] * B[2];
+	}
+
+	// Axis-aligned bounds of a node or primitive of a Bvh.
+	template <typename T>
+	struct _BvhBounds
+	{
+		_Vec3<T> min = { std::numeric_limits<T>::max(), std::numeric_limits<T>::max(), std::numeric_limits<T>::max() };
+		_Vec3<T> max = { std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest() };
+
+		// Grows the bounds to contain the given point.
+		void grow(const _Vec3<T>& point) noexcept
+		{
+			for (std::size_t i = 0; i < 3; ++i)
+			{
+				min[i] = std::min(min[i], point[i]);
+				max[i] = std::max(max[i], point[i]);
+			}
+		}
+
+		// Grows the bounds to contain the given bounds.
+		void grow(const _BvhBounds& other) noexcept
+		{
+			for (std::size_t i = 0; i < 3; ++i)
+			{
+				min[i] = std::min(min[i], other.min[i]);
+				max[i] = std::max(max[i], other.max[i]);
+			}
+		}
+
+		// Returns half of the surface area, or 0 if the bounds are empty.
+		T halfArea() const noexcept
+		{
+			const T dx = max[0] - min[0];
+			const T dy = max[1] - min[1];
+			const T dz = max[2] - min[2];
+
+			if (dx < T(0) || dy < T(0) || dz < T(0))
+				return T(0);
+
+			return dx * dy + dy * dz + dz * dx;
+		}
+
+		// Returns true if the bounds overlap or touch the given bounds.
+		bool overlaps(const _BvhBounds& other) const noexcept
+		{
+			return min[0] <= other.max[0] && other.min[0] <= max[0] &&
+				   min[1] <= other.max[1] && other.min[1] <= max[1] &&
+				   min[2] <= other.max[2] && other.min[2] <= max[2];
+		}
+
+		// Returns the distance squared from the bounds to the given point.
+		T distanceSquared(const _Vec3<T>& point) const noexcept
+		{
+			T d = T(0);
+
+			for (std::size_t i = 0; i < 3; ++i)
+			{
+				const T v = std::max(std::max(min[i] - point[i], point[i] - max[i]), T(0));
+				d += v * v;
+			}
+
+			return d;
+		}
+
+		// Returns the distance along the ray at which it enters the bounds,
+		// or infinity if the ray misses the bounds within [0, limit].
+		// inverse holds the reciprocals of the components of the direction.
+		T enter(const _Vec3<T>& origin, const _Vec3<T>& inverse, T limit) const noexcept
+		{
+			T near = T(0);
+			T far = limit;
+
+			for (std::size_t i = 0; i < 3; ++i)
+			{
+				T t0 = (min[i] - origin[i]) * inverse[i];
+				T t1 = (max[i] - origin[i]) * inverse[i];
+
+				if (t0 > t1)
+					std::swap(t0, t1);
+
+				// Written so that a NaN, from a ray in the plane of a face,
+				// leaves the interval unchanged.
+				near = t0 > near ? t0 : near;
+				far = t1 < far ? t1 : far;
+			}
+
+			return near <= far ? near : std::numeric_limits<T>::infinity();
+		}
+	};
+
+	// Node of a Bvh. Interior nodes have a count of 0, and their children are
+	// at first and first + 1. Leaves hold the primitives [first, first + count)
+	// in the order of the tree.
+	template <typename T>
+	struct _BvhNode
+	{
+		_BvhBounds<T> bounds;
+		u32 first;
+		u32 count;
+	};
+
+	// Triangle of a Bvh, stored in the order of the tree.
+	template <typename T>
+	struct _BvhTriangle
+	{
+		_Vec3<T> A;
+		_Vec3<T> B;
+		_Vec3<T> C;
+	};
+
+	// Subtree of a Bvh that is left to a worker thread.
+	struct _BvhTask
+	{
+		std::size_t node;
+		std::size_t begin;
+		std::size_t end;
+		std::size_t depth;
+	};
+
+	// Bvhs with fewer primitives than this are built on a single thread.
+	inline constexpr std::size_t _parallel_bvh_build = std::size_t(1) << 14;
+
+	// Depth below which nodes are split at the median instead of by the
+	// surface area heuristic, which bounds the depth of the tree.
+	inline constexpr std::size_t _bvh_sah_depth = 40;
+
+	// Size of the traversal stacks. The depth of a tree is at most
+	// _bvh_sah_depth plus 32 median splits.
+	inline constexpr std::size_t _bvh_stack_size = 80;
+
+	// Builds the nodes of a Bvh over the primitives listed in order,
+	// given the bounds and centroids of every primitive.
+	template <typename T>
+	struct _BvhBuilder
+	{
+		static constexpr std::size_t bins = 16;
+
+		const std::vector<_BvhBounds<T>>& bounds;
+		const std::vector<_Vec3<T>>& centroids;
+		std::vector<u32>& order;
+		std::size_t leafSize;
+
+		// Builds the subtree of the given node over order[begin, end).
+		// If tasks is not nullptr, subtrees of at most taskSize primitives
+		// are added to tasks instead of being built.
+		void build(std::vector<_BvhNode<T>>& nodes, std::size_t node, std::size_t begin, std::size_t end,
+				   std::size_t depth, std::size_t taskSize, std::vector<_BvhTask>* tasks) const
+		{
+			_BvhBounds<T> box;
+			_BvhBounds<T> centroid_box;
+
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				box.grow(bounds[order[i]]);
+				centroid_box.grow(centroids[order[i]]);
+			}
+
+			nodes[node].bounds = box;
+			nodes[node].first = static_cast<u32>(begin);
+			nodes[node].count = static_cast<u32>(end - begin);
+
+			const std::size_t count = end - begin;
+
+			if (count <= 1)
+				return;
+
+			if (tasks != nullptr && count <= taskSize)
+			{
+				tasks->push_back(_BvhTask{ node, begin, end, depth });
+				return;
+			}
+
+			std::size_t best_axis = 3;
+			std::size_t best_bin = 0;
+			T best_cost = std::numeric_limits<T>::max();
+
+			if (depth < _bvh_sah_depth)
+			{
+				for (std::size_t axis = 0; axis < 3; ++axis)
+				{
+					const T extent = centroid_box.max[axis] - centroid_box.min[axis];
+
+					if (!(extent > T(0)))
+						continue;
+
+					const T scale = static_cast<T>(bins) / extent;
+					std::array<_BvhBounds<T>, bins> bin_bounds;
+					std::array<std::size_t, bins> bin_counts{};
+
+					for (std::size_t i = begin; i < end; ++i)
+					{
+						const u32 p = order[i];
+						const std::size_t b = std::min(bins - 1, static_cast<std::size_t>((centroids[p][axis] - centroid_box.min[axis]) * scale));
+						bin_bounds[b].grow(bounds[p]);
+						++bin_counts[b];
+					}
+
+					// left_area[i] and left_count[i] cover the bins [0, i].
+					std::array<T, bins> left_area;
+					std::array<std::size_t, bins> left_count;
+					_BvhBounds<T> left;
+					std::size_t left_n = 0;
+
+					for (std::size_t b = 0; b < bins - 1; ++b)
+					{
+						left.grow(bin_bounds[b]);
+						left_n += bin_counts[b];
+						left_area[b] = left.halfArea();
+						left_count[b] = left_n;
+					}
+
+					_BvhBounds<T> right;
+					std::size_t right_n = 0;
+
+					for (std::size_t b = bins - 1; b > 0; --b)
+					{
+						right.grow(bin_bounds[b]);
+						right_n += bin_counts[b];
+
+						if (left_count[b - 1] == 0 || right_n == 0)
+							continue;
+
+						const T cost = static_cast<T>(left_count[b - 1]) * left_area[b - 1] + static_cast<T>(right_n) * right.halfArea();
+
+						if (cost < best_cost)
+						{
+							best_cost = cost;
+							best_axis = axis;
+							best_bin = b - 1;
+						}
+					}
+				}
+
+				// Keeps the primitives in a leaf if splitting them is not
+				// expected to be cheaper, counting 1 for each box tested.
+				const T leaf_cost = static_cast<T>(count) * box.halfArea();
+
+				if (count <= leafSize && (best_axis == 3 || box.halfArea() + best_cost >= leaf_cost))
+					return;
+			}
+			else if (count <= leafSize)
+				return;
+
+			std::size_t mid = begin;
+
+			if (best_axis != 3)
+			{
+				const T scale = static_cast<T>(bins) / (centroid_box.max[best_axis] - centroid_box.min[best_axis]);
+				const T lo = centroid_box.min[best_axis];
+
+				mid = static_cast<std::size_t>(std::partition(order.begin() + begin, order.begin() + end, [&](u32 p)
+				{
+					return std::min(bins - 1, static_cast<std::size_t>((centroids[p][best_axis] - lo) * scale)) <= best_bin;
+				}) - order.begin());
+			}
+
+			// Splits at the median of the widest axis if the heuristic
+			// gave up or could not separate the primitives.
+			if (mid == begin || mid == end)
+			{
+				std::size_t axis = 0;
+
+				for (std::size_t i = 1; i < 3; ++i)
+				{
+					if (centroid_box.max[i] - centroid_box.min[i] > centroid_box.max[axis] - centroid_box.min[axis])
+						axis = i;
+				}
+
+				mid = begin + count / 2;
+				std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+								 [&](u32 A, u32 B) { return centroids[A][axis] < centroids[B][axis]; });
+			}
+
+			const std::size_t left_child = nodes.size();
+			nodes.resize(nodes.size() + 2);
+			nodes[node].first = static_cast<u32>(left_child);
+			nodes[node].count = 0;
+
+			build(nodes, left_child, begin, mid, depth + 1, taskSize, tasks);
+			build(nodes, left_child + 1, mid, end, depth + 1, taskSize, tasks);
+		}
+	};
+
+	// Returns the closest point on the triangle to P.
+	template <typename T>
+	_Vec3<T> _closest_point(const _BvhTriangle<T>& tri, const _Vec3<T>& P) noexcept
+	{
+		const _Vec3<T> ab = _sub(tri.B, tri.A);
+		const _Vec3<T> ac = _sub(tri.C, tri.A);
+		const _Vec3<T> ap = _sub(P, tri.A);
+
+		auto point = [&](T v, T w)
+		{
+			return _Vec3<T>{ tri.A[0] + ab[0] * v + ac[0] * w, tri.A[1] + ab[1] * v + ac[1] * w, tri.A[2] + ab[2] * v + ac[2] * w };
+		};
+
+		const T d1 = _dot(ab, ap);
+		const T d2 = _dot(ac, ap);
+
+		if (d1 <= T(0) && d2 <= T(0))
+			return tri.A;
+
+		const _Vec3<T> bp = _sub(P, tri.B);
+		const T d3 = _dot(ab, bp);
+		const T d4 = _dot(ac, bp);
+
+		if (d3 >= T(0) && d4 <= d3)
+			return tri.B;
+
+		const T vc = d1 * d4 - d3 * d2;
+
+		if (vc <= T(0) && d1 >= T(0) && d3 <= T(0))
+			return point(d1 / (d1 - d3), T(0));
+
+		const _Vec3<T> cp = _sub(P, tri.C);
+		const T d5 = _dot(ab, cp);
+		const T d6 = _dot(ac, cp);
+
+		if (d6 >= T(0) && d5 <= d6)
+			return tri.C;
+
+		const T vb = d5 * d2 - d1 * d6;
+
+		if (vb <= T(0) && d2 >= T(0) && d6 <= T(0))
+			return point(T(0), d2 / (d2 - d6));
+
+		const T va = d3 * d6 - d5 * d4;
+
+		if (va <= T(0) && (d4 - d3) >= T(0) && (d5 - d6) >= T(0))
+		{
+			const T w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+			return point(T(1) - w, w);
+		}
+
+		const T denom = T(1) / (va + vb + vc);
+		return point(vb * denom, vc * denom);
+	}
+
+	// Returns true if the triangle overlaps the bounds,
+	// by the separating axis test of Akenine-Moller.
+	template <typename T>
+	bool _overlaps(const _BvhTriangle<T>& tri, const _BvhBounds<T>& box) noexcept
+	{
+		_Vec3<T> center;
+		_Vec3<T> half;
+
+		for (std::size_t i = 0; i < 3; ++i)
+		{
+			center[i] = (box.min[i] + box.max[i]) * T(0.5);
+			half[i] = (box.max[i] - box.min[i]) * T(0.5);
+		}
+
+		const std::array<_Vec3<T>, 3> v = { _sub(tri.A, center), _sub(tri.B, center), _sub(tri.C, center) };
+
+		// Returns true if the axis separates the triangle from the box.
+		auto separates = [&](const _Vec3<T>& axis)
+		{
+			const T p0 = _dot(v[0], axis);
+			const T p1 = _dot(v[1], axis);
+			const T p2 = _dot(v[2], axis);
+			const T r = half[0] * std::abs(axis[0]) + half[1] * std::abs(axis[1]) + half[2] * std::abs(axis[2]);
+
+			return std::min(std::min(p0, p1), p2) > r || std::max(std::max(p0, p1), p2) < -r;
+		};
+
+		const std::array<_Vec3<T>, 3> edges = { _sub(v[1], v[0]), _sub(v[2], v[1]), _sub(v[0], v[2]) };
+
+		for (std::size_t i = 0; i < 3; ++i)
+		{
+			for (std::size_t j = 0; j < 3; ++j)
+			{
+				_Vec3<T> unit{};
+				unit[j] = T(1);
+
+				if (separates(_cross(edges[i], unit)))
+					return false;
+			}
+		}
+
+		for (std::size_t j = 0; j < 3; ++j)
+		{
+			_Vec3<T> unit{};
+			unit[j] = T(1);
+
+			if (separates(unit))
+				return false;
+		}
+
+		return !separates(_cross(edges[0], edges[1]));
+	}
+}
+
+export namespace jlib
+{
+	// Utility template class for ray casts and overlap queries against
+	// large sets of triangles or boxes in 3-dimensional space.
+	//
+	// The Bvh is a bounding volume hierarchy built with the binned surface
+	// area heuristic. Large builds split the top of the tree on the calling
+	// thread and build the subtrees below it in parallel. refit() updates
+	// the bounds for moved primitives without changing the tree, which
+	// keeps queries correct but slowly degrades them as the primitives
+	// drift from where they were at build time.
+	//
+	// Triangles are given as an indexed mesh, with 3 indices per triangle.
+	// Queries report primitives by their position in the input.
+	// The queries are const and may be called from several threads at once.
+	template <std::floating_point T> class Bvh
+	{
+		public:
+
+		using size_type = std::size_t;
+
+		// Result of a ray cast.
+		struct Hit
+		{
+			// The index of the primitive hit, or primitiveCount() if there was no hit.
+			size_type primitive;
+
+			// The point hit is origin + distance * direction.
+			T distance;
+
+			// Barycentric coordinates of the point hit on a triangle,
+			// which is A + u * (B - A) + v * (C - A). 0 for boxes.
+			T u;
+			T v;
+		};
+
+		private:
+
+		enum class Kind
+		{
+			None,
+			Triangles,
+			Boxes
+		};
+
+		std::vector<_BvhNode<T>> _nodes;
+		std::vector<u32> _order;
+		std::vector<u32> _indices;
+		std::vector<_BvhTriangle<T>> _triangles;
+		std::vector<_BvhBounds<T>> _boxes;
+		Kind _kind;
+		size_type _leafSize;
+
+		static _Vec3<T> toVec(const Vector3<T>& vec) noexcept
+		{
+			return _Vec3<T>{ vec.x, vec.y, vec.z };
+		}
+
+		static _BvhBounds<T> toBounds(const Box<T>& box) noexcept
+		{
+			_BvhBounds<T> bounds;
+			bounds.grow(toVec(box.vertex));
+			bounds.grow(_Vec3<T>{ box.vertex.x + box.length, box.vertex.y + box.width, box.vertex.z + box.height });
+			return bounds;
+		}
+
+		// Returns the triangle with the given index of the mesh.
+		_BvhTriangle<T> triangle(std::span<const Vector3<T>> vertices, size_type n) const noexcept
+		{
+			return _BvhTriangle<T>{ toVec(vertices[_indices[3 * n]]), toVec(vertices[_indices[3 * n + 1]]),
+									toVec(vertices[_indices[3 * n + 2]]) };
+		}
+
+		// Returns the bounds of the primitive at the given position in the tree.
+		_BvhBounds<T> primitiveBounds(size_type i) const noexcept
+		{
+			if (_kind == Kind::Boxes)
+				return _boxes[i];
+
+			_BvhBounds<T> bounds;
+			bounds.grow(_triangles[i].A);
+			bounds.grow(_triangles[i].B);
+			bounds.grow(_triangles[i].C);
+			return bounds;
+		}
+
+		// Builds the nodes from the bounds of every primitive and
+		// then stores the primitives in the order of the tree.
+		void buildNodes(const std::vector<_BvhBounds<T>>& bounds)
+		{
+			const size_type n = bounds.size();
+
+			std::vector<_Vec3<T>> centroids(n);
+
+			for (size_type i = 0; i < n; ++i)
+			{
+				for (size_type j = 0; j < 3; ++j)
+					centroids[i][j] = (bounds[i].min[j] + bounds[i].max[j]) * T(0.5);
+			}
+
+			_order.resize(n);
+			std::iota(_order.begin(), _order.end(), u32(0));
+			_nodes.clear();
+
+			if (n == 0)
+				return;
+
+			_nodes.reserve(2 * n / std::min<size_type>(_leafSize, 2));
+			_nodes.resize(1);
+
+			const _BvhBuilder<T> builder{ bounds, centroids, _order, _leafSize };
+
+			if (n < _parallel_bvh_build)
+			{
+				builder.build(_nodes, 0, 0, n, 0, 0, nullptr);
+				return;
+			}
+
+			// Splits the top of the tree here, then builds the
+			// subtrees below it on separate threads.
+			std::vector<_BvhTask> tasks;
+			builder.build(_nodes, 0, 0, n, 0, std::max<size_type>(n / 64, 1024), &tasks);
+
+			std::vector<std::vector<_BvhNode<T>>> subtrees(tasks.size());
+			std::vector<size_type> rows(tasks.size());
+			std::iota(rows.begin(), rows.end(), size_type(0));
+
+			std::for_each(std::execution::par, rows.begin(), rows.end(), [&](size_type t)
+			{
+				const _BvhTask& task = tasks[t];
+				subtrees[t].resize(1);
+				builder.build(subtrees[t], 0, task.begin, task.end, task.depth, 0, nullptr);
+			});
+
+			// The root of each subtree replaces its task node, and the rest
+			// of its nodes are appended. Children keep their relative order.
+			for (size_type t = 0; t < tasks.size(); ++t)
+			{
+				const size_type base = _nodes.size() - 1;
+
+				for (size_type i = 0; i < subtrees[t].size(); ++i)
+				{
+					_BvhNode<T> node = subtrees[t][i];
+
+					if (node.count == 0)
+						node.first = static_cast<u32>(base + node.first);
+
+					if (i == 0)
+						_nodes[tasks[t].node] = node;
+					else
+						_nodes.push_back(node);
+				}
+			}
+		}
+
+		// Recomputes the bounds of every node from the primitives.
+		// Children are always stored after their parents.
+		void refitNodes()
+		{
+			for (size_type i = _nodes.size(); i-- > 0;)
+			{
+				_BvhNode<T>& node = _nodes[i];
+				node.bounds = _BvhBounds<T>();
+
+				if (node.count == 0)
+				{
+					node.bounds.grow(_nodes[node.first].bounds);
+					node.bounds.grow(_nodes[node.first + 1].bounds);
+				}
+				else
+				{
+					for (size_type p = node.first; p < node.first + node.count; ++p)
+						node.bounds.grow(primitiveBounds(p));
+				}
+			}
+		}
+
+		// Calls visit(position) for every primitive in a leaf whose bounds
+		// overlap the region. enter(bounds) returns true if the bounds
+		// overlap the region. Stops early if visit returns true.
+		template <typename Enter, typename Visit>
+		void query(Enter&& enter, Visit&& visit) const
+		{
+			if (_nodes.empty() || !enter(_nodes[0].bounds))
+				return;
+
+			u32 stack[_bvh_stack_size];
+			size_type top = 0;
+			stack[top++] = 0;
+
+			while (top > 0)
+			{
+				const _BvhNode<T>& node = _nodes[stack[--top]];
+
+				if (node.count != 0)
+				{
+					for (size_type p = node.first; p < node.first + node.count; ++p)
+					{
+						if (visit(p))
+							return;
+					}
+
+					continue;
+				}
+
+				if (enter(_nodes[node.first].bounds))
+					stack[top++] = node.first;
+				if (enter(_nodes[node.first + 1].bounds))
+					stack[top++] = node.first + 1;
+			}
+		}
+
+		// Returns the distance along the ray to the primitive at the given
+		// position in the tree, or infinity if the ray misses it within [0, limit].
+		T intersect(size_type p, const _Vec3<T>& origin, const _Vec3<T>& direction,
+					const _Vec3<T>& inverse, T limit, T& u, T& v) const noexcept
+		{
+			constexpr T miss = std::numeric_limits<T>::infinity();
+
+			if (_kind == Kind::Boxes)
+			{
+				u = T(0);
+				v = T(0);
+				return _boxes[p].enter(origin, inverse, limit);
+			}
+
+			// Moller-Trumbore intersection, hitting both sides of the triangle.
+			const _BvhTriangle<T>& tri = _triangles[p];
+			const _Vec3<T> e1 = _sub(tri.B, tri.A);
+			const _Vec3<T> e2 = _sub(tri.C, tri.A);
+			const _Vec3<T> pv = _cross(direction, e2);
+			const T det = _dot(e1, pv);
+
+			if (det == T(0))
+				return miss;
+
+			const T inv_det = T(1) / det;
+			const _Vec3<T> s = _sub(origin, tri.A);
+			u = _dot(s, pv) * inv_det;
+
+			if (u < T(0) || u > T(1))
+				return miss;
+
+			const _Vec3<T> q = _cross(s, e1);
+			v = _dot(direction, q) * inv_det;
+
+			if (v < T(0) || u + v > T(1))
+				return miss;
+
+			const T t = _dot(e2, q) * inv_det;
+			return (t >= T(0) && t <= limit) ? t : miss;
+		}
+
+		// Returns the closest primitive hit by the ray, or
+		// the first primitive found to be hit if Any is true.
+		template <bool Any>
+		Hit trace(const Vector3<T>& origin, const Vector3<T>& direction, T maxDistance) const
+		{
+			constexpr T miss = std::numeric_limits<T>::infinity();
+			Hit hit{ primitiveCount(), maxDistance, T(0), T(0) };
+
+			if (_nodes.empty())
+				return hit;
+
+			const _Vec3<T> o = toVec(origin);
+			const _Vec3<T> d = toVec(direction);
+			const _Vec3<T> inv = { T(1) / d[0], T(1) / d[1], T(1) / d[2] };
+
+			if (_nodes[0].bounds.enter(o, inv, maxDistance) == miss)
+				return hit;
+
+			// Visits the closer child first, and skips nodes
+			// that are entered beyond the closest hit so far.
+			u32 stack[_bvh_stack_size];
+			T entry[_bvh_stack_size];
+			size_type top = 0;
+			stack[top] = 0;
+			entry[top++] = T(0);
+
+			while (top > 0)
+			{
+				--top;
+
+				if (entry[top] > hit.distance)
+					continue;
+
+				const _BvhNode<T>& node = _nodes[stack[top]];
+
+				if (node.count != 0)
+				{
+					for (size_type p = node.first; p < node.first + node.count; ++p)
+					{
+						T u;
+						T v;
+						const T t = intersect(p, o, d, inv, hit.distance, u, v);
+
+						if (t != miss)
+						{
+							hit = Hit{ _order[p], t, u, v };
+
+							if constexpr (Any)
+								return hit;
+						}
+					}
+
+					continue;
+				}
+
+				u32 near_child = node.first;
+				u32 far_child = node.first + 1;
+				T near_t = _nodes[near_child].bounds.enter(o, inv, hit.distance);
+				T far_t = _nodes[far_child].bounds.enter(o, inv, hit.distance);
+
+				if (far_t < near_t)
+				{
+					std::swap(near_child, far_child);
+					std::swap(near_t, far_t);
+				}
+
+				if (far_t != miss)
+				{
+					stack[top] = far_child;
+					entry[top++] = far_t;
+				}
+
+				if (near_t != miss)
+				{
+					stack[top] = near_child;
+					entry[top++] = near_t;
+				}
+			}
+
+			if (hit.primitive == primitiveCount())
+				hit.distance = maxDistance;
+
+			return hit;
+		}
+
+
+		public:
+
+		// Default constructor.
+		// Creates an empty Bvh.
+		Bvh() : _kind(Kind::None), _leafSize(4)
+		{
+
+		}
+
+		// Builds the Bvh over the triangles of an indexed mesh.
+		// Throws a std::invalid_argument if the size of indices is not
+		// a multiple of 3 or leafSize is 0.
+		// Throws a std::out_of_range if an index is not less than vertices.size().
+		Bvh(std::span<const Vector3<T>> vertices, std::span<const u32> indices, size_type leafSize = 4)
+			: _kind(Kind::None), _leafSize(4)
+		{
+			build(vertices, indices, leafSize);
+		}
+
+		// Builds the Bvh over the given boxes.
+		// Throws a std::invalid_argument if leafSize is 0.
+		Bvh(std::span<const Box<T>> boxes, size_type leafSize = 4) : _kind(Kind::None), _leafSize(4)
+		{
+			build(boxes, leafSize);
+		}
+
+		// Default copy constructor.
+		Bvh(const Bvh& other) = default;
+
+		// Default move constructor.
+		Bvh(Bvh&& other) = default;
+
+		// Default copy assignment operator.
+		Bvh& operator = (const Bvh& other) = default;
+
+		// Default move assignment operator.
+		Bvh& operator = (Bvh&& other) = default;
+
+		// Rebuilds the Bvh over the triangles of an indexed mesh.
+		// Leaves hold at most leafSize triangles, unless they can't be split.
+		// Throws a std::invalid_argument if the size of indices is not
+		// a multiple of 3 or leafSize is 0.
+		// Throws a std::out_of_range if an index is not less than vertices.size().
+		void build(std::span<const Vector3<T>> vertices, std::span<const u32> indices, size_type leafSize = 4)
+		{
+			if (indices.size() % 3 != 0)
+				throw std::invalid_argument("ERROR: The index count must be a multiple of 3.");
+			if (leafSize == 0)
+				throw std::invalid_argument("ERROR: The leaf size must not be 0.");
+
+			for (u32 index : indices)
+			{
+				if (index >= vertices.size())
+					throw std::out_of_range("ERROR: Invalid vertex index.");
+			}
+
+			clear();
+			_kind = Kind::Triangles;
+			_leafSize = leafSize;
+			_indices.assign(indices.begin(), indices.end());
+
+			const size_type n = indices.size() / 3;
+			std::vector<_BvhBounds<T>> bounds(n);
+
+			for (size_type i = 0; i < n; ++i)
+			{
+				const _BvhTriangle<T> tri = triangle(vertices, i);
+				bounds[i].grow(tri.A);
+				bounds[i].grow(tri.B);
+				bounds[i].grow(tri.C);
+			}
+
+			buildNodes(bounds);
+
+			_triangles.resize(n);
+
+			for (size_type i = 0; i < n; ++i)
+				_triangles[i] = triangle(vertices, _order[i]);
+		}
+
+		// Rebuilds the Bvh over the given boxes.
+		// Leaves hold at most leafSize boxes, unless they can't be split.
+		// Throws a std::invalid_argument if leafSize is 0.
+		void build(std::span<const Box<T>> boxes, size_type leafSize = 4)
+		{
+			if (leafSize == 0)
+				throw std::invalid_argument("ERROR: The leaf size must not be 0.");
+
+			clear();
+			_kind = Kind::Boxes;
+			_leafSize = leafSize;
+
+			std::vector<_BvhBounds<T>> bounds(boxes.size());
+
+			for (size_type i = 0; i < boxes.size(); ++i)
+				bounds[i] = toBounds(boxes[i]);
+
+			buildNodes(bounds);
+
+			_boxes.resize(boxes.size());
+
+			for (size_type i = 0; i < boxes.size(); ++i)
+				_boxes[i] = bounds[_order[i]];
+		}
+
+		// Moves the triangles to the given vertices, keeping the indices
+		// and the tree of the last build.
+		// Throws a std::logic_error if the Bvh was not built from a mesh.
+		// Throws a std::out_of_range if an index is not less than vertices.size().
+		void refit(std::span<const Vector3<T>> vertices)
+		{
+			if (_kind != Kind::Triangles)
+				throw std::logic_error("ERROR: The Bvh was not built from triangles.");
+
+			if (!_indices.empty() && *std::max_element(_indices.begin(), _indices.end()) >= vertices.size())
+				throw std::out_of_range("ERROR: Invalid vertex index.");
+
+			for (size_type i = 0; i < _triangles.size(); ++i)
+				_triangles[i] = triangle(vertices, _order[i]);
+
+			refitNodes();
+		}
+
+		// Moves the boxes to the given boxes, keeping the tree of the last build.
+		// Throws a std::logic_error if the Bvh was not built from boxes.
+		// Throws a std::invalid_argument if the number of boxes changed.
+		void refit(std::span<const Box<T>> boxes)
+		{
+			if (_kind != Kind::Boxes)
+				throw std::logic_error("ERROR: The Bvh was not built from boxes.");
+			if (boxes.size() != _boxes.size())
+				throw std::invalid_argument("ERROR: Array sizes do not match.");
+
+			for (size_type i = 0; i < _boxes.size(); ++i)
+				_boxes[i] = toBounds(boxes[_order[i]]);
+
+			refitNodes();
+		}
+
+		// Removes every primitive from the Bvh.
+		void clear() noexcept
+		{
+			_nodes.clear();
+			_order.clear();
+			_indices.clear();
+			_triangles.clear();
+			_boxes.clear();
+			_kind = Kind::None;
+		}
+
+		// Returns the number of primitives in the Bvh.
+		size_type primitiveCount() const noexcept
+		{
+			return _order.size();
+		}
+
+		// Returns the number of nodes in the Bvh.
+		size_type nodeCount() const noexcept
+		{
+			return _nodes.size();
+		}
+
+		// Returns true if the Bvh holds no primitives.
+		bool empty() const noexcept
+		{
+			return _order.empty();
+		}
+
+		// Returns the smallest Box that contains every primitive.
+		// Returns a Box with a size of 0 at the origin if the Bvh is empty.
+		Box<T> bounds() const
+		{
+			if (_nodes.empty())
+				return Box<T>();
+
+			const _BvhBounds<T>& b = _nodes[0].bounds;
+			return Box<T>(b.min[0], b.min[1], b.min[2], b.max[0] - b.min[0], b.max[1] - b.min[1], b.max[2] - b.min[2]);
+		}
+
+		// Returns the closest primitive hit by the ray from origin along direction
+		// within maxDistance. Distances are in multiples of the length of direction.
+		// Returns a Hit with a primitive of primitiveCount() if nothing is hit.
+		Hit raycast(const Vector3<T>& origin, const Vector3<T>& direction,
+					T maxDistance = std::numeric_limits<T>::infinity()) const
+		{
+			return trace<false>(origin, direction, maxDistance);
+		}
+
+		// Returns true if the ray from origin along direction hits any primitive
+		// within maxDistance. Distances are in multiples of the length of direction.
+		// Stops at the first hit found, which makes it cheaper than raycast().
+		bool occluded(const Vector3<T>& origin, const Vector3<T>& direction,
+					  T maxDistance = std::numeric_limits<T>::infinity()) const
+		{
+			return trace<true>(origin, direction, maxDistance).primitive != primitiveCount();
+		}
+
+		// Returns the primitives that overlap the given Sphere, in no particular order.
+		std::vector<size_type> overlapping(const Sphere<T>& sphere) const
+		{
+			const _Vec3<T> c = toVec(sphere.center);
+			const T r2 = sphere.radius * sphere.radius;
+			std::vector<size_type> result;
+
+			query([&](const _BvhBounds<T>& bounds) { return bounds.distanceSquared(c) <= r2; },
+				  [&](size_type p)
+				  {
+					  bool overlap;
+
+					  if (_kind == Kind::Boxes)
+						  overlap = _boxes[p].distanceSquared(c) <= r2;
+					  else
+					  {
+						  const _Vec3<T> d = _sub(_closest_point(_triangles[p], c), c);
+						  overlap = _dot(d, d) <= r2;
+					  }
+
+					  if (overlap)
+						  result.push_back(_order[p]);
+
+					  return false;
+				  });
+
+			return result;
+		}
+
+		// Returns the primitives that overlap the given Box, in no particular order.
+		std::vector<size_type> overlapping(const Box<T>& box) const
+		{
+			const _BvhBounds<T> b = toBounds(box);
+			std::vector<size_type> result;
+
+			query([&](const _BvhBounds<T>& bounds) { return bounds.overlaps(b); },
+				  [&](size_type p)
+				  {
+					  const bool overlap = _kind == Kind::Boxes ? _boxes[p].overlaps(b) : _overlaps(_triangles[p], b);
+
+					  if (overlap)
+						  result.push_back(_order[p]);
+
+					  return false;
+				  });
+
+			return result;
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,521 @@
+// JLibrary
+// ChunkedGrid.ixx
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Module file for the ChunkedGrid class.
+
+module;
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+export module ChunkedGrid;
+
+import FixedGrid;
+import GridLayout;
+import Vector3;
+
+namespace jlib
+{
+	// Hash of the coordinates of a chunk.
+	struct _ChunkHash
+	{
+		std::size_t operator () (const Vector3<std::int64_t>& pos) const noexcept
+		{
+			// Multiplies each coordinate by a large odd constant so that
+			// neighboring chunks do not collide in the low bits.
+			std::uint64_t h = static_cast<std::uint64_t>(pos.x) * 0x9e3779b97f4a7c15;
+			h ^= static_cast<std::uint64_t>(pos.y) * 0xc2b2ae3d27d4eb4f;
+			h ^= static_cast<std::uint64_t>(pos.z) * 0x165667b19e3779f9;
+			return static_cast<std::size_t>(h ^ (h >> 29));
+		}
+	};
+}
+
+export namespace jlib
+{
+	// Utility template class for representing an unbounded, mostly empty
+	// 3-dimensional grid. The grid is split into ChunkDim x ChunkDim x ChunkDim
+	// FixedGrid chunks, which are only allocated when an element in them
+	// is written to. Elements of chunks that are not allocated have the
+	// default value of the ChunkedGrid.
+	//
+	// The default value is either a constant or a function of the coordinates
+	// of the element. The function is only evaluated when an element that
+	// is not allocated is read, or when its chunk is allocated.
+	//
+	// ChunkDim must be a power of 2. Coordinates may be negative.
+	template <typename T, std::size_t ChunkDim = 16, typename Layout = LinearLayout>
+	class ChunkedGrid
+	{
+		static_assert(std::has_single_bit(ChunkDim), "The chunk size must be a power of 2.");
+
+		public:
+
+		using value_type = T;
+		using chunk_type = FixedGrid<T, ChunkDim, ChunkDim, ChunkDim, Layout>;
+		using coordinate_type = std::int64_t;
+		using position_type = Vector3<std::int64_t>;
+		using generator_type = std::function<T(std::int64_t, std::int64_t, std::int64_t)>;
+		using size_type = std::size_t;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+
+		// log2(ChunkDim).
+		static constexpr std::size_t chunkShift = static_cast<std::size_t>(std::countr_zero(ChunkDim));
+
+		// Number of elements in a chunk.
+		static constexpr std::size_t chunkSize = ChunkDim * ChunkDim * ChunkDim;
+
+		private:
+
+		using map_type = std::unordered_map<position_type, std::unique_ptr<chunk_type>, _ChunkHash>;
+
+		map_type _chunks;
+		T _default;
+		generator_type _generator;
+
+		// The chunk used last, which skips the hash lookup
+		// when consecutive accesses fall into the same chunk.
+		position_type _lastPos;
+		chunk_type* _lastChunk;
+
+		// Returns the coordinate of the chunk that contains the coordinate n.
+		// The shift is arithmetic, so negative coordinates round down.
+		static constexpr std::int64_t chunkCoordinate(std::int64_t n) noexcept
+		{
+			return n >> chunkShift;
+		}
+
+		// Returns the coordinate of n inside of its chunk.
+		static constexpr std::size_t localCoordinate(std::int64_t n) noexcept
+		{
+			return static_cast<std::size_t>(n & static_cast<std::int64_t>(ChunkDim - 1));
+		}
+
+		// Returns the default value of the element at (x, y, z).
+		T defaultAt(std::int64_t x, std::int64_t y, std::int64_t z) const
+		{
+			if (_generator)
+				return _generator(x, y, z);
+
+			return _default;
+		}
+
+		// Sets every element of the chunk at pos to its default value.
+		void fillDefault(chunk_type& chunk, const position_type& pos) const
+		{
+			if (!_generator)
+			{
+				std::fill(chunk.data(), chunk.dataEnd(), _default);
+				return;
+			}
+
+			const std::int64_t x0 = pos.x << chunkShift;
+			const std::int64_t y0 = pos.y << chunkShift;
+			const std::int64_t z0 = pos.z << chunkShift;
+
+			for (std::size_t z = 0; z < ChunkDim; ++z)
+			{
+				for (std::size_t y = 0; y < ChunkDim; ++y)
+				{
+					for (std::size_t x = 0; x < ChunkDim; ++x)
+					{
+						chunk(x, y, z) = _generator(x0 + static_cast<std::int64_t>(x), y0 + static_cast<std::int64_t>(y),
+													z0 + static_cast<std::int64_t>(z));
+					}
+				}
+			}
+		}
+
+		// Returns the chunk at pos, or nullptr if it is not allocated.
+		chunk_type* lookup(const position_type& pos) const
+		{
+			if (_lastChunk != nullptr && _lastPos == pos)
+				return _lastChunk;
+
+			auto iter = _chunks.find(pos);
+			return iter != _chunks.end() ? iter->second.get() : nullptr;
+		}
+
+		// Returns the chunk at pos, allocating it if it is not allocated.
+		chunk_type& acquire(const position_type& pos)
+		{
+			if (_lastChunk != nullptr && _lastPos == pos)
+				return *_lastChunk;
+
+			auto [iter, inserted] = _chunks.try_emplace(pos);
+
+			if (inserted)
+			{
+				try
+				{
+					iter->second = std::make_unique_for_overwrite<chunk_type>();
+					fillDefault(*iter->second, pos);
+				}
+				catch (...)
+				{
+					_chunks.erase(iter);
+					throw;
+				}
+			}
+
+			_lastPos = pos;
+			_lastChunk = iter->second.get();
+			return *_lastChunk;
+		}
+
+		public:
+
+		// Forward iterator over the allocated chunks of a ChunkedGrid.
+		// Dereferencing it gives the coordinates of the chunk and the chunk.
+		// The order of the chunks is unspecified.
+		template <bool IsConst> class ChunkIterator
+		{
+			public:
+
+			using chunk_reference = std::conditional_t<IsConst, const chunk_type&, chunk_type&>;
+
+			// An allocated chunk and its coordinates.
+			struct Entry
+			{
+				position_type position;
+				chunk_reference chunk;
+			};
+
+			using value_type = Entry;
+			using reference = Entry;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::forward_iterator_tag;
+
+			private:
+
+			using base_type = std::conditional_t<IsConst, typename map_type::const_iterator, typename map_type::iterator>;
+
+			base_type _iter;
+
+			public:
+
+			// Default constructor.
+			ChunkIterator() = default;
+
+			// Constructs the ChunkIterator from an iterator of the map of chunks.
+			explicit ChunkIterator(base_type iter) : _iter(iter)
+			{
+
+			}
+
+			// Constructs a const ChunkIterator from a non-const one.
+			template <bool OtherConst> requires (IsConst && !OtherConst)
+			ChunkIterator(const ChunkIterator<OtherConst>& other) : _iter(other.base())
+			{
+
+			}
+
+			// Returns the iterator of the map of chunks.
+			base_type base() const
+			{
+				return _iter;
+			}
+
+			// Overload of unary operator *
+			Entry operator * () const
+			{
+				return Entry{ _iter->first, *_iter->second };
+			}
+
+			// Overload of prefix operator ++
+			ChunkIterator& operator ++ ()
+			{
+				++_iter;
+				return *this;
+			}
+
+			// Overload of postfix operator ++
+			ChunkIterator operator ++ (int)
+			{
+				ChunkIterator tmp = *this;
+				++_iter;
+				return tmp;
+			}
+
+			// Overload of binary operator ==
+			friend bool operator == (const ChunkIterator& A, const ChunkIterator& B)
+			{
+				return A._iter == B._iter;
+			}
+		};
+
+		using iterator = ChunkIterator<false>;
+		using const_iterator = ChunkIterator<true>;
+
+		// Default constructor.
+		// Sets the default value of the ChunkedGrid to T().
+		ChunkedGrid() : _default(), _lastChunk(nullptr)
+		{
+
+		}
+
+		// 1-parameter constructor.
+		// Sets the default value of the ChunkedGrid to value.
+		ChunkedGrid(const_reference value) : _default(value), _lastChunk(nullptr)
+		{
+
+		}
+
+		// 1-parameter constructor.
+		// Sets the default value of the element at (x, y, z)
+		// of the ChunkedGrid to generator(x, y, z).
+		ChunkedGrid(generator_type generator) : _default(), _generator(std::move(generator)), _lastChunk(nullptr)
+		{
+
+		}
+
+		// Deleted copy constructor.
+		ChunkedGrid(const ChunkedGrid& other) = delete;
+
+		// Move constructor.
+		ChunkedGrid(ChunkedGrid&& other) noexcept
+			: _chunks(std::move(other._chunks)), _default(std::move(other._default)),
+			  _generator(std::move(other._generator)), _lastChunk(nullptr)
+		{
+			other._lastChunk = nullptr;
+		}
+
+		// Deleted copy assignment operator.
+		ChunkedGrid& operator = (const ChunkedGrid& other) = delete;
+
+		// Move assignment operator.
+		ChunkedGrid& operator = (ChunkedGrid&& other) noexcept
+		{
+			_chunks = std::move(other._chunks);
+			_default = std::move(other._default);
+			_generator = std::move(other._generator);
+			_lastChunk = nullptr;
+			other._lastChunk = nullptr;
+			return *this;
+		}
+
+		// Default destructor.
+		~ChunkedGrid() = default;
+
+		// Returns the coordinates of the chunk that contains the element at (x, y, z).
+		static position_type chunkPosition(std::int64_t x, std::int64_t y, std::int64_t z) noexcept
+		{
+			return position_type(chunkCoordinate(x), chunkCoordinate(y), chunkCoordinate(z));
+		}
+
+		// Returns the number of allocated chunks.
+		size_type chunkCount() const noexcept
+		{
+			return _chunks.size();
+		}
+
+		// Returns the number of allocated elements.
+		size_type allocatedSize() const noexcept
+		{
+			return _chunks.size() * chunkSize;
+		}
+
+		// Returns true if the ChunkedGrid has no allocated chunks.
+		bool isEmpty() const noexcept
+		{
+			return _chunks.empty();
+		}
+
+		// Returns true if the chunk at (cx, cy, cz) is allocated.
+		bool isAllocated(std::int64_t cx, std::int64_t cy, std::int64_t cz) const
+		{
+			return lookup(position_type(cx, cy, cz)) != nullptr;
+		}
+
+		// Returns a pointer to the chunk at (cx, cy, cz),
+		// or nullptr if it is not allocated.
+		chunk_type* findChunk(std::int64_t cx, std::int64_t cy, std::int64_t cz)
+		{
+			return lookup(position_type(cx, cy, cz));
+		}
+
+		// Returns a pointer to the chunk at (cx, cy, cz),
+		// or nullptr if it is not allocated.
+		const chunk_type* findChunk(std::int64_t cx, std::int64_t cy, std::int64_t cz) const
+		{
+			return lookup(position_type(cx, cy, cz));
+		}
+
+		// Returns the chunk at (cx, cy, cz).
+		// Allocates the chunk and sets it to the default value if it is not allocated.
+		chunk_type& chunk(std::int64_t cx, std::int64_t cy, std::int64_t cz)
+		{
+			return acquire(position_type(cx, cy, cz));
+		}
+
+		// Returns a pointer to the element at (x, y, z),
+		// or nullptr if its chunk is not allocated.
+		pointer find(std::int64_t x, std::int64_t y, std::int64_t z)
+		{
+			chunk_type* c = lookup(chunkPosition(x, y, z));
+			return c != nullptr ? &(*c)(localCoordinate(x), localCoordinate(y), localCoordinate(z)) : nullptr;
+		}
+
+		// Returns a pointer to the element at (x, y, z),
+		// or nullptr if its chunk is not allocated.
+		const_pointer find(std::int64_t x, std::int64_t y, std::int64_t z) const
+		{
+			const chunk_type* c = lookup(chunkPosition(x, y, z));
+			return c != nullptr ? &(*c)(localCoordinate(x), localCoordinate(y), localCoordinate(z)) : nullptr;
+		}
+
+		// Returns the value of the element at (x, y, z).
+		// Returns the default value without allocating if its chunk is not allocated.
+		T get(std::int64_t x, std::int64_t y, std::int64_t z) const
+		{
+			const_pointer ptr = find(x, y, z);
+			return ptr != nullptr ? *ptr : defaultAt(x, y, z);
+		}
+
+		// Sets the element at (x, y, z) to value.
+		// Allocates its chunk if it is not allocated.
+		void set(std::int64_t x, std::int64_t y, std::int64_t z, const_reference value)
+		{
+			(*this)(x, y, z) = value;
+		}
+
+		// Returns the element at (x, y, z).
+		// Allocates its chunk if it is not allocated.
+		reference operator () (std::int64_t x, std::int64_t y, std::int64_t z)
+		{
+			return acquire(chunkPosition(x, y, z))(localCoordinate(x), localCoordinate(y), localCoordinate(z));
+		}
+
+		// Removes the chunk at (cx, cy, cz) and returns it,
+		// so that it may be saved before it is destroyed.
+		// Returns nullptr if the chunk is not allocated.
+		std::unique_ptr<chunk_type> extract(std::int64_t cx, std::int64_t cy, std::int64_t cz)
+		{
+			auto iter = _chunks.find(position_type(cx, cy, cz));
+
+			if (iter == _chunks.end())
+				return nullptr;
+
+			std::unique_ptr<chunk_type> c = std::move(iter->second);
+			_chunks.erase(iter);
+			_lastChunk = nullptr;
+			return c;
+		}
+
+		// Sets the chunk at (cx, cy, cz) to the given chunk,
+		// replacing the chunk there if it is allocated.
+		// Does nothing if the given chunk is nullptr.
+		void insert(std::int64_t cx, std::int64_t cy, std::int64_t cz, std::unique_ptr<chunk_type> c)
+		{
+			if (c == nullptr)
+				return;
+
+			_chunks.insert_or_assign(position_type(cx, cy, cz), std::move(c));
+			_lastChunk = nullptr;
+		}
+
+		// Removes the chunk at (cx, cy, cz), which resets its elements to the default value.
+		// Returns true if the chunk was allocated.
+		bool evict(std::int64_t cx, std::int64_t cy, std::int64_t cz)
+		{
+			_lastChunk = nullptr;
+			return _chunks.erase(position_type(cx, cy, cz)) != 0;
+		}
+
+		// Removes every chunk for which pred(position, chunk) returns true.
+		// Returns the number of chunks removed.
+		template <typename Predicate>
+		requires std::predicate<Predicate&, const position_type&, const chunk_type&>
+		size_type evictIf(Predicate pred)
+		{
+			_lastChunk = nullptr;
+			return std::erase_if(_chunks, [&pred](const auto& entry) { return pred(entry.first, *entry.second); });
+		}
+
+		// Removes every chunk whose elements all equal their default value.
+		// Returns the number of chunks removed.
+		size_type prune() requires std::equality_comparable<T>
+		{
+			return evictIf([this](const position_type& pos, const chunk_type& c)
+			{
+				if (!_generator)
+					return std::all_of(c.data(), c.dataEnd(), [this](const T& value) { return value == _default; });
+
+				const std::int64_t x0 = pos.x << chunkShift;
+				const std::int64_t y0 = pos.y << chunkShift;
+				const std::int64_t z0 = pos.z << chunkShift;
+
+				for (std::size_t z = 0; z < ChunkDim; ++z)
+				{
+					for (std::size_t y = 0; y < ChunkDim; ++y)
+					{
+						for (std::size_t x = 0; x < ChunkDim; ++x)
+						{
+							if (!(c(x, y, z) == _generator(x0 + static_cast<std::int64_t>(x), y0 + static_cast<std::int64_t>(y),
+														   z0 + static_cast<std::int64_t>(z))))
+								return false;
+						}
+					}
+				}
+
+				return true;
+			});
+		}
+
+		// Removes every chunk.
+		void clear() noexcept
+		{
+			_chunks.clear();
+			_lastChunk = nullptr;
+		}
+
+		// Returns an iterator pointing to the first allocated chunk.
+		iterator begin() noexcept
+		{
+			return iterator(_chunks.begin());
+		}
+
+		// Returns an iterator pointing to the first allocated chunk.
+		const_iterator begin() const noexcept
+		{
+			return const_iterator(_chunks.cbegin());
+		}
+
+		// Returns an iterator pointing to the first allocated chunk.
+		const_iterator cbegin() const noexcept
+		{
+			return const_iterator(_chunks.cbegin());
+		}
+
+		// Returns an iterator pointing to 1 past the last allocated chunk.
+		iterator end() noexcept
+		{
+			return iterator(_chunks.end());
+		}
+
+		// Returns an iterator pointing to 1 past the last allocated chunk.
+		const_iterator end() const noexcept
+		{
+			return const_iterator(_chunks.cend());
+		}
+
+		// Returns an iterator pointing to 1 past the last allocated chunk.
+		const_iterator cend() const noexcept
+		{
+			return const_iterator(_chunks.cend());
+		}
+	};
+}
\ No newline at end of file
@@ -1,7 +1,7 @@
 // JLibrary
 // Circle.ixx
 // Created on 2022-01-08 by Justyn Durnford
-// Last modified on 2022-02-22 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
 // Module file for the Circle template class.
 
 module;
@@ -10,8 +10,10 @@ module;
 #include "Constants.hpp"
 
 #include <cmath>
+#include <concepts>
 #include <ostream>
 #include <string>
+#include <type_traits>
 
 export module Circle;
 
@@ -113,17 +115,25 @@ export namespace jlib
 		// Checks if the given point lies within or on the Circle.
 		bool contains(const Vector2<T>& point)
 		{
-			return distance(center, point) <= radius;
+			// Compares squared distances, in double for integer types.
+			using R = std::conditional_t<std::floating_point<T>, T, double>;
+
+			const R dx = static_cast<R>(point.x) - static_cast<R>(center.x);
+			const R dy = static_cast<R>(point.y) - static_cast<R>(center.y);
+			const R r = static_cast<R>(radius);
+
+			return r >= R(0) && dx * dx + dy * dy <= r * r;
 		}
 
 		// Checks if the given point lies within or on the Circle.
 		template <arithmetic U>
 		bool contains(const Vector2<U>& point)
 		{
-			Vector2f A(center);
-			Vector2f B(point);
+			const float dx = float(point.x) - float(center.x);
+			const float dy = float(point.y) - float(center.y);
+			const float r = float(radius);
 
-			return distance(A, B) <= radius;
+			return r >= 0.0f && dx * dx + dy * dy <= r * r;
 		}
 
 		// Returns a std::string representation of the Circle.
@@ -143,7 +153,11 @@ export namespace jlib
 	template <arithmetic T>
 	bool intersection(const Circle<T>& A, const Circle<T>& B)
 	{
-		return std::powf(std::fabsf(A.radius) + std::fabsf(B.radius), 2.0f) <= (std::powf(B.x - A.x, 2.0f) + std::powf(B.y - A.y, 2.0f));
+		const T dx = B.center.x - A.center.x;
+		const T dy = B.center.y - A.center.y;
+		const T r = std::abs(A.radius) + std::abs(B.radius);
+
+		return (dx * dx) + (dy * dy) <= r * r;
 	}
 
 	// Overload of binary operator == 
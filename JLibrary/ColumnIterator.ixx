@@ -1,25 +1,28 @@
 // JLibrary
-// Matrix.ixx
+// ColumnIterator.ixx
 // Created on 2022-01-08 by Justyn Durnford
-// Last modified on 2022-04-05 by Justyn Durnford
-// Module file for the Matrix template class.
+// Last modified on 2026-10-17 by Justyn Durnford
+// Module file for the ColumnIterator template class.
 
 module;
 
 #include <compare>
 #include <cstddef>
 #include <iterator>
+#include <type_traits>
 
 export module ColumnIterator;
 
 export namespace jlib
 {
-	// 
+	// Random access iterator over a column of a matrix stored row by row.
+	// Each step moves the pointer by the size of a row.
+	// T may be const qualified for a read-only iterator.
 	template <typename T> class ColumnIterator
 	{
 		public:
 
-		using value_type = T;
+		using value_type = std::remove_cv_t<T>;
 		using pointer = T*;
 		using const_pointer = const T*;
 		using reference = T&;
@@ -30,161 +33,165 @@ export namespace jlib
 		private:
 
 		pointer _ptr;
-		std::size_t _rowSize;
+		difference_type _rowSize;
 
 		public:
 
-		// 
-		ColumnIterator()
+		// Default constructor.
+		constexpr ColumnIterator() noexcept
 		{
 			_ptr = nullptr;
+			_rowSize = 0;
 		}
 
-		// 
-		ColumnIterator(pointer ptr)
+		// Constructs the iterator at ptr, moving rowSize elements per step.
+		constexpr ColumnIterator(pointer ptr, std::size_t rowSize) noexcept
 		{
 			_ptr = ptr;
+			_rowSize = static_cast<difference_type>(rowSize);
 		}
 
-		// 
-		ColumnIterator(std::nullptr_t)
+		// nullptr constructor.
+		constexpr ColumnIterator(std::nullptr_t) noexcept
 		{
 			_ptr = nullptr;
+			_rowSize = 0;
 		}
 
-		// 
-		ColumnIterator(const ColumnIterator& other) = default;
+		// Converting constructor.
+		// Allows a ColumnIterator<T> to be used as a ColumnIterator<const T>.
+		template <typename U> requires std::is_convertible_v<U*, T*>
+		constexpr ColumnIterator(const ColumnIterator<U>& other) noexcept
+		{
+			_ptr = other.base();
+			_rowSize = static_cast<difference_type>(other.rowSize());
+		}
+
+		// Copy constructor.
+		constexpr ColumnIterator(const ColumnIterator& other) = default;
+
+		// Move constructor.
+		constexpr ColumnIterator(ColumnIterator&& other) = default;
 
-		// 
-		ColumnIterator(ColumnIterator&& other) = default;
+		// Copy assignment operator.
+		constexpr ColumnIterator& operator = (const ColumnIterator& other) = default;
 
-		// 
-		ColumnIterator& operator = (const ColumnIterator& other) = default;
+		// Move assignment operator.
+		constexpr ColumnIterator& operator = (ColumnIterator&& other) = default;
 
-		// 
-		ColumnIterator& operator = (ColumnIterator&& other) = default;
+		// Destructor.
+		constexpr ~ColumnIterator() = default;
 
-		// 
-		~ColumnIterator() = default;
+		// Returns the pointer to the current element.
+		constexpr pointer base() const noexcept
+		{
+			return _ptr;
+		}
 
-		// 
-		ColumnIterator& operator ++ () noexcept
+		// Returns the number of elements the iterator moves per step.
+		constexpr std::size_t rowSize() const noexcept
+		{
+			return static_cast<std::size_t>(_rowSize);
+		}
+
+		// Overload of prefix operator ++
+		constexpr ColumnIterator& operator ++ () noexcept
 		{
 			_ptr += _rowSize;
 			return *this;
 		}
 
-		// 
-		ColumnIterator& operator ++ (int) noexcept
+		// Overload of postfix operator ++
+		constexpr ColumnIterator operator ++ (int) noexcept
 		{
 			ColumnIterator tmp = *this;
 			++(*this);
 			return tmp;
 		}
 
-		// 
-		ColumnIterator& operator -- () noexcept
+		// Overload of prefix operator --
+		constexpr ColumnIterator& operator -- () noexcept
 		{
 			_ptr -= _rowSize;
 			return *this;
 		}
 
-		// 
-		ColumnIterator& operator -- (int) noexcept
+		// Overload of postfix operator --
+		constexpr ColumnIterator operator -- (int) noexcept
 		{
 			ColumnIterator tmp = *this;
 			--(*this);
 			return tmp;
 		}
 
-		// 
-		ColumnIterator& operator += (std::ptrdiff_t offset) noexcept
+		// Overload of operator +=
+		constexpr ColumnIterator& operator += (difference_type offset) noexcept
 		{
 			_ptr += offset * _rowSize;
 			return *this;
 		}
 
-		// 
-		ColumnIterator& operator -= (std::ptrdiff_t offset) noexcept
+		// Overload of operator -=
+		constexpr ColumnIterator& operator -= (difference_type offset) noexcept
 		{
 			_ptr -= offset * _rowSize;
 			return *this;
 		}
 
-		// 
-		friend ColumnIterator operator + (const ColumnIterator& A, std::ptrdiff_t offset)
+		// Overload of binary operator +
+		friend constexpr ColumnIterator operator + (const ColumnIterator& A, difference_type offset) noexcept
 		{
-			return ColumnIterator(A._ptr + offset * _rowSize);
+			return ColumnIterator(A._ptr + offset * A._rowSize, A.rowSize());
 		}
 
-		// 
-		friend ColumnIterator operator - (const ColumnIterator& A, std::ptrdiff_t offset)
+		// Overload of binary operator +
+		friend constexpr ColumnIterator operator + (difference_type offset, const ColumnIterator& A) noexcept
 		{
-			return ColumnIterator(A._ptr - offset * _rowSize);
+			return A + offset;
 		}
 
-		// 
-		reference operator * () const noexcept
+		// Overload of binary operator -
+		friend constexpr ColumnIterator operator - (const ColumnIterator& A, difference_type offset) noexcept
 		{
-			return *_ptr;
+			return ColumnIterator(A._ptr - offset * A._rowSize, A.rowSize());
 		}
 
-		// 
-		pointer operator -> () const noexcept
+		// Overload of binary operator -
+		// Returns the number of rows between the iterators,
+		// which must belong to the same column.
+		friend constexpr difference_type operator - (const ColumnIterator& A, const ColumnIterator& B) noexcept
 		{
-			return _ptr;
+			return A._rowSize != 0 ? (A._ptr - B._ptr) / A._rowSize : 0;
 		}
 
-		// 
-		reference operator [] (std::ptrdiff_t offset)
+		// Overload of unary operator *
+		constexpr reference operator * () const noexcept
 		{
-			return *(_ptr + offset * _rowSize);
-		}
-
-		// 
-		bool operator == (const ColumnIterator& other)
-		{
-			return _ptr == other._ptr;
-		}
-
-		// 
-		bool operator != (const ColumnIterator& other)
-		{
-			return _ptr != other._ptr;
-		}
-
-		// 
-		bool operator < (const ColumnIterator& other)
-		{
-			return _ptr < other._ptr;
+			return *_ptr;
 		}
 
-		// 
-		bool operator <= (const ColumnIterator& other)
+		// Overload of operator ->
+		constexpr pointer operator -> () const noexcept
 		{
-			return _ptr <= other._ptr;
+			return _ptr;
 		}
 
-		// 
-		bool operator > (const ColumnIterator& other)
+		// Returns the element offset rows away from the iterator.
+		constexpr reference operator [] (difference_type offset) const noexcept
 		{
-			return _ptr > other._ptr;
+			return *(_ptr + offset * _rowSize);
 		}
 
-		// 
-		bool operator >= (const ColumnIterator& other)
+		// Overload of binary operator ==
+		friend constexpr bool operator == (const ColumnIterator& A, const ColumnIterator& B) noexcept
 		{
-			return _ptr >= other._ptr;
+			return A._ptr == B._ptr;
 		}
 
-		// 
-		std::strong_ordering operator <=> (const ColumnIterator& other)
+		// Overload of binary operator <=>
+		friend constexpr std::strong_ordering operator <=> (const ColumnIterator& A, const ColumnIterator& B) noexcept
 		{
-			if (_ptr < other._ptr)
-				return std::strong_ordering::less;
-			if (_ptr > other._ptr)
-				return std::strong_ordering::greater;
-			return std::strong_ordering::equal;
+			return std::compare_three_way()(A._ptr, B._ptr);
 		}
 	};
 }
\ No newline at end of file
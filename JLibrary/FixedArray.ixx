@@ -1,11 +1,14 @@
 // JLibrary
 // FixedArray.ixx
 // Created on 2022-01-08 by Justyn Durnford
-// Last modified on 2022-03-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
 // Module file for the FixedArray template class.
 
 module;
 
+#include "Simd.hpp"
+#include "Uninitialized.hpp"
+
 #include <algorithm>
 #include <array>
 #include <compare>
@@ -15,6 +18,7 @@ module;
 #include <iostream>
 #include <iterator>
 #include <stdexcept>
+#include <type_traits>
 
 export module FixedArray;
 
@@ -23,8 +27,9 @@ import MiscTemplateFunctions;
 export namespace jlib
 {
 	// This template class serves as a fixed-size container.
-	// This acts very much like a std::array, but a std::array
-	// does not allocate memory on the heap, which this class does.
+	// This acts very much like a std::array: the elements are stored
+	// inline, so a FixedArray never allocates memory on the heap.
+	// It is trivially copyable whenever T is trivially copyable.
 	// Iterators for this class are just simple pointers.
 	template <typename T, std::size_t N> class FixedArray
 	{
@@ -44,122 +49,94 @@ export namespace jlib
 
 		private:
 
-		pointer _data;
-
-		// This function allocates memory for the container.
-		// It may throw if it fails to do this.
-		void allocate()
-		{
-			if (N != 0)
-			{
-				try
-				{
-					_data = new value_type[N];
-				}
-				catch (...)
-				{
-					_data = nullptr;
-					throw;
-				}
-			}
-			else
-				_data = nullptr;
-		}
+		// A FixedArray of size 0 still holds one element,
+		// since C++ does not allow arrays of size 0.
+		value_type _data[N == 0 ? 1 : N];
 
 		public:
 
 		// Default constructor.
-		FixedArray()
+		// Every element is value-initialized.
+		constexpr FixedArray() : _data{}
 		{
-			allocate();
+
+		}
+
+		// Uninitialized constructor.
+		// Does not value-initialize the elements. Trivial elements are
+		// left untouched, so their contents must be written before they are read.
+		constexpr explicit FixedArray(uninitialized_t)
+		{
+
 		}
 
 		// Value constructor.
-		FixedArray(const_reference value)
+		constexpr FixedArray(const_reference value)
 		{
-			allocate();
 			std::fill(_data, _data + N, value);
 		}
 
 		// Constructs the FixedArray with the contents in the range[begin, begin + N).
 		// This DOES NOT move the contents from the given range, it simply
 		// copies its contents into the new FixedArray.
-		FixedArray(const_pointer begin)
+		constexpr FixedArray(const_pointer begin)
 		{
-			allocate();
 			std::copy(begin, begin + N, _data);
 		}
 
 		// std::initializer_list constructor.
-		FixedArray(std::initializer_list<T> elems)
+		// If the list holds fewer than N elements, the
+		// remaining elements are value-initialized.
+		constexpr FixedArray(std::initializer_list<T> elems)
 		{
-			allocate();
-			std::copy(elems.begin(), elems.begin() + N, _data);
+			size_type count = std::min(elems.size(), N);
+			std::copy(elems.begin(), elems.begin() + count, _data);
+			std::fill(_data + count, _data + N, value_type());
 		}
 
 		// std::array constructor.
-		FixedArray(const std::array<T, N>& arr)
+		constexpr FixedArray(const std::array<T, N>& arr)
 		{
-			allocate();
 			std::copy(arr.begin(), arr.end(), _data);
 		}
 
 		// Copy constructor.
-		FixedArray(const FixedArray& other)
-		{
-			allocate();
-			std::copy(other.begin(), other.end(), _data);
-		}
+		constexpr FixedArray(const FixedArray& other) = default;
 
 		// Different-type Copy constructor.
 		template <typename U>
-		explicit FixedArray(const FixedArray<U, N>& other)
+		constexpr explicit FixedArray(const FixedArray<U, N>& other)
 		{
-			allocate();
-			jlib::copy(other.data(), other.data() + N, _data);
+			for (size_type i = 0; i < N; ++i)
+				_data[i] = static_cast<value_type>(other[i]);
 		}
 
 		// Move constructor.
-		FixedArray(FixedArray&& other) noexcept
-		{
-			std::swap(_data, other._data);
-		}
+		constexpr FixedArray(FixedArray&& other) = default;
 
 		// std::initializer_list assignment operator.
-		FixedArray& operator = (std::initializer_list<T> elems)
+		constexpr FixedArray& operator = (std::initializer_list<T> elems)
 		{
-			std::copy(elems.begin(), elems.begin() + N, _data);
+			size_type count = std::min(elems.size(), N);
+			std::copy(elems.begin(), elems.begin() + count, _data);
 			return *this;
 		}
 
 		// std::array assignment operator.
-		FixedArray& operator = (const std::array<T, N>& arr)
+		constexpr FixedArray& operator = (const std::array<T, N>& arr)
 		{
 			std::copy(arr.begin(), arr.end(), _data);
 			return *this;
 		}
 
 		// Copy assignment operator.
-		FixedArray& operator = (const FixedArray& other)
-		{
-			std::copy(other.begin(), other.end(), _data);
-			return *this;
-		}
+		constexpr FixedArray& operator = (const FixedArray& other) = default;
 
 		// Move assignment operator.
-		FixedArray& operator = (FixedArray&& other) noexcept
-		{
-			delete[] _data;
-			_data = nullptr;
-			std::swap(_data, other._data);
-			return *this;
-		}
+		constexpr FixedArray& operator = (FixedArray&& other) = default;
 
 		// Destructor.
-		~FixedArray() noexcept
-		{
-			delete[] _data;
-		}
+		constexpr ~FixedArray() = default;
 
 		// Returns the size of the FixedArray.
 		constexpr size_type size() const noexcept
@@ -335,14 +312,17 @@ export namespace jlib
 		// Sets every element to the given value.
 		constexpr void setAll(const_reference value)
 		{
-			for (size_type i = 0; i < N; ++i)
-				_data[i] = value;
+			if (std::is_constant_evaluated())
+				std::fill(_data, _data + N, value);
+			else
+				simd::fill_n(_data, N, value);
 		}
 
 		// Swaps the contents of this FixedArray with another FixedArray.
-		void swapWith(FixedArray& other) noexcept
+		// Since the elements are stored inline, this swaps every element.
+		constexpr void swapWith(FixedArray& other) noexcept(std::is_nothrow_swappable_v<T>)
 		{
-			std::swap(_data, other._data);
+			std::swap_ranges(_data, _data + N, other._data);
 		}
 
 		// Returns the element at the given index the FixedArray.
@@ -388,26 +368,14 @@ export namespace jlib
 	template <std::totally_ordered T, std::size_t N>
 	bool operator == (const FixedArray<T, N>& A, const FixedArray<T, N>& B)
 	{
-		for (std::size_t i = 0; i < N; ++i)
-		{
-			if (A[i] != B[i])
-				return false;
-		}
-
-		return true;
+		return simd::equal_n(A.data(), B.data(), N);
 	}
 
 	// Overload of binary operator !=
 	template <std::totally_ordered T, std::size_t N>
 	bool operator != (const FixedArray<T, N>& A, const FixedArray<T, N>& B)
 	{
-		for (std::size_t i = 0; i < N; ++i)
-		{
-			if (A[i] != B[i])
-				return true;
-		}
-
-		return false;
+		return !(A == B);
 	}
 
 	// Overload of binary operator <
@@ -487,6 +455,7 @@ export namespace jlib
 			os << A[i] << ", ";
 
 		os << A[N - 1] << " }\n";
+		return os;
 	}
 
 	// Overload of std::wostream operator <<
@@ -499,5 +468,6 @@ export namespace jlib
 			wos << A[i] << L", ";
 
 		wos << A[N - 1] << L" }\n";
+		return wos;
 	}
 }
\ No newline at end of file
@@ -1,45 +1,211 @@
 // JLibrary
 // FixedGrid.ixx
 // Created on 2022-06-25 by Justyn Durnford
-// Last modified on 2022-09-21 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
 // Module file for the FixedGrid class.
 
 module;
 
-#include <stdexcept>
+#include <algorithm>
 #include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
 
 export module FixedGrid;
 
 import FixedArray;
+import GridLayout;
 import Vector3;
 
 export namespace jlib
 {
-    template <typename T, size_t LENGTH, size_t WIDTH, size_t HEIGHT>
-    class FixedGrid
-    {
-        public:
+	// Which cells around a cell count as its neighbors.
+	// The value is the largest number of coordinates that may differ.
+	enum class GridConnectivity
+	{
+		Face = 1,   // The 6 cells that share a face.
+		Edge = 2,   // The 18 cells that share a face or an edge.
+		Vertex = 3  // The 26 cells that share a face, an edge or a corner.
+	};
+
+	// Forward iterator over the neighbors of a cell of a grid
+	// that lie inside of the grid. Grid may be const qualified.
+	// The grid must provide contains(x, y, z) for signed coordinates
+	// and operator () (x, y, z).
+	template <typename Grid> class GridNeighborIterator
+	{
+		public:
+
+		using value_type = typename std::remove_cv_t<Grid>::value_type;
+		using reference = std::conditional_t<std::is_const_v<Grid>, const value_type&, value_type&>;
+		using pointer = std::remove_reference_t<reference>*;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		private:
+
+		Grid* _grid;
+		std::ptrdiff_t _x;
+		std::ptrdiff_t _y;
+		std::ptrdiff_t _z;
+		int _offset;
+		int _distance;
+
+		// Returns true if the cell at the given offset of the 3 x 3 x 3 block
+		// is a neighbor inside of the grid.
+		bool isNeighbor(int offset) const
+		{
+			const int dx = (offset % 3) - 1;
+			const int dy = ((offset / 3) % 3) - 1;
+			const int dz = (offset / 9) - 1;
+			const int distance = (dx != 0) + (dy != 0) + (dz != 0);
+
+			return distance != 0 && distance <= _distance && _grid->contains(_x + dx, _y + dy, _z + dz);
+		}
+
+		// Moves to the first neighbor at or after the current offset.
+		void skip()
+		{
+			while (_offset < 27 && !isNeighbor(_offset))
+				++_offset;
+		}
+
+		public:
+
+		// Default constructor.
+		// Creates an end iterator.
+		GridNeighborIterator() : _grid(nullptr), _x(0), _y(0), _z(0), _offset(27), _distance(0)
+		{
+
+		}
+
+		// Constructs an iterator at the first neighbor of the cell at (x, y, z).
+		GridNeighborIterator(Grid& grid, std::ptrdiff_t x, std::ptrdiff_t y, std::ptrdiff_t z, GridConnectivity connectivity)
+			: _grid(&grid), _x(x), _y(y), _z(z), _offset(0), _distance(static_cast<int>(connectivity))
+		{
+			skip();
+		}
+
+		// Returns the coordinates of the current neighbor.
+		Vector3<std::ptrdiff_t> position() const
+		{
+			return Vector3<std::ptrdiff_t>(_x + (_offset % 3) - 1, _y + ((_offset / 3) % 3) - 1, _z + (_offset / 9) - 1);
+		}
+
+		// Overload of unary operator *
+		reference operator * () const
+		{
+			const Vector3<std::ptrdiff_t> pos = position();
+			return (*_grid)(static_cast<std::size_t>(pos.x), static_cast<std::size_t>(pos.y), static_cast<std::size_t>(pos.z));
+		}
+
+		// Overload of operator ->
+		pointer operator -> () const
+		{
+			return &(**this);
+		}
+
+		// Overload of prefix operator ++
+		GridNeighborIterator& operator ++ ()
+		{
+			++_offset;
+			skip();
+			return *this;
+		}
+
+		// Overload of postfix operator ++
+		GridNeighborIterator operator ++ (int)
+		{
+			GridNeighborIterator tmp = *this;
+			++(*this);
+			return tmp;
+		}
+
+		// Overload of binary operator ==
+		// Iterators are equal if they are both at the end
+		// or at the same neighbor of the same cell.
+		friend bool operator == (const GridNeighborIterator& A, const GridNeighborIterator& B) noexcept
+		{
+			if (A._offset == 27 || B._offset == 27)
+				return A._offset == B._offset;
+
+			return A._grid == B._grid && A._x == B._x && A._y == B._y && A._z == B._z && A._offset == B._offset;
+		}
+	};
+
+	// Range of the neighbors of a cell of a grid, for use in range-based for loops.
+	template <typename Grid> class GridNeighborRange
+	{
+		GridNeighborIterator<Grid> _begin;
+
+		public:
+
+		GridNeighborRange(Grid& grid, std::ptrdiff_t x, std::ptrdiff_t y, std::ptrdiff_t z, GridConnectivity connectivity)
+			: _begin(grid, x, y, z, connectivity)
+		{
+
+		}
+
+		// Returns an iterator pointing to the first neighbor.
+		GridNeighborIterator<Grid> begin() const
+		{
+			return _begin;
+		}
+
+		// Returns an iterator pointing to 1 past the last neighbor.
+		GridNeighborIterator<Grid> end() const
+		{
+			return GridNeighborIterator<Grid>();
+		}
+	};
+
+	// Utility template class for representing a 3-dimensional grid
+	// with dimensions known at compile time.
+	// x is in [0, WIDTH), y is in [0, HEIGHT) and z is in [0, LENGTH).
+	//
+	// Layout chooses the order of the elements in memory.
+	// LinearLayout stores them row by row, MortonLayout along a Z-order
+	// curve and BrickLayout<B> in B x B x B bricks. The last two keep the
+	// neighbors of a cell in fewer cache lines, but may pad the storage,
+	// so data(), begin() and size() cover storageSize() elements in layout order.
+	//
+	// LinearLayout is the fastest for sweeps over the whole grid with x
+	// innermost, since every access but the first of a row is sequential
+	// and its index is the cheapest to compute. For a 3 x 3 x 3 sweep of a
+	// 256^3 float grid, MortonLayout was about 1.6x to 3.6x and
+	// BrickLayout<8> about 2.5x to 4.5x slower. For 3 x 3 x 3 blocks at
+	// scattered cells, MortonLayout was even with LinearLayout and
+	// BrickLayout<8> up to 2x slower. The other layouts only pay off when
+	// memory traffic, not index arithmetic, is the bottleneck, such as
+	// larger neighborhoods, many threads sharing the memory bandwidth or
+	// visiting the cells in layout order through data() or begin().
+	// "Tests.exe bench" measures both patterns.
+	template <typename T, size_t LENGTH, size_t WIDTH, size_t HEIGHT, typename Layout = LinearLayout>
+	class FixedGrid
+	{
+		public:
 
 		using value_type = T;
+		using layout_type = Layout;
 		using size_type = std::size_t;
 		using difference_type = std::ptrdiff_t;
 		using reference = value_type&;
 		using const_reference = const value_type&;
 		using pointer = value_type*;
 		using const_pointer = const value_type*;
-		using iterator = FixedArray<T, LENGTH * WIDTH * HEIGHT>::iterator;
-		using const_iterator = FixedArray<T, LENGTH * WIDTH * HEIGHT>::const_iterator;
+		using iterator = FixedArray<T, Layout::storageSize(WIDTH, HEIGHT, LENGTH)>::iterator;
+		using const_iterator = FixedArray<T, Layout::storageSize(WIDTH, HEIGHT, LENGTH)>::const_iterator;
 		using row_iterator = iterator;
 		using const_row_iterator = const_iterator;
-		using reverse_iterator = FixedArray<T, LENGTH * WIDTH * HEIGHT>::reverse_iterator;
-		using const_reverse_iterator = FixedArray<T, LENGTH * WIDTH * HEIGHT>::const_reverse_iterator;
+		using reverse_iterator = FixedArray<T, Layout::storageSize(WIDTH, HEIGHT, LENGTH)>::reverse_iterator;
+		using const_reverse_iterator = FixedArray<T, Layout::storageSize(WIDTH, HEIGHT, LENGTH)>::const_reverse_iterator;
 
-        private:
+		private:
 
-        FixedArray<T, LENGTH * WIDTH * HEIGHT> _data;
+		FixedArray<T, Layout::storageSize(WIDTH, HEIGHT, LENGTH)> _data;
 
-        public:
+		public:
 
 		// Default constructor.
 		FixedGrid() = default;
@@ -51,10 +217,57 @@ export namespace jlib
 			std::fill(data(), dataEnd(), value);
 		}
 
-		// Returns the number of elements in the FixedMatrix.
+		// Returns the number of elements along x.
+		static constexpr size_type width() noexcept
+		{
+			return WIDTH;
+		}
+
+		// Returns the number of elements along y.
+		static constexpr size_type height() noexcept
+		{
+			return HEIGHT;
+		}
+
+		// Returns the number of elements along z.
+		static constexpr size_type length() noexcept
+		{
+			return LENGTH;
+		}
+
+		// Returns the number of elements in memory, which is the number
+		// of elements from begin() to end(). This is LENGTH * WIDTH * HEIGHT
+		// for LinearLayout, but includes the padding of the other layouts.
 		constexpr size_type size() const noexcept
 		{
-			return LENGTH * WIDTH * HEIGHT;
+			return storageSize();
+		}
+
+		// Returns the number of elements in memory,
+		// including the padding of the layout.
+		static constexpr size_type storageSize() noexcept
+		{
+			return Layout::storageSize(WIDTH, HEIGHT, LENGTH);
+		}
+
+		// Returns the index in memory of the element at (x, y, z).
+		// Does NOT perform bounds-checking.
+		static constexpr size_type index(size_type x, size_type y, size_type z) noexcept
+		{
+			return Layout::index(x, y, z, WIDTH, HEIGHT, LENGTH);
+		}
+
+		// Returns the coordinates of the element at the given index in memory.
+		static Vector3<size_type> coordinates(size_type n) noexcept
+		{
+			return Layout::coordinates(n, WIDTH, HEIGHT, LENGTH);
+		}
+
+		// Returns true if (x, y, z) is inside of the FixedGrid.
+		static constexpr bool contains(difference_type x, difference_type y, difference_type z) noexcept
+		{
+			return x >= 0 && y >= 0 && z >= 0 &&
+				   static_cast<size_type>(x) < WIDTH && static_cast<size_type>(y) < HEIGHT && static_cast<size_type>(z) < LENGTH;
 		}
 
 		// Returns the pointer of the FixedGrid.
@@ -81,29 +294,105 @@ export namespace jlib
 			return _data.dataEnd();
 		}
 
-		// 
+		// Returns an iterator pointing to the first element of the FixedGrid.
+		// The elements are visited in layout order, padding included.
+		constexpr iterator begin() noexcept
+		{
+			return _data.begin();
+		}
+
+		// Returns an iterator pointing to the first element of the FixedGrid.
+		// The elements are visited in layout order, padding included.
+		constexpr const_iterator begin() const noexcept
+		{
+			return _data.begin();
+		}
+
+		// Returns an iterator pointing to the first element of the FixedGrid.
+		// The elements are visited in layout order, padding included.
+		constexpr const_iterator cbegin() const noexcept
+		{
+			return _data.cbegin();
+		}
+
+		// Returns an iterator pointing to 1 past the last element of the FixedGrid.
+		constexpr iterator end() noexcept
+		{
+			return _data.end();
+		}
+
+		// Returns an iterator pointing to 1 past the last element of the FixedGrid.
+		constexpr const_iterator end() const noexcept
+		{
+			return _data.end();
+		}
+
+		// Returns an iterator pointing to 1 past the last element of the FixedGrid.
+		constexpr const_iterator cend() const noexcept
+		{
+			return _data.cend();
+		}
+
+		// Returns the element at (x, y, z).
+		// Throws a std::out_of_range if given an invalid index.
+		constexpr reference at(size_type x, size_type y, size_type z)
+		{
+			if (x >= WIDTH || y >= HEIGHT || z >= LENGTH)
+				throw std::out_of_range("ERROR: Invalid FixedGrid index.");
+
+			return _data[index(x, y, z)];
+		}
+
+		// Returns the element at (x, y, z).
+		// Throws a std::out_of_range if given an invalid index.
+		constexpr const_reference at(size_type x, size_type y, size_type z) const
+		{
+			if (x >= WIDTH || y >= HEIGHT || z >= LENGTH)
+				throw std::out_of_range("ERROR: Invalid FixedGrid index.");
+
+			return _data[index(x, y, z)];
+		}
+
+		// Returns the neighbors of the element at (x, y, z) that are inside of the FixedGrid.
+		GridNeighborRange<FixedGrid> neighbors(size_type x, size_type y, size_type z, GridConnectivity connectivity = GridConnectivity::Vertex)
+		{
+			return GridNeighborRange<FixedGrid>(*this, static_cast<difference_type>(x), static_cast<difference_type>(y),
+												static_cast<difference_type>(z), connectivity);
+		}
+
+		// Returns the neighbors of the element at (x, y, z) that are inside of the FixedGrid.
+		GridNeighborRange<const FixedGrid> neighbors(size_type x, size_type y, size_type z, GridConnectivity connectivity = GridConnectivity::Vertex) const
+		{
+			return GridNeighborRange<const FixedGrid>(*this, static_cast<difference_type>(x), static_cast<difference_type>(y),
+													  static_cast<difference_type>(z), connectivity);
+		}
+
+		// Returns the element at the given index in memory.
+		// Does NOT perform bounds-checking.
 		constexpr reference operator [] (size_type n)
 		{
 			return _data[n];
 		}
 
-		// 
+		// Returns the element at the given index in memory.
+		// Does NOT perform bounds-checking.
 		constexpr const_reference operator [] (size_type n) const
 		{
 			return _data[n];
 		}
 
-        // 
-        constexpr reference operator () (size_type x, size_type y, size_type z)
-        {
-            return _data[z * WIDTH * HEIGHT + y * WIDTH + x];
-        }
+		// Returns the element at (x, y, z).
+		// Does NOT perform bounds-checking.
+		constexpr reference operator () (size_type x, size_type y, size_type z)
+		{
+			return _data[index(x, y, z)];
+		}
 
-		// 
+		// Returns the element at (x, y, z).
+		// Does NOT perform bounds-checking.
 		constexpr const_reference operator () (size_type x, size_type y, size_type z) const
 		{
-			return _data[z * WIDTH * HEIGHT + y * WIDTH + x];
+			return _data[index(x, y, z)];
 		}
-    };
-
+	};
 }
\ No newline at end of file
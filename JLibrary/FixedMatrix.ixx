@@ -1,26 +1,66 @@
 // JLibrary
 // FixedMatrix.ixx
 // Created on 2022-01-08 by Justyn Durnford
-// Last modified on 2022-09-12 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
 // Module file for the FixedMatrix template class.
 
 module;
 
 #include "Arithmetic.hpp"
+#include "Simd.hpp"
+#include "Uninitialized.hpp"
 
 #include <algorithm>
 #include <array>
+#include <cmath>
+#include <concepts>
 #include <cstddef>
 #include <initializer_list>
 #include <iterator>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 export module FixedMatrix;
 
 import ColumnIterator;
 import FixedArray;
+import MatrixExpression;
+import MatrixView;
 import MiscTemplateFunctions;
 import Vector2;
+import VectorN;
+
+namespace jlib
+{
+	// Calls f(i) for every i in [0, N) through a fold expression,
+	// so the loop is fully unrolled at compile time.
+	template <std::size_t N, typename F>
+	constexpr void _unroll(F&& f)
+	{
+		[&]<std::size_t... I>(std::index_sequence<I...>)
+		{
+			(f(I), ...);
+		}(std::make_index_sequence<N>());
+	}
+
+	// Largest loop that FixedMatrix operations unroll.
+	// Longer loops are left to the compiler to keep compile times down.
+	inline constexpr std::size_t _unroll_limit = 64;
+
+	// Calls f(i) for every i in [0, N), unrolled if N <= _unroll_limit.
+	template <std::size_t N, typename F>
+	constexpr void _static_for(F&& f)
+	{
+		if constexpr (N <= _unroll_limit)
+			_unroll<N>(f);
+		else
+		{
+			for (std::size_t i = 0; i < N; ++i)
+				f(i);
+		}
+	}
+}
 
 export namespace jlib
 {
@@ -32,6 +72,10 @@ export namespace jlib
 	// This seems a bit confusing to people who are
 	// used to X x Y coordinates, but this is consistent
 	// with how they are represented in mathematics.
+	// 
+	// The element-wise operators +, - and scalar * and / return lazy
+	// matrix expressions, which are evaluated in one unrolled loop when
+	// they are assigned to a FixedMatrix.
 	template <typename T, std::size_t R, std::size_t C> class FixedMatrix
 	{
 		public:
@@ -59,17 +103,24 @@ export namespace jlib
 		public:
 
 		// Default constructor.
-		FixedMatrix() = default;
+		// Every element is value-initialized.
+		constexpr FixedMatrix() = default;
+
+		// Constructs the FixedMatrix without initializing its elements.
+		constexpr explicit FixedMatrix(uninitialized_t) : _data(uninitialized)
+		{
+
+		}
 
 		// 1-parameter constructor.
 		// Sets every element of the FixedMatrix to value.
-		FixedMatrix(const_reference value)
+		constexpr FixedMatrix(const_reference value)
 		{
-			std::fill(data(), data() + size(), value);
+			_data.setAll(value);
 		}
 
 		// 2-dimensional std::initializer_list constructor.
-		FixedMatrix(std::initializer_list<std::initializer_list<T>> list)
+		constexpr FixedMatrix(std::initializer_list<std::initializer_list<T>> list)
 		{
 			size_type row_i = 0;
 
@@ -84,13 +135,30 @@ export namespace jlib
 		// This constructor doesn't replace the copy constructor,
 		// it's called only when U != T.
 		template <typename U>
-		explicit FixedMatrix(const FixedMatrix<U, R, C>& other)
+		constexpr explicit FixedMatrix(const FixedMatrix<U, R, C>& other) : _data(uninitialized)
+		{
+			_static_for<R * C>([&](std::size_t i) { _data[i] = static_cast<T>(other[i]); });
+		}
+
+		// Constructs the FixedMatrix by evaluating a matrix expression.
+		// Throws a std::invalid_argument if the dimensions do not match.
+		template <matrix_expression_node E>
+		constexpr FixedMatrix(const E& expr) : _data(uninitialized)
 		{
-			jlib::copy(other.data(), other.dataEnd(), data());
+			assign(expr);
+		}
+
+		// Evaluates a matrix expression into the FixedMatrix.
+		// Throws a std::invalid_argument if the dimensions do not match.
+		template <matrix_expression_node E>
+		constexpr FixedMatrix& operator = (const E& expr)
+		{
+			assign(expr);
+			return *this;
 		}
 
 		// 2-dimensional std::initializer_list assignment operator.
-		FixedMatrix& operator = (std::initializer_list<std::initializer_list<T>> list)
+		constexpr FixedMatrix& operator = (std::initializer_list<std::initializer_list<T>> list)
 		{
 			size_type row_i = 0;
 
@@ -103,6 +171,19 @@ export namespace jlib
 			return *this;
 		}
 
+		// Sets every element of the FixedMatrix to the corresponding
+		// element of a matrix expression. The expression may refer to
+		// this FixedMatrix, since element n only depends on element n.
+		// Throws a std::invalid_argument if the dimensions do not match.
+		template <matrix_expression E>
+		constexpr void assign(const E& expr)
+		{
+			if (expr.rowCount() != R || expr.colCount() != C)
+				throw std::invalid_argument("ERROR: Matrix dimensions do not match.");
+
+			_static_for<R * C>([&](std::size_t i) { _data[i] = static_cast<T>(expr[i]); });
+		}
+
 		// Returns the number of rows in the FixedMatrix.
 		constexpr size_type rowCount() const noexcept
 		{
@@ -170,21 +251,21 @@ export namespace jlib
 		// Returns nullptr if the FixedMatrix is empty.
 		constexpr reverse_iterator rbegin() noexcept
 		{
-			return std::reverse_iterator<iterator>(_data + R * C);
+			return _data.rbegin();
 		}
 
 		// Returns a reverse iterator pointing to the first element of the FixedMatrix.
 		// Returns nullptr if the FixedMatrix is empty.
 		constexpr const_reverse_iterator rbegin() const noexcept
 		{
-			return std::reverse_iterator<const_iterator>(_data + R * C);
+			return _data.crbegin();
 		}
 
 		// Returns a reverse iterator pointing to the first element of the FixedMatrix.
 		// Returns nullptr if the FixedMatrix is empty.
 		constexpr const_reverse_iterator crbegin() const noexcept
 		{
-			return std::reverse_iterator<const_iterator>(_data + R * C);
+			return _data.crbegin();
 		}
 
 		// Returns an iterator pointing to 1 past the last element of the FixedMatrix.
@@ -212,21 +293,21 @@ export namespace jlib
 		// Returns nullptr if the FixedMatrix is empty.
 		constexpr reverse_iterator rend() noexcept
 		{
-			return std::reverse_iterator<iterator>(_data);
+			return _data.rend();
 		}
 
 		// Returns a reverse iterator pointing to 1 past the last element of the FixedMatrix.
 		// Returns nullptr if the FixedMatrix is empty.
 		constexpr const_reverse_iterator rend() const noexcept
 		{
-			return std::reverse_iterator<const_iterator>(_data);
+			return _data.crend();
 		}
 
 		// Returns a reverse iterator pointing to 1 past the last element of the FixedMatrix.
 		// Returns nullptr if the FixedMatrix is empty.
 		constexpr const_reverse_iterator crend() const noexcept
 		{
-			return std::reverse_iterator<const_iterator>(_data);
+			return _data.crend();
 		}
 
 		// Returns an iterator pointing to the first element of the given row.
@@ -274,7 +355,19 @@ export namespace jlib
 		// Returns an iterator pointing to 1 past the last element of the given column.
 		const_column_iterator colEnd(size_type col) const noexcept
 		{
-			return column_iterator(_data.dataEnd() + col, C);
+			return const_column_iterator(_data.dataEnd() + col, C);
+		}
+
+		// Returns a non-owning view of the FixedMatrix.
+		constexpr MatrixView<T> view() noexcept
+		{
+			return MatrixView<T>(_data.data(), R, C);
+		}
+
+		// Returns a non-owning view of the FixedMatrix.
+		constexpr MatrixView<const T> view() const noexcept
+		{
+			return MatrixView<const T>(_data.data(), R, C);
 		}
 
 		// Returns the element at the given index of the FixedMatrix.
@@ -414,7 +507,7 @@ export namespace jlib
 
 			std::array<T, R> arr;
 
-			for (size_type row_i(0); row_i < C; ++row_i)
+			for (size_type row_i(0); row_i < R; ++row_i)
 				arr[row_i] = _data[(C * row_i) + col];
 
 			return arr;
@@ -424,17 +517,17 @@ export namespace jlib
 		template <size_type R2, size_type C2>
 		FixedMatrix<T, R2, C2> submatrix(size_type row_begin, size_type col_begin) const
 		{
-			if (row_begin >= R || row_begin + R2)
+			if (row_begin + R2 > R)
 				throw std::out_of_range("Invalid row index.");
-			if (col_begin >= C || col_begin + C >= C2)
+			if (col_begin + C2 > C)
 				throw std::out_of_range("Invalid column index.");
 
-			FixedMatrix<T, R2, C2> M;
+			FixedMatrix<T, R2, C2> M(uninitialized);
 
 			for (size_type row_i(0); row_i < R2; ++row_i)
 			{
 				for (size_type col_i(0); col_i < C2; ++col_i)
-					M._data[(row_i * C) + col_i] = _data[(row_i * C) + col_i];
+					M(row_i, col_i) = _data[((row_begin + row_i) * C) + col_begin + col_i];
 			}
 
 			return M;
@@ -497,21 +590,21 @@ export namespace jlib
 	// {  a,  b  }
 	// {  c,  d  }
 	template <arithmetic T>
-	inline T determinant(T a, T b, T c, T d)
+	constexpr T determinant(T a, T b, T c, T d)
 	{
 		return (a * d) - (b * c);
 	}
 
 	// Returns the determinant of the 2x2 FixedMatrix.
 	template <arithmetic T>
-	inline T determinant(const FixedMatrix<T, 2, 2>& M)
+	constexpr T determinant(const FixedMatrix<T, 2, 2>& M)
 	{
 		return (M(0, 0) * M(1, 1)) - (M(1, 0) * M(0, 1));
 	}
 
 	// Returns the determinant of the 3x3 FixedMatrix.
 	template <arithmetic T>
-	T determinant(const FixedMatrix<T, 3, 3>& M)
+	constexpr T determinant(const FixedMatrix<T, 3, 3>& M)
 	{
 		T A = M(0, 0) * determinant(M(1, 1), M(1, 2), M(2, 1), M(2, 2));
 		T B = M(0, 1) * determinant(M(1, 0), M(1, 2), M(2, 0), M(2, 2));
@@ -520,217 +613,372 @@ export namespace jlib
 		return A - B + C;
 	}
 
-	// Returns the determinant of the 4x4 FixedMatrix.
+	// Returns the 2x2 sub-determinants of the top two rows (s)
+	// and of the bottom two rows (c) of the 4x4 FixedMatrix.
+	// By the Laplace expansion theorem, the determinant and the
+	// inverse of M can both be written with these 12 values.
 	template <arithmetic T>
-	T determinant(const FixedMatrix<T, 4, 4>& M)
+	constexpr std::array<T, 12> _sub_determinants(const FixedMatrix<T, 4, 4>& M)
 	{
-		FixedMatrix<T, 3, 3> A =
-		{
-			{ M(1, 1), M(1, 2), M(1, 3) },
-			{ M(2, 1), M(2, 2), M(2, 3) },
-			{ M(3, 1), M(3, 2), M(3, 3) }
+		return
+		{
+			(M(0, 0) * M(1, 1)) - (M(1, 0) * M(0, 1)),
+			(M(0, 0) * M(1, 2)) - (M(1, 0) * M(0, 2)),
+			(M(0, 0) * M(1, 3)) - (M(1, 0) * M(0, 3)),
+			(M(0, 1) * M(1, 2)) - (M(1, 1) * M(0, 2)),
+			(M(0, 1) * M(1, 3)) - (M(1, 1) * M(0, 3)),
+			(M(0, 2) * M(1, 3)) - (M(1, 2) * M(0, 3)),
+			(M(2, 0) * M(3, 1)) - (M(3, 0) * M(2, 1)),
+			(M(2, 0) * M(3, 2)) - (M(3, 0) * M(2, 2)),
+			(M(2, 0) * M(3, 3)) - (M(3, 0) * M(2, 3)),
+			(M(2, 1) * M(3, 2)) - (M(3, 1) * M(2, 2)),
+			(M(2, 1) * M(3, 3)) - (M(3, 1) * M(2, 3)),
+			(M(2, 2) * M(3, 3)) - (M(3, 2) * M(2, 3))
 		};
+	}
+
+	// Returns the determinant of the 4x4 FixedMatrix.
+	// Uses the closed form from the 2x2 sub-determinants
+	// instead of 4 cofactor expansions, so there are no branches.
+	template <arithmetic T>
+	constexpr T determinant(const FixedMatrix<T, 4, 4>& M)
+	{
+		const auto [s0, s1, s2, s3, s4, s5, c0, c1, c2, c3, c4, c5] = _sub_determinants(M);
+
+		return (s0 * c5) - (s1 * c4) + (s2 * c3) + (s3 * c2) - (s4 * c1) + (s5 * c0);
+	}
 
-		FixedMatrix<T, 3, 3> B =
+	// Returns the inverse of the 2x2 FixedMatrix.
+	// If M is singular, the elements of the result are infinite or NaN.
+	template <std::floating_point T>
+	constexpr FixedMatrix<T, 2, 2> inverse(const FixedMatrix<T, 2, 2>& M)
+	{
+		T inv = T(1) / determinant(M);
+
+		return
 		{
-			{ M(1, 0), M(1, 2), M(1, 3) },
-			{ M(2, 0), M(2, 2), M(2, 3) },
-			{ M(3, 0), M(3, 2), M(3, 3) }
+			{  M(1, 1) * inv, -M(0, 1) * inv },
+			{ -M(1, 0) * inv,  M(0, 0) * inv }
 		};
+	}
+
+	// Returns the inverse of the 3x3 FixedMatrix,
+	// which is its adjugate divided by its determinant.
+	// If M is singular, the elements of the result are infinite or NaN.
+	template <std::floating_point T>
+	constexpr FixedMatrix<T, 3, 3> inverse(const FixedMatrix<T, 3, 3>& M)
+	{
+		T c00 = determinant(M(1, 1), M(1, 2), M(2, 1), M(2, 2));
+		T c01 = determinant(M(1, 2), M(1, 0), M(2, 2), M(2, 0));
+		T c02 = determinant(M(1, 0), M(1, 1), M(2, 0), M(2, 1));
+		T inv = T(1) / ((M(0, 0) * c00) + (M(0, 1) * c01) + (M(0, 2) * c02));
 
-		FixedMatrix<T, 3, 3> C =
+		return
 		{
-			{ M(1, 0), M(1, 1), M(1, 3) },
-			{ M(2, 0), M(2, 1), M(2, 3) },
-			{ M(3, 0), M(3, 1), M(3, 3) }
+			{ c00 * inv, determinant(M(0, 2), M(0, 1), M(2, 2), M(2, 1)) * inv, determinant(M(0, 1), M(0, 2), M(1, 1), M(1, 2)) * inv },
+			{ c01 * inv, determinant(M(0, 0), M(0, 2), M(2, 0), M(2, 2)) * inv, determinant(M(0, 2), M(0, 0), M(1, 2), M(1, 0)) * inv },
+			{ c02 * inv, determinant(M(0, 1), M(0, 0), M(2, 1), M(2, 0)) * inv, determinant(M(0, 0), M(0, 1), M(1, 0), M(1, 1)) * inv }
 		};
+	}
+
+	// Returns the inverse of the 4x4 FixedMatrix.
+	// The adjugate is built from the same 12 sub-determinants as
+	// the determinant, which takes about 100 multiplies and adds
+	// and a single division, with no branches or pivoting.
+	// If M is singular, the elements of the result are infinite or NaN.
+	template <std::floating_point T>
+	constexpr FixedMatrix<T, 4, 4> inverse(const FixedMatrix<T, 4, 4>& M)
+	{
+		const auto [s0, s1, s2, s3, s4, s5, c0, c1, c2, c3, c4, c5] = _sub_determinants(M);
+		T inv = T(1) / ((s0 * c5) - (s1 * c4) + (s2 * c3) + (s3 * c2) - (s4 * c1) + (s5 * c0));
 
-		FixedMatrix<T, 3, 3> D =
+		return
 		{
-			{ M(1, 0), M(1, 1), M(1, 2) },
-			{ M(2, 0), M(2, 1), M(2, 2) },
-			{ M(3, 0), M(3, 1), M(3, 2) }
+			{
+				( M(1, 1) * c5 - M(1, 2) * c4 + M(1, 3) * c3) * inv,
+				(-M(0, 1) * c5 + M(0, 2) * c4 - M(0, 3) * c3) * inv,
+				( M(3, 1) * s5 - M(3, 2) * s4 + M(3, 3) * s3) * inv,
+				(-M(2, 1) * s5 + M(2, 2) * s4 - M(2, 3) * s3) * inv
+			},
+			{
+				(-M(1, 0) * c5 + M(1, 2) * c2 - M(1, 3) * c1) * inv,
+				( M(0, 0) * c5 - M(0, 2) * c2 + M(0, 3) * c1) * inv,
+				(-M(3, 0) * s5 + M(3, 2) * s2 - M(3, 3) * s1) * inv,
+				( M(2, 0) * s5 - M(2, 2) * s2 + M(2, 3) * s1) * inv
+			},
+			{
+				( M(1, 0) * c4 - M(1, 1) * c2 + M(1, 3) * c0) * inv,
+				(-M(0, 0) * c4 + M(0, 1) * c2 - M(0, 3) * c0) * inv,
+				( M(3, 0) * s4 - M(3, 1) * s2 + M(3, 3) * s0) * inv,
+				(-M(2, 0) * s4 + M(2, 1) * s2 - M(2, 3) * s0) * inv
+			},
+			{
+				(-M(1, 0) * c3 + M(1, 1) * c1 - M(1, 2) * c0) * inv,
+				( M(0, 0) * c3 - M(0, 1) * c1 + M(0, 2) * c0) * inv,
+				(-M(3, 0) * s3 + M(3, 1) * s1 - M(3, 2) * s0) * inv,
+				( M(2, 0) * s3 - M(2, 1) * s1 + M(2, 2) * s0) * inv
+			}
 		};
-
-		return M(0, 0) * determinant(A) - M(0, 1) * determinant(B) + M(0, 2) * determinant(C) - M(0, 3) * determinant(D);
 	}
 
-	// Returns the dot product of the given Matrices.
-	template <arithmetic T, std::size_t R, std::size_t C, std::size_t S>
-	FixedMatrix<T, R, S> dot_product(const FixedMatrix<T, R, C>& A, const FixedMatrix<T, C, S>& B)
+	// Returns the solution x of A * x = b.
+	// Uses Gaussian elimination with partial pivoting on copies of A and b,
+	// which is more accurate than multiplying b by the inverse of A.
+	// Throws a std::domain_error if A is singular.
+	template <std::floating_point T, std::size_t N>
+	VectorN<T, N> solve(const FixedMatrix<T, N, N>& A, const VectorN<T, N>& b)
 	{
-		FixedMatrix<T, R, S> M;
-		T value;
+		FixedMatrix<T, N, N> M(A);
+		VectorN<T, N> x(b);
 
-		for (std::size_t r(0); r < R; ++r)
+		for (std::size_t k = 0; k < N; ++k)
 		{
-			std::array<T, C> row(A.getRow(r));
+			std::size_t p = k;
 
-			for (std::size_t s(0); s < S; ++s)
+			for (std::size_t i = k + 1; i < N; ++i)
 			{
-				value = 0;
-				std::array<R, C> col(B.getCol(s));
+				if (std::abs(M(i, k)) > std::abs(M(p, k)))
+					p = i;
+			}
 
-				for (std::size_t c(0); c < C; ++c)
-					value += row[c] * col[c];
+			if (M(p, k) == T(0))
+				throw std::domain_error("ERROR: Matrix is singular.");
 
-				M(r, s) = value;
+			if (p != k)
+			{
+				std::swap_ranges(M.data() + (k * N), M.data() + ((k + 1) * N), M.data() + (p * N));
+				std::swap(x[k], x[p]);
 			}
-		}
 
-		return M;
-	}
+			for (std::size_t i = k + 1; i < N; ++i)
+			{
+				T l = M(i, k) / M(k, k);
 
-	// Overload of binary operator == 
-	template <typename T, std::size_t R, std::size_t C>
-	bool operator == (const FixedMatrix<T, R, C>& A, const FixedMatrix<T, R, C>& B)
-	{
-		for (std::size_t i(0); i < R * C; ++i)
+				for (std::size_t j = k + 1; j < N; ++j)
+					M(i, j) -= l * M(k, j);
+
+				x[i] -= l * x[k];
+			}
+		}
+
+		for (std::size_t k = N; k-- > 0;)
 		{
-			if (A[i] != B[i])
-				return false;
+			for (std::size_t j = k + 1; j < N; ++j)
+				x[k] -= M(k, j) * x[j];
+
+			x[k] /= M(k, k);
 		}
 
-		return true;
+		return x;
 	}
 
-	// Overload of binary operator != 
-	template <typename T, std::size_t R, std::size_t C>
-	bool operator != (const FixedMatrix<T, R, C>& A, const FixedMatrix<T, R, C>& B)
+	// Returns the dot product of the given Matrices.
+	// The loops are unrolled at compile time.
+	template <arithmetic T, std::size_t R, std::size_t C, std::size_t S>
+	constexpr FixedMatrix<T, R, S> dot_product(const FixedMatrix<T, R, C>& A, const FixedMatrix<T, C, S>& B)
 	{
-		for (std::size_t i(0); i < R * C; ++i)
+		FixedMatrix<T, R, S> M(uninitialized);
+
+		_static_for<R * S>([&](std::size_t i)
 		{
-			if (A[i] != B[i])
-				return true;
-		}
+			std::size_t r = i / S;
+			std::size_t s = i % S;
+			T value = 0;
+
+			_static_for<C>([&](std::size_t c) { value += A(r, c) * B(c, s); });
 
-		return false;
+			M[i] = value;
+		});
+
+		return M;
 	}
 
-	// Overload of unary operator -
+	// Returns the vector v transformed by the FixedMatrix M,
+	// which is the product of M and the column vector v.
 	template <arithmetic T, std::size_t R, std::size_t C>
-	FixedMatrix<T, R, C> operator - (const FixedMatrix<T, R, C>& A)
+	VectorN<T, R> transform(const FixedMatrix<T, R, C>& M, const VectorN<T, C>& v)
 	{
-		FixedMatrix<T, R, C> M;
+		VectorN<T, R> result;
 
-		for (std::size_t row_i(0); row_i < R; ++row_i)
+		_static_for<R>([&](std::size_t r)
 		{
-			for (std::size_t col_i(0); col_i < C; ++col_i)
-				M(row_i, col_i) = A(row_i, col_i) * static_cast<T>(-1);
-		}
+			T value = 0;
 
-		return M;
+			_static_for<C>([&](std::size_t c) { value += M(r, c) * v[c]; });
+
+			result[r] = value;
+		});
+
+		return result;
 	}
 
-	// Overload of binary operator +
-	template <arithmetic T, std::size_t R, std::size_t C>
-	FixedMatrix<T, R, C> operator + (const FixedMatrix<T, R, C>& A, const FixedMatrix<T, R, C>& B)
+	// Returns the transpose of the FixedMatrix.
+	template <typename T, std::size_t R, std::size_t C>
+	constexpr FixedMatrix<T, C, R> transpose(const FixedMatrix<T, R, C>& A)
 	{
-		FixedMatrix<T, R, C> M;
+		FixedMatrix<T, C, R> M(uninitialized);
 
-		for (std::size_t row_i(0); row_i < R; ++row_i)
-		{
-			for (std::size_t col_i(0); col_i < C; ++col_i)
-				M(row_i, col_i) = A(row_i, col_i) + B(row_i, col_i);
-		}
+		_static_for<R * C>([&](std::size_t i) { M(i % C, i / C) = A[i]; });
 
 		return M;
 	}
 
-	// Overload of binary operator -
-	template <arithmetic T, std::size_t R, std::size_t C>
-	FixedMatrix<T, R, C> operator - (const FixedMatrix<T, R, C>& A, const FixedMatrix<T, R, C>& B)
+	#ifdef JLIB_SIMD_X86
+
+	// Returns the product of the 4x4 matrices.
+	// Every row of the result is the sum of the rows of B
+	// scaled by the elements of the same row of A,
+	// which takes 4 SSE multiplies and 3 SSE adds per row.
+	constexpr FixedMatrix<float, 4, 4> dot_product(const FixedMatrix<float, 4, 4>& A, const FixedMatrix<float, 4, 4>& B)
 	{
-		FixedMatrix<T, C, R> M;
+		if (std::is_constant_evaluated())
+			return dot_product<float, 4, 4, 4>(A, B);
+
+		FixedMatrix<float, 4, 4> M(uninitialized);
+
+		__m128 b0 = _mm_loadu_ps(B.data());
+		__m128 b1 = _mm_loadu_ps(B.data() + 4);
+		__m128 b2 = _mm_loadu_ps(B.data() + 8);
+		__m128 b3 = _mm_loadu_ps(B.data() + 12);
 
-		for (std::size_t row_i(0); row_i < R; ++row_i)
+		for (std::size_t r = 0; r < 4; ++r)
 		{
-			for (std::size_t col_i(0); col_i < C; ++col_i)
-				M(row_i, col_i) = A(row_i, col_i) - B(row_i, col_i);
+			const float* a = A.data() + (r * 4);
+
+			__m128 row = _mm_mul_ps(_mm_set1_ps(a[0]), b0);
+			row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[1]), b1));
+			row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[2]), b2));
+			row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[3]), b3));
+
+			_mm_storeu_ps(M.data() + (r * 4), row);
 		}
 
 		return M;
 	}
 
-	// Overload of binary operator *
-	template <arithmetic T, arithmetic U, std::size_t R, std::size_t C>
-	FixedMatrix<T, R, C> operator * (const FixedMatrix<T, R, C>& A, U scalar)
+	// Returns the vector v transformed by the 4x4 FixedMatrix M.
+	// The rows of M are multiplied by v, then transposed
+	// so the 4 dot products are finished with vertical adds.
+	inline VectorN<float, 4> transform(const FixedMatrix<float, 4, 4>& M, const VectorN<float, 4>& v)
 	{
-		FixedMatrix<T, C, R> M;
+		__m128 x = _mm_loadu_ps(v.data());
+		__m128 r0 = _mm_mul_ps(_mm_loadu_ps(M.data()), x);
+		__m128 r1 = _mm_mul_ps(_mm_loadu_ps(M.data() + 4), x);
+		__m128 r2 = _mm_mul_ps(_mm_loadu_ps(M.data() + 8), x);
+		__m128 r3 = _mm_mul_ps(_mm_loadu_ps(M.data() + 12), x);
 
-		for (std::size_t row_i(0); row_i < R; ++row_i)
-		{
-			for (std::size_t col_i(0); col_i < C; ++col_i)
-				M(row_i, col_i) = A(row_i, col_i) * scalar;
-		}
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
 
-		return M;
+		VectorN<float, 4> result;
+		_mm_storeu_ps(result.data(), _mm_add_ps(_mm_add_ps(r0, r1), _mm_add_ps(r2, r3)));
+		return result;
 	}
 
-	// Overload of binary operator /
-	template <arithmetic T, arithmetic U, std::size_t R, std::size_t C>
-	FixedMatrix<T, R, C> operator / (const FixedMatrix<T, R, C>& A, U scalar)
+	// Returns the transpose of the 4x4 FixedMatrix.
+	constexpr FixedMatrix<float, 4, 4> transpose(const FixedMatrix<float, 4, 4>& A)
 	{
-		FixedMatrix<T, C, R> M;
+		if (std::is_constant_evaluated())
+			return transpose<float, 4, 4>(A);
 
-		for (std::size_t row_i(0); row_i < R; ++row_i)
-		{
-			for (std::size_t col_i(0); col_i < C; ++col_i)
-				M(row_i, col_i) = A(row_i, col_i) / scalar;
-		}
+		__m128 r0 = _mm_loadu_ps(A.data());
+		__m128 r1 = _mm_loadu_ps(A.data() + 4);
+		__m128 r2 = _mm_loadu_ps(A.data() + 8);
+		__m128 r3 = _mm_loadu_ps(A.data() + 12);
 
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+		FixedMatrix<float, 4, 4> M(uninitialized);
+		_mm_storeu_ps(M.data(), r0);
+		_mm_storeu_ps(M.data() + 4, r1);
+		_mm_storeu_ps(M.data() + 8, r2);
+		_mm_storeu_ps(M.data() + 12, r3);
 		return M;
 	}
 
-	// Overload of binary operator +=
-	template <arithmetic T, std::size_t R, std::size_t C>
-	FixedMatrix<T, R, C>& operator += (FixedMatrix<T, R, C>& A, const FixedMatrix<T, R, C>& B)
+	#endif // JLIB_SIMD_X86
+
+	// Overload of binary operator == 
+	template <typename T, std::size_t R, std::size_t C>
+	constexpr bool operator == (const FixedMatrix<T, R, C>& A, const FixedMatrix<T, R, C>& B)
 	{
-		for (std::size_t row_i(0); row_i < R; ++row_i)
+		for (std::size_t i(0); i < R * C; ++i)
 		{
-			for (std::size_t col_i(0); col_i < C; ++col_i)
-				A(row_i, col_i) += B(row_i, col_i);
+			if (A[i] != B[i])
+				return false;
 		}
 
+		return true;
+	}
+
+	// Overload of binary operator != 
+	template <typename T, std::size_t R, std::size_t C>
+	constexpr bool operator != (const FixedMatrix<T, R, C>& A, const FixedMatrix<T, R, C>& B)
+	{
+		return !(A == B);
+	}
+
+	// Overload of binary operator *
+	// Returns the matrix product of A and B.
+	template <arithmetic T, std::size_t R, std::size_t C, std::size_t S>
+	constexpr FixedMatrix<T, R, S> operator * (const FixedMatrix<T, R, C>& A, const FixedMatrix<T, C, S>& B)
+	{
+		return dot_product(A, B);
+	}
+
+	// Overload of binary operator *
+	// Returns the vector v transformed by the FixedMatrix M.
+	template <arithmetic T, std::size_t R, std::size_t C>
+	VectorN<T, R> operator * (const FixedMatrix<T, R, C>& M, const VectorN<T, C>& v)
+	{
+		return transform(M, v);
+	}
+
+	// Overload of binary operator +=
+	// B may be a FixedMatrix or any matrix expression.
+	// Throws a std::invalid_argument if the dimensions do not match.
+	template <arithmetic T, std::size_t R, std::size_t C, matrix_expression E>
+	constexpr FixedMatrix<T, R, C>& operator += (FixedMatrix<T, R, C>& A, const E& B)
+	{
+		if (B.rowCount() != R || B.colCount() != C)
+			throw std::invalid_argument("ERROR: Matrix dimensions do not match.");
+
+		_static_for<R * C>([&](std::size_t i) { A[i] += B[i]; });
 		return A;
 	}
 
 	// Overload of binary operator -=
-	template <arithmetic T, std::size_t R, std::size_t C>
-	FixedMatrix<T, R, C>& operator -= (FixedMatrix<T, R, C>& A, const FixedMatrix<T, R, C>& B)
+	// B may be a FixedMatrix or any matrix expression.
+	// Throws a std::invalid_argument if the dimensions do not match.
+	template <arithmetic T, std::size_t R, std::size_t C, matrix_expression E>
+	constexpr FixedMatrix<T, R, C>& operator -= (FixedMatrix<T, R, C>& A, const E& B)
 	{
-		for (std::size_t row_i(0); row_i < R; ++row_i)
-		{
-			for (std::size_t col_i(0); col_i < C; ++col_i)
-				A(row_i, col_i) -= B(row_i, col_i);
-		}
+		if (B.rowCount() != R || B.colCount() != C)
+			throw std::invalid_argument("ERROR: Matrix dimensions do not match.");
 
+		_static_for<R * C>([&](std::size_t i) { A[i] -= B[i]; });
 		return A;
 	}
 
 	// Overload of binary operator *=
 	template <arithmetic T, arithmetic U, std::size_t R, std::size_t C>
-	FixedMatrix<T, R, C>& operator *= (FixedMatrix<T, R, C>& M, U scalar)
+	constexpr FixedMatrix<T, R, C>& operator *= (FixedMatrix<T, R, C>& M, U scalar)
 	{
-		for (std::size_t row_i(0); row_i < R; ++row_i)
-		{
-			for (std::size_t col_i(0); col_i < C; ++col_i)
-				M(row_i, col_i) *= scalar;
-		}
-
+		_static_for<R * C>([&](std::size_t i) { M[i] *= scalar; });
 		return M;
 	}
 
 	// Overload of binary operator /=
 	template <arithmetic T, arithmetic U, std::size_t R, std::size_t C>
-	FixedMatrix<T, R, C>& operator /= (FixedMatrix<T, R, C>& M, U scalar)
+	constexpr FixedMatrix<T, R, C>& operator /= (FixedMatrix<T, R, C>& M, U scalar)
 	{
-		for (std::size_t row_i(0); row_i < R; ++row_i)
-		{
-			for (std::size_t col_i(0); col_i < C; ++col_i)
-				M(row_i, col_i) /= scalar;
-		}
-
+		_static_for<R * C>([&](std::size_t i) { M[i] /= scalar; });
 		return M;
 	}
+}
+
+namespace jlib
+{
+	// FixedMatrix can be an operand of matrix expressions.
+	template <typename T, std::size_t R, std::size_t C>
+	constexpr bool enable_matrix_expression<FixedMatrix<T, R, C>> = true;
 }
\ No newline at end of file
@@ -0,0 +1,147 @@
+// JLibrary
+// FrameArena.cpp
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Source file for the FrameArena class.
+
+#include "FrameArena.hpp"
+
+#include <cstddef>
+using std::byte;
+using std::size_t;
+
+#include <memory>
+using std::align;
+
+#include <memory_resource>
+using std::pmr::memory_resource;
+
+namespace jlib
+{
+	void FrameArena::_addBlock(size_t min_size)
+	{
+		size_t size = min_size;
+
+		// Grow geometrically so a frame that keeps overflowing
+		// only adds a logarithmic number of blocks.
+		if (!_blocks.empty() && size < _blocks.back().size * 2)
+			size = _blocks.back().size * 2;
+
+		_blocks.reserve(_blocks.size() + 1);
+		byte* data = static_cast<byte*>(_upstream->allocate(size, block_alignment));
+		_blocks.push_back({ data, size });
+		_offset = 0;
+	}
+
+	void FrameArena::_releaseBlocks() noexcept
+	{
+		for (const Block& block : _blocks)
+			_upstream->deallocate(block.data, block.size, block_alignment);
+
+		_blocks.clear();
+		_offset = 0;
+	}
+
+	void* FrameArena::do_allocate(size_t bytes, size_t alignment)
+	{
+		if (bytes == 0)
+			bytes = 1;
+
+		if (!_blocks.empty())
+		{
+			Block& block = _blocks.back();
+			void* ptr = block.data + _offset;
+			size_t space = block.size - _offset;
+
+			if (align(alignment, bytes, ptr, space) != nullptr)
+			{
+				_offset = (static_cast<byte*>(ptr) - block.data) + bytes;
+				_used += bytes;
+				return ptr;
+			}
+		}
+
+		// Over-aligned requests may need padding at the start of the new block.
+		size_t padding = alignment > block_alignment ? alignment : 0;
+		_addBlock(bytes + padding);
+
+		Block& block = _blocks.back();
+		void* ptr = block.data;
+		size_t space = block.size;
+		align(alignment, bytes, ptr, space);
+		_offset = (static_cast<byte*>(ptr) - block.data) + bytes;
+		_used += bytes;
+		return ptr;
+	}
+
+	void FrameArena::do_deallocate(void*, size_t, size_t)
+	{
+
+	}
+
+	bool FrameArena::do_is_equal(const memory_resource& other) const noexcept
+	{
+		return this == &other;
+	}
+
+	FrameArena::FrameArena(size_t capacity, memory_resource* upstream)
+	{
+		_offset = 0;
+		_used = 0;
+		_peak = 0;
+		_upstream = upstream;
+
+		if (capacity != 0)
+			_addBlock(capacity);
+	}
+
+	FrameArena::~FrameArena() noexcept
+	{
+		_releaseBlocks();
+	}
+
+	void FrameArena::reset()
+	{
+		if (_used > _peak)
+			_peak = _used;
+
+		_used = 0;
+		_offset = 0;
+
+		if (_blocks.size() > 1)
+		{
+			size_t total = 0;
+
+			for (const Block& block : _blocks)
+				total += block.size;
+
+			_releaseBlocks();
+			_addBlock(total);
+		}
+	}
+
+	size_t FrameArena::capacity() const noexcept
+	{
+		size_t total = 0;
+
+		for (const Block& block : _blocks)
+			total += block.size;
+
+		return total;
+	}
+
+	size_t FrameArena::used() const noexcept
+	{
+		return _used;
+	}
+
+	size_t FrameArena::peak() const noexcept
+	{
+		return _used > _peak ? _used : _peak;
+	}
+
+	memory_resource* FrameArena::upstream() const noexcept
+	{
+		return _upstream;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+// JLibrary
+// FrameArena.hpp
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Header file for the FrameArena class.
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace jlib
+{
+	// Class that represents a bump-pointer memory arena meant to
+	// be reset once per frame. Allocating only moves a pointer forward
+	// and deallocating does nothing; every allocation is released at once
+	// by calling reset(). Containers use it through std::pmr, for example
+	// jlib::pmr::Array, jlib::pmr::Matrix or a Buffer given its address.
+	// 
+	// If a frame needs more memory than the arena holds, additional
+	// blocks are taken from the upstream resource. The next reset()
+	// merges them into a single block large enough for the whole frame,
+	// so steady-state frames never touch the upstream resource.
+	// 
+	// Nothing allocated from the arena may be used after reset() is called.
+	class FrameArena : public std::pmr::memory_resource
+	{
+		struct Block
+		{
+			std::byte* data;
+			std::size_t size;
+		};
+
+		std::vector<Block> _blocks;
+		std::size_t _offset;
+		std::size_t _used;
+		std::size_t _peak;
+		std::pmr::memory_resource* _upstream;
+
+		// Adds a block of at least min_size bytes from the upstream resource.
+		void _addBlock(std::size_t min_size);
+
+		// Returns every block to the upstream resource.
+		void _releaseBlocks() noexcept;
+
+		protected:
+
+		// Allocates bytes from the current block.
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+		// Does nothing, the memory is released by reset().
+		void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override;
+
+		// Returns true if other is this FrameArena.
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+		public:
+
+		// Alignment in bytes of the blocks allocated by a FrameArena.
+		static constexpr std::size_t block_alignment = 64;
+
+		// Capacity constructor.
+		// Allocates a block of capacity bytes from the upstream resource.
+		explicit FrameArena(std::size_t capacity, std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+		FrameArena(const FrameArena& other) = delete;
+
+		FrameArena& operator = (const FrameArena& other) = delete;
+
+		// Destructor.
+		~FrameArena() noexcept override;
+
+		// Releases every allocation made since the last reset.
+		// If the frame overflowed into several blocks, they are replaced
+		// with a single block large enough to hold all of them.
+		void reset();
+
+		// Returns the total size in bytes of the blocks owned by the arena.
+		std::size_t capacity() const noexcept;
+
+		// Returns the number of bytes handed out since the last reset.
+		std::size_t used() const noexcept;
+
+		// Returns the largest number of bytes handed out in a single frame.
+		std::size_t peak() const noexcept;
+
+		// Returns the upstream memory resource.
+		std::pmr::memory_resource* upstream() const noexcept;
+	};
+}
\ No newline at end of file
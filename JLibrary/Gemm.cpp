@@ -0,0 +1,421 @@
+// JLibrary
+// Gemm.cpp
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Source file defining the general matrix multiply functions.
+
+#include "Gemm.hpp"
+#include "Simd.hpp"
+
+#include <algorithm>
+using std::for_each;
+using std::min;
+
+#include <cstddef>
+using std::size_t;
+
+#include <execution>
+
+#include <new>
+using std::align_val_t;
+
+#include <numeric>
+using std::iota;
+
+#include <vector>
+using std::vector;
+
+namespace jlib
+{
+	namespace
+	{
+		// Block sizes of the multiply, in elements.
+		// A KC x NR panel of B stays in L1, an MC x KC block of A in L2
+		// and a KC x NC block of B in L3. MC is a multiple of MR and
+		// NC is a multiple of NR.
+		template <typename T> struct GemmBlocking;
+
+		template <> struct GemmBlocking<float>
+		{
+			static constexpr size_t MR = 6;
+			static constexpr size_t NR = 16;
+			static constexpr size_t MC = 96;
+			static constexpr size_t KC = 256;
+			static constexpr size_t NC = 2048;
+		};
+
+		template <> struct GemmBlocking<double>
+		{
+			static constexpr size_t MR = 6;
+			static constexpr size_t NR = 8;
+			static constexpr size_t MC = 96;
+			static constexpr size_t KC = 256;
+			static constexpr size_t NC = 2048;
+		};
+
+		// Products with fewer multiply-adds than this run on one thread.
+		constexpr double parallel_threshold = 2097152.0;
+
+		// 64-byte aligned scratch memory for the packed blocks.
+		template <typename T>
+		class PackBuffer
+		{
+			T* _data;
+
+			public:
+
+			explicit PackBuffer(size_t size)
+				: _data(static_cast<T*>(::operator new(size * sizeof(T), align_val_t(64))))
+			{
+
+			}
+
+			PackBuffer(const PackBuffer&) = delete;
+			PackBuffer& operator = (const PackBuffer&) = delete;
+
+			~PackBuffer()
+			{
+				::operator delete(_data, align_val_t(64));
+			}
+
+			T* data() noexcept
+			{
+				return _data;
+			}
+		};
+
+		// Copies the mc x kc block of A starting at ptr into panels of MR rows.
+		// Every panel stores its kc columns one after another, so the kernel
+		// reads it sequentially. Rows past mc are filled with 0.
+		template <typename T, size_t MR>
+		void pack_A(size_t mc, size_t kc, const T* ptr, size_t lda, T* dest) noexcept
+		{
+			for (size_t ir = 0; ir < mc; ir += MR)
+			{
+				size_t rows = min(MR, mc - ir);
+
+				for (size_t i = 0; i < MR; ++i)
+				{
+					if (i < rows)
+					{
+						const T* row = ptr + ((ir + i) * lda);
+
+						for (size_t p = 0; p < kc; ++p)
+							dest[(p * MR) + i] = row[p];
+					}
+					else
+					{
+						for (size_t p = 0; p < kc; ++p)
+							dest[(p * MR) + i] = T(0);
+					}
+				}
+
+				dest += MR * kc;
+			}
+		}
+
+		// Copies the kc x nc block of B starting at ptr into panels of NR columns.
+		// Every panel stores its kc rows one after another. Columns past nc are filled with 0.
+		template <typename T, size_t NR>
+		void pack_B(size_t kc, size_t nc, const T* ptr, size_t ldb, T* dest) noexcept
+		{
+			for (size_t jr = 0; jr < nc; jr += NR)
+			{
+				size_t cols = min(NR, nc - jr);
+
+				for (size_t p = 0; p < kc; ++p)
+				{
+					const T* row = ptr + (p * ldb) + jr;
+					size_t j = 0;
+
+					for (; j < cols; ++j)
+						dest[j] = row[j];
+					for (; j < NR; ++j)
+						dest[j] = T(0);
+
+					dest += NR;
+				}
+			}
+		}
+
+		// Computes the MR x NR product of a packed panel of A and
+		// a packed panel of B into ab, stored row by row.
+		template <typename T, size_t MR, size_t NR>
+		void scalar_kernel(size_t kc, const T* a, const T* b, T* ab) noexcept
+		{
+			for (size_t i = 0; i < MR * NR; ++i)
+				ab[i] = T(0);
+
+			for (size_t p = 0; p < kc; ++p)
+			{
+				for (size_t i = 0; i < MR; ++i)
+				{
+					for (size_t j = 0; j < NR; ++j)
+						ab[(i * NR) + j] += a[i] * b[j];
+				}
+
+				a += MR;
+				b += NR;
+			}
+		}
+
+		#ifdef JLIB_SIMD_X86
+
+		// 6 x 16 float kernel. The tile lives in 12 of the 16 ymm registers.
+		JLIB_TARGET_AVX2 void avx2_kernel(size_t kc, const float* a, const float* b, float* ab) noexcept
+		{
+			__m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+			__m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+			__m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+			__m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+			__m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+			__m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+
+			for (size_t p = 0; p < kc; ++p)
+			{
+				__m256 b0 = _mm256_load_ps(b);
+				__m256 b1 = _mm256_load_ps(b + 8);
+				__m256 ai;
+
+				ai = _mm256_broadcast_ss(a);
+				c00 = _mm256_fmadd_ps(ai, b0, c00);
+				c01 = _mm256_fmadd_ps(ai, b1, c01);
+				ai = _mm256_broadcast_ss(a + 1);
+				c10 = _mm256_fmadd_ps(ai, b0, c10);
+				c11 = _mm256_fmadd_ps(ai, b1, c11);
+				ai = _mm256_broadcast_ss(a + 2);
+				c20 = _mm256_fmadd_ps(ai, b0, c20);
+				c21 = _mm256_fmadd_ps(ai, b1, c21);
+				ai = _mm256_broadcast_ss(a + 3);
+				c30 = _mm256_fmadd_ps(ai, b0, c30);
+				c31 = _mm256_fmadd_ps(ai, b1, c31);
+				ai = _mm256_broadcast_ss(a + 4);
+				c40 = _mm256_fmadd_ps(ai, b0, c40);
+				c41 = _mm256_fmadd_ps(ai, b1, c41);
+				ai = _mm256_broadcast_ss(a + 5);
+				c50 = _mm256_fmadd_ps(ai, b0, c50);
+				c51 = _mm256_fmadd_ps(ai, b1, c51);
+
+				a += 6;
+				b += 16;
+			}
+
+			_mm256_store_ps(ab, c00);
+			_mm256_store_ps(ab + 8, c01);
+			_mm256_store_ps(ab + 16, c10);
+			_mm256_store_ps(ab + 24, c11);
+			_mm256_store_ps(ab + 32, c20);
+			_mm256_store_ps(ab + 40, c21);
+			_mm256_store_ps(ab + 48, c30);
+			_mm256_store_ps(ab + 56, c31);
+			_mm256_store_ps(ab + 64, c40);
+			_mm256_store_ps(ab + 72, c41);
+			_mm256_store_ps(ab + 80, c50);
+			_mm256_store_ps(ab + 88, c51);
+		}
+
+		// 6 x 8 double kernel. The tile lives in 12 of the 16 ymm registers.
+		JLIB_TARGET_AVX2 void avx2_kernel(size_t kc, const double* a, const double* b, double* ab) noexcept
+		{
+			__m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+			__m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+			__m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+			__m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+			__m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+			__m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+
+			for (size_t p = 0; p < kc; ++p)
+			{
+				__m256d b0 = _mm256_load_pd(b);
+				__m256d b1 = _mm256_load_pd(b + 4);
+				__m256d ai;
+
+				ai = _mm256_broadcast_sd(a);
+				c00 = _mm256_fmadd_pd(ai, b0, c00);
+				c01 = _mm256_fmadd_pd(ai, b1, c01);
+				ai = _mm256_broadcast_sd(a + 1);
+				c10 = _mm256_fmadd_pd(ai, b0, c10);
+				c11 = _mm256_fmadd_pd(ai, b1, c11);
+				ai = _mm256_broadcast_sd(a + 2);
+				c20 = _mm256_fmadd_pd(ai, b0, c20);
+				c21 = _mm256_fmadd_pd(ai, b1, c21);
+				ai = _mm256_broadcast_sd(a + 3);
+				c30 = _mm256_fmadd_pd(ai, b0, c30);
+				c31 = _mm256_fmadd_pd(ai, b1, c31);
+				ai = _mm256_broadcast_sd(a + 4);
+				c40 = _mm256_fmadd_pd(ai, b0, c40);
+				c41 = _mm256_fmadd_pd(ai, b1, c41);
+				ai = _mm256_broadcast_sd(a + 5);
+				c50 = _mm256_fmadd_pd(ai, b0, c50);
+				c51 = _mm256_fmadd_pd(ai, b1, c51);
+
+				a += 6;
+				b += 8;
+			}
+
+			_mm256_store_pd(ab, c00);
+			_mm256_store_pd(ab + 4, c01);
+			_mm256_store_pd(ab + 8, c10);
+			_mm256_store_pd(ab + 12, c11);
+			_mm256_store_pd(ab + 16, c20);
+			_mm256_store_pd(ab + 20, c21);
+			_mm256_store_pd(ab + 24, c30);
+			_mm256_store_pd(ab + 28, c31);
+			_mm256_store_pd(ab + 32, c40);
+			_mm256_store_pd(ab + 36, c41);
+			_mm256_store_pd(ab + 40, c50);
+			_mm256_store_pd(ab + 44, c51);
+		}
+
+		#endif // JLIB_SIMD_X86
+
+		// Writes alpha * ab + beta * C into the rows x cols tile of C at ptr.
+		// C is not read if beta is 0.
+		template <typename T, size_t NR>
+		void update_tile(size_t rows, size_t cols, T alpha, const T* ab, T beta, T* ptr, size_t ldc) noexcept
+		{
+			for (size_t i = 0; i < rows; ++i)
+			{
+				T* row = ptr + (i * ldc);
+				const T* src = ab + (i * NR);
+
+				if (beta == T(0))
+				{
+					for (size_t j = 0; j < cols; ++j)
+						row[j] = alpha * src[j];
+				}
+				else
+				{
+					for (size_t j = 0; j < cols; ++j)
+						row[j] = (alpha * src[j]) + (beta * row[j]);
+				}
+			}
+		}
+
+		// Multiplies C by beta, or sets it to 0 if beta is 0.
+		template <typename T>
+		void scale(size_t m, size_t n, T beta, T* C, size_t ldc) noexcept
+		{
+			for (size_t i = 0; i < m; ++i)
+			{
+				T* row = C + (i * ldc);
+
+				for (size_t j = 0; j < n; ++j)
+					row[j] = (beta == T(0)) ? T(0) : beta * row[j];
+			}
+		}
+
+		// Blocked multiply following the loop structure of BLIS:
+		// the columns of C are split into NC blocks, the inner dimension into
+		// KC blocks and the rows of C into MC blocks. Each KC x NC block of B
+		// is packed once and shared, each MC x KC block of A is packed by the
+		// thread that multiplies it.
+		template <typename T, typename Kernel>
+		void gemm_blocked(size_t m, size_t n, size_t k, T alpha, const T* A, size_t lda,
+						  const T* B, size_t ldb, T beta, T* C, size_t ldc, bool parallel, Kernel kernel)
+		{
+			using Blocking = GemmBlocking<T>;
+			constexpr size_t MR = Blocking::MR;
+			constexpr size_t NR = Blocking::NR;
+			constexpr size_t MC = Blocking::MC;
+			constexpr size_t KC = Blocking::KC;
+			constexpr size_t NC = Blocking::NC;
+
+			if (m == 0 || n == 0)
+				return;
+
+			if (k == 0 || alpha == T(0))
+			{
+				scale(m, n, beta, C, ldc);
+				return;
+			}
+
+			size_t row_blocks = (m + MC - 1) / MC;
+			bool threaded = parallel && row_blocks > 1 && double(m) * double(n) * double(k) >= parallel_threshold;
+
+			vector<size_t> blocks(row_blocks);
+			iota(blocks.begin(), blocks.end(), size_t(0));
+
+			PackBuffer<T> packed_B(KC * ((min(n, NC) + NR - 1) / NR) * NR);
+
+			// Every row block packs A into its own slice when the blocks run
+			// in parallel, and into the same slice otherwise. The buffer is
+			// allocated once and reused for every jc and pc iteration.
+			PackBuffer<T> packed_A((threaded ? row_blocks : 1) * MC * KC);
+
+			for (size_t jc = 0; jc < n; jc += NC)
+			{
+				size_t nc = min(NC, n - jc);
+
+				for (size_t pc = 0; pc < k; pc += KC)
+				{
+					size_t kc = min(KC, k - pc);
+					T block_beta = (pc == 0) ? beta : T(1);
+
+					pack_B<T, NR>(kc, nc, B + (pc * ldb) + jc, ldb, packed_B.data());
+
+					auto multiply_block = [&](size_t block)
+					{
+						size_t ic = block * MC;
+						size_t mc = min(MC, m - ic);
+
+						T* block_A = packed_A.data() + (threaded ? block : 0) * MC * KC;
+						alignas(64) T ab[MR * NR];
+
+						pack_A<T, MR>(mc, kc, A + (ic * lda) + pc, lda, block_A);
+
+						for (size_t jr = 0; jr < nc; jr += NR)
+						{
+							for (size_t ir = 0; ir < mc; ir += MR)
+							{
+								kernel(kc, block_A + (ir * kc), packed_B.data() + (jr * kc), ab);
+								update_tile<T, NR>(min(MR, mc - ir), min(NR, nc - jr), alpha, ab, block_beta,
+												   C + ((ic + ir) * ldc) + jc + jr, ldc);
+							}
+						}
+					};
+
+					if (threaded)
+						for_each(std::execution::par, blocks.begin(), blocks.end(), multiply_block);
+					else
+						for_each(blocks.begin(), blocks.end(), multiply_block);
+				}
+			}
+		}
+
+		template <typename T>
+		void gemm_dispatch(size_t m, size_t n, size_t k, T alpha, const T* A, size_t lda,
+						   const T* B, size_t ldb, T beta, T* C, size_t ldc, bool parallel)
+		{
+			using Blocking = GemmBlocking<T>;
+
+			#ifdef JLIB_SIMD_X86
+			if (simd::cpu_features().avx2 && simd::cpu_features().fma)
+			{
+				gemm_blocked(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, parallel,
+					[](size_t kc, const T* a, const T* b, T* ab) { avx2_kernel(kc, a, b, ab); });
+				return;
+			}
+			#endif // JLIB_SIMD_X86
+
+			gemm_blocked(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, parallel,
+				scalar_kernel<T, Blocking::MR, Blocking::NR>);
+		}
+	}
+
+	void gemm(size_t m, size_t n, size_t k,
+			  float alpha, const float* A, size_t lda,
+			  const float* B, size_t ldb,
+			  float beta, float* C, size_t ldc, bool parallel)
+	{
+		gemm_dispatch(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, parallel);
+	}
+
+	void gemm(size_t m, size_t n, size_t k,
+			  double alpha, const double* A, size_t lda,
+			  const double* B, size_t ldb,
+			  double beta, double* C, size_t ldc, bool parallel)
+	{
+		gemm_dispatch(m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, parallel);
+	}
+}
\ No newline at end of file
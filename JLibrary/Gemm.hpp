@@ -0,0 +1,40 @@
+// JLibrary
+// Gemm.hpp
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Header file declaring the general matrix multiply functions.
+
+#pragma once
+
+#include <cstddef>
+
+namespace jlib
+{
+	// Computes C = alpha * A * B + beta * C, where A is an m x k matrix,
+	// B is a k x n matrix and C is an m x n matrix, all stored row by row.
+	// lda, ldb and ldc are the distances between the rows of each matrix.
+	// If beta is 0, C is not read, so it may hold uninitialized values.
+	// C must not overlap A or B.
+	//
+	// The product is computed in cache-sized blocks from packed copies of
+	// A and B, using an AVX2/FMA kernel when the CPU supports it.
+	// If parallel is true, large products are split across threads.
+	void gemm(std::size_t m, std::size_t n, std::size_t k,
+			  float alpha, const float* A, std::size_t lda,
+			  const float* B, std::size_t ldb,
+			  float beta, float* C, std::size_t ldc, bool parallel = true);
+
+	// Computes C = alpha * A * B + beta * C, where A is an m x k matrix,
+	// B is a k x n matrix and C is an m x n matrix, all stored row by row.
+	// lda, ldb and ldc are the distances between the rows of each matrix.
+	// If beta is 0, C is not read, so it may hold uninitialized values.
+	// C must not overlap A or B.
+	//
+	// The product is computed in cache-sized blocks from packed copies of
+	// A and B, using an AVX2/FMA kernel when the CPU supports it.
+	// If parallel is true, large products are split across threads.
+	void gemm(std::size_t m, std::size_t n, std::size_t k,
+			  double alpha, const double* A, std::size_t lda,
+			  const double* B, std::size_t ldb,
+			  double beta, double* C, std::size_t ldc, bool parallel = true);
+}
\ No newline at end of file
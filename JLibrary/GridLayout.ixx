@@ -0,0 +1,207 @@
+// JLibrary
+// GridLayout.ixx
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Module file for the memory layouts of the FixedGrid class.
+
+module;
+
+#include "Simd.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+export module GridLayout;
+
+import Vector3;
+
+namespace jlib
+{
+	// Bits 0, 3, 6, ... of a Morton code, which hold the bits of x.
+	inline constexpr std::uint64_t _morton_mask = 0x1249249249249249;
+
+	// Moves bit i of the low 21 bits of v to bit 3i.
+	constexpr std::uint64_t _spread_bits3(std::uint64_t v) noexcept
+	{
+		v &= 0x1fffff;
+		v = (v | (v << 32)) & 0x1f00000000ffff;
+		v = (v | (v << 16)) & 0x1f0000ff0000ff;
+		v = (v | (v << 8)) & 0x100f00f00f00f00f;
+		v = (v | (v << 4)) & 0x10c30c30c30c30c3;
+		v = (v | (v << 2)) & _morton_mask;
+		return v;
+	}
+
+	// Moves bit 3i of v to bit i, which undoes _spread_bits3.
+	constexpr std::uint64_t _compact_bits3(std::uint64_t v) noexcept
+	{
+		v &= _morton_mask;
+		v = (v ^ (v >> 2)) & 0x10c30c30c30c30c3;
+		v = (v ^ (v >> 4)) & 0x100f00f00f00f00f;
+		v = (v ^ (v >> 8)) & 0x1f0000ff0000ff;
+		v = (v ^ (v >> 16)) & 0x1f00000000ffff;
+		v = (v ^ (v >> 32)) & 0x1fffff;
+		return v;
+	}
+}
+
+export namespace jlib
+{
+	// A layout maps the coordinates (x, y, z) of a width x height x length
+	// grid to the index of the element in memory. Every layout provides:
+	//
+	// storageSize(w, h, l): the number of elements the layout needs,
+	// which may be more than w * h * l if it pads the grid.
+	// index(x, y, z, w, h, l): the index of the element at (x, y, z).
+	// coordinates(n, w, h, l): the coordinates of the element at index n.
+
+	// Stores the elements row by row, then layer by layer,
+	// so the index is (z * h * w) + (y * w) + x.
+	struct LinearLayout
+	{
+		static constexpr std::size_t storageSize(std::size_t w, std::size_t h, std::size_t l) noexcept
+		{
+			return w * h * l;
+		}
+
+		static constexpr std::size_t index(std::size_t x, std::size_t y, std::size_t z,
+										   std::size_t w, std::size_t h, std::size_t) noexcept
+		{
+			return (z * w * h) + (y * w) + x;
+		}
+
+		static Vector3<std::size_t> coordinates(std::size_t n, std::size_t w, std::size_t h, std::size_t) noexcept
+		{
+			return Vector3<std::size_t>(n % w, (n / w) % h, n / (w * h));
+		}
+	};
+
+	// Stores the elements along a Z-order curve, whose index interleaves
+	// the bits of x, y and z. Elements that are close in all 3 dimensions
+	// are close in memory, so a neighborhood touches few cache lines.
+	//
+	// Only the bits that all 3 coordinates have are interleaved. The grid is
+	// split into cubes whose side is the largest power of 2 that fits in its
+	// smallest dimension. Each cube is stored along the Z-order curve, and
+	// the cubes are laid out linearly. A grid whose dimensions are the same
+	// power of 2 is a single cube. Every dimension is padded by less than
+	// the side of a cube, so the storage is less than 8 * w * h * l and is
+	// exactly w * h * l when the dimensions are multiples of the side.
+	// For example FixedGrid<float, 2, 1024, 2, MortonLayout> stores 4096
+	// elements, where interleaving every bit would need over 300 million.
+	// The Morton codes are computed with pdep and pext if BMI2 is enabled.
+	struct MortonLayout
+	{
+		// Returns the Morton code of (x, y, z).
+		static constexpr std::uint64_t encode(std::uint64_t x, std::uint64_t y, std::uint64_t z) noexcept
+		{
+			#ifdef JLIB_SIMD_BMI2
+			if (!std::is_constant_evaluated())
+				return _pdep_u64(x, _morton_mask) | _pdep_u64(y, _morton_mask << 1) | _pdep_u64(z, _morton_mask << 2);
+			#endif
+
+			return _spread_bits3(x) | (_spread_bits3(y) << 1) | (_spread_bits3(z) << 2);
+		}
+
+		// Returns the coordinates of the Morton code.
+		static Vector3<std::size_t> decode(std::uint64_t code) noexcept
+		{
+			#ifdef JLIB_SIMD_BMI2
+			return Vector3<std::size_t>(_pext_u64(code, _morton_mask), _pext_u64(code, _morton_mask << 1), _pext_u64(code, _morton_mask << 2));
+			#else
+			return Vector3<std::size_t>(_compact_bits3(code), _compact_bits3(code >> 1), _compact_bits3(code >> 2));
+			#endif
+		}
+
+		// Returns log2 of the side of the cubes of a w x h x l grid.
+		static constexpr std::size_t cubeShift(std::size_t w, std::size_t h, std::size_t l) noexcept
+		{
+			const std::size_t smallest = std::min({ w, h, l });
+
+			if (smallest == 0)
+				return 0;
+
+			return std::min(static_cast<std::size_t>(std::bit_width(smallest)) - 1, std::size_t(21));
+		}
+
+		static constexpr std::size_t storageSize(std::size_t w, std::size_t h, std::size_t l) noexcept
+		{
+			const std::size_t shift = cubeShift(w, h, l);
+			const std::size_t mask = (std::size_t(1) << shift) - 1;
+
+			return (((w + mask) >> shift) * ((h + mask) >> shift) * ((l + mask) >> shift)) << (3 * shift);
+		}
+
+		static constexpr std::size_t index(std::size_t x, std::size_t y, std::size_t z,
+										   std::size_t w, std::size_t h, std::size_t l) noexcept
+		{
+			const std::size_t shift = cubeShift(w, h, l);
+			const std::size_t mask = (std::size_t(1) << shift) - 1;
+			const std::size_t cubes_x = (w + mask) >> shift;
+			const std::size_t cubes_y = (h + mask) >> shift;
+			const std::size_t cube = ((((z >> shift) * cubes_y) + (y >> shift)) * cubes_x) + (x >> shift);
+
+			return (cube << (3 * shift)) | static_cast<std::size_t>(encode(x & mask, y & mask, z & mask));
+		}
+
+		static Vector3<std::size_t> coordinates(std::size_t n, std::size_t w, std::size_t h, std::size_t l) noexcept
+		{
+			const std::size_t shift = cubeShift(w, h, l);
+			const std::size_t mask = (std::size_t(1) << shift) - 1;
+			const std::size_t cubes_x = (w + mask) >> shift;
+			const std::size_t cubes_y = (h + mask) >> shift;
+			const std::size_t cube = n >> (3 * shift);
+			const Vector3<std::size_t> inner = decode(n & ((std::size_t(1) << (3 * shift)) - 1));
+
+			return Vector3<std::size_t>(((cube % cubes_x) << shift) + inner.x,
+										(((cube / cubes_x) % cubes_y) << shift) + inner.y,
+										((cube / (cubes_x * cubes_y)) << shift) + inner.z);
+		}
+	};
+
+	// Stores the elements in B x B x B bricks, which are stored linearly
+	// inside and laid out linearly themselves. A neighborhood that does not
+	// cross a brick boundary stays inside B * B * B * sizeof(T) bytes.
+	// B must be a power of 2, and the grid is padded to whole bricks.
+	template <std::size_t B = 8> struct BrickLayout
+	{
+		static_assert(std::has_single_bit(B), "The brick size must be a power of 2.");
+
+		// log2(B).
+		static constexpr std::size_t shift = static_cast<std::size_t>(std::countr_zero(B));
+
+		// Number of elements in a brick.
+		static constexpr std::size_t brickSize = B * B * B;
+
+		static constexpr std::size_t storageSize(std::size_t w, std::size_t h, std::size_t l) noexcept
+		{
+			return ((w + B - 1) >> shift) * ((h + B - 1) >> shift) * ((l + B - 1) >> shift) * brickSize;
+		}
+
+		static constexpr std::size_t index(std::size_t x, std::size_t y, std::size_t z,
+										   std::size_t w, std::size_t h, std::size_t) noexcept
+		{
+			const std::size_t bricks_x = (w + B - 1) >> shift;
+			const std::size_t bricks_y = (h + B - 1) >> shift;
+			const std::size_t brick = ((((z >> shift) * bricks_y) + (y >> shift)) * bricks_x) + (x >> shift);
+			const std::size_t inner = ((((z & (B - 1)) << shift) + (y & (B - 1))) << shift) + (x & (B - 1));
+
+			return (brick * brickSize) + inner;
+		}
+
+		static Vector3<std::size_t> coordinates(std::size_t n, std::size_t w, std::size_t h, std::size_t) noexcept
+		{
+			const std::size_t bricks_x = (w + B - 1) >> shift;
+			const std::size_t bricks_y = (h + B - 1) >> shift;
+			const std::size_t brick = n / brickSize;
+			const std::size_t inner = n % brickSize;
+
+			return Vector3<std::size_t>(((brick % bricks_x) << shift) + (inner & (B - 1)),
+										(((brick / bricks_x) % bricks_y) << shift) + ((inner >> shift) & (B - 1)),
+										((brick / (bricks_x * bricks_y)) << shift) + (inner >> (2 * shift)));
+		}
+	};
+}
\ No newline at end of file
@@ -1,7 +1,7 @@
 // JLibrary
 // JLibrary.hpp
 // Created on 2021-08-06 by Justyn Durnford
-// Last modified on 2022-05-18 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
 // Header file that includes/imports all of the JLibrary.
 
 #pragma once
@@ -14,36 +14,57 @@
 #include "Constants.hpp"
 #include "Conversions.hpp"
 #include "Direction.hpp"
+#include "FrameArena.hpp"
+#include "Gemm.hpp"
 #include "Gamepad.hpp"
 #include "Hexadecimal.hpp"
 #include "IntegerTypedefs.hpp"
 #include "Mouse.hpp"
+#include "Simd.hpp"
 #include "String.hpp"
 #include "Time.hpp"
+#include "Uninitialized.hpp"
 
 import Array;
+import BitMatrix;
+import BroadPhase;
 import Box;
+import Bvh;
+import ChunkedGrid;
 import Circle;
+import ColumnIterator;
 import ComplexNumber;
 import Equation;
 import FixedArray;
+import FixedGrid;
 import FixedMatrix;
 import Fraction;
+import GridLayout;
+import KdTree;
 import LinearEquation1;
 import LinearEquation2;
 import LinearEquation3;
 import LineSegment;
 import Matrix;
+import MatrixDecomposition;
+import MatrixExpression;
+import MatrixView;
 import MiscTemplateFunctions;
 import Plane;
+import PointQueries;
 import Polynomial;
 import Ptr;
 import Rect;
+import SmallArray;
+import SparseMatrix;
+import Stencil;
 import SFML_JLIB;
+import SimdVector;
 import Sphere;
 import Square;
 import Triangle;
 import Vector2;
 import Vector3;
+import VectorArray;
 import VectorEquation3;
 import VectorN;
\ No newline at end of file
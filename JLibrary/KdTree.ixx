@@ -0,0 +1,483 @@
+// JLibrary
+// KdTree.ixx
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Module file for the KdTree template class.
+
+module;
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <execution>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+export module KdTree;
+
+import Vector3;
+import VectorN;
+
+namespace jlib
+{
+	// Node of a KdTree. The nodes are stored in preorder, so the left child
+	// of a node directly follows it. Leaves have a right child of 0.
+	// The points of a node are [begin, end) in the order of the tree.
+	template <typename T>
+	struct _KdNode
+	{
+		T split;
+		std::size_t axis;
+		std::size_t begin;
+		std::size_t end;
+		std::size_t right;
+	};
+
+	// Batches of fewer queries than this run on a single thread.
+	inline constexpr std::size_t _parallel_kd_queries = 64;
+}
+
+export namespace jlib
+{
+	// Utility template class for finding the nearest points to a query
+	// among a fixed set of N-dimensional points.
+	//
+	// The points are split at the median of their widest dimension until
+	// at most leafSize points are left, and then stored in the order of
+	// the tree. Queries visit the closer side of every split first and
+	// skip the other side if it is too far away to hold a closer point.
+	//
+	// Setting epsilon above 0 turns on approximate searches. The k-th
+	// point returned is then at most (1 + epsilon) times as far away as
+	// the true k-th nearest point, but far fewer points are visited.
+	template <std::floating_point T, std::size_t N> class KdTree
+	{
+		public:
+
+		using point_type = VectorN<T, N>;
+		using size_type = std::size_t;
+
+		// A point found by a query.
+		struct Neighbor
+		{
+			// The index of the point in the points the KdTree was built from.
+			size_type index;
+
+			// The distance squared between the point and the query.
+			T distanceSquared;
+
+			// Overload of binary operator <
+			// Orders Neighbors by their distance.
+			friend bool operator < (const Neighbor& A, const Neighbor& B) noexcept
+			{
+				return A.distanceSquared < B.distanceSquared;
+			}
+		};
+
+		private:
+
+		std::vector<point_type> _points;
+		std::vector<size_type> _indices;
+		std::vector<_KdNode<T>> _nodes;
+		size_type _leafSize;
+		T _epsilon;
+
+		// Converts a Vector3 into a point.
+		static point_type toPoint(const Vector3<T>& vec) requires (N == 3)
+		{
+			return point_type{ vec.x, vec.y, vec.z };
+		}
+
+		// Converts an array of Vector3s into points.
+		static std::vector<point_type> toPoints(std::span<const Vector3<T>> vecs) requires (N == 3)
+		{
+			std::vector<point_type> points;
+			points.reserve(vecs.size());
+
+			for (const Vector3<T>& vec : vecs)
+				points.push_back(toPoint(vec));
+
+			return points;
+		}
+
+		// Builds the subtree over _indices[begin, end).
+		void buildNode(std::span<const point_type> points, size_type begin, size_type end)
+		{
+			const size_type node = _nodes.size();
+			_nodes.push_back(_KdNode<T>{ T(0), 0, begin, end, 0 });
+
+			if (end - begin <= _leafSize)
+				return;
+
+			point_type lo(points[_indices[begin]]);
+			point_type hi(lo);
+
+			for (size_type i = begin + 1; i < end; ++i)
+			{
+				const point_type& point = points[_indices[i]];
+
+				for (size_type d = 0; d < N; ++d)
+				{
+					lo[d] = std::min(lo[d], point[d]);
+					hi[d] = std::max(hi[d], point[d]);
+				}
+			}
+
+			size_type axis = 0;
+
+			for (size_type d = 1; d < N; ++d)
+			{
+				if (hi[d] - lo[d] > hi[axis] - lo[axis])
+					axis = d;
+			}
+
+			// Every point is the same, so the node can't be split.
+			if (hi[axis] == lo[axis])
+				return;
+
+			const size_type mid = begin + (end - begin) / 2;
+
+			std::nth_element(_indices.begin() + begin, _indices.begin() + mid, _indices.begin() + end,
+							 [&](size_type A, size_type B) { return points[A][axis] < points[B][axis]; });
+
+			const T split = points[_indices[mid]][axis];
+
+			buildNode(points, begin, mid);
+			const size_type right = _nodes.size();
+			buildNode(points, mid, end);
+
+			_nodes[node].split = split;
+			_nodes[node].axis = axis;
+			_nodes[node].right = right;
+		}
+
+		// Calls visit(position, distance squared) for every point of the subtree
+		// whose distance squared to query is at most bound. offsets holds the
+		// distance from query to the region of the node along each dimension,
+		// and rd is the sum of their squares. visit may lower bound.
+		template <typename Visit>
+		void searchNode(size_type node, const point_type& query, std::array<T, N>& offsets, T rd,
+						T scale, const T& bound, Visit& visit) const
+		{
+			const _KdNode<T>& n = _nodes[node];
+
+			if (n.right == 0)
+			{
+				for (size_type i = n.begin; i < n.end; ++i)
+				{
+					const T d = distance_squared(_points[i], query);
+
+					if (d <= bound)
+						visit(i, d);
+				}
+
+				return;
+			}
+
+			// Points of the left child are <= split and points
+			// of the right child are >= split along the axis.
+			const T diff = query[n.axis] - n.split;
+			const size_type near_child = diff < T(0) ? node + 1 : n.right;
+			const size_type far_child = diff < T(0) ? n.right : node + 1;
+
+			searchNode(near_child, query, offsets, rd, scale, bound, visit);
+
+			const T old = offsets[n.axis];
+			const T far_rd = rd - old * old + diff * diff;
+
+			if (far_rd * scale <= bound)
+			{
+				offsets[n.axis] = diff;
+				searchNode(far_child, query, offsets, far_rd, scale, bound, visit);
+				offsets[n.axis] = old;
+			}
+		}
+
+		// Writes the k nearest points to query into heap, closest first.
+		// Returns the number of points written, which is less than k
+		// only if the KdTree holds fewer than k points.
+		size_type search(const point_type& query, size_type k, Neighbor* heap) const
+		{
+			if (k == 0 || _nodes.empty())
+				return 0;
+
+			size_type count = 0;
+			T bound = std::numeric_limits<T>::infinity();
+			std::array<T, N> offsets{};
+
+			auto visit = [&](size_type i, T d)
+			{
+				if (count < k)
+				{
+					heap[count++] = Neighbor{ _indices[i], d };
+					std::push_heap(heap, heap + count);
+				}
+				else if (d < heap[0].distanceSquared)
+				{
+					std::pop_heap(heap, heap + k);
+					heap[k - 1] = Neighbor{ _indices[i], d };
+					std::push_heap(heap, heap + k);
+				}
+
+				if (count == k)
+					bound = heap[0].distanceSquared;
+			};
+
+			const T scale = (T(1) + _epsilon) * (T(1) + _epsilon);
+			searchNode(0, query, offsets, T(0), scale, bound, visit);
+			std::sort_heap(heap, heap + count);
+
+			return count;
+		}
+
+		// Sets out[i] to the nearest point to queries[i].
+		void searchBatch(std::span<const point_type> queries, std::span<Neighbor> out) const
+		{
+			if (queries.size() != out.size())
+				throw std::invalid_argument("ERROR: Array sizes do not match.");
+
+			auto query = [&](size_type i)
+			{
+				out[i] = nearest(queries[i]);
+			};
+
+			std::vector<size_type> rows(queries.size());
+			std::iota(rows.begin(), rows.end(), size_type(0));
+
+			if (queries.size() >= _parallel_kd_queries)
+				std::for_each(std::execution::par, rows.begin(), rows.end(), query);
+			else
+				std::for_each(rows.begin(), rows.end(), query);
+		}
+
+		// Sets out[i * k, i * k + k) to the k nearest points to queries[i], closest first.
+		void searchBatch(std::span<const point_type> queries, size_type k, std::span<Neighbor> out) const
+		{
+			if (queries.size() * k != out.size())
+				throw std::invalid_argument("ERROR: Array sizes do not match.");
+
+			auto query = [&](size_type i)
+			{
+				Neighbor* heap = out.data() + i * k;
+				const size_type count = search(queries[i], k, heap);
+				std::fill(heap + count, heap + k, Neighbor{ size(), std::numeric_limits<T>::infinity() });
+			};
+
+			std::vector<size_type> rows(queries.size());
+			std::iota(rows.begin(), rows.end(), size_type(0));
+
+			if (queries.size() >= _parallel_kd_queries)
+				std::for_each(std::execution::par, rows.begin(), rows.end(), query);
+			else
+				std::for_each(rows.begin(), rows.end(), query);
+		}
+
+		public:
+
+		// Default constructor.
+		// Creates an empty KdTree.
+		KdTree() : _leafSize(16), _epsilon(0)
+		{
+
+		}
+
+		// Builds the KdTree over the given points.
+		// Throws a std::invalid_argument if leafSize is 0.
+		KdTree(std::span<const point_type> points, size_type leafSize = 16) : _leafSize(16), _epsilon(0)
+		{
+			build(points, leafSize);
+		}
+
+		// Builds the KdTree over the given points.
+		// Throws a std::invalid_argument if leafSize is 0.
+		KdTree(std::span<const Vector3<T>> points, size_type leafSize = 16) requires (N == 3) : _leafSize(16), _epsilon(0)
+		{
+			build(points, leafSize);
+		}
+
+		// Default copy constructor.
+		KdTree(const KdTree& other) = default;
+
+		// Default move constructor.
+		KdTree(KdTree&& other) = default;
+
+		// Default copy assignment operator.
+		KdTree& operator = (const KdTree& other) = default;
+
+		// Default move assignment operator.
+		KdTree& operator = (KdTree&& other) = default;
+
+		// Rebuilds the KdTree over the given points.
+		// Leaves hold at most leafSize points.
+		// Throws a std::invalid_argument if leafSize is 0.
+		void build(std::span<const point_type> points, size_type leafSize = 16)
+		{
+			if (leafSize == 0)
+				throw std::invalid_argument("ERROR: The leaf size must not be 0.");
+
+			_leafSize = leafSize;
+			_nodes.clear();
+			_indices.resize(points.size());
+			std::iota(_indices.begin(), _indices.end(), size_type(0));
+
+			if (!points.empty())
+				buildNode(points, 0, points.size());
+
+			_points.resize(points.size());
+
+			for (size_type i = 0; i < points.size(); ++i)
+				_points[i] = points[_indices[i]];
+		}
+
+		// Rebuilds the KdTree over the given points.
+		// Leaves hold at most leafSize points.
+		// Throws a std::invalid_argument if leafSize is 0.
+		void build(std::span<const Vector3<T>> points, size_type leafSize = 16) requires (N == 3)
+		{
+			build(std::span<const point_type>(toPoints(points)), leafSize);
+		}
+
+		// Removes every point from the KdTree.
+		void clear() noexcept
+		{
+			_points.clear();
+			_indices.clear();
+			_nodes.clear();
+		}
+
+		// Returns the number of points in the KdTree.
+		size_type size() const noexcept
+		{
+			return _points.size();
+		}
+
+		// Returns true if the KdTree holds no points.
+		bool empty() const noexcept
+		{
+			return _points.empty();
+		}
+
+		// Returns the largest number of points in a leaf.
+		size_type leafSize() const noexcept
+		{
+			return _leafSize;
+		}
+
+		// Returns the allowed relative error of the nearest neighbor queries.
+		// 0 means the queries are exact.
+		T epsilon() const noexcept
+		{
+			return _epsilon;
+		}
+
+		// Sets the allowed relative error of the nearest neighbor queries.
+		// Throws a std::invalid_argument if epsilon is negative.
+		void setEpsilon(T epsilon)
+		{
+			if (!(epsilon >= T(0)))
+				throw std::invalid_argument("ERROR: Epsilon must not be negative.");
+
+			_epsilon = epsilon;
+		}
+
+		// Returns the nearest point to query.
+		// Returns a Neighbor with an index of size() if the KdTree is empty.
+		Neighbor nearest(const point_type& query) const
+		{
+			Neighbor result{ size(), std::numeric_limits<T>::infinity() };
+			search(query, 1, &result);
+			return result;
+		}
+
+		// Returns the nearest point to query.
+		// Returns a Neighbor with an index of size() if the KdTree is empty.
+		Neighbor nearest(const Vector3<T>& query) const requires (N == 3)
+		{
+			return nearest(toPoint(query));
+		}
+
+		// Returns the k nearest points to query, closest first.
+		// Returns fewer than k points only if the KdTree holds fewer than k points.
+		std::vector<Neighbor> nearest(const point_type& query, size_type k) const
+		{
+			std::vector<Neighbor> result(std::min(k, size()));
+			search(query, result.size(), result.data());
+			return result;
+		}
+
+		// Returns the k nearest points to query, closest first.
+		// Returns fewer than k points only if the KdTree holds fewer than k points.
+		std::vector<Neighbor> nearest(const Vector3<T>& query, size_type k) const requires (N == 3)
+		{
+			return nearest(toPoint(query), k);
+		}
+
+		// Sets out[i] to the nearest point to queries[i].
+		// Large batches are split across threads.
+		// Throws a std::invalid_argument if the sizes of queries and out are not equal.
+		void nearest(std::span<const point_type> queries, std::span<Neighbor> out) const
+		{
+			searchBatch(queries, out);
+		}
+
+		// Sets out[i] to the nearest point to queries[i].
+		// Large batches are split across threads.
+		// Throws a std::invalid_argument if the sizes of queries and out are not equal.
+		void nearest(std::span<const Vector3<T>> queries, std::span<Neighbor> out) const requires (N == 3)
+		{
+			searchBatch(toPoints(queries), out);
+		}
+
+		// Sets out[i * k, i * k + k) to the k nearest points to queries[i], closest first.
+		// If the KdTree holds fewer than k points, the rest have an index of size().
+		// Large batches are split across threads.
+		// Throws a std::invalid_argument if the size of out is not queries.size() * k.
+		void nearest(std::span<const point_type> queries, size_type k, std::span<Neighbor> out) const
+		{
+			searchBatch(queries, k, out);
+		}
+
+		// Sets out[i * k, i * k + k) to the k nearest points to queries[i], closest first.
+		// If the KdTree holds fewer than k points, the rest have an index of size().
+		// Large batches are split across threads.
+		// Throws a std::invalid_argument if the size of out is not queries.size() * k.
+		void nearest(std::span<const Vector3<T>> queries, size_type k, std::span<Neighbor> out) const requires (N == 3)
+		{
+			searchBatch(toPoints(queries), k, out);
+		}
+
+		// Returns every point whose distance to query is at most radius, closest first.
+		// Radius queries are always exact.
+		std::vector<Neighbor> withinRadius(const point_type& query, T radius) const
+		{
+			std::vector<Neighbor> result;
+
+			if (_nodes.empty() || radius < T(0))
+				return result;
+
+			const T bound = radius * radius;
+			std::array<T, N> offsets{};
+
+			auto visit = [&](size_type i, T d)
+			{
+				result.push_back(Neighbor{ _indices[i], d });
+			};
+
+			searchNode(0, query, offsets, T(0), T(1), bound, visit);
+			std::sort(result.begin(), result.end());
+
+			return result;
+		}
+
+		// Returns every point whose distance to query is at most radius, closest first.
+		// Radius queries are always exact.
+		std::vector<Neighbor> withinRadius(const Vector3<T>& query, T radius) const requires (N == 3)
+		{
+			return withinRadius(toPoint(query), radius);
+		}
+	};
+}
\ No newline at end of file
@@ -1,22 +1,32 @@
 // JLibrary
 // Matrix.ixx
 // Created on 2022-01-08 by Justyn Durnford
-// Last modified on 2022-03-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
 // Module file for the Matrix template class.
 
 module;
 
 #include "Arithmetic.hpp"
+#include "Gemm.hpp"
+#include "Uninitialized.hpp"
 
 #include <algorithm>
+#include <concepts>
 #include <cstddef>
 #include <initializer_list>
 #include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 export module Matrix;
 
 import Array;
+import ColumnIterator;
+import MatrixExpression;
+import MatrixView;
 import MiscTemplateFunctions;
 import Vector2;
 
@@ -30,23 +40,35 @@ export namespace jlib
 	// This seems a bit confusing to people who are
 	// used to X x Y coordinates, but this is consistent
 	// with how they are represented in mathematics.
-	template <typename T> class Matrix
+	// 
+	// Memory is obtained from the Allocator, which defaults to std::allocator.
+	// jlib::pmr::Matrix uses a std::pmr::polymorphic_allocator.
+	// 
+	// The element-wise operators +, - and scalar * and / return lazy
+	// matrix expressions, which are evaluated in one loop and without
+	// temporary allocations when they are assigned to a Matrix.
+	template <typename T, typename Allocator = std::allocator<T>> class Matrix
 	{
+		public:
+
 		using value_type = T;
+		using allocator_type = Allocator;
 		using size_type = std::size_t;
 		using difference_type = std::ptrdiff_t;
 		using reference = value_type&;
 		using const_reference = const value_type&;
 		using pointer = value_type*;
 		using const_pointer = const value_type*;
-		using iterator = Array<T>::iterator;
-		using const_iterator = Array<T>::const_iterator;
-		using reverse_iterator = Array<T>::reverse_iterator;
-		using const_reverse_iterator = Array<T>::const_reverse_iterator;
+		using iterator = Array<T, Allocator>::iterator;
+		using const_iterator = Array<T, Allocator>::const_iterator;
+		using reverse_iterator = Array<T, Allocator>::reverse_iterator;
+		using const_reverse_iterator = Array<T, Allocator>::const_reverse_iterator;
+		using column_iterator = ColumnIterator<T>;
+		using const_column_iterator = ColumnIterator<const T>;
 
 		private:
 
-		Array<T> _data;
+		Array<T, Allocator> _data;
 		size_type _rows;
 		size_type _cols;
 
@@ -59,27 +81,109 @@ export namespace jlib
 				_rows = rows;
 				_cols = cols;
 
-				_data = Array<T>(_rows * _cols);
+				_data = Array<T, Allocator>(_rows * _cols, _data.get_allocator());
 			}
 			else
 			{
+				// The elements must go too, since size() is the size of _data.
+				_data.clear();
 				_rows = 0;
 				_cols = 0;
 			}
 		}
 
-		// This function deallocates the memory currently used
-		// by the container and reallocates sufficient memory
-		// for the new requested size.
+		// Makes room for at least size elements. The capacity
+		// grows geometrically so that repeated resizes are cheap.
+		// It may throw if it fails to do this.
+		void grow(size_type size)
+		{
+			if (size > _data.capacity())
+				_data.reserve(std::max(size, _data.capacity() + _data.capacity() / 2));
+		}
+
+		// Sets the elements in the range [first, last) to T().
+		static void valueFill(pointer first, pointer last)
+		{
+			if (first < last)
+				std::fill(first, last, T());
+		}
+
+		// Moves the overlapping block of the Matrix into the layout of
+		// a rows x cols Matrix inside the current memory.
+		// The capacity must be at least rows * cols.
+		void relayout(size_type rows, size_type cols)
+		{
+			size_type keep_rows = std::min(rows, _rows);
+			size_type old_size = _data.size();
+			size_type new_size = rows * cols;
+
+			if (cols > _cols)
+			{
+				// Rows move towards the end, so they are moved last to first.
+				// Every kept row is inside the first new_size elements.
+				_data.resize(new_size);
+				pointer ptr = data();
+
+				for (size_type row_i = keep_rows; row_i-- > 1;)
+				{
+					pointer row = ptr + (row_i * _cols);
+					std::move_backward(row, row + _cols, ptr + (row_i * cols) + _cols);
+				}
+
+				for (size_type row_i = 0; row_i < keep_rows; ++row_i)
+					valueFill(ptr + (row_i * cols) + _cols, ptr + ((row_i + 1) * cols));
+
+				valueFill(ptr + (keep_rows * cols), ptr + std::min(old_size, new_size));
+			}
+			else
+			{
+				// Rows move towards the front, so they are moved first to last.
+				pointer ptr = data();
+
+				for (size_type row_i = 1; row_i < keep_rows; ++row_i)
+				{
+					pointer row = ptr + (row_i * _cols);
+					std::move(row, row + cols, ptr + (row_i * cols));
+				}
+
+				valueFill(ptr + (keep_rows * cols), ptr + std::min(old_size, new_size));
+				_data.resize(new_size);
+			}
+		}
+
+		// Allocates memory for a rows x cols Matrix and moves
+		// the overlapping block of the Matrix into it row by row.
 		// It may throw if it fails to do this.
 		void reallocate(size_type rows, size_type cols)
 		{
-			Array<T> newarr(rows * cols);
-			size_type size = std::min(_data.size(), newarr.size());
-			std::copy(newarr.begin(), newarr.end(), _data.begin());
+			Array<T, Allocator> newarr(_data.get_allocator());
+			newarr.reserve(std::max(rows * cols, _data.capacity() + _data.capacity() / 2));
+			newarr.resize(rows * cols);
+
+			size_type keep_rows = std::min(rows, _rows);
+			size_type keep_cols = std::min(cols, _cols);
+
+			for (size_type row_i = 0; row_i < keep_rows; ++row_i)
+			{
+				pointer row = data() + (row_i * _cols);
+				std::move(row, row + keep_cols, newarr.data() + (row_i * cols));
+			}
+
 			_data = std::move(newarr);
 		}
 
+		// Sets every element to the corresponding element of the expression,
+		// which must have the same dimensions as the Matrix.
+		template <matrix_expression E>
+		void evaluate(const E& expr)
+		{
+			pointer ptr = data();
+			size_type count = size();
+
+			for (size_type i = 0; i < count; ++i)
+				ptr[i] = static_cast<T>(expr[i]);
+		}
+
 		public:
 
 		// Default constructor.
@@ -88,22 +192,46 @@ export namespace jlib
 			allocate(0, 0);
 		}
 
+		// Allocator constructor.
+		explicit Matrix(const Allocator& alloc) : _data(alloc)
+		{
+			allocate(0, 0);
+		}
+
 		// Size constructor.
-		Matrix(size_type rows, size_type cols)
+		Matrix(size_type rows, size_type cols, const Allocator& alloc = Allocator()) : _data(alloc)
 		{
 			allocate(rows, cols);
 		}
 
 		// Size and value constructor.
 		// Sets every element of the Matrix to value.
-		Matrix(size_type rows, size_type cols, const_reference value)
+		Matrix(size_type rows, size_type cols, const_reference value, const Allocator& alloc = Allocator()) : _data(alloc)
 		{
 			allocate(rows, cols);
 			std::fill(data(), data() + size(), value);
 		}
 
+		// Uninitialized size constructor.
+		// Allocates a rows x cols Matrix without value-initializing
+		// trivial elements, so they must be written before they are read.
+		Matrix(size_type rows, size_type cols, uninitialized_t, const Allocator& alloc = Allocator()) : _data(alloc)
+		{
+			if (rows != 0 && cols != 0)
+			{
+				_rows = rows;
+				_cols = cols;
+				_data = Array<T, Allocator>(rows * cols, uninitialized, alloc);
+			}
+			else
+			{
+				_rows = 0;
+				_cols = 0;
+			}
+		}
+
 		// 2-dimensional std::initializer_list constructor.
-		Matrix(std::initializer_list<std::initializer_list<T>> list)
+		Matrix(std::initializer_list<std::initializer_list<T>> list, const Allocator& alloc = Allocator()) : _data(alloc)
 		{
 			auto iter = list.begin();
 			size_type cols = 0;
@@ -132,8 +260,8 @@ export namespace jlib
 		// Constructs the Matrix from another type of Matrix.
 		// This constructor doesn't replace the copy constructor,
 		// it's called only when U != T.
-		template <typename U>
-		explicit Matrix(const Matrix<U>& other)
+		template <typename U, typename OtherAllocator>
+		explicit Matrix(const Matrix<U, OtherAllocator>& other, const Allocator& alloc = Allocator()) : _data(alloc)
 		{
 			allocate(other.rowCount(), other.colCount());
 			jlib::copy(other.data(), other.data() + size(), data());
@@ -142,6 +270,28 @@ export namespace jlib
 		// Move constructor.
 		Matrix(Matrix&& other) = default;
 
+		// Constructs the Matrix by evaluating a matrix expression.
+		template <matrix_expression_node E>
+		Matrix(const E& expr, const Allocator& alloc = Allocator()) : _data(alloc)
+		{
+			allocate(expr.rowCount(), expr.colCount());
+			evaluate(expr);
+		}
+
+		// Evaluates a matrix expression into the Matrix.
+		// Memory is only allocated if the dimensions of the Matrix change.
+		template <matrix_expression_node E>
+		Matrix& operator = (const E& expr)
+		{
+			// If the dimensions differ, the expression cannot refer
+			// to this Matrix, so the old elements can be discarded.
+			if (expr.rowCount() != _rows || expr.colCount() != _cols)
+				allocate(expr.rowCount(), expr.colCount());
+
+			evaluate(expr);
+			return *this;
+		}
+
 		// 2-dimensional std::initializer_list assignment operator.
 		Matrix& operator = (std::initializer_list<std::initializer_list<T>> list)
 		{
@@ -177,6 +327,12 @@ export namespace jlib
 		// Destructor.
 		~Matrix() = default;
 
+		// Returns a copy of the allocator used by the Matrix.
+		constexpr allocator_type get_allocator() const noexcept
+		{
+			return _data.get_allocator();
+		}
+
 		// Returns the number of rows in the Matrix.
 		constexpr size_type rowCount() const noexcept
 		{
@@ -315,6 +471,44 @@ export namespace jlib
 			return _data.cbegin() + (_cols * row);
 		}
 
+		// Returns an iterator pointing to the first element of the given column.
+		constexpr column_iterator colBegin(size_type col) noexcept
+		{
+			return column_iterator(data() + col, _cols);
+		}
+
+		// Returns an iterator pointing to the first element of the given column.
+		constexpr const_column_iterator colBegin(size_type col) const noexcept
+		{
+			return const_column_iterator(data() + col, _cols);
+		}
+
+		// Returns an iterator pointing to 1 past the last element of the given column.
+		constexpr column_iterator colEnd(size_type col) noexcept
+		{
+			return colBegin(col) + static_cast<difference_type>(_rows);
+		}
+
+		// Returns an iterator pointing to 1 past the last element of the given column.
+		constexpr const_column_iterator colEnd(size_type col) const noexcept
+		{
+			return colBegin(col) + static_cast<difference_type>(_rows);
+		}
+
+		// Returns a non-owning view of the Matrix.
+		// The view is invalidated when the Matrix reallocates.
+		constexpr MatrixView<T> view() noexcept
+		{
+			return MatrixView<T>(data(), _rows, _cols);
+		}
+
+		// Returns a non-owning view of the Matrix.
+		// The view is invalidated when the Matrix reallocates.
+		constexpr MatrixView<const T> view() const noexcept
+		{
+			return MatrixView<const T>(data(), _rows, _cols);
+		}
+
 		// Returns the element at the given index of the Matrix.
 		// Throws a std::out_of_range if given an invalid index.
 		constexpr reference at(size_type n)
@@ -421,41 +615,135 @@ export namespace jlib
 			_data[(v.y * _cols) + v.x] = value;
 		}
 
-		// Empties the Matrix.
+		// Empties the Matrix and releases its memory.
 		constexpr void clear() noexcept
 		{
 			_data.clear();
+			_rows = 0;
+			_cols = 0;
+		}
+
+		// Returns the number of elements the Matrix can hold
+		// without allocating more memory.
+		constexpr size_type capacity() const noexcept
+		{
+			return _data.capacity();
+		}
+
+		// Ensures the Matrix can be resized to rows x cols
+		// without allocating more memory.
+		// It may throw if it fails to do this.
+		void reserve(size_type rows, size_type cols)
+		{
+			_data.reserve(rows * cols);
+		}
+
+		// Reduces the capacity of the Matrix to its size.
+		// It may throw if it fails to do this.
+		void shrink_to_fit()
+		{
+			_data.shrink_to_fit();
 		}
 
-		// Resizes the Matrix with the copied elements.
+		// Resizes the Matrix to rows x cols, keeping the elements of the
+		// block shared by the old and new dimensions at the same [row][col].
+		// New elements are value-initialized.
+		// Memory is only reallocated if rows * cols exceeds the capacity;
+		// otherwise the rows are moved within the current memory.
 		// It may throw if it fails to do this.
 		void resize(size_type rows, size_type cols)
 		{
-			reallocate(rows, cols);
+			if (rows == 0 || cols == 0)
+			{
+				_data.resize(0);
+				_rows = 0;
+				_cols = 0;
+				return;
+			}
+
+			if (cols == _cols)
+			{
+				// The rows keep their position, so only the end changes.
+				grow(rows * cols);
+				_data.resize(rows * cols);
+			}
+			else if (rows * cols <= _data.capacity())
+				relayout(rows, cols);
+			else
+				reallocate(rows, cols);
+
+			_rows = rows;
+			_cols = cols;
+		}
+
+		// Adds a Matrix or matrix expression to the Matrix.
+		// Throws a std::invalid_argument if the dimensions do not match.
+		template <matrix_expression E>
+		Matrix& operator += (const E& expr)
+		{
+			if (expr.rowCount() != _rows || expr.colCount() != _cols)
+				throw std::invalid_argument("ERROR: Matrix dimensions do not match.");
+
+			pointer ptr = data();
+			for (size_type i = 0; i < size(); ++i)
+				ptr[i] += expr[i];
+
+			return *this;
+		}
+
+		// Subtracts a Matrix or matrix expression from the Matrix.
+		// Throws a std::invalid_argument if the dimensions do not match.
+		template <matrix_expression E>
+		Matrix& operator -= (const E& expr)
+		{
+			if (expr.rowCount() != _rows || expr.colCount() != _cols)
+				throw std::invalid_argument("ERROR: Matrix dimensions do not match.");
+
+			pointer ptr = data();
+			for (size_type i = 0; i < size(); ++i)
+				ptr[i] -= expr[i];
+
+			return *this;
+		}
+
+		// Multiplies every element of the Matrix by the scalar.
+		template <arithmetic U>
+		Matrix& operator *= (U scalar)
+		{
+			for (reference elem : _data)
+				elem *= scalar;
+
+			return *this;
+		}
+
+		// Divides every element of the Matrix by the scalar.
+		template <arithmetic U>
+		Matrix& operator /= (U scalar)
+		{
+			for (reference elem : _data)
+				elem /= scalar;
+
+			return *this;
 		}
 
 		// Returns a copy of the given row.
-		Array<T> getRow(size_type row) const
+		Array<T, Allocator> getRow(size_type row) const
 		{
 			if (row >= _rows)
 				throw std::out_of_range("ERROR: Invalid row index.");
 
-			Array<T> arr;
-			for (size_type col_i(0); col_i < _cols; ++col_i)
-				arr[col_i] = _data[row][col_i];
-
-			return arr;
+			return Array<T, Allocator>(rowBegin(row), rowBegin(row) + _cols, _data.get_allocator());
 		}
 
 		// Returns a copy of the given column.
-		Array<T> getCol(size_type col) const
+		Array<T, Allocator> getCol(size_type col) const
 		{
 			if (col >= _cols)
 				throw std::out_of_range("ERROR: Invalid column index.");
 
-			Array<T> arr;
+			Array<T, Allocator> arr(_rows, uninitialized, _data.get_allocator());
 			for (size_type row_i(0); row_i < _rows; ++row_i)
-				arr[row_i] = _data[row_i][col];
+				arr[row_i] = _data[(row_i * _cols) + col];
 
 			return arr;
 		}
@@ -468,6 +756,22 @@ export namespace jlib
 			std::swap(_cols, other._cols);
 		}
 
+		// Transposes the Matrix.
+		// A square Matrix is transposed in place with tiled swaps.
+		// Otherwise the transpose is written into new memory,
+		// which replaces the memory of the Matrix.
+		void transposeInPlace()
+		{
+			if (_rows == _cols)
+				transpose_in_place(view());
+			else
+			{
+				Matrix M(_cols, _rows, uninitialized, _data.get_allocator());
+				transpose(std::as_const(*this).view(), M.view());
+				swapWith(M);
+			}
+		}
+
 		// Returns the element at the given index the Matrix.
 		// Does NOT perform bounds-checking.
 		constexpr reference operator [] (size_type n)
@@ -516,8 +820,8 @@ export namespace jlib
 	};
 
 	// Overload of binary operator == 
-	template <typename T>
-	bool operator == (const Matrix<T>& A, const Matrix<T>& B)
+	template <typename T, typename Allocator>
+	bool operator == (const Matrix<T, Allocator>& A, const Matrix<T, Allocator>& B)
 	{
 		if (A.rowCount() != B.rowCount() || A.colCount() != B.colCount())
 			return false;
@@ -532,8 +836,8 @@ export namespace jlib
 	}
 
 	// Overload of binary operator == 
-	template <typename T>
-	bool operator != (const Matrix<T>& A, const Matrix<T>& B)
+	template <typename T, typename Allocator>
+	bool operator != (const Matrix<T, Allocator>& A, const Matrix<T, Allocator>& B)
 	{
 		if (A.rowCount() != B.rowCount() || A.colCount() != B.colCount())
 			return true;
@@ -546,4 +850,80 @@ export namespace jlib
 
 		return false;
 	}
+
+	// Computes C = alpha * A * B + beta * C.
+	// Matrices of float or double use the blocked, vectorized jlib::gemm,
+	// split across threads if parallel is true and the product is large.
+	// C must not be A or B.
+	// Throws a std::invalid_argument if the dimensions do not match.
+	template <typename T, typename Allocator>
+	void gemm(T alpha, const Matrix<T, Allocator>& A, const Matrix<T, Allocator>& B,
+			  T beta, Matrix<T, Allocator>& C, bool parallel = true)
+	{
+		if (A.colCount() != B.rowCount() || C.rowCount() != A.rowCount() || C.colCount() != B.colCount())
+			throw std::invalid_argument("ERROR: Matrix dimensions do not match.");
+
+		std::size_t m = A.rowCount();
+		std::size_t n = B.colCount();
+		std::size_t k = A.colCount();
+
+		if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+			jlib::gemm(m, n, k, alpha, A.data(), k, B.data(), n, beta, C.data(), n, parallel);
+		else
+		{
+			for (std::size_t i = 0; i < m; ++i)
+			{
+				for (std::size_t j = 0; j < n; ++j)
+					C(i, j) = (beta == T(0)) ? T(0) : beta * C(i, j);
+
+				// i-k-j order walks B and C row by row.
+				for (std::size_t p = 0; p < k; ++p)
+				{
+					T a = alpha * A(i, p);
+
+					for (std::size_t j = 0; j < n; ++j)
+						C(i, j) += a * B(p, j);
+				}
+			}
+		}
+	}
+
+	// Overload of binary operator *
+	// Returns the matrix product of A and B.
+	// Throws a std::invalid_argument if A.colCount() != B.rowCount().
+	template <typename T, typename Allocator>
+	Matrix<T, Allocator> operator * (const Matrix<T, Allocator>& A, const Matrix<T, Allocator>& B)
+	{
+		if (A.colCount() != B.rowCount())
+			throw std::invalid_argument("ERROR: Matrix dimensions do not match.");
+
+		Matrix<T, Allocator> C(A.rowCount(), B.colCount(), A.get_allocator());
+		gemm(T(1), A, B, T(0), C);
+		return C;
+	}
+
+	// Returns the transpose of the Matrix.
+	// The copy is made in cache-sized tiles, in parallel for large matrices.
+	template <typename T, typename Allocator>
+	Matrix<T, Allocator> transpose(const Matrix<T, Allocator>& A)
+	{
+		Matrix<T, Allocator> M(A.colCount(), A.rowCount(), uninitialized, A.get_allocator());
+		transpose(A.view(), M.view());
+		return M;
+	}
+
+	namespace pmr
+	{
+		// Matrix that obtains its memory from a std::pmr::memory_resource.
+		template <typename T> using Matrix = jlib::Matrix<T, std::pmr::polymorphic_allocator<T>>;
+	}
+}
+
+// Specializations are not exported declarations,
+// so they live outside the export block.
+namespace jlib
+{
+	// Matrix can be an operand of matrix expressions.
+	template <typename T, typename Allocator>
+	constexpr bool enable_matrix_expression<Matrix<T, Allocator>> = true;
 }
\ No newline at end of file
@@ -0,0 +1,736 @@
+// JLibrary
+// MatrixDecomposition.ixx
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Module file for the LU, Cholesky and QR decompositions of the Matrix template class.
+
+module;
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+
+export module MatrixDecomposition;
+
+import Array;
+import Matrix;
+
+export namespace jlib
+{
+	// LU decomposition with partial pivoting of a square Matrix A,
+	// such that P * A = L * U, where P is a permutation matrix,
+	// L is lower triangular with 1s on its diagonal and U is upper triangular.
+	//
+	// L and U are stored together in a single Matrix, and the
+	// decomposition can be reused to solve for many right-hand sides.
+	// All of the inner loops walk along the rows of the Matrix.
+	template <std::floating_point T, typename Allocator = std::allocator<T>> class LUDecomposition
+	{
+		Matrix<T, Allocator> _lu;
+		Array<std::size_t> _pivots;
+		int _sign;
+		bool _singular;
+
+		public:
+
+		// Computes the decomposition of A.
+		// Throws a std::invalid_argument if A is not square.
+		explicit LUDecomposition(const Matrix<T, Allocator>& A) : _lu(A), _pivots(A.rowCount()), _sign(1), _singular(false)
+		{
+			if (A.rowCount() != A.colCount())
+				throw std::invalid_argument("ERROR: Matrix is not square.");
+
+			const std::size_t n = A.rowCount();
+			std::iota(_pivots.begin(), _pivots.end(), std::size_t(0));
+
+			for (std::size_t k = 0; k < n; ++k)
+			{
+				std::size_t p = k;
+
+				for (std::size_t i = k + 1; i < n; ++i)
+				{
+					if (std::abs(_lu(i, k)) > std::abs(_lu(p, k)))
+						p = i;
+				}
+
+				if (p != k)
+				{
+					std::swap_ranges(_lu.rowBegin(k), _lu.rowBegin(k) + n, _lu.rowBegin(p));
+					std::swap(_pivots[k], _pivots[p]);
+					_sign = -_sign;
+				}
+
+				const T pivot = _lu(k, k);
+
+				if (pivot == T(0))
+				{
+					_singular = true;
+					continue;
+				}
+
+				const T* row_k = _lu.rowBegin(k);
+
+				for (std::size_t i = k + 1; i < n; ++i)
+				{
+					T* row_i = _lu.rowBegin(i);
+					const T l = row_i[k] / pivot;
+					row_i[k] = l;
+
+					for (std::size_t j = k + 1; j < n; ++j)
+						row_i[j] -= l * row_k[j];
+				}
+			}
+		}
+
+		// Returns true if A is singular.
+		bool isSingular() const noexcept
+		{
+			return _singular;
+		}
+
+		// Returns the determinant of A.
+		T determinant() const noexcept
+		{
+			T det = static_cast<T>(_sign);
+
+			for (std::size_t i = 0; i < _lu.rowCount(); ++i)
+				det *= _lu(i, i);
+
+			return det;
+		}
+
+		// Returns the row permutation of the decomposition.
+		// Row i of P * A is row pivots()[i] of A.
+		const Array<std::size_t>& pivots() const noexcept
+		{
+			return _pivots;
+		}
+
+		// Returns L, the lower triangular factor.
+		Matrix<T, Allocator> lower() const
+		{
+			const std::size_t n = _lu.rowCount();
+			Matrix<T, Allocator> L(n, n, T(0), _lu.get_allocator());
+
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				std::copy(_lu.rowBegin(i), _lu.rowBegin(i) + i, L.rowBegin(i));
+				L(i, i) = T(1);
+			}
+
+			return L;
+		}
+
+		// Returns U, the upper triangular factor.
+		Matrix<T, Allocator> upper() const
+		{
+			const std::size_t n = _lu.rowCount();
+			Matrix<T, Allocator> U(n, n, T(0), _lu.get_allocator());
+
+			for (std::size_t i = 0; i < n; ++i)
+				std::copy(_lu.rowBegin(i) + i, _lu.rowBegin(i) + n, U.rowBegin(i) + i);
+
+			return U;
+		}
+
+		// Returns the solution x of A * x = b.
+		// Throws a std::invalid_argument if the size of b does not match A.
+		// Throws a std::domain_error if A is singular.
+		Array<T, Allocator> solve(const Array<T, Allocator>& b) const
+		{
+			const std::size_t n = _lu.rowCount();
+
+			if (b.size() != n)
+				throw std::invalid_argument("ERROR: Matrix dimensions do not match.");
+			if (_singular)
+				throw std::domain_error("ERROR: Matrix is singular.");
+
+			Array<T, Allocator> x(n, b.get_allocator());
+
+			for (std::size_t i = 0; i < n; ++i)
+				x[i] = b[_pivots[i]];
+
+			// Forward substitution with L.
+			for (std::size_t i = 1; i < n; ++i)
+			{
+				const T* row = _lu.rowBegin(i);
+				T value = x[i];
+
+				for (std::size_t j = 0; j < i; ++j)
+					value -= row[j] * x[j];
+
+				x[i] = value;
+			}
+
+			// Back substitution with U.
+			for (std::size_t i = n; i-- > 0;)
+			{
+				const T* row = _lu.rowBegin(i);
+				T value = x[i];
+
+				for (std::size_t j = i + 1; j < n; ++j)
+					value -= row[j] * x[j];
+
+				x[i] = value / row[i];
+			}
+
+			return x;
+		}
+
+		// Returns the solution X of A * X = B.
+		// Each column of B is a separate right-hand side.
+		// Throws a std::invalid_argument if the row count of B does not match A.
+		// Throws a std::domain_error if A is singular.
+		Matrix<T, Allocator> solve(const Matrix<T, Allocator>& B) const
+		{
+			const std::size_t n = _lu.rowCount();
+			const std::size_t m = B.colCount();
+
+			if (B.rowCount() != n)
+				throw std::invalid_argument("ERROR: Matrix dimensions do not match.");
+			if (_singular)
+				throw std::domain_error("ERROR: Matrix is singular.");
+
+			Matrix<T, Allocator> X(n, m, B.get_allocator());
+
+			for (std::size_t i = 0; i < n; ++i)
+				std::copy(B.rowBegin(_pivots[i]), B.rowBegin(_pivots[i]) + m, X.rowBegin(i));
+
+			// Forward substitution with L, one row of X at a time.
+			for (std::size_t i = 1; i < n; ++i)
+			{
+				T* x_i = X.rowBegin(i);
+
+				for (std::size_t k = 0; k < i; ++k)
+				{
+					const T l = _lu(i, k);
+					const T* x_k = X.rowBegin(k);
+
+					for (std::size_t j = 0; j < m; ++j)
+						x_i[j] -= l * x_k[j];
+				}
+			}
+
+			// Back substitution with U.
+			for (std::size_t i = n; i-- > 0;)
+			{
+				T* x_i = X.rowBegin(i);
+
+				for (std::size_t k = i + 1; k < n; ++k)
+				{
+					const T u = _lu(i, k);
+					const T* x_k = X.rowBegin(k);
+
+					for (std::size_t j = 0; j < m; ++j)
+						x_i[j] -= u * x_k[j];
+				}
+
+				const T inv = T(1) / _lu(i, i);
+
+				for (std::size_t j = 0; j < m; ++j)
+					x_i[j] *= inv;
+			}
+
+			return X;
+		}
+
+		// Returns the inverse of A.
+		// Throws a std::domain_error if A is singular.
+		Matrix<T, Allocator> inverse() const
+		{
+			const std::size_t n = _lu.rowCount();
+			Matrix<T, Allocator> I(n, n, T(0), _lu.get_allocator());
+
+			for (std::size_t i = 0; i < n; ++i)
+				I(i, i) = T(1);
+
+			return solve(I);
+		}
+	};
+
+	// Cholesky decomposition of a symmetric positive-definite Matrix A,
+	// such that A = L * transpose(L), where L is lower triangular.
+	//
+	// Only the lower triangle of A is read. This takes about half of
+	// the work of an LU decomposition and needs no pivoting.
+	template <std::floating_point T, typename Allocator = std::allocator<T>> class CholeskyDecomposition
+	{
+		Matrix<T, Allocator> _l;
+		bool _positiveDefinite;
+
+		public:
+
+		// Computes the decomposition of A.
+		// If A is not positive-definite, the decomposition stops early
+		// and isPositiveDefinite() returns false.
+		// Throws a std::invalid_argument if A is not square.
+		explicit CholeskyDecomposition(const Matrix<T, Allocator>& A) : _l(A.rowCount(), A.colCount(), T(0), A.get_allocator()), _positiveDefinite(true)
+		{
+			if (A.rowCount() != A.colCount())
+				throw std::invalid_argument("ERROR: Matrix is not square.");
+
+			const std::size_t n = A.rowCount();
+
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				T* l_i = _l.rowBegin(i);
+
+				for (std::size_t j = 0; j <= i; ++j)
+				{
+					const T* l_j = _l.rowBegin(j);
+					T value = A(i, j);
+
+					for (std::size_t k = 0; k < j; ++k)
+						value -= l_i[k] * l_j[k];
+
+					if (i != j)
+						l_i[j] = value / l_j[j];
+					else if (value > T(0))
+						l_i[i] = std::sqrt(value);
+					else
+					{
+						_positiveDefinite = false;
+						return;
+					}
+				}
+			}
+		}
+
+		// Returns true if A is positive-definite.
+		bool isPositiveDefinite() const noexcept
+		{
+			return _positiveDefinite;
+		}
+
+		// Returns L, the lower triangular factor.
+		const Matrix<T, Allocator>& lower() const noexcept
+		{
+			return _l;
+		}
+
+		// Returns the determinant of A, which is
+		// the square of the product of the diagonal of L.
+		T determinant() const noexcept
+		{
+			if (!_positiveDefinite)
+				return T(0);
+
+			T det = T(1);
+
+			for (std::size_t i = 0; i < _l.rowCount(); ++i)
+				det *= _l(i, i);
+
+			return det * det;
+		}
+
+		// Returns the solution x of A * x = b.
+		// Throws a std::invalid_argument if the size of b does not match A.
+		// Throws a std::domain_error if A is not positive-definite.
+		Array<T, Allocator> solve(const Array<T, Allocator>& b) const
+		{
+			const std::size_t n = _l.rowCount();
+
+			if (b.size() != n)
+				throw std::invalid_argument("ERROR: Matrix dimensions do not match.");
+			if (!_positiveDefinite)
+				throw std::domain_error("ERROR: Matrix is not positive-definite.");
+
+			Array<T, Allocator> x(b);
+
+			// Forward substitution with L.
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				const T* row = _l.rowBegin(i);
+				T value = x[i];
+
+				for (std::size_t j = 0; j < i; ++j)
+					value -= row[j] * x[j];
+
+				x[i] = value / row[i];
+			}
+
+			// Back substitution with the transpose of L.
+			// Each solved element is removed from the ones
+			// above it, so L is still read row by row.
+			for (std::size_t i = n; i-- > 0;)
+			{
+				const T* row = _l.rowBegin(i);
+				x[i] /= row[i];
+
+				for (std::size_t j = 0; j < i; ++j)
+					x[j] -= row[j] * x[i];
+			}
+
+			return x;
+		}
+
+		// Returns the solution X of A * X = B.
+		// Each column of B is a separate right-hand side.
+		// Throws a std::invalid_argument if the row count of B does not match A.
+		// Throws a std::domain_error if A is not positive-definite.
+		Matrix<T, Allocator> solve(const Matrix<T, Allocator>& B) const
+		{
+			const std::size_t n = _l.rowCount();
+			const std::size_t m = B.colCount();
+
+			if (B.rowCount() != n)
+				throw std::invalid_argument("ERROR: Matrix dimensions do not match.");
+			if (!_positiveDefinite)
+				throw std::domain_error("ERROR: Matrix is not positive-definite.");
+
+			Matrix<T, Allocator> X(B);
+
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				T* x_i = X.rowBegin(i);
+
+				for (std::size_t k = 0; k < i; ++k)
+				{
+					const T l = _l(i, k);
+					const T* x_k = X.rowBegin(k);
+
+					for (std::size_t j = 0; j < m; ++j)
+						x_i[j] -= l * x_k[j];
+				}
+
+				const T inv = T(1) / _l(i, i);
+
+				for (std::size_t j = 0; j < m; ++j)
+					x_i[j] *= inv;
+			}
+
+			for (std::size_t i = n; i-- > 0;)
+			{
+				T* x_i = X.rowBegin(i);
+				const T inv = T(1) / _l(i, i);
+
+				for (std::size_t j = 0; j < m; ++j)
+					x_i[j] *= inv;
+
+				for (std::size_t k = 0; k < i; ++k)
+				{
+					const T l = _l(i, k);
+					T* x_k = X.rowBegin(k);
+
+					for (std::size_t j = 0; j < m; ++j)
+						x_k[j] -= l * x_i[j];
+				}
+			}
+
+			return X;
+		}
+	};
+
+	// Householder QR decomposition of an m x n Matrix A with m >= n,
+	// such that A = Q * R, where Q is an m x n Matrix with orthonormal
+	// columns and R is an n x n upper triangular Matrix.
+	//
+	// The Householder vectors are stored below the diagonal and R above it.
+	// The decomposition solves square systems without pivoting and
+	// overdetermined systems in the least squares sense.
+	template <std::floating_point T, typename Allocator = std::allocator<T>> class QRDecomposition
+	{
+		Matrix<T, Allocator> _qr;
+		Array<T, Allocator> _rdiag;
+
+		// Applies the Householder reflections to the rows of X,
+		// which gives transpose(Q) * X in the first n rows.
+		void applyQt(Matrix<T, Allocator>& X) const
+		{
+			const std::size_t rows = _qr.rowCount();
+			const std::size_t cols = _qr.colCount();
+			const std::size_t m = X.colCount();
+			Array<T, Allocator> s(m, _rdiag.get_allocator());
+
+			for (std::size_t k = 0; k < cols; ++k)
+			{
+				if (_qr(k, k) == T(0))
+					continue;
+
+				std::fill(s.begin(), s.end(), T(0));
+
+				for (std::size_t i = k; i < rows; ++i)
+				{
+					const T v = _qr(i, k);
+					const T* x_i = X.rowBegin(i);
+
+					for (std::size_t j = 0; j < m; ++j)
+						s[j] += v * x_i[j];
+				}
+
+				const T scale = T(-1) / _qr(k, k);
+
+				for (std::size_t j = 0; j < m; ++j)
+					s[j] *= scale;
+
+				for (std::size_t i = k; i < rows; ++i)
+				{
+					const T v = _qr(i, k);
+					T* x_i = X.rowBegin(i);
+
+					for (std::size_t j = 0; j < m; ++j)
+						x_i[j] += s[j] * v;
+				}
+			}
+		}
+
+		public:
+
+		// Computes the decomposition of A.
+		// Throws a std::invalid_argument if A has fewer rows than columns.
+		explicit QRDecomposition(const Matrix<T, Allocator>& A) : _qr(A), _rdiag(A.colCount(), A.get_allocator())
+		{
+			const std::size_t rows = A.rowCount();
+			const std::size_t cols = A.colCount();
+
+			if (rows < cols)
+				throw std::invalid_argument("ERROR: Matrix has fewer rows than columns.");
+
+			Array<T, Allocator> s(cols, A.get_allocator());
+
+			for (std::size_t k = 0; k < cols; ++k)
+			{
+				// The norm of the column is scaled by its largest
+				// element so the sum of squares cannot overflow.
+				T largest = T(0);
+
+				for (std::size_t i = k; i < rows; ++i)
+					largest = std::max(largest, std::abs(_qr(i, k)));
+
+				T norm = T(0);
+
+				if (largest != T(0))
+				{
+					for (std::size_t i = k; i < rows; ++i)
+					{
+						const T x = _qr(i, k) / largest;
+						norm += x * x;
+					}
+
+					norm = largest * std::sqrt(norm);
+
+					if (_qr(k, k) < T(0))
+						norm = -norm;
+
+					for (std::size_t i = k; i < rows; ++i)
+						_qr(i, k) /= norm;
+
+					_qr(k, k) += T(1);
+
+					// Reflects the remaining columns. The dot products with the
+					// Householder vector are accumulated for all of the columns
+					// at once, so the Matrix is read row by row.
+					std::fill(s.begin() + k + 1, s.end(), T(0));
+
+					for (std::size_t i = k; i < rows; ++i)
+					{
+						const T v = _qr(i, k);
+						const T* row = _qr.rowBegin(i);
+
+						for (std::size_t j = k + 1; j < cols; ++j)
+							s[j] += v * row[j];
+					}
+
+					const T scale = T(-1) / _qr(k, k);
+
+					for (std::size_t j = k + 1; j < cols; ++j)
+						s[j] *= scale;
+
+					for (std::size_t i = k; i < rows; ++i)
+					{
+						const T v = _qr(i, k);
+						T* row = _qr.rowBegin(i);
+
+						for (std::size_t j = k + 1; j < cols; ++j)
+							row[j] += s[j] * v;
+					}
+				}
+
+				_rdiag[k] = -norm;
+			}
+		}
+
+		// Returns true if R, and therefore A, has full rank.
+		bool isFullRank() const noexcept
+		{
+			for (std::size_t i = 0; i < _rdiag.size(); ++i)
+			{
+				if (_rdiag[i] == T(0))
+					return false;
+			}
+
+			return true;
+		}
+
+		// Returns Q, the m x n Matrix with orthonormal columns.
+		Matrix<T, Allocator> q() const
+		{
+			const std::size_t rows = _qr.rowCount();
+			const std::size_t cols = _qr.colCount();
+			Matrix<T, Allocator> Q(rows, cols, T(0), _qr.get_allocator());
+
+			for (std::size_t i = 0; i < cols; ++i)
+				Q(i, i) = T(1);
+
+			// Applies the reflections in reverse order to the
+			// first n columns of the identity, Q = H0 * H1 * ... * I.
+			Array<T, Allocator> s(cols, _rdiag.get_allocator());
+
+			for (std::size_t k = cols; k-- > 0;)
+			{
+				if (_qr(k, k) == T(0))
+					continue;
+
+				std::fill(s.begin() + k, s.end(), T(0));
+
+				for (std::size_t i = k; i < rows; ++i)
+				{
+					const T v = _qr(i, k);
+					const T* row = Q.rowBegin(i);
+
+					for (std::size_t j = k; j < cols; ++j)
+						s[j] += v * row[j];
+				}
+
+				const T scale = T(-1) / _qr(k, k);
+
+				for (std::size_t i = k; i < rows; ++i)
+				{
+					const T v = _qr(i, k) * scale;
+					T* row = Q.rowBegin(i);
+
+					for (std::size_t j = k; j < cols; ++j)
+						row[j] += s[j] * v;
+				}
+			}
+
+			return Q;
+		}
+
+		// Returns R, the n x n upper triangular Matrix.
+		Matrix<T, Allocator> r() const
+		{
+			const std::size_t cols = _qr.colCount();
+			Matrix<T, Allocator> R(cols, cols, T(0), _qr.get_allocator());
+
+			for (std::size_t i = 0; i < cols; ++i)
+			{
+				R(i, i) = _rdiag[i];
+				std::copy(_qr.rowBegin(i) + i + 1, _qr.rowBegin(i) + cols, R.rowBegin(i) + i + 1);
+			}
+
+			return R;
+		}
+
+		// Returns the x that minimizes the length of A * x - b.
+		// If A is square, this is the solution of A * x = b.
+		// Throws a std::invalid_argument if the size of b does not match A.
+		// Throws a std::domain_error if A does not have full rank.
+		Array<T, Allocator> solve(const Array<T, Allocator>& b) const
+		{
+			Matrix<T, Allocator> B(b.size(), 1, b.get_allocator());
+			std::copy(b.begin(), b.end(), B.data());
+
+			Matrix<T, Allocator> X = solve(B);
+			return Array<T, Allocator>(X.data(), X.data() + X.size(), b.get_allocator());
+		}
+
+		// Returns the X that minimizes the length of each column of A * X - B.
+		// Each column of B is a separate right-hand side.
+		// Throws a std::invalid_argument if the row count of B does not match A.
+		// Throws a std::domain_error if A does not have full rank.
+		Matrix<T, Allocator> solve(const Matrix<T, Allocator>& B) const
+		{
+			const std::size_t cols = _qr.colCount();
+			const std::size_t m = B.colCount();
+
+			if (B.rowCount() != _qr.rowCount())
+				throw std::invalid_argument("ERROR: Matrix dimensions do not match.");
+			if (!isFullRank())
+				throw std::domain_error("ERROR: Matrix is rank deficient.");
+
+			Matrix<T, Allocator> Y(B);
+			applyQt(Y);
+
+			Matrix<T, Allocator> X(cols, m, B.get_allocator());
+			std::copy(Y.data(), Y.data() + (cols * m), X.data());
+
+			// Back substitution with R.
+			for (std::size_t i = cols; i-- > 0;)
+			{
+				T* x_i = X.rowBegin(i);
+
+				for (std::size_t k = i + 1; k < cols; ++k)
+				{
+					const T r = _qr(i, k);
+					const T* x_k = X.rowBegin(k);
+
+					for (std::size_t j = 0; j < m; ++j)
+						x_i[j] -= r * x_k[j];
+				}
+
+				const T inv = T(1) / _rdiag[i];
+
+				for (std::size_t j = 0; j < m; ++j)
+					x_i[j] *= inv;
+			}
+
+			return X;
+		}
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Returns the solution x of A * x = b.
+	// Square systems are solved with an LU decomposition and
+	// overdetermined systems in the least squares sense with a QR decomposition.
+	// Throws a std::invalid_argument if the dimensions do not match
+	// or if A has fewer rows than columns.
+	// Throws a std::domain_error if A is singular.
+	template <std::floating_point T, typename Allocator>
+	Array<T, Allocator> solve(const Matrix<T, Allocator>& A, const Array<T, Allocator>& b)
+	{
+		if (A.rowCount() == A.colCount())
+			return LUDecomposition<T, Allocator>(A).solve(b);
+
+		return QRDecomposition<T, Allocator>(A).solve(b);
+	}
+
+	// Returns the solution X of A * X = B.
+	// Each column of B is a separate right-hand side.
+	// Square systems are solved with an LU decomposition and
+	// overdetermined systems in the least squares sense with a QR decomposition.
+	// Throws a std::invalid_argument if the dimensions do not match
+	// or if A has fewer rows than columns.
+	// Throws a std::domain_error if A is singular.
+	template <std::floating_point T, typename Allocator>
+	Matrix<T, Allocator> solve(const Matrix<T, Allocator>& A, const Matrix<T, Allocator>& B)
+	{
+		if (A.rowCount() == A.colCount())
+			return LUDecomposition<T, Allocator>(A).solve(B);
+
+		return QRDecomposition<T, Allocator>(A).solve(B);
+	}
+
+	// Returns the inverse of the square Matrix.
+	// Throws a std::invalid_argument if A is not square.
+	// Throws a std::domain_error if A is singular.
+	template <std::floating_point T, typename Allocator>
+	Matrix<T, Allocator> inverse(const Matrix<T, Allocator>& A)
+	{
+		return LUDecomposition<T, Allocator>(A).inverse();
+	}
+
+	// Returns the determinant of the square Matrix.
+	// Throws a std::invalid_argument if A is not square.
+	template <std::floating_point T, typename Allocator>
+	T determinant(const Matrix<T, Allocator>& A)
+	{
+		return LUDecomposition<T, Allocator>(A).determinant();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,238 @@
+// JLibrary
+// MatrixExpression.ixx
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Module file for the lazy element-wise matrix expressions.
+
+module;
+
+#include "Arithmetic.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+export module MatrixExpression;
+
+export namespace jlib
+{
+	// Specialized as true for the matrix types that can be
+	// operands of a matrix expression, such as Matrix and FixedMatrix.
+	// They must store their elements row by row and provide
+	// value_type, rowCount(), colCount() and operator [] (n).
+	template <typename T> constexpr bool enable_matrix_expression = false;
+
+	// Base class of the nodes of a matrix expression.
+	struct MatrixExpressionNode
+	{
+
+	};
+
+	// A node of a matrix expression, such as A + B.
+	template <typename E>
+	concept matrix_expression_node = std::derived_from<std::remove_cvref_t<E>, MatrixExpressionNode>;
+
+	// Anything that can be an operand of a matrix expression.
+	template <typename E>
+	concept matrix_expression = matrix_expression_node<E> || enable_matrix_expression<std::remove_cvref_t<E>>;
+
+	// Nodes are small and are stored by value, so an expression can be
+	// returned from a function. Matrices are stored by reference, so they
+	// must outlive any expression that refers to them.
+	template <typename E>
+	using _expression_storage_t = std::conditional_t<matrix_expression_node<E>, const E, const E&>;
+
+	// Element-wise operation on two matrix expressions, such as A + B.
+	// Nothing is computed until an element is requested, so a chain
+	// like A + B * s - C is evaluated in a single loop when it is
+	// assigned to a Matrix or FixedMatrix, without temporaries.
+	template <typename Op, matrix_expression L, matrix_expression R>
+	class MatrixBinaryExpression : public MatrixExpressionNode
+	{
+		_expression_storage_t<L> _lhs;
+		_expression_storage_t<R> _rhs;
+
+		public:
+
+		using value_type = typename L::value_type;
+
+		// Throws a std::invalid_argument if the dimensions do not match.
+		constexpr MatrixBinaryExpression(const L& lhs, const R& rhs) : _lhs(lhs), _rhs(rhs)
+		{
+			if (lhs.rowCount() != rhs.rowCount() || lhs.colCount() != rhs.colCount())
+				throw std::invalid_argument("ERROR: Matrix dimensions do not match.");
+		}
+
+		// Returns the number of rows of the result.
+		constexpr std::size_t rowCount() const noexcept
+		{
+			return _lhs.rowCount();
+		}
+
+		// Returns the number of columns of the result.
+		constexpr std::size_t colCount() const noexcept
+		{
+			return _lhs.colCount();
+		}
+
+		// Returns the number of elements of the result.
+		constexpr std::size_t size() const noexcept
+		{
+			return rowCount() * colCount();
+		}
+
+		// Computes the element at the given index of the result.
+		constexpr value_type operator [] (std::size_t n) const
+		{
+			return static_cast<value_type>(Op()(_lhs[n], _rhs[n]));
+		}
+
+		// Computes the element at [row][col] of the result.
+		constexpr value_type operator () (std::size_t row, std::size_t col) const
+		{
+			return (*this)[(row * colCount()) + col];
+		}
+	};
+
+	// Element-wise operation on a matrix expression, such as -A.
+	template <typename Op, matrix_expression E>
+	class MatrixUnaryExpression : public MatrixExpressionNode
+	{
+		_expression_storage_t<E> _expr;
+
+		public:
+
+		using value_type = typename E::value_type;
+
+		constexpr explicit MatrixUnaryExpression(const E& expr) : _expr(expr)
+		{
+
+		}
+
+		// Returns the number of rows of the result.
+		constexpr std::size_t rowCount() const noexcept
+		{
+			return _expr.rowCount();
+		}
+
+		// Returns the number of columns of the result.
+		constexpr std::size_t colCount() const noexcept
+		{
+			return _expr.colCount();
+		}
+
+		// Returns the number of elements of the result.
+		constexpr std::size_t size() const noexcept
+		{
+			return rowCount() * colCount();
+		}
+
+		// Computes the element at the given index of the result.
+		constexpr value_type operator [] (std::size_t n) const
+		{
+			return static_cast<value_type>(Op()(_expr[n]));
+		}
+
+		// Computes the element at [row][col] of the result.
+		constexpr value_type operator () (std::size_t row, std::size_t col) const
+		{
+			return (*this)[(row * colCount()) + col];
+		}
+	};
+
+	// Element-wise operation of a matrix expression and a scalar, such as A * s.
+	template <typename Op, matrix_expression E, arithmetic S>
+	class MatrixScalarExpression : public MatrixExpressionNode
+	{
+		_expression_storage_t<E> _expr;
+		S _scalar;
+
+		public:
+
+		using value_type = typename E::value_type;
+
+		constexpr MatrixScalarExpression(const E& expr, S scalar) : _expr(expr), _scalar(scalar)
+		{
+
+		}
+
+		// Returns the number of rows of the result.
+		constexpr std::size_t rowCount() const noexcept
+		{
+			return _expr.rowCount();
+		}
+
+		// Returns the number of columns of the result.
+		constexpr std::size_t colCount() const noexcept
+		{
+			return _expr.colCount();
+		}
+
+		// Returns the number of elements of the result.
+		constexpr std::size_t size() const noexcept
+		{
+			return rowCount() * colCount();
+		}
+
+		// Computes the element at the given index of the result.
+		constexpr value_type operator [] (std::size_t n) const
+		{
+			return static_cast<value_type>(Op()(_expr[n], _scalar));
+		}
+
+		// Computes the element at [row][col] of the result.
+		constexpr value_type operator () (std::size_t row, std::size_t col) const
+		{
+			return (*this)[(row * colCount()) + col];
+		}
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Overload of unary operator -
+	template <matrix_expression E>
+	constexpr auto operator - (const E& A)
+	{
+		return MatrixUnaryExpression<std::negate<>, E>(A);
+	}
+
+	// Overload of binary operator +
+	// Throws a std::invalid_argument if the dimensions do not match.
+	template <matrix_expression L, matrix_expression R>
+	constexpr auto operator + (const L& A, const R& B)
+	{
+		return MatrixBinaryExpression<std::plus<>, L, R>(A, B);
+	}
+
+	// Overload of binary operator -
+	// Throws a std::invalid_argument if the dimensions do not match.
+	template <matrix_expression L, matrix_expression R>
+	constexpr auto operator - (const L& A, const R& B)
+	{
+		return MatrixBinaryExpression<std::minus<>, L, R>(A, B);
+	}
+
+	// Overload of binary operator *
+	template <matrix_expression E, arithmetic S>
+	constexpr auto operator * (const E& A, S scalar)
+	{
+		return MatrixScalarExpression<std::multiplies<>, E, S>(A, scalar);
+	}
+
+	// Overload of binary operator *
+	template <arithmetic S, matrix_expression E>
+	constexpr auto operator * (S scalar, const E& A)
+	{
+		return MatrixScalarExpression<std::multiplies<>, E, S>(A, scalar);
+	}
+
+	// Overload of binary operator /
+	template <matrix_expression E, arithmetic S>
+	constexpr auto operator / (const E& A, S scalar)
+	{
+		return MatrixScalarExpression<std::divides<>, E, S>(A, scalar);
+	}
+}
\ No newline at end of file
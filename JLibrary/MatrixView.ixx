@@ -0,0 +1,451 @@
+// JLibrary
+// MatrixView.ixx
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Module file for the MatrixView and ColumnView template classes and the tiled transpose.
+
+module;
+
+#include "Simd.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <execution>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+export module MatrixView;
+
+import ColumnIterator;
+
+namespace jlib
+{
+	// Side length of the square tiles used by the transposes.
+	// A tile of doubles spans 32 cache lines of the source and
+	// 32 cache lines of the destination, which both fit in L1.
+	inline constexpr std::size_t _transpose_tile = 32;
+
+	// Transposes of fewer elements than this run on a single thread.
+	inline constexpr std::size_t _parallel_transpose = std::size_t(1) << 18;
+
+	// Writes the transpose of the rows x cols block at src into dst.
+	// Blocks of floats are transposed 4 x 4 at a time in SSE registers.
+	template <typename T>
+	void _transpose_block(const T* src, std::size_t src_stride, T* dst, std::size_t dst_stride, std::size_t rows, std::size_t cols)
+	{
+		std::size_t row = 0;
+
+		#ifdef JLIB_SIMD_X86
+		if constexpr (std::is_same_v<T, float>)
+		{
+			for (; row + 4 <= rows; row += 4)
+			{
+				const float* s = src + (row * src_stride);
+				std::size_t col = 0;
+
+				for (; col + 4 <= cols; col += 4)
+				{
+					__m128 r0 = _mm_loadu_ps(s + col);
+					__m128 r1 = _mm_loadu_ps(s + src_stride + col);
+					__m128 r2 = _mm_loadu_ps(s + (2 * src_stride) + col);
+					__m128 r3 = _mm_loadu_ps(s + (3 * src_stride) + col);
+
+					_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+					float* d = dst + (col * dst_stride) + row;
+					_mm_storeu_ps(d, r0);
+					_mm_storeu_ps(d + dst_stride, r1);
+					_mm_storeu_ps(d + (2 * dst_stride), r2);
+					_mm_storeu_ps(d + (3 * dst_stride), r3);
+				}
+
+				for (; col < cols; ++col)
+				{
+					for (std::size_t i = 0; i < 4; ++i)
+						dst[(col * dst_stride) + row + i] = s[(i * src_stride) + col];
+				}
+			}
+		}
+		#endif // JLIB_SIMD_X86
+
+		for (; row < rows; ++row)
+		{
+			for (std::size_t col = 0; col < cols; ++col)
+				dst[(col * dst_stride) + row] = src[(row * src_stride) + col];
+		}
+	}
+
+	// Calls op(first, count) for each band of tile rows in [0, rows).
+	// The bands run in parallel if the transpose is large enough.
+	template <typename Op>
+	void _for_each_band(std::size_t rows, std::size_t elements, Op op)
+	{
+		std::vector<std::size_t> bands((rows + _transpose_tile - 1) / _transpose_tile);
+		std::iota(bands.begin(), bands.end(), std::size_t(0));
+
+		auto band = [&](std::size_t b)
+		{
+			std::size_t first = b * _transpose_tile;
+			op(first, std::min(_transpose_tile, rows - first));
+		};
+
+		if (elements >= _parallel_transpose && bands.size() > 1)
+			std::for_each(std::execution::par, bands.begin(), bands.end(), band);
+		else
+			std::for_each(bands.begin(), bands.end(), band);
+	}
+}
+
+export namespace jlib
+{
+	// Non-owning view of a column of a matrix stored row by row.
+	// Consecutive elements are stride elements apart.
+	// The viewed elements must outlive the view.
+	template <typename T> class ColumnView
+	{
+		public:
+
+		using value_type = std::remove_cv_t<T>;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = T&;
+		using pointer = T*;
+		using iterator = ColumnIterator<T>;
+
+		private:
+
+		pointer _data;
+		size_type _size;
+		size_type _stride;
+
+		public:
+
+		// Default constructor.
+		// Creates an empty view.
+		constexpr ColumnView() noexcept
+		{
+			_data = nullptr;
+			_size = 0;
+			_stride = 0;
+		}
+
+		// Views size elements starting at data, stride elements apart.
+		constexpr ColumnView(pointer data, size_type size, size_type stride) noexcept
+		{
+			_data = data;
+			_size = size;
+			_stride = stride;
+		}
+
+		// Converting constructor.
+		// Allows a ColumnView<T> to be used as a ColumnView<const T>.
+		template <typename U> requires std::is_convertible_v<U*, T*>
+		constexpr ColumnView(const ColumnView<U>& other) noexcept
+		{
+			_data = other.data();
+			_size = other.size();
+			_stride = other.stride();
+		}
+
+		// Returns a pointer to the first element.
+		constexpr pointer data() const noexcept
+		{
+			return _data;
+		}
+
+		// Returns the number of elements.
+		constexpr size_type size() const noexcept
+		{
+			return _size;
+		}
+
+		// Returns the distance between consecutive elements.
+		constexpr size_type stride() const noexcept
+		{
+			return _stride;
+		}
+
+		// Returns true if the view has no elements.
+		constexpr bool isEmpty() const noexcept
+		{
+			return _size == 0;
+		}
+
+		// Returns an iterator pointing to the first element.
+		constexpr iterator begin() const noexcept
+		{
+			return iterator(_data, _stride);
+		}
+
+		// Returns an iterator pointing to 1 past the last element.
+		constexpr iterator end() const noexcept
+		{
+			return iterator(_data, _stride) + static_cast<difference_type>(_size);
+		}
+
+		// Returns the element at the given index.
+		// Throws a std::out_of_range if given an invalid index.
+		constexpr reference at(size_type n) const
+		{
+			if (n >= _size)
+				throw std::out_of_range("ERROR: Invalid index.");
+
+			return _data[n * _stride];
+		}
+
+		// Returns the element at the given index.
+		// Does NOT perform bounds-checking.
+		constexpr reference operator [] (size_type n) const noexcept
+		{
+			return _data[n * _stride];
+		}
+	};
+
+	// Non-owning view of a 2-dimensional block of elements stored row by row,
+	// such as a Matrix, a FixedMatrix or a rectangular region of either.
+	// Rows are stride elements apart, so a view of a region refers
+	// to the elements of its parent without copying them.
+	// The viewed elements must outlive the view.
+	template <typename T> class MatrixView
+	{
+		public:
+
+		using value_type = std::remove_cv_t<T>;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = T&;
+		using pointer = T*;
+		using row_iterator = T*;
+		using column_iterator = ColumnIterator<T>;
+
+		private:
+
+		pointer _data;
+		size_type _rows;
+		size_type _cols;
+		size_type _stride;
+
+		public:
+
+		// Default constructor.
+		// Creates an empty view.
+		constexpr MatrixView() noexcept
+		{
+			_data = nullptr;
+			_rows = 0;
+			_cols = 0;
+			_stride = 0;
+		}
+
+		// Views a rows x cols block of contiguous rows starting at data.
+		constexpr MatrixView(pointer data, size_type rows, size_type cols) noexcept
+		{
+			_data = data;
+			_rows = rows;
+			_cols = cols;
+			_stride = cols;
+		}
+
+		// Views a rows x cols block starting at data,
+		// with the rows stride elements apart.
+		constexpr MatrixView(pointer data, size_type rows, size_type cols, size_type stride) noexcept
+		{
+			_data = data;
+			_rows = rows;
+			_cols = cols;
+			_stride = stride;
+		}
+
+		// Converting constructor.
+		// Allows a MatrixView<T> to be used as a MatrixView<const T>.
+		template <typename U> requires std::is_convertible_v<U*, T*>
+		constexpr MatrixView(const MatrixView<U>& other) noexcept
+		{
+			_data = other.data();
+			_rows = other.rowCount();
+			_cols = other.colCount();
+			_stride = other.stride();
+		}
+
+		// Returns a pointer to the first element.
+		constexpr pointer data() const noexcept
+		{
+			return _data;
+		}
+
+		// Returns the number of rows.
+		constexpr size_type rowCount() const noexcept
+		{
+			return _rows;
+		}
+
+		// Returns the number of columns.
+		constexpr size_type colCount() const noexcept
+		{
+			return _cols;
+		}
+
+		// Returns the number of elements.
+		constexpr size_type size() const noexcept
+		{
+			return _rows * _cols;
+		}
+
+		// Returns the distance between the starts of consecutive rows.
+		constexpr size_type stride() const noexcept
+		{
+			return _stride;
+		}
+
+		// Returns true if the view has no elements.
+		constexpr bool isEmpty() const noexcept
+		{
+			return _rows == 0 || _cols == 0;
+		}
+
+		// Returns true if the rows follow each other without gaps.
+		constexpr bool isContiguous() const noexcept
+		{
+			return _stride == _cols || _rows <= 1;
+		}
+
+		// Returns an iterator pointing to the first element of the given row.
+		constexpr row_iterator rowBegin(size_type row) const noexcept
+		{
+			return _data + (row * _stride);
+		}
+
+		// Returns an iterator pointing to 1 past the last element of the given row.
+		constexpr row_iterator rowEnd(size_type row) const noexcept
+		{
+			return _data + (row * _stride) + _cols;
+		}
+
+		// Returns an iterator pointing to the first element of the given column.
+		constexpr column_iterator colBegin(size_type col) const noexcept
+		{
+			return column_iterator(_data + col, _stride);
+		}
+
+		// Returns an iterator pointing to 1 past the last element of the given column.
+		constexpr column_iterator colEnd(size_type col) const noexcept
+		{
+			return colBegin(col) + static_cast<difference_type>(_rows);
+		}
+
+		// Returns a view of the given row.
+		// Throws a std::out_of_range if given an invalid row index.
+		constexpr std::span<T> row(size_type row) const
+		{
+			if (row >= _rows)
+				throw std::out_of_range("ERROR: Invalid row index.");
+
+			return std::span<T>(rowBegin(row), _cols);
+		}
+
+		// Returns a view of the given column.
+		// Throws a std::out_of_range if given an invalid column index.
+		constexpr ColumnView<T> col(size_type col) const
+		{
+			if (col >= _cols)
+				throw std::out_of_range("ERROR: Invalid column index.");
+
+			return ColumnView<T>(_data + col, _rows, _stride);
+		}
+
+		// Returns a view of the rows x cols region whose
+		// first element is at [row][col].
+		// Throws a std::out_of_range if the region does not fit in the view.
+		constexpr MatrixView subview(size_type row, size_type col, size_type rows, size_type cols) const
+		{
+			if (row > _rows || rows > _rows - row || col > _cols || cols > _cols - col)
+				throw std::out_of_range("ERROR: Invalid region.");
+
+			return MatrixView(_data + (row * _stride) + col, rows, cols, _stride);
+		}
+
+		// Returns the element at [row][col].
+		// Throws a std::out_of_range if given an invalid index.
+		constexpr reference at(size_type row, size_type col) const
+		{
+			if (row >= _rows)
+				throw std::out_of_range("ERROR: Invalid row index.");
+			if (col >= _cols)
+				throw std::out_of_range("ERROR: Invalid column index.");
+
+			return _data[(row * _stride) + col];
+		}
+
+		// Returns the element at [row][col].
+		// Does NOT perform bounds-checking.
+		constexpr reference operator () (size_type row, size_type col) const noexcept
+		{
+			return _data[(row * _stride) + col];
+		}
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Writes the transpose of src into dst, which must not overlap src.
+	// The views are walked in 32 x 32 tiles, so both the reads and the
+	// strided writes stay in cache, and large transposes are split
+	// across threads by bands of rows.
+	// Throws a std::invalid_argument if dst is not colCount() x rowCount() of src.
+	template <typename T>
+	void transpose(MatrixView<const std::type_identity_t<T>> src, MatrixView<T> dst)
+	{
+		if (dst.rowCount() != src.colCount() || dst.colCount() != src.rowCount())
+			throw std::invalid_argument("ERROR: Matrix dimensions do not match.");
+
+		const std::size_t cols = src.colCount();
+
+		_for_each_band(src.rowCount(), src.size(), [&](std::size_t row, std::size_t rows)
+		{
+			for (std::size_t col = 0; col < cols; col += _transpose_tile)
+			{
+				_transpose_block(src.rowBegin(row) + col, src.stride(), dst.rowBegin(col) + row, dst.stride(),
+								 rows, std::min(_transpose_tile, cols - col));
+			}
+		});
+	}
+
+	// Transposes the square view in place.
+	// Each pair of mirrored 32 x 32 tiles is swapped in one pass,
+	// and the bands of tile rows are split across threads.
+	// Throws a std::invalid_argument if the view is not square.
+	template <typename T>
+	void transpose_in_place(MatrixView<T> M)
+	{
+		if (M.rowCount() != M.colCount())
+			throw std::invalid_argument("ERROR: Matrix is not square.");
+
+		const std::size_t n = M.rowCount();
+
+		_for_each_band(n, M.size(), [&](std::size_t row, std::size_t rows)
+		{
+			// The tile on the diagonal.
+			for (std::size_t i = 0; i < rows; ++i)
+			{
+				for (std::size_t j = i + 1; j < rows; ++j)
+					std::swap(M(row + i, row + j), M(row + j, row + i));
+			}
+
+			// The tiles right of the diagonal and their mirrors below it.
+			for (std::size_t col = row + rows; col < n; col += _transpose_tile)
+			{
+				const std::size_t cols = std::min(_transpose_tile, n - col);
+
+				for (std::size_t i = 0; i < rows; ++i)
+				{
+					for (std::size_t j = 0; j < cols; ++j)
+						std::swap(M(row + i, col + j), M(col + j, row + i));
+				}
+			}
+		});
+	}
+}
\ No newline at end of file
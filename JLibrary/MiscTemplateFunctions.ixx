@@ -1,52 +1,417 @@
 // JLibrary
 // MiscTemplateFunctions.ixx
 // Created on 2022-01-08 by Justyn Durnford
-// Last modified on 2022-09-28 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
 // Module file defining several template functions.
 
 module;
 
 #include "Arithmetic.hpp"
+#include "Simd.hpp"
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstddef>
+#include <execution>
 #include <functional>
 #include <iostream>
 #include <numeric>
+#include <type_traits>
+#include <vector>
 
 export module MiscTemplateFunctions;
 
 import ComplexNumber;
 
+namespace jlib
+{
+	// Number of elements each task of a parallel reduction processes.
+	// It does not depend on the number of threads, so the results of
+	// the reductions are the same on every machine.
+	inline constexpr std::size_t _reduction_chunk = 65536;
+
+	// Floating-point numbers are accumulated in their own type,
+	// integers in the widest integer type of the same signedness.
+	template <typename T>
+	using _accumulator_t = std::conditional_t<std::is_floating_point_v<T>, T,
+		std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>>;
+
+	// Splits [0, count) into chunks of _reduction_chunk elements,
+	// reduces every chunk with chunk_op(offset, size) and folds the
+	// results in order with combine. The chunks are processed in
+	// parallel when there is more than one.
+	template <typename R, typename ChunkOp, typename Combine>
+	R _reduce_chunks(std::size_t count, ChunkOp chunk_op, Combine combine)
+	{
+		if (count <= _reduction_chunk)
+			return chunk_op(std::size_t(0), count);
+
+		struct Slot
+		{
+			R value;
+		};
+
+		std::vector<Slot> slots((count + _reduction_chunk - 1) / _reduction_chunk);
+
+		std::for_each(std::execution::par, slots.begin(), slots.end(), [&](Slot& slot)
+		{
+			std::size_t offset = static_cast<std::size_t>(&slot - slots.data()) * _reduction_chunk;
+			slot.value = chunk_op(offset, std::min(_reduction_chunk, count - offset));
+		});
+
+		R result = slots[0].value;
+
+		for (std::size_t i = 1; i < slots.size(); ++i)
+			result = combine(result, slots[i].value);
+
+		return result;
+	}
+
+	// Returns the sum of the count numbers starting at ptr.
+	// Sums blocks of 128 numbers in 8 independent lanes, which the
+	// compiler can vectorize, and adds the blocks pairwise.
+	// The error grows with log(count) instead of count.
+	template <typename T>
+	T _pairwise_sum(const T* ptr, std::size_t count)
+	{
+		if (count <= 128)
+		{
+			T lanes[8] = {};
+			std::size_t i = 0;
+
+			for (; i + 8 <= count; i += 8)
+			{
+				for (std::size_t j = 0; j < 8; ++j)
+					lanes[j] += ptr[i + j];
+			}
+
+			T sum = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+
+			for (; i < count; ++i)
+				sum += ptr[i];
+
+			return sum;
+		}
+
+		std::size_t half = (count / 2) & ~std::size_t(7);
+		return _pairwise_sum(ptr, half) + _pairwise_sum(ptr + half, count - half);
+	}
+
+	// Returns the sum of the count products A[i] * B[i], added pairwise.
+	template <typename T>
+	T _pairwise_dot(const T* A, const T* B, std::size_t count)
+	{
+		if (count <= 128)
+		{
+			T lanes[8] = {};
+			std::size_t i = 0;
+
+			for (; i + 8 <= count; i += 8)
+			{
+				for (std::size_t j = 0; j < 8; ++j)
+					lanes[j] += A[i + j] * B[i + j];
+			}
+
+			T sum = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+
+			for (; i < count; ++i)
+				sum += A[i] * B[i];
+
+			return sum;
+		}
+
+		std::size_t half = (count / 2) & ~std::size_t(7);
+		return _pairwise_dot(A, B, half) + _pairwise_dot(A + half, B + half, count - half);
+	}
+
+	// Compensated sum of floating-point numbers.
+	// add() uses the Kahan-Babuska-Neumaier update, which stays
+	// exact even when the added number is larger than the sum.
+	template <typename T>
+	struct _CompensatedSum
+	{
+		T sum = 0;
+		T compensation = 0;
+
+		void add(T value) noexcept
+		{
+			T total = sum + value;
+
+			if (std::abs(sum) >= std::abs(value))
+				compensation += (sum - total) + value;
+			else
+				compensation += (value - total) + sum;
+
+			sum = total;
+		}
+
+		T result() const noexcept
+		{
+			return sum + compensation;
+		}
+	};
+
+	// Returns the Kahan sum of the count numbers starting at ptr.
+	// Runs 8 independent Kahan sums so the loop can be vectorized.
+	template <typename T>
+	_CompensatedSum<T> _kahan_sum(const T* ptr, std::size_t count)
+	{
+		T sums[8] = {};
+		T compensations[8] = {};
+		std::size_t i = 0;
+
+		for (; i + 8 <= count; i += 8)
+		{
+			for (std::size_t j = 0; j < 8; ++j)
+			{
+				T y = ptr[i + j] - compensations[j];
+				T t = sums[j] + y;
+				compensations[j] = (t - sums[j]) - y;
+				sums[j] = t;
+			}
+		}
+
+		_CompensatedSum<T> result;
+
+		for (std::size_t j = 0; j < 8; ++j)
+		{
+			result.add(sums[j]);
+			result.add(-compensations[j]);
+		}
+
+		for (; i < count; ++i)
+			result.add(ptr[i]);
+
+		return result;
+	}
+
+	// Count, mean and sum of squared deviations of a range of numbers.
+	struct _Moments
+	{
+		std::size_t count = 0;
+		double mean = 0.0;
+		double m2 = 0.0;
+	};
+
+	// Merges the moments of two ranges (Chan et al.).
+	inline _Moments _merge_moments(const _Moments& A, const _Moments& B) noexcept
+	{
+		_Moments result;
+		result.count = A.count + B.count;
+
+		double delta = B.mean - A.mean;
+		double weight = double(B.count) / double(result.count);
+
+		result.mean = A.mean + delta * weight;
+		result.m2 = A.m2 + B.m2 + delta * delta * double(A.count) * weight;
+
+		return result;
+	}
+}
+
 export namespace jlib
 {
+	// Summation algorithms for floating-point numbers.
+	// Pairwise: fast, error grows with log(n).
+	// Kahan: slower, error does not grow with n.
+	enum class Summation
+	{
+		Pairwise,
+		Kahan
+	};
 	// Copies every element in the range[from_first, from_first + size) to
 	// the elements in the range [to_first, to_first + size).
 	// This should be used when the types To and From are different.
 	// Otherwise, std::copy from <algorithm> should be used.
+	// Common numeric conversions such as int -> float use SIMD instructions.
 	template <typename To, typename From>
 	void copy(const From* from_first, const From* from_last, To* to_first)
 	{
-		for (std::ptrdiff_t i = 0; i < from_last - from_first; ++i)
-			to_first[i] = static_cast<To>(from_first[i]);
+		simd::convert_n(from_first, to_first, static_cast<std::size_t>(from_last - from_first));
 	}
 
-	// Returns the sum of the passed numbers.
+	// Returns the smallest number in the range [first, last).
+	// The range must not be empty.
 	template <arithmetic T>
-	T add_all(T* first, T* last)
+	T min_value(const T* first, const T* last)
 	{
-		T sum = 0;
+		return _reduce_chunks<T>(static_cast<std::size_t>(last - first),
+			[=](std::size_t offset, std::size_t size) { return simd::min_n(first + offset, size); },
+			[](T A, T B) { return std::min(A, B); });
+	}
+
+	// Returns the largest number in the range [first, last).
+	// The range must not be empty.
+	template <arithmetic T>
+	T max_value(const T* first, const T* last)
+	{
+		return _reduce_chunks<T>(static_cast<std::size_t>(last - first),
+			[=](std::size_t offset, std::size_t size) { return simd::max_n(first + offset, size); },
+			[](T A, T B) { return std::max(A, B); });
+	}
+
+	// Returns the sum of the numbers in the range [first, last).
+	// Large ranges are split across threads.
+	// Floating-point numbers are summed with the given algorithm.
+	// Integers are summed in a 64-bit integer, which is also what is
+	// returned, so the sum of a range of int does not wrap around.
+	template <arithmetic T>
+	_accumulator_t<T> add_all(const T* first, const T* last, Summation method = Summation::Pairwise)
+	{
+		std::size_t count = static_cast<std::size_t>(last - first);
+
+		if constexpr (std::is_floating_point_v<T>)
+		{
+			if (method == Summation::Kahan)
+			{
+				_CompensatedSum<T> sum = _reduce_chunks<_CompensatedSum<T>>(count,
+					[=](std::size_t offset, std::size_t size) { return _kahan_sum(first + offset, size); },
+					[](_CompensatedSum<T> A, const _CompensatedSum<T>& B) { A.add(B.sum); A.add(B.compensation); return A; });
+
+				return sum.result();
+			}
+
+			_CompensatedSum<T> sum = _reduce_chunks<_CompensatedSum<T>>(count,
+				[=](std::size_t offset, std::size_t size) { return _CompensatedSum<T>{ _pairwise_sum(first + offset, size), T(0) }; },
+				[](_CompensatedSum<T> A, const _CompensatedSum<T>& B) { A.add(B.sum); return A; });
+
+			return sum.result();
+		}
+		else
+		{
+			using Acc = _accumulator_t<T>;
+
+			return _reduce_chunks<Acc>(count,
+				[=](std::size_t offset, std::size_t size)
+				{
+					Acc sum = 0;
+
+					for (std::size_t i = offset; i < offset + size; ++i)
+						sum += first[i];
+
+					return sum;
+				},
+				std::plus<Acc>());
+		}
+	}
+
+	// Returns the average of the numbers in the range [first, last).
+	// Integers are summed in a 64-bit integer and floating-point
+	// numbers are summed pairwise, so the sum does not overflow
+	// or lose precision over long ranges. The division is done in double
+	// and only the result is rounded to float.
+	// The range must not be empty.
+	template <arithmetic T>
+	float average(const T* first, const T* last)
+	{
+		std::size_t count = static_cast<std::size_t>(last - first);
+
+		if constexpr (std::is_floating_point_v<T>)
+		{
+			// The chunk sums are added in double so the result is not
+			// rounded to T before the division.
+			_CompensatedSum<double> sum = _reduce_chunks<_CompensatedSum<double>>(count,
+				[=](std::size_t offset, std::size_t size) { return _CompensatedSum<double>{ double(_pairwise_sum(first + offset, size)), 0.0 }; },
+				[](_CompensatedSum<double> A, const _CompensatedSum<double>& B) { A.add(B.sum); return A; });
+
+			return float(sum.result() / double(count));
+		}
+		else
+		{
+			using Acc = _accumulator_t<T>;
+
+			Acc sum = _reduce_chunks<Acc>(count,
+				[=](std::size_t offset, std::size_t size)
+				{
+					Acc sum = 0;
 
-		for (T* ptr = first; ptr < last; ++ptr)
-			sum += *ptr;
+					for (std::size_t i = offset; i < offset + size; ++i)
+						sum += first[i];
 
-		return sum;
+					return sum;
+				},
+				std::plus<Acc>());
+
+			return float(double(sum) / double(count));
+		}
 	}
 
-	// Returns the average of the passed numbers.
+	// Returns the population variance of the numbers in the range [first, last).
+	// Every chunk of the range is reduced with two passes over cached data,
+	// and the chunks are merged with the parallel algorithm of Chan et al.
+	// The range must not be empty.
 	template <arithmetic T>
-	float average(T* first, T* last)
+	double variance(const T* first, const T* last)
 	{
-		return float(add_all(first, last)) / (last - first);
+		std::size_t count = static_cast<std::size_t>(last - first);
+
+		_Moments moments = _reduce_chunks<_Moments>(count,
+			[=](std::size_t offset, std::size_t size)
+			{
+				const T* ptr = first + offset;
+				_Moments result;
+				result.count = size;
+
+				double sum = 0.0;
+
+				for (std::size_t i = 0; i < size; ++i)
+					sum += double(ptr[i]);
+
+				result.mean = sum / double(size);
+
+				for (std::size_t i = 0; i < size; ++i)
+				{
+					double deviation = double(ptr[i]) - result.mean;
+					result.m2 += deviation * deviation;
+				}
+
+				return result;
+			},
+			_merge_moments);
+
+		return moments.m2 / double(count);
+	}
+
+	// Returns the standard deviation of the numbers in the range [first, last).
+	template <arithmetic T>
+	double standard_deviation(const T* first, const T* last)
+	{
+		return std::sqrt(variance(first, last));
+	}
+
+	// Returns the sum of the products of the numbers in the ranges
+	// [A_first, A_last) and [B_first, B_first + (A_last - A_first)).
+	// Large ranges are split across threads.
+	template <arithmetic T>
+	_accumulator_t<T> dot(const T* A_first, const T* A_last, const T* B_first)
+	{
+		using Acc = _accumulator_t<T>;
+
+		std::size_t count = static_cast<std::size_t>(A_last - A_first);
+
+		if constexpr (std::is_floating_point_v<T>)
+		{
+			_CompensatedSum<T> sum = _reduce_chunks<_CompensatedSum<T>>(count,
+				[=](std::size_t offset, std::size_t size) { return _CompensatedSum<T>{ _pairwise_dot(A_first + offset, B_first + offset, size), T(0) }; },
+				[](_CompensatedSum<T> A, const _CompensatedSum<T>& B) { A.add(B.sum); return A; });
+
+			return sum.result();
+		}
+		else
+		{
+			return _reduce_chunks<Acc>(count,
+				[=](std::size_t offset, std::size_t size)
+				{
+					Acc sum = 0;
+
+					for (std::size_t i = offset; i < offset + size; ++i)
+						sum += Acc(A_first[i]) * Acc(B_first[i]);
+
+					return sum;
+				},
+				std::plus<Acc>());
+		}
 	}
 
 	// 
@@ -0,0 +1,347 @@
+// JLibrary
+// PointQueries.ixx
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Module file for batched point-in-shape tests.
+
+module;
+
+#include "Arithmetic.hpp"
+#include "IntegerTypedefs.hpp"
+#include "Simd.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <execution>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+export module PointQueries;
+
+import Circle;
+import Rect;
+import Sphere;
+import Vector2;
+import Vector3;
+import VectorArray;
+
+namespace jlib
+{
+	// Tests over more points or shapes than this are split across threads.
+	inline constexpr std::size_t _parallel_point_queries = std::size_t(1) << 16;
+
+	// Number of points or shapes each thread tests at a time.
+	// A multiple of 64, so no two threads write to the same word of a mask.
+	inline constexpr std::size_t _point_query_chunk = std::size_t(1) << 14;
+
+	// The type the tests are computed in. Integers are widened to
+	// double so that squaring them can't overflow.
+	template <typename T>
+	using _query_t = std::conditional_t<std::floating_point<T>, T, double>;
+
+	// Throws a std::invalid_argument if mask can't hold count bits.
+	inline void _check_mask(std::size_t words, std::size_t count)
+	{
+		if (words < (count + 63) / 64)
+			throw std::invalid_argument("ERROR: The mask is too small.");
+	}
+
+	// Calls test(begin, end) over [0, count) in chunks of _point_query_chunk,
+	// in parallel if count is large enough.
+	template <typename Function>
+	void _for_each_chunk(std::size_t count, Function&& test)
+	{
+		if (count < _parallel_point_queries)
+		{
+			test(std::size_t(0), count);
+			return;
+		}
+
+		std::vector<std::size_t> chunks((count + _point_query_chunk - 1) / _point_query_chunk);
+		std::iota(chunks.begin(), chunks.end(), std::size_t(0));
+
+		std::for_each(std::execution::par, chunks.begin(), chunks.end(), [&](std::size_t chunk)
+		{
+			const std::size_t begin = chunk * _point_query_chunk;
+			test(begin, std::min(count, begin + _point_query_chunk));
+		});
+	}
+
+	// Sets bit i % 64 of mask[i / 64] to inside(i) for every i in [begin, end).
+	// begin must be a multiple of 64.
+	template <typename Predicate>
+	void _fill_mask(std::size_t begin, std::size_t end, u64* mask, Predicate&& inside)
+	{
+		for (std::size_t word = begin; word < end; word += 64)
+		{
+			const std::size_t last = std::min(end, word + 64);
+			u64 bits = 0;
+
+			for (std::size_t i = word; i < last; ++i)
+				bits |= u64(inside(i)) << (i - word);
+
+			mask[word / 64] = bits;
+		}
+	}
+
+	// Returns the radius squared of a Circle, or -1 if the radius is
+	// negative, since such a Circle contains no points.
+	template <typename T>
+	_query_t<T> _circle_radius_squared(T radius)
+	{
+		const _query_t<T> r = static_cast<_query_t<T>>(radius);
+		return r < _query_t<T>(0) ? _query_t<T>(-1) : r * r;
+	}
+
+	// Sets bit i % 64 of mask[i / 64] if (x[i], y[i], z[i]) lies within
+	// the given radius of the center. Pass nullptr as z for 2 components.
+	template <typename T>
+	void _within_radius(const T* x, const T* y, const T* z, std::size_t count,
+		_query_t<T> cx, _query_t<T> cy, _query_t<T> cz, _query_t<T> radius_squared, u64* mask)
+	{
+		_for_each_chunk(count, [&](std::size_t begin, std::size_t end)
+		{
+			if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+			{
+				simd::within_radius(x + begin, y + begin, z != nullptr ? z + begin : nullptr,
+					end - begin, cx, cy, cz, radius_squared, mask + begin / 64);
+			}
+			else
+			{
+				_fill_mask(begin, end, mask, [&](std::size_t i)
+				{
+					const double dx = static_cast<double>(x[i]) - cx;
+					const double dy = static_cast<double>(y[i]) - cy;
+					const double dz = z != nullptr ? static_cast<double>(z[i]) - cz : 0.0;
+
+					return dx * dx + dy * dy + dz * dz <= radius_squared;
+				});
+			}
+		});
+	}
+}
+
+export namespace jlib
+{
+	// Returns the number of words a mask of count bits needs.
+	constexpr std::size_t mask_size(std::size_t count) noexcept
+	{
+		return (count + 63) / 64;
+	}
+
+	// Returns the indices of the set bits among the first count bits of mask,
+	// in increasing order.
+	// Throws a std::invalid_argument if mask can't hold count bits.
+	inline std::vector<std::size_t> mask_indices(std::span<const u64> mask, std::size_t count)
+	{
+		_check_mask(mask.size(), count);
+
+		std::vector<std::size_t> indices;
+
+		for (std::size_t word = 0; word < mask_size(count); ++word)
+		{
+			u64 bits = mask[word];
+
+			if (word == count / 64)
+				bits &= (u64(1) << (count % 64)) - 1;
+
+			while (bits != 0)
+			{
+				indices.push_back(word * 64 + std::countr_zero(bits));
+				bits &= bits - 1;
+			}
+		}
+
+		return indices;
+	}
+
+	// Sets bit i % 64 of mask[i / 64] if points[i] lies within or on the Circle,
+	// and clears it otherwise. The unused bits of the last word are cleared.
+	// Throws a std::invalid_argument if mask holds fewer than mask_size(points.size()) words.
+	template <arithmetic T, typename Allocator>
+	void contains(const Circle<T>& circle, const Vector2Array<T, Allocator>& points, std::span<u64> mask)
+	{
+		_check_mask(mask.size(), points.size());
+
+		_within_radius<T>(points.xData(), points.yData(), nullptr, points.size(),
+			static_cast<_query_t<T>>(circle.center.x), static_cast<_query_t<T>>(circle.center.y), _query_t<T>(0),
+			_circle_radius_squared(circle.radius), mask.data());
+	}
+
+	// Sets bit i % 64 of mask[i / 64] if points[i] lies within or on the Rect,
+	// and clears it otherwise. The unused bits of the last word are cleared.
+	// Throws a std::invalid_argument if mask holds fewer than mask_size(points.size()) words.
+	template <arithmetic T, typename Allocator>
+	void contains(const Rect<T>& rect, const Vector2Array<T, Allocator>& points, std::span<u64> mask)
+	{
+		_check_mask(mask.size(), points.size());
+
+		const T min_x = std::min(rect.vertex.x, static_cast<T>(rect.vertex.x + rect.length));
+		const T max_x = std::max(rect.vertex.x, static_cast<T>(rect.vertex.x + rect.length));
+		const T min_y = std::min(rect.vertex.y, static_cast<T>(rect.vertex.y + rect.height));
+		const T max_y = std::max(rect.vertex.y, static_cast<T>(rect.vertex.y + rect.height));
+		const T* x = points.xData();
+		const T* y = points.yData();
+
+		_for_each_chunk(points.size(), [&](std::size_t begin, std::size_t end)
+		{
+			if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+				simd::within_bounds(x + begin, y + begin, end - begin, min_x, min_y, max_x, max_y, mask.data() + begin / 64);
+			else
+			{
+				_fill_mask(begin, end, mask.data(), [&](std::size_t i)
+				{
+					return (x[i] >= min_x) && (x[i] <= max_x) && (y[i] >= min_y) && (y[i] <= max_y);
+				});
+			}
+		});
+	}
+
+	// Sets bit i % 64 of mask[i / 64] if points[i] lies within or on the Sphere,
+	// and clears it otherwise. The unused bits of the last word are cleared.
+	// Throws a std::invalid_argument if mask holds fewer than mask_size(points.size()) words.
+	template <arithmetic T, typename Allocator>
+	void contains(const Sphere<T>& sphere, const Vector3Array<T, Allocator>& points, std::span<u64> mask)
+	{
+		_check_mask(mask.size(), points.size());
+
+		const _query_t<T> r = static_cast<_query_t<T>>(sphere.radius);
+
+		_within_radius<T>(points.xData(), points.yData(), points.zData(), points.size(),
+			static_cast<_query_t<T>>(sphere.center.x), static_cast<_query_t<T>>(sphere.center.y),
+			static_cast<_query_t<T>>(sphere.center.z), r * r, mask.data());
+	}
+
+	// Returns the indices of the points that lie within or on the Circle, in increasing order.
+	template <arithmetic T, typename Allocator>
+	std::vector<std::size_t> contained_points(const Circle<T>& circle, const Vector2Array<T, Allocator>& points)
+	{
+		std::vector<u64> mask(mask_size(points.size()));
+		contains(circle, points, std::span<u64>(mask));
+		return mask_indices(mask, points.size());
+	}
+
+	// Returns the indices of the points that lie within or on the Rect, in increasing order.
+	template <arithmetic T, typename Allocator>
+	std::vector<std::size_t> contained_points(const Rect<T>& rect, const Vector2Array<T, Allocator>& points)
+	{
+		std::vector<u64> mask(mask_size(points.size()));
+		contains(rect, points, std::span<u64>(mask));
+		return mask_indices(mask, points.size());
+	}
+
+	// Returns the indices of the points that lie within or on the Sphere, in increasing order.
+	template <arithmetic T, typename Allocator>
+	std::vector<std::size_t> contained_points(const Sphere<T>& sphere, const Vector3Array<T, Allocator>& points)
+	{
+		std::vector<u64> mask(mask_size(points.size()));
+		contains(sphere, points, std::span<u64>(mask));
+		return mask_indices(mask, points.size());
+	}
+
+	// Sets bit i % 64 of mask[i / 64] if the point lies within or on circles[i],
+	// and clears it otherwise. The unused bits of the last word are cleared.
+	// Throws a std::invalid_argument if mask holds fewer than mask_size(circles.size()) words.
+	template <arithmetic T>
+	void contains(std::type_identity_t<std::span<const Circle<T>>> circles, const Vector2<T>& point, std::span<u64> mask)
+	{
+		_check_mask(mask.size(), circles.size());
+
+		const _query_t<T> px = static_cast<_query_t<T>>(point.x);
+		const _query_t<T> py = static_cast<_query_t<T>>(point.y);
+
+		_for_each_chunk(circles.size(), [&](std::size_t begin, std::size_t end)
+		{
+			_fill_mask(begin, end, mask.data(), [&](std::size_t i)
+			{
+				const _query_t<T> dx = static_cast<_query_t<T>>(circles[i].center.x) - px;
+				const _query_t<T> dy = static_cast<_query_t<T>>(circles[i].center.y) - py;
+
+				return dx * dx + dy * dy <= _circle_radius_squared(circles[i].radius);
+			});
+		});
+	}
+
+	// Sets bit i % 64 of mask[i / 64] if the point lies within or on rects[i],
+	// and clears it otherwise. The unused bits of the last word are cleared.
+	// Throws a std::invalid_argument if mask holds fewer than mask_size(rects.size()) words.
+	template <arithmetic T>
+	void contains(std::type_identity_t<std::span<const Rect<T>>> rects, const Vector2<T>& point, std::span<u64> mask)
+	{
+		_check_mask(mask.size(), rects.size());
+
+		_for_each_chunk(rects.size(), [&](std::size_t begin, std::size_t end)
+		{
+			_fill_mask(begin, end, mask.data(), [&](std::size_t i)
+			{
+				const Rect<T>& rect = rects[i];
+				const T x0 = rect.vertex.x;
+				const T x1 = static_cast<T>(rect.vertex.x + rect.length);
+				const T y0 = rect.vertex.y;
+				const T y1 = static_cast<T>(rect.vertex.y + rect.height);
+
+				return (point.x >= std::min(x0, x1)) && (point.x <= std::max(x0, x1)) &&
+					   (point.y >= std::min(y0, y1)) && (point.y <= std::max(y0, y1));
+			});
+		});
+	}
+
+	// Sets bit i % 64 of mask[i / 64] if the point lies within or on spheres[i],
+	// and clears it otherwise. The unused bits of the last word are cleared.
+	// Throws a std::invalid_argument if mask holds fewer than mask_size(spheres.size()) words.
+	template <arithmetic T>
+	void contains(std::type_identity_t<std::span<const Sphere<T>>> spheres, const Vector3<T>& point, std::span<u64> mask)
+	{
+		_check_mask(mask.size(), spheres.size());
+
+		const _query_t<T> px = static_cast<_query_t<T>>(point.x);
+		const _query_t<T> py = static_cast<_query_t<T>>(point.y);
+		const _query_t<T> pz = static_cast<_query_t<T>>(point.z);
+
+		_for_each_chunk(spheres.size(), [&](std::size_t begin, std::size_t end)
+		{
+			_fill_mask(begin, end, mask.data(), [&](std::size_t i)
+			{
+				const _query_t<T> dx = static_cast<_query_t<T>>(spheres[i].center.x) - px;
+				const _query_t<T> dy = static_cast<_query_t<T>>(spheres[i].center.y) - py;
+				const _query_t<T> dz = static_cast<_query_t<T>>(spheres[i].center.z) - pz;
+				const _query_t<T> r = static_cast<_query_t<T>>(spheres[i].radius);
+
+				return dx * dx + dy * dy + dz * dz <= r * r;
+			});
+		});
+	}
+
+	// Returns the indices of the circles that contain the point, in increasing order.
+	template <arithmetic T>
+	std::vector<std::size_t> containing_shapes(std::type_identity_t<std::span<const Circle<T>>> circles, const Vector2<T>& point)
+	{
+		std::vector<u64> mask(mask_size(circles.size()));
+		contains<T>(circles, point, std::span<u64>(mask));
+		return mask_indices(mask, circles.size());
+	}
+
+	// Returns the indices of the rects that contain the point, in increasing order.
+	template <arithmetic T>
+	std::vector<std::size_t> containing_shapes(std::type_identity_t<std::span<const Rect<T>>> rects, const Vector2<T>& point)
+	{
+		std::vector<u64> mask(mask_size(rects.size()));
+		contains<T>(rects, point, std::span<u64>(mask));
+		return mask_indices(mask, rects.size());
+	}
+
+	// Returns the indices of the spheres that contain the point, in increasing order.
+	template <arithmetic T>
+	std::vector<std::size_t> containing_shapes(std::type_identity_t<std::span<const Sphere<T>>> spheres, const Vector3<T>& point)
+	{
+		std::vector<u64> mask(mask_size(spheres.size()));
+		contains<T>(spheres, point, std::span<u64>(mask));
+		return mask_indices(mask, spheres.size());
+	}
+}
\ No newline at end of file
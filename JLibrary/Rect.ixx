@@ -1,7 +1,7 @@
 // JLibrary
 // Rect.ixx
 // Created on 2022-01-08 by Justyn Durnford
-// Last modified on 2022-02-22 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
 // Module file for the Rect template class.
 
 module;
@@ -257,8 +257,7 @@ export namespace jlib
 		Vector2<T> ABR(A.bottomRight());
 		Vector2<T> BBR(B.bottomRight());
 
-		if ((ABR.vertex.x < BTL.vertex.x) || (ABR.vertex.y < BTL.vertex.y) || 
-			(BBR.vertex.x < ATL.vertex.x) || (BBR.vertex.y < ATL.vertex.y))
+		if ((ABR.x < BTL.x) || (ABR.y < BTL.y) || (BBR.x < ATL.x) || (BBR.y < ATL.y))
 			return false;
 		return true;
 	}
@@ -0,0 +1,1378 @@
+// JLibrary
+// Simd.cpp
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Source file defining several SIMD bulk operations.
+
+#include "Simd.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#include <cstddef>
+using std::size_t;
+
+#include <cstring>
+using std::memcpy;
+
+#ifdef JLIB_SIMD_X86
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#endif
+
+namespace jlib
+{
+	namespace simd
+	{
+		namespace
+		{
+			CpuFeatures detect_cpu_features() noexcept
+			{
+				CpuFeatures features;
+
+				#if defined(JLIB_SIMD_X86) && defined(_MSC_VER)
+
+				int info[4];
+				__cpuid(info, 0);
+				int max_leaf = info[0];
+
+				__cpuid(info, 1);
+				features.sse2 = (info[3] & (1 << 26)) != 0;
+				features.sse41 = (info[2] & (1 << 19)) != 0;
+				bool fma = (info[2] & (1 << 12)) != 0;
+				bool osxsave = (info[2] & (1 << 27)) != 0;
+				bool avx = (info[2] & (1 << 28)) != 0;
+
+				// The OS must save the YMM registers for AVX to be usable.
+				if (osxsave && avx)
+					features.avx = (_xgetbv(0) & 0x6) == 0x6;
+
+				features.fma = features.avx && fma;
+
+				if (max_leaf >= 7)
+				{
+					__cpuidex(info, 7, 0);
+					features.avx2 = features.avx && (info[1] & (1 << 5)) != 0;
+					features.bmi2 = (info[1] & (1 << 8)) != 0;
+				}
+
+				#elif defined(JLIB_SIMD_X86)
+
+				__builtin_cpu_init();
+				features.sse2 = __builtin_cpu_supports("sse2");
+				features.sse41 = __builtin_cpu_supports("sse4.1");
+				features.avx = __builtin_cpu_supports("avx");
+				features.avx2 = __builtin_cpu_supports("avx2");
+				features.fma = __builtin_cpu_supports("fma");
+				features.bmi2 = __builtin_cpu_supports("bmi2");
+
+				#endif // JLIB_SIMD_X86
+
+				return features;
+			}
+
+			// Returns the best level that the CPU supports.
+			Level detect_level() noexcept
+			{
+				if (cpu_features().avx2)
+					return Level::AVX2;
+				if (cpu_features().sse2)
+					return Level::SSE2;
+				return Level::Scalar;
+			}
+
+			// The level the kernels use, set by set_dispatch_level().
+			std::atomic<Level>& active_level() noexcept
+			{
+				static std::atomic<Level> level(detect_level());
+				return level;
+			}
+
+			// Returns true if the kernels may use AVX2.
+			bool use_avx2() noexcept
+			{
+				return active_level().load(std::memory_order_relaxed) == Level::AVX2;
+			}
+
+			// Returns true if the kernels may use SSE2.
+			bool use_sse2() noexcept
+			{
+				return active_level().load(std::memory_order_relaxed) >= Level::SSE2;
+			}
+
+			// Fills bytes bytes starting at dest with the repeating 32-byte pattern.
+			void scalar_fill(unsigned char* dest, size_t bytes, const unsigned char* pattern) noexcept
+			{
+				size_t i = 0;
+
+				for (; i + 32 <= bytes; i += 32)
+					memcpy(dest + i, pattern, 32);
+
+				memcpy(dest + i, pattern, bytes - i);
+			}
+
+			template <typename To, typename From>
+			void scalar_convert(const From* src, To* dest, size_t count) noexcept
+			{
+				for (size_t i = 0; i < count; ++i)
+					dest[i] = static_cast<To>(src[i]);
+			}
+
+			template <typename T>
+			bool scalar_equal(const T* A, const T* B, size_t count) noexcept
+			{
+				for (size_t i = 0; i < count; ++i)
+				{
+					if (A[i] != B[i])
+						return false;
+				}
+
+				return true;
+			}
+
+			template <typename T>
+			T scalar_min(const T* ptr, size_t count) noexcept
+			{
+				T value = ptr[0];
+
+				for (size_t i = 1; i < count; ++i)
+					value = std::min(value, ptr[i]);
+
+				return value;
+			}
+
+			template <typename T>
+			T scalar_max(const T* ptr, size_t count) noexcept
+			{
+				T value = ptr[0];
+
+				for (size_t i = 1; i < count; ++i)
+					value = std::max(value, ptr[i]);
+
+				return value;
+			}
+
+			// 4 independent sums let the additions overlap in the pipeline.
+			template <typename T>
+			T scalar_dot(const T* A, const T* B, size_t count) noexcept
+			{
+				T sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+				size_t i = 0;
+
+				for (; i + 4 <= count; i += 4)
+				{
+					sum0 += A[i] * B[i];
+					sum1 += A[i + 1] * B[i + 1];
+					sum2 += A[i + 2] * B[i + 2];
+					sum3 += A[i + 3] * B[i + 3];
+				}
+
+				for (; i < count; ++i)
+					sum0 += A[i] * B[i];
+
+				return (sum0 + sum1) + (sum2 + sum3);
+			}
+
+			template <typename T>
+			T scalar_distance_squared(const T* A, const T* B, size_t count) noexcept
+			{
+				T sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+				size_t i = 0;
+
+				for (; i + 4 <= count; i += 4)
+				{
+					const T d0 = A[i] - B[i];
+					const T d1 = A[i + 1] - B[i + 1];
+					const T d2 = A[i + 2] - B[i + 2];
+					const T d3 = A[i + 3] - B[i + 3];
+					sum0 += d0 * d0;
+					sum1 += d1 * d1;
+					sum2 += d2 * d2;
+					sum3 += d3 * d3;
+				}
+
+				for (; i < count; ++i)
+				{
+					const T d = A[i] - B[i];
+					sum0 += d * d;
+				}
+
+				return (sum0 + sum1) + (sum2 + sum3);
+			}
+
+			template <typename T>
+			void scalar_within_radius(const T* x, const T* y, const T* z, size_t count,
+				T cx, T cy, T cz, T radius_squared, u64* mask) noexcept
+			{
+				for (size_t begin = 0; begin < count; begin += 64)
+				{
+					const size_t end = std::min(count, begin + 64);
+					u64 bits = 0;
+
+					for (size_t i = begin; i < end; ++i)
+					{
+						const T dx = x[i] - cx;
+						const T dy = y[i] - cy;
+						T d = dx * dx + dy * dy;
+
+						if (z != nullptr)
+						{
+							const T dz = z[i] - cz;
+							d += dz * dz;
+						}
+
+						bits |= u64(d <= radius_squared) << (i - begin);
+					}
+
+					mask[begin / 64] = bits;
+				}
+			}
+
+			template <typename T>
+			void scalar_within_bounds(const T* x, const T* y, size_t count,
+				T min_x, T min_y, T max_x, T max_y, u64* mask) noexcept
+			{
+				for (size_t begin = 0; begin < count; begin += 64)
+				{
+					const size_t end = std::min(count, begin + 64);
+					u64 bits = 0;
+
+					for (size_t i = begin; i < end; ++i)
+					{
+						const bool inside = (x[i] >= min_x) & (x[i] <= max_x) & (y[i] >= min_y) & (y[i] <= max_y);
+						bits |= u64(inside) << (i - begin);
+					}
+
+					mask[begin / 64] = bits;
+				}
+			}
+
+			#ifdef JLIB_SIMD_X86
+
+			///////////////////////////////////////////////////////////////////////////////////////
+			// SSE2 kernels
+			///////////////////////////////////////////////////////////////////////////////////////
+
+			JLIB_TARGET_SSE2 void sse2_fill(unsigned char* dest, size_t bytes, const unsigned char* pattern) noexcept
+			{
+				__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern));
+				size_t i = 0;
+
+				for (; i + 16 <= bytes; i += 16)
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), v);
+
+				memcpy(dest + i, pattern, bytes - i);
+			}
+
+			JLIB_TARGET_SSE2 bool sse2_equal(const float* A, const float* B, size_t count) noexcept
+			{
+				size_t i = 0;
+
+				for (; i + 4 <= count; i += 4)
+				{
+					__m128 eq = _mm_cmpeq_ps(_mm_loadu_ps(A + i), _mm_loadu_ps(B + i));
+
+					if (_mm_movemask_ps(eq) != 0xF)
+						return false;
+				}
+
+				return scalar_equal(A + i, B + i, count - i);
+			}
+
+			JLIB_TARGET_SSE2 bool sse2_equal(const double* A, const double* B, size_t count) noexcept
+			{
+				size_t i = 0;
+
+				for (; i + 2 <= count; i += 2)
+				{
+					__m128d eq = _mm_cmpeq_pd(_mm_loadu_pd(A + i), _mm_loadu_pd(B + i));
+
+					if (_mm_movemask_pd(eq) != 0x3)
+						return false;
+				}
+
+				return scalar_equal(A + i, B + i, count - i);
+			}
+
+			JLIB_TARGET_SSE2 void sse2_convert(const i32* src, float* dest, size_t count) noexcept
+			{
+				size_t i = 0;
+
+				for (; i + 4 <= count; i += 4)
+					_mm_storeu_ps(dest + i, _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+
+				scalar_convert(src + i, dest + i, count - i);
+			}
+
+			JLIB_TARGET_SSE2 void sse2_convert(const u8* src, float* dest, size_t count) noexcept
+			{
+				const __m128i zero = _mm_setzero_si128();
+				size_t i = 0;
+
+				for (; i + 16 <= count; i += 16)
+				{
+					__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+					__m128i lo16 = _mm_unpacklo_epi8(bytes, zero);
+					__m128i hi16 = _mm_unpackhi_epi8(bytes, zero);
+
+					_mm_storeu_ps(dest + i, _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo16, zero)));
+					_mm_storeu_ps(dest + i + 4, _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo16, zero)));
+					_mm_storeu_ps(dest + i + 8, _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi16, zero)));
+					_mm_storeu_ps(dest + i + 12, _mm_cvtepi32_ps(_mm_unpackhi_epi16(hi16, zero)));
+				}
+
+				scalar_convert(src + i, dest + i, count - i);
+			}
+
+			JLIB_TARGET_SSE2 void sse2_convert(const float* src, i32* dest, size_t count) noexcept
+			{
+				size_t i = 0;
+
+				for (; i + 4 <= count; i += 4)
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_cvttps_epi32(_mm_loadu_ps(src + i)));
+
+				scalar_convert(src + i, dest + i, count - i);
+			}
+
+			JLIB_TARGET_SSE2 void sse2_convert(const float* src, double* dest, size_t count) noexcept
+			{
+				size_t i = 0;
+
+				for (; i + 4 <= count; i += 4)
+				{
+					__m128 v = _mm_loadu_ps(src + i);
+					_mm_storeu_pd(dest + i, _mm_cvtps_pd(v));
+					_mm_storeu_pd(dest + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+				}
+
+				scalar_convert(src + i, dest + i, count - i);
+			}
+
+			JLIB_TARGET_SSE2 void sse2_convert(const double* src, float* dest, size_t count) noexcept
+			{
+				size_t i = 0;
+
+				for (; i + 4 <= count; i += 4)
+				{
+					__m128 lo = _mm_cvtpd_ps(_mm_loadu_pd(src + i));
+					__m128 hi = _mm_cvtpd_ps(_mm_loadu_pd(src + i + 2));
+					_mm_storeu_ps(dest + i, _mm_movelh_ps(lo, hi));
+				}
+
+				scalar_convert(src + i, dest + i, count - i);
+			}
+
+			JLIB_TARGET_SSE2 float sse2_min(const float* ptr, size_t count) noexcept
+			{
+				__m128 acc = _mm_set1_ps(ptr[0]);
+				size_t i = 0;
+
+				for (; i + 4 <= count; i += 4)
+					acc = _mm_min_ps(acc, _mm_loadu_ps(ptr + i));
+
+				alignas(16) float lanes[4];
+				_mm_store_ps(lanes, acc);
+				float value = std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3]));
+
+				for (; i < count; ++i)
+					value = std::min(value, ptr[i]);
+
+				return value;
+			}
+
+			JLIB_TARGET_SSE2 float sse2_max(const float* ptr, size_t count) noexcept
+			{
+				__m128 acc = _mm_set1_ps(ptr[0]);
+				size_t i = 0;
+
+				for (; i + 4 <= count; i += 4)
+					acc = _mm_max_ps(acc, _mm_loadu_ps(ptr + i));
+
+				alignas(16) float lanes[4];
+				_mm_store_ps(lanes, acc);
+				float value = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+
+				for (; i < count; ++i)
+					value = std::max(value, ptr[i]);
+
+				return value;
+			}
+
+			JLIB_TARGET_SSE2 double sse2_min(const double* ptr, size_t count) noexcept
+			{
+				__m128d acc = _mm_set1_pd(ptr[0]);
+				size_t i = 0;
+
+				for (; i + 2 <= count; i += 2)
+					acc = _mm_min_pd(acc, _mm_loadu_pd(ptr + i));
+
+				alignas(16) double lanes[2];
+				_mm_store_pd(lanes, acc);
+				double value = std::min(lanes[0], lanes[1]);
+
+				for (; i < count; ++i)
+					value = std::min(value, ptr[i]);
+
+				return value;
+			}
+
+			JLIB_TARGET_SSE2 double sse2_max(const double* ptr, size_t count) noexcept
+			{
+				__m128d acc = _mm_set1_pd(ptr[0]);
+				size_t i = 0;
+
+				for (; i + 2 <= count; i += 2)
+					acc = _mm_max_pd(acc, _mm_loadu_pd(ptr + i));
+
+				alignas(16) double lanes[2];
+				_mm_store_pd(lanes, acc);
+				double value = std::max(lanes[0], lanes[1]);
+
+				for (; i < count; ++i)
+					value = std::max(value, ptr[i]);
+
+				return value;
+			}
+
+			// SSE2 has no 32-bit integer min/max, so they are built from a compare and a blend.
+			JLIB_TARGET_SSE2 i32 sse2_min(const i32* ptr, size_t count) noexcept
+			{
+				__m128i acc = _mm_set1_epi32(ptr[0]);
+				size_t i = 0;
+
+				for (; i + 4 <= count; i += 4)
+				{
+					__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i));
+					__m128i gt = _mm_cmpgt_epi32(acc, v);
+					acc = _mm_or_si128(_mm_and_si128(gt, v), _mm_andnot_si128(gt, acc));
+				}
+
+				alignas(16) i32 lanes[4];
+				_mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+				i32 value = std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3]));
+
+				for (; i < count; ++i)
+					value = std::min(value, ptr[i]);
+
+				return value;
+			}
+
+			JLIB_TARGET_SSE2 i32 sse2_max(const i32* ptr, size_t count) noexcept
+			{
+				__m128i acc = _mm_set1_epi32(ptr[0]);
+				size_t i = 0;
+
+				for (; i + 4 <= count; i += 4)
+				{
+					__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i));
+					__m128i gt = _mm_cmpgt_epi32(v, acc);
+					acc = _mm_or_si128(_mm_and_si128(gt, v), _mm_andnot_si128(gt, acc));
+				}
+
+				alignas(16) i32 lanes[4];
+				_mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+				i32 value = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+
+				for (; i < count; ++i)
+					value = std::max(value, ptr[i]);
+
+				return value;
+			}
+
+			JLIB_TARGET_SSE2 float sse2_dot(const float* A, const float* B, size_t count) noexcept
+			{
+				__m128 acc0 = _mm_setzero_ps();
+				__m128 acc1 = _mm_setzero_ps();
+				size_t i = 0;
+
+				for (; i + 8 <= count; i += 8)
+				{
+					acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(A + i), _mm_loadu_ps(B + i)));
+					acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(A + i + 4), _mm_loadu_ps(B + i + 4)));
+				}
+
+				alignas(16) float lanes[4];
+				_mm_store_ps(lanes, _mm_add_ps(acc0, acc1));
+				float value = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+				for (; i < count; ++i)
+					value += A[i] * B[i];
+
+				return value;
+			}
+
+			JLIB_TARGET_SSE2 double sse2_dot(const double* A, const double* B, size_t count) noexcept
+			{
+				__m128d acc0 = _mm_setzero_pd();
+				__m128d acc1 = _mm_setzero_pd();
+				size_t i = 0;
+
+				for (; i + 4 <= count; i += 4)
+				{
+					acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(A + i), _mm_loadu_pd(B + i)));
+					acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(A + i + 2), _mm_loadu_pd(B + i + 2)));
+				}
+
+				alignas(16) double lanes[2];
+				_mm_store_pd(lanes, _mm_add_pd(acc0, acc1));
+				double value = lanes[0] + lanes[1];
+
+				for (; i < count; ++i)
+					value += A[i] * B[i];
+
+				return value;
+			}
+
+			JLIB_TARGET_SSE2 float sse2_distance_squared(const float* A, const float* B, size_t count) noexcept
+			{
+				__m128 acc0 = _mm_setzero_ps();
+				__m128 acc1 = _mm_setzero_ps();
+				size_t i = 0;
+
+				for (; i + 8 <= count; i += 8)
+				{
+					__m128 d0 = _mm_sub_ps(_mm_loadu_ps(A + i), _mm_loadu_ps(B + i));
+					__m128 d1 = _mm_sub_ps(_mm_loadu_ps(A + i + 4), _mm_loadu_ps(B + i + 4));
+					acc0 = _mm_add_ps(acc0, _mm_mul_ps(d0, d0));
+					acc1 = _mm_add_ps(acc1, _mm_mul_ps(d1, d1));
+				}
+
+				alignas(16) float lanes[4];
+				_mm_store_ps(lanes, _mm_add_ps(acc0, acc1));
+				float value = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+				for (; i < count; ++i)
+				{
+					const float d = A[i] - B[i];
+					value += d * d;
+				}
+
+				return value;
+			}
+
+			JLIB_TARGET_SSE2 double sse2_distance_squared(const double* A, const double* B, size_t count) noexcept
+			{
+				__m128d acc0 = _mm_setzero_pd();
+				__m128d acc1 = _mm_setzero_pd();
+				size_t i = 0;
+
+				for (; i + 4 <= count; i += 4)
+				{
+					__m128d d0 = _mm_sub_pd(_mm_loadu_pd(A + i), _mm_loadu_pd(B + i));
+					__m128d d1 = _mm_sub_pd(_mm_loadu_pd(A + i + 2), _mm_loadu_pd(B + i + 2));
+					acc0 = _mm_add_pd(acc0, _mm_mul_pd(d0, d0));
+					acc1 = _mm_add_pd(acc1, _mm_mul_pd(d1, d1));
+				}
+
+				alignas(16) double lanes[2];
+				_mm_store_pd(lanes, _mm_add_pd(acc0, acc1));
+				double value = lanes[0] + lanes[1];
+
+				for (; i < count; ++i)
+				{
+					const double d = A[i] - B[i];
+					value += d * d;
+				}
+
+				return value;
+			}
+
+			JLIB_TARGET_SSE2 void sse2_within_radius(const float* x, const float* y, const float* z, size_t count,
+				float cx, float cy, float cz, float radius_squared, u64* mask) noexcept
+			{
+				const __m128 vcx = _mm_set1_ps(cx);
+				const __m128 vcy = _mm_set1_ps(cy);
+				const __m128 vcz = _mm_set1_ps(cz);
+				const __m128 vr = _mm_set1_ps(radius_squared);
+
+				for (size_t begin = 0; begin < count; begin += 64)
+				{
+					u64 bits = 0;
+
+					for (size_t j = 0; j < 64; j += 4)
+					{
+						const size_t i = begin + j;
+						const __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), vcx);
+						const __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), vcy);
+						__m128 d = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+
+						if (z != nullptr)
+						{
+							const __m128 dz = _mm_sub_ps(_mm_loadu_ps(z + i), vcz);
+							d = _mm_add_ps(d, _mm_mul_ps(dz, dz));
+						}
+
+						bits |= u64(_mm_movemask_ps(_mm_cmple_ps(d, vr))) << j;
+					}
+
+					mask[begin / 64] = bits;
+				}
+			}
+
+			JLIB_TARGET_SSE2 void sse2_within_radius(const double* x, const double* y, const double* z, size_t count,
+				double cx, double cy, double cz, double radius_squared, u64* mask) noexcept
+			{
+				const __m128d vcx = _mm_set1_pd(cx);
+				const __m128d vcy = _mm_set1_pd(cy);
+				const __m128d vcz = _mm_set1_pd(cz);
+				const __m128d vr = _mm_set1_pd(radius_squared);
+
+				for (size_t begin = 0; begin < count; begin += 64)
+				{
+					u64 bits = 0;
+
+					for (size_t j = 0; j < 64; j += 2)
+					{
+						const size_t i = begin + j;
+						const __m128d dx = _mm_sub_pd(_mm_loadu_pd(x + i), vcx);
+						const __m128d dy = _mm_sub_pd(_mm_loadu_pd(y + i), vcy);
+						__m128d d = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+
+						if (z != nullptr)
+						{
+							const __m128d dz = _mm_sub_pd(_mm_loadu_pd(z + i), vcz);
+							d = _mm_add_pd(d, _mm_mul_pd(dz, dz));
+						}
+
+						bits |= u64(_mm_movemask_pd(_mm_cmple_pd(d, vr))) << j;
+					}
+
+					mask[begin / 64] = bits;
+				}
+			}
+
+			JLIB_TARGET_SSE2 void sse2_within_bounds(const float* x, const float* y, size_t count,
+				float min_x, float min_y, float max_x, float max_y, u64* mask) noexcept
+			{
+				const __m128 lo_x = _mm_set1_ps(min_x);
+				const __m128 lo_y = _mm_set1_ps(min_y);
+				const __m128 hi_x = _mm_set1_ps(max_x);
+				const __m128 hi_y = _mm_set1_ps(max_y);
+
+				for (size_t begin = 0; begin < count; begin += 64)
+				{
+					u64 bits = 0;
+
+					for (size_t j = 0; j < 64; j += 4)
+					{
+						const size_t i = begin + j;
+						const __m128 vx = _mm_loadu_ps(x + i);
+						const __m128 vy = _mm_loadu_ps(y + i);
+						const __m128 inside_x = _mm_and_ps(_mm_cmpge_ps(vx, lo_x), _mm_cmple_ps(vx, hi_x));
+						const __m128 inside_y = _mm_and_ps(_mm_cmpge_ps(vy, lo_y), _mm_cmple_ps(vy, hi_y));
+						bits |= u64(_mm_movemask_ps(_mm_and_ps(inside_x, inside_y))) << j;
+					}
+
+					mask[begin / 64] = bits;
+				}
+			}
+
+			JLIB_TARGET_SSE2 void sse2_within_bounds(const double* x, const double* y, size_t count,
+				double min_x, double min_y, double max_x, double max_y, u64* mask) noexcept
+			{
+				const __m128d lo_x = _mm_set1_pd(min_x);
+				const __m128d lo_y = _mm_set1_pd(min_y);
+				const __m128d hi_x = _mm_set1_pd(max_x);
+				const __m128d hi_y = _mm_set1_pd(max_y);
+
+				for (size_t begin = 0; begin < count; begin += 64)
+				{
+					u64 bits = 0;
+
+					for (size_t j = 0; j < 64; j += 2)
+					{
+						const size_t i = begin + j;
+						const __m128d vx = _mm_loadu_pd(x + i);
+						const __m128d vy = _mm_loadu_pd(y + i);
+						const __m128d inside_x = _mm_and_pd(_mm_cmpge_pd(vx, lo_x), _mm_cmple_pd(vx, hi_x));
+						const __m128d inside_y = _mm_and_pd(_mm_cmpge_pd(vy, lo_y), _mm_cmple_pd(vy, hi_y));
+						bits |= u64(_mm_movemask_pd(_mm_and_pd(inside_x, inside_y))) << j;
+					}
+
+					mask[begin / 64] = bits;
+				}
+			}
+
+			///////////////////////////////////////////////////////////////////////////////////////
+			// AVX2 kernels
+			///////////////////////////////////////////////////////////////////////////////////////
+
+			JLIB_TARGET_AVX2 void avx2_fill(unsigned char* dest, size_t bytes, const unsigned char* pattern) noexcept
+			{
+				__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern));
+				size_t i = 0;
+
+				for (; i + 32 <= bytes; i += 32)
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), v);
+
+				memcpy(dest + i, pattern, bytes - i);
+			}
+
+			JLIB_TARGET_AVX2 bool avx2_equal(const float* A, const float* B, size_t count) noexcept
+			{
+				size_t i = 0;
+
+				for (; i + 8 <= count; i += 8)
+				{
+					__m256 eq = _mm256_cmp_ps(_mm256_loadu_ps(A + i), _mm256_loadu_ps(B + i), _CMP_EQ_OQ);
+
+					if (_mm256_movemask_ps(eq) != 0xFF)
+						return false;
+				}
+
+				return scalar_equal(A + i, B + i, count - i);
+			}
+
+			JLIB_TARGET_AVX2 bool avx2_equal(const double* A, const double* B, size_t count) noexcept
+			{
+				size_t i = 0;
+
+				for (; i + 4 <= count; i += 4)
+				{
+					__m256d eq = _mm256_cmp_pd(_mm256_loadu_pd(A + i), _mm256_loadu_pd(B + i), _CMP_EQ_OQ);
+
+					if (_mm256_movemask_pd(eq) != 0xF)
+						return false;
+				}
+
+				return scalar_equal(A + i, B + i, count - i);
+			}
+
+			JLIB_TARGET_AVX2 void avx2_convert(const i32* src, float* dest, size_t count) noexcept
+			{
+				size_t i = 0;
+
+				for (; i + 8 <= count; i += 8)
+					_mm256_storeu_ps(dest + i, _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i))));
+
+				scalar_convert(src + i, dest + i, count - i);
+			}
+
+			JLIB_TARGET_AVX2 void avx2_convert(const u8* src, float* dest, size_t count) noexcept
+			{
+				size_t i = 0;
+
+				for (; i + 8 <= count; i += 8)
+				{
+					__m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+					_mm256_storeu_ps(dest + i, _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(bytes)));
+				}
+
+				scalar_convert(src + i, dest + i, count - i);
+			}
+
+			JLIB_TARGET_AVX2 void avx2_convert(const float* src, i32* dest, size_t count) noexcept
+			{
+				size_t i = 0;
+
+				for (; i + 8 <= count; i += 8)
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), _mm256_cvttps_epi32(_mm256_loadu_ps(src + i)));
+
+				scalar_convert(src + i, dest + i, count - i);
+			}
+
+			JLIB_TARGET_AVX2 void avx2_convert(const float* src, double* dest, size_t count) noexcept
+			{
+				size_t i = 0;
+
+				for (; i + 4 <= count; i += 4)
+					_mm256_storeu_pd(dest + i, _mm256_cvtps_pd(_mm_loadu_ps(src + i)));
+
+				scalar_convert(src + i, dest + i, count - i);
+			}
+
+			JLIB_TARGET_AVX2 void avx2_convert(const double* src, float* dest, size_t count) noexcept
+			{
+				size_t i = 0;
+
+				for (; i + 4 <= count; i += 4)
+					_mm_storeu_ps(dest + i, _mm256_cvtpd_ps(_mm256_loadu_pd(src + i)));
+
+				scalar_convert(src + i, dest + i, count - i);
+			}
+
+			JLIB_TARGET_AVX2 float avx2_min(const float* ptr, size_t count) noexcept
+			{
+				__m256 acc = _mm256_set1_ps(ptr[0]);
+				size_t i = 0;
+
+				for (; i + 8 <= count; i += 8)
+					acc = _mm256_min_ps(acc, _mm256_loadu_ps(ptr + i));
+
+				alignas(32) float lanes[8];
+				_mm256_store_ps(lanes, acc);
+				float value = scalar_min(lanes, 8);
+
+				for (; i < count; ++i)
+					value = std::min(value, ptr[i]);
+
+				return value;
+			}
+
+			JLIB_TARGET_AVX2 float avx2_max(const float* ptr, size_t count) noexcept
+			{
+				__m256 acc = _mm256_set1_ps(ptr[0]);
+				size_t i = 0;
+
+				for (; i + 8 <= count; i += 8)
+					acc = _mm256_max_ps(acc, _mm256_loadu_ps(ptr + i));
+
+				alignas(32) float lanes[8];
+				_mm256_store_ps(lanes, acc);
+				float value = scalar_max(lanes, 8);
+
+				for (; i < count; ++i)
+					value = std::max(value, ptr[i]);
+
+				return value;
+			}
+
+			JLIB_TARGET_AVX2 double avx2_min(const double* ptr, size_t count) noexcept
+			{
+				__m256d acc = _mm256_set1_pd(ptr[0]);
+				size_t i = 0;
+
+				for (; i + 4 <= count; i += 4)
+					acc = _mm256_min_pd(acc, _mm256_loadu_pd(ptr + i));
+
+				alignas(32) double lanes[4];
+				_mm256_store_pd(lanes, acc);
+				double value = scalar_min(lanes, 4);
+
+				for (; i < count; ++i)
+					value = std::min(value, ptr[i]);
+
+				return value;
+			}
+
+			JLIB_TARGET_AVX2 double avx2_max(const double* ptr, size_t count) noexcept
+			{
+				__m256d acc = _mm256_set1_pd(ptr[0]);
+				size_t i = 0;
+
+				for (; i + 4 <= count; i += 4)
+					acc = _mm256_max_pd(acc, _mm256_loadu_pd(ptr + i));
+
+				alignas(32) double lanes[4];
+				_mm256_store_pd(lanes, acc);
+				double value = scalar_max(lanes, 4);
+
+				for (; i < count; ++i)
+					value = std::max(value, ptr[i]);
+
+				return value;
+			}
+
+			JLIB_TARGET_AVX2 i32 avx2_min(const i32* ptr, size_t count) noexcept
+			{
+				__m256i acc = _mm256_set1_epi32(ptr[0]);
+				size_t i = 0;
+
+				for (; i + 8 <= count; i += 8)
+					acc = _mm256_min_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + i)));
+
+				alignas(32) i32 lanes[8];
+				_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+				i32 value = scalar_min(lanes, 8);
+
+				for (; i < count; ++i)
+					value = std::min(value, ptr[i]);
+
+				return value;
+			}
+
+			JLIB_TARGET_AVX2 i32 avx2_max(const i32* ptr, size_t count) noexcept
+			{
+				__m256i acc = _mm256_set1_epi32(ptr[0]);
+				size_t i = 0;
+
+				for (; i + 8 <= count; i += 8)
+					acc = _mm256_max_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + i)));
+
+				alignas(32) i32 lanes[8];
+				_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+				i32 value = scalar_max(lanes, 8);
+
+				for (; i < count; ++i)
+					value = std::max(value, ptr[i]);
+
+				return value;
+			}
+
+			JLIB_TARGET_AVX2 float avx2_dot(const float* A, const float* B, size_t count) noexcept
+			{
+				__m256 acc0 = _mm256_setzero_ps();
+				__m256 acc1 = _mm256_setzero_ps();
+				size_t i = 0;
+
+				for (; i + 16 <= count; i += 16)
+				{
+					acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(A + i), _mm256_loadu_ps(B + i)));
+					acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(A + i + 8), _mm256_loadu_ps(B + i + 8)));
+				}
+
+				alignas(32) float lanes[8];
+				_mm256_store_ps(lanes, _mm256_add_ps(acc0, acc1));
+				float value = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+
+				for (; i < count; ++i)
+					value += A[i] * B[i];
+
+				return value;
+			}
+
+			JLIB_TARGET_AVX2 double avx2_dot(const double* A, const double* B, size_t count) noexcept
+			{
+				__m256d acc0 = _mm256_setzero_pd();
+				__m256d acc1 = _mm256_setzero_pd();
+				size_t i = 0;
+
+				for (; i + 8 <= count; i += 8)
+				{
+					acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(A + i), _mm256_loadu_pd(B + i)));
+					acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(_mm256_loadu_pd(A + i + 4), _mm256_loadu_pd(B + i + 4)));
+				}
+
+				alignas(32) double lanes[4];
+				_mm256_store_pd(lanes, _mm256_add_pd(acc0, acc1));
+				double value = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+				for (; i < count; ++i)
+					value += A[i] * B[i];
+
+				return value;
+			}
+
+			JLIB_TARGET_AVX2 float avx2_distance_squared(const float* A, const float* B, size_t count) noexcept
+			{
+				__m256 acc0 = _mm256_setzero_ps();
+				__m256 acc1 = _mm256_setzero_ps();
+				size_t i = 0;
+
+				for (; i + 16 <= count; i += 16)
+				{
+					__m256 d0 = _mm256_sub_ps(_mm256_loadu_ps(A + i), _mm256_loadu_ps(B + i));
+					__m256 d1 = _mm256_sub_ps(_mm256_loadu_ps(A + i + 8), _mm256_loadu_ps(B + i + 8));
+					acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(d0, d0));
+					acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(d1, d1));
+				}
+
+				alignas(32) float lanes[8];
+				_mm256_store_ps(lanes, _mm256_add_ps(acc0, acc1));
+				float value = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+
+				for (; i < count; ++i)
+				{
+					const float d = A[i] - B[i];
+					value += d * d;
+				}
+
+				return value;
+			}
+
+			JLIB_TARGET_AVX2 double avx2_distance_squared(const double* A, const double* B, size_t count) noexcept
+			{
+				__m256d acc0 = _mm256_setzero_pd();
+				__m256d acc1 = _mm256_setzero_pd();
+				size_t i = 0;
+
+				for (; i + 8 <= count; i += 8)
+				{
+					__m256d d0 = _mm256_sub_pd(_mm256_loadu_pd(A + i), _mm256_loadu_pd(B + i));
+					__m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(A + i + 4), _mm256_loadu_pd(B + i + 4));
+					acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(d0, d0));
+					acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(d1, d1));
+				}
+
+				alignas(32) double lanes[4];
+				_mm256_store_pd(lanes, _mm256_add_pd(acc0, acc1));
+				double value = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+				for (; i < count; ++i)
+				{
+					const double d = A[i] - B[i];
+					value += d * d;
+				}
+
+				return value;
+			}
+
+			JLIB_TARGET_AVX2 void avx2_within_radius(const float* x, const float* y, const float* z, size_t count,
+				float cx, float cy, float cz, float radius_squared, u64* mask) noexcept
+			{
+				const __m256 vcx = _mm256_set1_ps(cx);
+				const __m256 vcy = _mm256_set1_ps(cy);
+				const __m256 vcz = _mm256_set1_ps(cz);
+				const __m256 vr = _mm256_set1_ps(radius_squared);
+
+				for (size_t begin = 0; begin < count; begin += 64)
+				{
+					u64 bits = 0;
+
+					for (size_t j = 0; j < 64; j += 8)
+					{
+						const size_t i = begin + j;
+						const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + i), vcx);
+						const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + i), vcy);
+						__m256 d = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+
+						if (z != nullptr)
+						{
+							const __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(z + i), vcz);
+							d = _mm256_add_ps(d, _mm256_mul_ps(dz, dz));
+						}
+
+						bits |= u64(_mm256_movemask_ps(_mm256_cmp_ps(d, vr, _CMP_LE_OQ))) << j;
+					}
+
+					mask[begin / 64] = bits;
+				}
+			}
+
+			JLIB_TARGET_AVX2 void avx2_within_radius(const double* x, const double* y, const double* z, size_t count,
+				double cx, double cy, double cz, double radius_squared, u64* mask) noexcept
+			{
+				const __m256d vcx = _mm256_set1_pd(cx);
+				const __m256d vcy = _mm256_set1_pd(cy);
+				const __m256d vcz = _mm256_set1_pd(cz);
+				const __m256d vr = _mm256_set1_pd(radius_squared);
+
+				for (size_t begin = 0; begin < count; begin += 64)
+				{
+					u64 bits = 0;
+
+					for (size_t j = 0; j < 64; j += 4)
+					{
+						const size_t i = begin + j;
+						const __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + i), vcx);
+						const __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y + i), vcy);
+						__m256d d = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+
+						if (z != nullptr)
+						{
+							const __m256d dz = _mm256_sub_pd(_mm256_loadu_pd(z + i), vcz);
+							d = _mm256_add_pd(d, _mm256_mul_pd(dz, dz));
+						}
+
+						bits |= u64(_mm256_movemask_pd(_mm256_cmp_pd(d, vr, _CMP_LE_OQ))) << j;
+					}
+
+					mask[begin / 64] = bits;
+				}
+			}
+
+			JLIB_TARGET_AVX2 void avx2_within_bounds(const float* x, const float* y, size_t count,
+				float min_x, float min_y, float max_x, float max_y, u64* mask) noexcept
+			{
+				const __m256 lo_x = _mm256_set1_ps(min_x);
+				const __m256 lo_y = _mm256_set1_ps(min_y);
+				const __m256 hi_x = _mm256_set1_ps(max_x);
+				const __m256 hi_y = _mm256_set1_ps(max_y);
+
+				for (size_t begin = 0; begin < count; begin += 64)
+				{
+					u64 bits = 0;
+
+					for (size_t j = 0; j < 64; j += 8)
+					{
+						const size_t i = begin + j;
+						const __m256 vx = _mm256_loadu_ps(x + i);
+						const __m256 vy = _mm256_loadu_ps(y + i);
+						const __m256 inside_x = _mm256_and_ps(_mm256_cmp_ps(vx, lo_x, _CMP_GE_OQ), _mm256_cmp_ps(vx, hi_x, _CMP_LE_OQ));
+						const __m256 inside_y = _mm256_and_ps(_mm256_cmp_ps(vy, lo_y, _CMP_GE_OQ), _mm256_cmp_ps(vy, hi_y, _CMP_LE_OQ));
+						bits |= u64(_mm256_movemask_ps(_mm256_and_ps(inside_x, inside_y))) << j;
+					}
+
+					mask[begin / 64] = bits;
+				}
+			}
+
+			JLIB_TARGET_AVX2 void avx2_within_bounds(const double* x, const double* y, size_t count,
+				double min_x, double min_y, double max_x, double max_y, u64* mask) noexcept
+			{
+				const __m256d lo_x = _mm256_set1_pd(min_x);
+				const __m256d lo_y = _mm256_set1_pd(min_y);
+				const __m256d hi_x = _mm256_set1_pd(max_x);
+				const __m256d hi_y = _mm256_set1_pd(max_y);
+
+				for (size_t begin = 0; begin < count; begin += 64)
+				{
+					u64 bits = 0;
+
+					for (size_t j = 0; j < 64; j += 4)
+					{
+						const size_t i = begin + j;
+						const __m256d vx = _mm256_loadu_pd(x + i);
+						const __m256d vy = _mm256_loadu_pd(y + i);
+						const __m256d inside_x = _mm256_and_pd(_mm256_cmp_pd(vx, lo_x, _CMP_GE_OQ), _mm256_cmp_pd(vx, hi_x, _CMP_LE_OQ));
+						const __m256d inside_y = _mm256_and_pd(_mm256_cmp_pd(vy, lo_y, _CMP_GE_OQ), _mm256_cmp_pd(vy, hi_y, _CMP_LE_OQ));
+						bits |= u64(_mm256_movemask_pd(_mm256_and_pd(inside_x, inside_y))) << j;
+					}
+
+					mask[begin / 64] = bits;
+				}
+			}
+
+			#endif // JLIB_SIMD_X86
+
+			// Fills bytes bytes starting at dest with the repeating 32-byte pattern.
+			void fill_pattern(void* dest, size_t bytes, const unsigned char* pattern) noexcept
+			{
+				unsigned char* ptr = static_cast<unsigned char*>(dest);
+
+				#ifdef JLIB_SIMD_X86
+				if (use_avx2())
+					return avx2_fill(ptr, bytes, pattern);
+				if (use_sse2())
+					return sse2_fill(ptr, bytes, pattern);
+				#endif // JLIB_SIMD_X86
+
+				scalar_fill(ptr, bytes, pattern);
+			}
+
+			// Fills count elements of type T starting at dest with value.
+			template <typename T>
+			void fill_value(void* dest, size_t count, T value) noexcept
+			{
+				unsigned char pattern[32];
+
+				for (size_t i = 0; i < 32; i += sizeof(T))
+					memcpy(pattern + i, &value, sizeof(T));
+
+				fill_pattern(dest, count * sizeof(T), pattern);
+			}
+		}
+
+		// The kernels below are picked at runtime, so the same binary runs on
+		// any x86 CPU and still uses AVX2 where it is available.
+		#ifdef JLIB_SIMD_X86
+			#define JLIB_SIMD_DISPATCH(name, ...)    \
+				if (use_avx2())                      \
+					return avx2_##name(__VA_ARGS__); \
+				if (use_sse2())                      \
+					return sse2_##name(__VA_ARGS__);
+		#else
+			#define JLIB_SIMD_DISPATCH(name, ...)
+		#endif // JLIB_SIMD_X86
+
+		const CpuFeatures& cpu_features() noexcept
+		{
+			static const CpuFeatures features = detect_cpu_features();
+			return features;
+		}
+
+		Level dispatch_level() noexcept
+		{
+			return active_level().load(std::memory_order_relaxed);
+		}
+
+		Level set_dispatch_level(Level level) noexcept
+		{
+			level = std::min(level, detect_level());
+			active_level().store(level, std::memory_order_relaxed);
+			return level;
+		}
+
+		void fill_16(void* dest, size_t count, u16 value) noexcept
+		{
+			fill_value(dest, count, value);
+		}
+
+		void fill_32(void* dest, size_t count, u32 value) noexcept
+		{
+			fill_value(dest, count, value);
+		}
+
+		void fill_64(void* dest, size_t count, u64 value) noexcept
+		{
+			fill_value(dest, count, value);
+		}
+
+		bool equal(const float* A, const float* B, size_t count) noexcept
+		{
+			JLIB_SIMD_DISPATCH(equal, A, B, count)
+			return scalar_equal(A, B, count);
+		}
+
+		bool equal(const double* A, const double* B, size_t count) noexcept
+		{
+			JLIB_SIMD_DISPATCH(equal, A, B, count)
+			return scalar_equal(A, B, count);
+		}
+
+		void convert(const i32* src, float* dest, size_t count) noexcept
+		{
+			JLIB_SIMD_DISPATCH(convert, src, dest, count)
+			scalar_convert(src, dest, count);
+		}
+
+		void convert(const u8* src, float* dest, size_t count) noexcept
+		{
+			JLIB_SIMD_DISPATCH(convert, src, dest, count)
+			scalar_convert(src, dest, count);
+		}
+
+		void convert(const float* src, i32* dest, size_t count) noexcept
+		{
+			JLIB_SIMD_DISPATCH(convert, src, dest, count)
+			scalar_convert(src, dest, count);
+		}
+
+		void convert(const float* src, double* dest, size_t count) noexcept
+		{
+			JLIB_SIMD_DISPATCH(convert, src, dest, count)
+			scalar_convert(src, dest, count);
+		}
+
+		void convert(const double* src, float* dest, size_t count) noexcept
+		{
+			JLIB_SIMD_DISPATCH(convert, src, dest, count)
+			scalar_convert(src, dest, count);
+		}
+
+		float min(const float* ptr, size_t count) noexcept
+		{
+			JLIB_SIMD_DISPATCH(min, ptr, count)
+			return scalar_min(ptr, count);
+		}
+
+		double min(const double* ptr, size_t count) noexcept
+		{
+			JLIB_SIMD_DISPATCH(min, ptr, count)
+			return scalar_min(ptr, count);
+		}
+
+		i32 min(const i32* ptr, size_t count) noexcept
+		{
+			JLIB_SIMD_DISPATCH(min, ptr, count)
+			return scalar_min(ptr, count);
+		}
+
+		float max(const float* ptr, size_t count) noexcept
+		{
+			JLIB_SIMD_DISPATCH(max, ptr, count)
+			return scalar_max(ptr, count);
+		}
+
+		double max(const double* ptr, size_t count) noexcept
+		{
+			JLIB_SIMD_DISPATCH(max, ptr, count)
+			return scalar_max(ptr, count);
+		}
+
+		i32 max(const i32* ptr, size_t count) noexcept
+		{
+			JLIB_SIMD_DISPATCH(max, ptr, count)
+			return scalar_max(ptr, count);
+		}
+
+		float dot(const float* A, const float* B, size_t count) noexcept
+		{
+			JLIB_SIMD_DISPATCH(dot, A, B, count)
+			return scalar_dot(A, B, count);
+		}
+
+		double dot(const double* A, const double* B, size_t count) noexcept
+		{
+			JLIB_SIMD_DISPATCH(dot, A, B, count)
+			return scalar_dot(A, B, count);
+		}
+
+		float distance_squared(const float* A, const float* B, size_t count) noexcept
+		{
+			JLIB_SIMD_DISPATCH(distance_squared, A, B, count)
+			return scalar_distance_squared(A, B, count);
+		}
+
+		double distance_squared(const double* A, const double* B, size_t count) noexcept
+		{
+			JLIB_SIMD_DISPATCH(distance_squared, A, B, count)
+			return scalar_distance_squared(A, B, count);
+		}
+
+		void within_radius(const float* x, const float* y, const float* z, size_t count,
+			float cx, float cy, float cz, float radius_squared, u64* mask) noexcept
+		{
+			// The kernels handle whole words, and the last partial word is done here.
+			size_t done = 0;
+
+			#ifdef JLIB_SIMD_X86
+			done = count - count % 64;
+
+			if (use_avx2())
+				avx2_within_radius(x, y, z, done, cx, cy, cz, radius_squared, mask);
+			else if (use_sse2())
+				sse2_within_radius(x, y, z, done, cx, cy, cz, radius_squared, mask);
+			else
+				done = 0;
+			#endif // JLIB_SIMD_X86
+
+			scalar_within_radius(x + done, y + done, z != nullptr ? z + done : nullptr, count - done,
+				cx, cy, cz, radius_squared, mask + done / 64);
+		}
+
+		void within_radius(const double* x, const double* y, const double* z, size_t count,
+			double cx, double cy, double cz, double radius_squared, u64* mask) noexcept
+		{
+			// The kernels handle whole words, and the last partial word is done here.
+			size_t done = 0;
+
+			#ifdef JLIB_SIMD_X86
+			done = count - count % 64;
+
+			if (use_avx2())
+				avx2_within_radius(x, y, z, done, cx, cy, cz, radius_squared, mask);
+			else if (use_sse2())
+				sse2_within_radius(x, y, z, done, cx, cy, cz, radius_squared, mask);
+			else
+				done = 0;
+			#endif // JLIB_SIMD_X86
+
+			scalar_within_radius(x + done, y + done, z != nullptr ? z + done : nullptr, count - done,
+				cx, cy, cz, radius_squared, mask + done / 64);
+		}
+
+		void within_bounds(const float* x, const float* y, size_t count,
+			float min_x, float min_y, float max_x, float max_y, u64* mask) noexcept
+		{
+			size_t done = 0;
+
+			#ifdef JLIB_SIMD_X86
+			done = count - count % 64;
+
+			if (use_avx2())
+				avx2_within_bounds(x, y, done, min_x, min_y, max_x, max_y, mask);
+			else if (use_sse2())
+				sse2_within_bounds(x, y, done, min_x, min_y, max_x, max_y, mask);
+			else
+				done = 0;
+			#endif // JLIB_SIMD_X86
+
+			scalar_within_bounds(x + done, y + done, count - done, min_x, min_y, max_x, max_y, mask + done / 64);
+		}
+
+		void within_bounds(const double* x, const double* y, size_t count,
+			double min_x, double min_y, double max_x, double max_y, u64* mask) noexcept
+		{
+			size_t done = 0;
+
+			#ifdef JLIB_SIMD_X86
+			done = count - count % 64;
+
+			if (use_avx2())
+				avx2_within_bounds(x, y, done, min_x, min_y, max_x, max_y, mask);
+			else if (use_sse2())
+				sse2_within_bounds(x, y, done, min_x, min_y, max_x, max_y, mask);
+			else
+				done = 0;
+			#endif // JLIB_SIMD_X86
+
+			scalar_within_bounds(x + done, y + done, count - done, min_x, min_y, max_x, max_y, mask + done / 64);
+		}
+
+		#undef JLIB_SIMD_DISPATCH
+	}
+}
\ No newline at end of file
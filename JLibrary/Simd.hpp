@@ -0,0 +1,258 @@
+// JLibrary
+// Simd.hpp
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Header file defining several SIMD bulk operations.
+
+#pragma once
+
+#include "IntegerTypedefs.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+// JLIB_SIMD_X86 is defined when compiling for x86 or x64,
+// where the SSE and SSE2 intrinsics can always be used.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+	#define JLIB_SIMD_X86
+	#include <immintrin.h>
+#endif
+
+// JLIB_SIMD_BMI2 is defined when every function may use BMI2, as with
+// /arch:AVX2 on MSVC or -mbmi2 and -march=haswell on GCC and Clang.
+// pdep and pext are only used in that case, because the index
+// calculations that use them must be inlined into their callers.
+#if (defined(_M_X64) || defined(__x86_64__)) && (defined(__BMI2__) || (defined(_MSC_VER) && defined(__AVX2__)))
+	#define JLIB_SIMD_BMI2
+#endif
+
+// MSVC allows intrinsics for any instruction set in any function.
+// GCC and Clang need the instruction set enabled on the function itself,
+// so that AVX2 code can live in a translation unit that is compiled for
+// the baseline CPU and only be called after checking cpu_features().
+#if defined(_MSC_VER) && !defined(__clang__)
+	#define JLIB_TARGET_SSE2
+	#define JLIB_TARGET_AVX2
+#else
+	#define JLIB_TARGET_SSE2 __attribute__((target("sse2")))
+	#define JLIB_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+
+namespace jlib
+{
+	namespace simd
+	{
+		// Structure describing the instruction sets the CPU supports.
+		struct CpuFeatures
+		{
+			bool sse2 = false;
+			bool sse41 = false;
+			bool avx = false;
+			bool avx2 = false;
+			bool fma = false;
+			bool bmi2 = false;
+		};
+
+		// Returns the instruction sets supported by the CPU and the OS.
+		// The CPU is only queried once.
+		const CpuFeatures& cpu_features() noexcept;
+
+		// Instruction sets the kernels below can be dispatched to.
+		enum class Level
+		{
+			Scalar,
+			SSE2,
+			AVX2
+		};
+
+		// Returns the instruction set the kernels below use.
+		// It starts as the best one cpu_features() reports.
+		Level dispatch_level() noexcept;
+
+		// Limits the kernels below to the given instruction set, or to the
+		// best one the CPU supports if that is lower, and returns the level
+		// now in use. Meant for comparing the kernels in benchmarks and tests.
+		Level set_dispatch_level(Level level) noexcept;
+
+		// Every kernel below picks an AVX2, SSE2 or scalar implementation
+		// at runtime based on dispatch_level(). The pointers need not be aligned.
+
+		// Sets count 16-bit values starting at dest to value.
+		void fill_16(void* dest, std::size_t count, u16 value) noexcept;
+
+		// Sets count 32-bit values starting at dest to value.
+		void fill_32(void* dest, std::size_t count, u32 value) noexcept;
+
+		// Sets count 64-bit values starting at dest to value.
+		void fill_64(void* dest, std::size_t count, u64 value) noexcept;
+
+		// Returns true if A[i] == B[i] for every i in [0, count).
+		bool equal(const float* A, const float* B, std::size_t count) noexcept;
+
+		// Returns true if A[i] == B[i] for every i in [0, count).
+		bool equal(const double* A, const double* B, std::size_t count) noexcept;
+
+		// Converts count values from src into dest.
+		void convert(const i32* src, float* dest, std::size_t count) noexcept;
+
+		// Converts count values from src into dest.
+		void convert(const u8* src, float* dest, std::size_t count) noexcept;
+
+		// Converts count values from src into dest, truncating towards 0.
+		void convert(const float* src, i32* dest, std::size_t count) noexcept;
+
+		// Converts count values from src into dest.
+		void convert(const float* src, double* dest, std::size_t count) noexcept;
+
+		// Converts count values from src into dest.
+		void convert(const double* src, float* dest, std::size_t count) noexcept;
+
+		// Returns the smallest of the count values starting at ptr.
+		// count must not be 0. The result is unspecified if a value is NaN.
+		float min(const float* ptr, std::size_t count) noexcept;
+
+		// Returns the smallest of the count values starting at ptr.
+		// count must not be 0. The result is unspecified if a value is NaN.
+		double min(const double* ptr, std::size_t count) noexcept;
+
+		// Returns the smallest of the count values starting at ptr.
+		// count must not be 0.
+		i32 min(const i32* ptr, std::size_t count) noexcept;
+
+		// Returns the largest of the count values starting at ptr.
+		// count must not be 0. The result is unspecified if a value is NaN.
+		float max(const float* ptr, std::size_t count) noexcept;
+
+		// Returns the largest of the count values starting at ptr.
+		// count must not be 0. The result is unspecified if a value is NaN.
+		double max(const double* ptr, std::size_t count) noexcept;
+
+		// Returns the largest of the count values starting at ptr.
+		// count must not be 0.
+		i32 max(const i32* ptr, std::size_t count) noexcept;
+
+		// Returns the sum of A[i] * B[i] for every i in [0, count).
+		// The order of the additions is unspecified.
+		float dot(const float* A, const float* B, std::size_t count) noexcept;
+
+		// Returns the sum of A[i] * B[i] for every i in [0, count).
+		// The order of the additions is unspecified.
+		double dot(const double* A, const double* B, std::size_t count) noexcept;
+
+		// Returns the sum of (A[i] - B[i])^2 for every i in [0, count).
+		// The order of the additions is unspecified.
+		float distance_squared(const float* A, const float* B, std::size_t count) noexcept;
+
+		// Returns the sum of (A[i] - B[i])^2 for every i in [0, count).
+		// The order of the additions is unspecified.
+		double distance_squared(const double* A, const double* B, std::size_t count) noexcept;
+
+		// Sets bit i % 64 of mask[i / 64] if (x[i] - cx)^2 + (y[i] - cy)^2 + (z[i] - cz)^2
+		// is at most radius_squared, and clears it otherwise. Pass nullptr as z for
+		// 2 components. mask must hold (count + 63) / 64 words. The unused bits
+		// of the last word are cleared.
+		void within_radius(const float* x, const float* y, const float* z, std::size_t count,
+			float cx, float cy, float cz, float radius_squared, u64* mask) noexcept;
+
+		// Sets bit i % 64 of mask[i / 64] if (x[i] - cx)^2 + (y[i] - cy)^2 + (z[i] - cz)^2
+		// is at most radius_squared, and clears it otherwise. Pass nullptr as z for
+		// 2 components. mask must hold (count + 63) / 64 words. The unused bits
+		// of the last word are cleared.
+		void within_radius(const double* x, const double* y, const double* z, std::size_t count,
+			double cx, double cy, double cz, double radius_squared, u64* mask) noexcept;
+
+		// Sets bit i % 64 of mask[i / 64] if min_x <= x[i] <= max_x and
+		// min_y <= y[i] <= max_y, and clears it otherwise. mask must hold
+		// (count + 63) / 64 words. The unused bits of the last word are cleared.
+		void within_bounds(const float* x, const float* y, std::size_t count,
+			float min_x, float min_y, float max_x, float max_y, u64* mask) noexcept;
+
+		// Sets bit i % 64 of mask[i / 64] if min_x <= x[i] <= max_x and
+		// min_y <= y[i] <= max_y, and clears it otherwise. mask must hold
+		// (count + 63) / 64 words. The unused bits of the last word are cleared.
+		void within_bounds(const double* x, const double* y, std::size_t count,
+			double min_x, double min_y, double max_x, double max_y, u64* mask) noexcept;
+
+		///////////////////////////////////////////////////////////////////////////////////////////
+		///////////////////////////////////////////////////////////////////////////////////////////
+
+		// Sets the count elements starting at first to value.
+		// Uses a SIMD kernel when T is trivially copyable and 1, 2, 4 or 8 bytes wide.
+		template <typename T>
+		void fill_n(T* first, std::size_t count, const T& value)
+		{
+			if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) == 1)
+				std::memset(first, std::bit_cast<u8>(value), count);
+			else if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) == 2)
+				fill_16(first, count, std::bit_cast<u16>(value));
+			else if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) == 4)
+				fill_32(first, count, std::bit_cast<u32>(value));
+			else if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) == 8)
+				fill_64(first, count, std::bit_cast<u64>(value));
+			else
+				std::fill_n(first, count, value);
+		}
+
+		// Returns true if A[i] == B[i] for every i in [0, count).
+		// Floating-point types use a SIMD kernel, types whose equality
+		// is bitwise equality are compared with std::memcmp.
+		template <typename T>
+		bool equal_n(const T* A, const T* B, std::size_t count)
+		{
+			if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>)
+				return simd::equal(A, B, count);
+			else if constexpr (std::is_integral_v<T> || std::is_enum_v<T> || std::is_same_v<T, std::byte>)
+				return count == 0 || std::memcmp(A, B, count * sizeof(T)) == 0;
+			else
+				return std::equal(A, A + count, B);
+		}
+
+		// Converts the count elements starting at src into dest
+		// with static_cast. Uses a SIMD kernel for the conversions
+		// i32 -> float, u8 -> float, float -> i32, float -> double
+		// and double -> float.
+		template <typename To, typename From>
+		void convert_n(const From* src, To* dest, std::size_t count)
+		{
+			if constexpr (std::is_same_v<From, To> && std::is_trivially_copyable_v<From>)
+			{
+				if (count != 0)
+					std::memmove(dest, src, count * sizeof(From));
+			}
+			else if constexpr (std::is_same_v<To, float> && (std::is_same_v<From, i32> || std::is_same_v<From, u8> || std::is_same_v<From, double>))
+				simd::convert(src, dest, count);
+			else if constexpr (std::is_same_v<From, float> && (std::is_same_v<To, i32> || std::is_same_v<To, double>))
+				simd::convert(src, dest, count);
+			else
+			{
+				for (std::size_t i = 0; i < count; ++i)
+					dest[i] = static_cast<To>(src[i]);
+			}
+		}
+
+		// Returns the smallest of the count elements starting at ptr.
+		// count must not be 0.
+		template <typename T>
+		T min_n(const T* ptr, std::size_t count)
+		{
+			if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, i32>)
+				return simd::min(ptr, count);
+			else
+				return *std::min_element(ptr, ptr + count);
+		}
+
+		// Returns the largest of the count elements starting at ptr.
+		// count must not be 0.
+		template <typename T>
+		T max_n(const T* ptr, std::size_t count)
+		{
+			if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double> || std::is_same_v<T, i32>)
+				return simd::max(ptr, count);
+			else
+				return *std::max_element(ptr, ptr + count);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,721 @@
+// JLibrary
+// SimdVector.ixx
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Module file for the Vec3f and Vec4f classes.
+
+module;
+
+#include "Angle.hpp"
+#include "Simd.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+export module SimdVector;
+
+import Vector3;
+
+namespace jlib
+{
+	// The 4 floats of a Vec3f or Vec4f. On x86 and x64 they live in an SSE register,
+	// elsewhere the helpers below compute them 1 lane at a time.
+	#ifdef JLIB_SIMD_X86
+	using _float4 = __m128;
+	#else
+	struct alignas(16) _float4
+	{
+		float v[4];
+	};
+	#endif // JLIB_SIMD_X86
+
+	inline _float4 _f4_set(float x, float y, float z, float w) noexcept
+	{
+		#ifdef JLIB_SIMD_X86
+		return _mm_set_ps(w, z, y, x);
+		#else
+		return _float4{ { x, y, z, w } };
+		#endif
+	}
+
+	inline _float4 _f4_splat(float value) noexcept
+	{
+		return _f4_set(value, value, value, value);
+	}
+
+	inline _float4 _f4_load(const float* ptr) noexcept
+	{
+		#ifdef JLIB_SIMD_X86
+		return _mm_loadu_ps(ptr);
+		#else
+		return _float4{ { ptr[0], ptr[1], ptr[2], ptr[3] } };
+		#endif
+	}
+
+	inline void _f4_store(_float4 v, float* ptr) noexcept
+	{
+		#ifdef JLIB_SIMD_X86
+		_mm_storeu_ps(ptr, v);
+		#else
+		for (int i = 0; i < 4; ++i)
+			ptr[i] = v.v[i];
+		#endif
+	}
+
+	// Returns lane i of v.
+	inline float _f4_get(_float4 v, int i) noexcept
+	{
+		alignas(16) float f[4];
+		_f4_store(v, f);
+		return f[i];
+	}
+
+	#ifdef JLIB_SIMD_X86
+	inline _float4 _f4_add(_float4 A, _float4 B) noexcept { return _mm_add_ps(A, B); }
+	inline _float4 _f4_sub(_float4 A, _float4 B) noexcept { return _mm_sub_ps(A, B); }
+	inline _float4 _f4_mul(_float4 A, _float4 B) noexcept { return _mm_mul_ps(A, B); }
+	inline _float4 _f4_div(_float4 A, _float4 B) noexcept { return _mm_div_ps(A, B); }
+	inline _float4 _f4_min(_float4 A, _float4 B) noexcept { return _mm_min_ps(A, B); }
+	inline _float4 _f4_max(_float4 A, _float4 B) noexcept { return _mm_max_ps(A, B); }
+	inline _float4 _f4_sqrt(_float4 A) noexcept { return _mm_sqrt_ps(A); }
+	inline _float4 _f4_abs(_float4 A) noexcept { return _mm_andnot_ps(_mm_set1_ps(-0.0f), A); }
+	inline bool _f4_equal(_float4 A, _float4 B) noexcept { return _mm_movemask_ps(_mm_cmpeq_ps(A, B)) == 0xf; }
+
+	// Sets the w lane to 0.
+	inline _float4 _f4_zero_w(_float4 A) noexcept
+	{
+		return _mm_and_ps(A, _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)));
+	}
+
+	// Returns the sum of the 4 lanes, as (x + z) + (y + w).
+	inline float _f4_sum(_float4 A) noexcept
+	{
+		const __m128 pairs = _mm_add_ps(A, _mm_movehl_ps(A, A));
+		return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 1, 1, 1))));
+	}
+
+	// Returns the cross product of the x, y and z lanes, with w set to 0.
+	inline _float4 _f4_cross(_float4 A, _float4 B) noexcept
+	{
+		// A * B.yzx - A.yzx * B gives the cross product in z, x, y order.
+		const __m128 A_yzx = _mm_shuffle_ps(A, A, _MM_SHUFFLE(3, 0, 2, 1));
+		const __m128 B_yzx = _mm_shuffle_ps(B, B, _MM_SHUFFLE(3, 0, 2, 1));
+		const __m128 C = _mm_sub_ps(_mm_mul_ps(A, B_yzx), _mm_mul_ps(A_yzx, B));
+		return _f4_zero_w(_mm_shuffle_ps(C, C, _MM_SHUFFLE(3, 0, 2, 1)));
+	}
+	#else
+	// Returns op applied to each pair of lanes.
+	template <typename Op>
+	inline _float4 _f4_map(_float4 A, _float4 B, Op op) noexcept
+	{
+		return _float4{ { op(A.v[0], B.v[0]), op(A.v[1], B.v[1]), op(A.v[2], B.v[2]), op(A.v[3], B.v[3]) } };
+	}
+
+	inline _float4 _f4_add(_float4 A, _float4 B) noexcept { return _f4_map(A, B, [](float a, float b) { return a + b; }); }
+	inline _float4 _f4_sub(_float4 A, _float4 B) noexcept { return _f4_map(A, B, [](float a, float b) { return a - b; }); }
+	inline _float4 _f4_mul(_float4 A, _float4 B) noexcept { return _f4_map(A, B, [](float a, float b) { return a * b; }); }
+	inline _float4 _f4_div(_float4 A, _float4 B) noexcept { return _f4_map(A, B, [](float a, float b) { return a / b; }); }
+	inline _float4 _f4_min(_float4 A, _float4 B) noexcept { return _f4_map(A, B, [](float a, float b) { return a < b ? a : b; }); }
+	inline _float4 _f4_max(_float4 A, _float4 B) noexcept { return _f4_map(A, B, [](float a, float b) { return a > b ? a : b; }); }
+	inline _float4 _f4_sqrt(_float4 A) noexcept { return _f4_map(A, A, [](float a, float) { return std::sqrt(a); }); }
+	inline _float4 _f4_abs(_float4 A) noexcept { return _f4_map(A, A, [](float a, float) { return std::abs(a); }); }
+	inline bool _f4_equal(_float4 A, _float4 B) noexcept
+	{
+		return A.v[0] == B.v[0] && A.v[1] == B.v[1] && A.v[2] == B.v[2] && A.v[3] == B.v[3];
+	}
+
+	// Sets the w lane to 0.
+	inline _float4 _f4_zero_w(_float4 A) noexcept
+	{
+		A.v[3] = 0.0f;
+		return A;
+	}
+
+	// Returns the sum of the 4 lanes, as (x + z) + (y + w).
+	inline float _f4_sum(_float4 A) noexcept
+	{
+		return (A.v[0] + A.v[2]) + (A.v[1] + A.v[3]);
+	}
+
+	// Returns the cross product of the x, y and z lanes, with w set to 0.
+	inline _float4 _f4_cross(_float4 A, _float4 B) noexcept
+	{
+		return _float4{ { (A.v[1] * B.v[2]) - (A.v[2] * B.v[1]), (A.v[2] * B.v[0]) - (A.v[0] * B.v[2]),
+						  (A.v[0] * B.v[1]) - (A.v[1] * B.v[0]), 0.0f } };
+	}
+	#endif // JLIB_SIMD_X86
+}
+
+export namespace jlib
+{
+	// Vector in 3-dimensional space that is stored in a single SSE register.
+	// The 4th lane is always 0, so every operation works on all 4 lanes at once.
+	// Vec3f is meant for computing with vectors, while Vector3<float>
+	// is meant for storing them. The two convert explicitly.
+	class alignas(16) Vec3f
+	{
+		_float4 _v;
+
+		public:
+
+		// Constructs the Vec3f from the 4 lanes. The w lane must be 0.
+		explicit Vec3f(_float4 v) noexcept : _v(v)
+		{
+
+		}
+
+		// Default constructor.
+		// Sets every component of the Vec3f to 0.
+		Vec3f() noexcept : _v(_f4_splat(0.0f))
+		{
+
+		}
+
+		// Constructs the Vec3f from the given coordinates.
+		Vec3f(float x, float y, float z) noexcept : _v(_f4_set(x, y, z, 0.0f))
+		{
+
+		}
+
+		// Constructs the Vec3f from a Vector3<float>.
+		explicit Vec3f(const Vector3<float>& vec) noexcept : _v(_f4_set(vec.x, vec.y, vec.z, 0.0f))
+		{
+
+		}
+
+		// Returns the Vec3f as a Vector3<float>.
+		explicit operator Vector3<float>() const
+		{
+			alignas(16) float f[4];
+			_f4_store(_v, f);
+			return Vector3<float>(f[0], f[1], f[2]);
+		}
+
+		// Returns the 4 lanes of the Vec3f.
+		_float4 lanes() const noexcept
+		{
+			return _v;
+		}
+
+		// Returns the x component of the Vec3f.
+		float x() const noexcept
+		{
+			#ifdef JLIB_SIMD_X86
+			return _mm_cvtss_f32(_v);
+			#else
+			return _v.v[0];
+			#endif
+		}
+
+		// Returns the y component of the Vec3f.
+		float y() const noexcept
+		{
+			return _f4_get(_v, 1);
+		}
+
+		// Returns the z component of the Vec3f.
+		float z() const noexcept
+		{
+			return _f4_get(_v, 2);
+		}
+
+		// Sets all the values of the Vec3f at once.
+		void set(float x, float y, float z) noexcept
+		{
+			_v = _f4_set(x, y, z, 0.0f);
+		}
+
+		// Returns the magnitude of the Vec3f.
+		float magnitude() const noexcept
+		{
+			return std::sqrt(_f4_sum(_f4_mul(_v, _v)));
+		}
+
+		// Overload of binary operator +=
+		Vec3f& operator += (const Vec3f& other) noexcept
+		{
+			_v = _f4_add(_v, other._v);
+			return *this;
+		}
+
+		// Overload of binary operator -=
+		Vec3f& operator -= (const Vec3f& other) noexcept
+		{
+			_v = _f4_sub(_v, other._v);
+			return *this;
+		}
+
+		// Overload of binary operator *=
+		Vec3f& operator *= (const Vec3f& other) noexcept
+		{
+			_v = _f4_mul(_v, other._v);
+			return *this;
+		}
+
+		// Overload of binary operator *=
+		// The w lane is cleared again, since 0 * inf and 0 * NaN are NaN.
+		Vec3f& operator *= (float scalar) noexcept
+		{
+			_v = _f4_zero_w(_f4_mul(_v, _f4_splat(scalar)));
+			return *this;
+		}
+
+		// Overload of binary operator /=
+		Vec3f& operator /= (const Vec3f& other) noexcept
+		{
+			_v = _f4_zero_w(_f4_div(_v, other._v));
+			return *this;
+		}
+
+		// Overload of binary operator /=
+		Vec3f& operator /= (float scalar) noexcept
+		{
+			_v = _f4_zero_w(_f4_div(_v, _f4_splat(scalar)));
+			return *this;
+		}
+	};
+
+	// Vector in 4-dimensional space, or a homogeneous 3D point or direction,
+	// that is stored in a single SSE register.
+	class alignas(16) Vec4f
+	{
+		_float4 _v;
+
+		public:
+
+		// Constructs the Vec4f from the 4 lanes.
+		explicit Vec4f(_float4 v) noexcept : _v(v)
+		{
+
+		}
+
+		// Default constructor.
+		// Sets every component of the Vec4f to 0.
+		Vec4f() noexcept : _v(_f4_splat(0.0f))
+		{
+
+		}
+
+		// Constructs the Vec4f from the given coordinates.
+		Vec4f(float x, float y, float z, float w) noexcept : _v(_f4_set(x, y, z, w))
+		{
+
+		}
+
+		// Constructs the Vec4f from a Vec3f and a w component.
+		Vec4f(const Vec3f& vec, float w) noexcept : _v(_f4_add(vec.lanes(), _f4_set(0.0f, 0.0f, 0.0f, w)))
+		{
+
+		}
+
+		// Constructs the Vec4f from a Vector3<float> and a w component.
+		Vec4f(const Vector3<float>& vec, float w) noexcept : _v(_f4_set(vec.x, vec.y, vec.z, w))
+		{
+
+		}
+
+		// Returns the Vec4f with the 4 floats starting at ptr.
+		static Vec4f load(const float* ptr) noexcept
+		{
+			return Vec4f(_f4_load(ptr));
+		}
+
+		// Writes the 4 components of the Vec4f to ptr.
+		void store(float* ptr) const noexcept
+		{
+			_f4_store(_v, ptr);
+		}
+
+		// Returns the 4 lanes of the Vec4f.
+		_float4 lanes() const noexcept
+		{
+			return _v;
+		}
+
+		// Returns the x, y and z components of the Vec4f.
+		Vec3f xyz() const noexcept
+		{
+			return Vec3f(_f4_zero_w(_v));
+		}
+
+		// Returns the x component of the Vec4f.
+		float x() const noexcept
+		{
+			return _f4_get(_v, 0);
+		}
+
+		// Returns the y component of the Vec4f.
+		float y() const noexcept
+		{
+			return _f4_get(_v, 1);
+		}
+
+		// Returns the z component of the Vec4f.
+		float z() const noexcept
+		{
+			return _f4_get(_v, 2);
+		}
+
+		// Returns the w component of the Vec4f.
+		float w() const noexcept
+		{
+			return _f4_get(_v, 3);
+		}
+
+		// Sets all the values of the Vec4f at once.
+		void set(float x, float y, float z, float w) noexcept
+		{
+			_v = _f4_set(x, y, z, w);
+		}
+
+		// Returns the magnitude of the Vec4f.
+		float magnitude() const noexcept
+		{
+			return std::sqrt(_f4_sum(_f4_mul(_v, _v)));
+		}
+
+		// Overload of binary operator +=
+		Vec4f& operator += (const Vec4f& other) noexcept
+		{
+			_v = _f4_add(_v, other._v);
+			return *this;
+		}
+
+		// Overload of binary operator -=
+		Vec4f& operator -= (const Vec4f& other) noexcept
+		{
+			_v = _f4_sub(_v, other._v);
+			return *this;
+		}
+
+		// Overload of binary operator *=
+		Vec4f& operator *= (const Vec4f& other) noexcept
+		{
+			_v = _f4_mul(_v, other._v);
+			return *this;
+		}
+
+		// Overload of binary operator *=
+		Vec4f& operator *= (float scalar) noexcept
+		{
+			_v = _f4_mul(_v, _f4_splat(scalar));
+			return *this;
+		}
+
+		// Overload of binary operator /=
+		Vec4f& operator /= (const Vec4f& other) noexcept
+		{
+			_v = _f4_div(_v, other._v);
+			return *this;
+		}
+
+		// Overload of binary operator /=
+		Vec4f& operator /= (float scalar) noexcept
+		{
+			_v = _f4_div(_v, _f4_splat(scalar));
+			return *this;
+		}
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Returns a Vec3f whose elements are the absolute values of
+	// each of the specified Vec3f's elements.
+	inline Vec3f abs(const Vec3f& vec) noexcept
+	{
+		return Vec3f(_f4_abs(vec.lanes()));
+	}
+
+	// Returns the dot product of the 2 given Vec3fs.
+	inline float dot_product(const Vec3f& A, const Vec3f& B) noexcept
+	{
+		return _f4_sum(_f4_mul(A.lanes(), B.lanes()));
+	}
+
+	// Returns the cross product of the 2 given Vec3fs.
+	inline Vec3f cross_product(const Vec3f& A, const Vec3f& B) noexcept
+	{
+		return Vec3f(_f4_cross(A.lanes(), B.lanes()));
+	}
+
+	// Returns the magnitude of the given Vec3f.
+	inline float magnitude(const Vec3f& vec) noexcept
+	{
+		return vec.magnitude();
+	}
+
+	// Returns the distance squared between the 2 given Vec3fs, treated as points.
+	inline float distance_squared(const Vec3f& A, const Vec3f& B) noexcept
+	{
+		const _float4 d = _f4_sub(B.lanes(), A.lanes());
+		return _f4_sum(_f4_mul(d, d));
+	}
+
+	// Returns the distance between the 2 given Vec3fs, treated as points.
+	inline float distance(const Vec3f& A, const Vec3f& B) noexcept
+	{
+		return std::sqrt(distance_squared(A, B));
+	}
+
+	// Determines if the 2 given Vec3fs are orthogonal to eachother.
+	inline bool are_normal(const Vec3f& A, const Vec3f& B) noexcept
+	{
+		return dot_product(A, B) == 0.0f;
+	}
+
+	// Returns the angle between the 2 given Vec3fs.
+	inline Angle angle_between(const Vec3f& A, const Vec3f& B)
+	{
+		return arccosine(dot_product(A, B) / std::sqrt(dot_product(A, A) * dot_product(B, B)));
+	}
+
+	// Returns the scalar projection of A onto B.
+	inline float comp_proj(const Vec3f& A, const Vec3f& B) noexcept
+	{
+		return dot_product(A, B) / B.magnitude();
+	}
+
+	// Returns the vector projection of A onto B.
+	inline Vec3f vector_proj(const Vec3f& A, const Vec3f& B) noexcept
+	{
+		return Vec3f(_f4_mul(B.lanes(), _f4_splat(dot_product(A, B) / dot_product(B, B))));
+	}
+
+	// Returns a unit vector of the given Vec3f.
+	inline Vec3f unit_vector(const Vec3f& vec) noexcept
+	{
+		return Vec3f(_f4_zero_w(_f4_div(vec.lanes(), _f4_splat(vec.magnitude()))));
+	}
+
+	// Normalizes the Vec3f by scaling each of its components so that it
+	// has a magnitude of 1.
+	inline void normalize(Vec3f& vec) noexcept
+	{
+		vec = unit_vector(vec);
+	}
+
+	// Returns a Vec3f whose elements are the maximum of each of the
+	// pairs of elements in two specified Vec3fs.
+	inline Vec3f max(const Vec3f& A, const Vec3f& B) noexcept
+	{
+		return Vec3f(_f4_max(A.lanes(), B.lanes()));
+	}
+
+	// Returns a Vec3f whose elements are the minimum of each of the
+	// pairs of elements in two specified Vec3fs.
+	inline Vec3f min(const Vec3f& A, const Vec3f& B) noexcept
+	{
+		return Vec3f(_f4_min(A.lanes(), B.lanes()));
+	}
+
+	// Returns a std::string representation of the given Vec3f.
+	inline std::string to_string(const Vec3f& vec)
+	{
+		return '<' + std::to_string(vec.x()) + ", " + std::to_string(vec.y()) + ", " + std::to_string(vec.z()) + '>';
+	}
+
+	// Returns a Vec4f whose elements are the absolute values of
+	// each of the specified Vec4f's elements.
+	inline Vec4f abs(const Vec4f& vec) noexcept
+	{
+		return Vec4f(_f4_abs(vec.lanes()));
+	}
+
+	// Returns the dot product of the 2 given Vec4fs.
+	inline float dot_product(const Vec4f& A, const Vec4f& B) noexcept
+	{
+		return _f4_sum(_f4_mul(A.lanes(), B.lanes()));
+	}
+
+	// Returns the magnitude of the given Vec4f.
+	inline float magnitude(const Vec4f& vec) noexcept
+	{
+		return vec.magnitude();
+	}
+
+	// Returns the distance squared between the 2 given Vec4fs, treated as points.
+	inline float distance_squared(const Vec4f& A, const Vec4f& B) noexcept
+	{
+		const _float4 d = _f4_sub(B.lanes(), A.lanes());
+		return _f4_sum(_f4_mul(d, d));
+	}
+
+	// Returns the distance between the 2 given Vec4fs, treated as points.
+	inline float distance(const Vec4f& A, const Vec4f& B) noexcept
+	{
+		return std::sqrt(distance_squared(A, B));
+	}
+
+	// Returns the angle between the 2 given Vec4fs.
+	inline Angle angle_between(const Vec4f& A, const Vec4f& B)
+	{
+		return arccosine(dot_product(A, B) / std::sqrt(dot_product(A, A) * dot_product(B, B)));
+	}
+
+	// Returns the vector projection of A onto B.
+	inline Vec4f vector_proj(const Vec4f& A, const Vec4f& B) noexcept
+	{
+		return Vec4f(_f4_mul(B.lanes(), _f4_splat(dot_product(A, B) / dot_product(B, B))));
+	}
+
+	// Returns a unit vector of the given Vec4f.
+	inline Vec4f unit_vector(const Vec4f& vec) noexcept
+	{
+		return Vec4f(_f4_div(vec.lanes(), _f4_splat(vec.magnitude())));
+	}
+
+	// Normalizes the Vec4f by scaling each of its components so that it
+	// has a magnitude of 1.
+	inline void normalize(Vec4f& vec) noexcept
+	{
+		vec = unit_vector(vec);
+	}
+
+	// Returns a Vec4f whose elements are the maximum of each of the
+	// pairs of elements in two specified Vec4fs.
+	inline Vec4f max(const Vec4f& A, const Vec4f& B) noexcept
+	{
+		return Vec4f(_f4_max(A.lanes(), B.lanes()));
+	}
+
+	// Returns a Vec4f whose elements are the minimum of each of the
+	// pairs of elements in two specified Vec4fs.
+	inline Vec4f min(const Vec4f& A, const Vec4f& B) noexcept
+	{
+		return Vec4f(_f4_min(A.lanes(), B.lanes()));
+	}
+
+	// Returns a std::string representation of the given Vec4f.
+	inline std::string to_string(const Vec4f& vec)
+	{
+		return '<' + std::to_string(vec.x()) + ", " + std::to_string(vec.y()) + ", " +
+			   std::to_string(vec.z()) + ", " + std::to_string(vec.w()) + '>';
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Overload of binary operator ==
+	inline bool operator == (const Vec3f& A, const Vec3f& B) noexcept
+	{
+		return _f4_equal(A.lanes(), B.lanes());
+	}
+
+	// Overload of unary operator -
+	inline Vec3f operator - (const Vec3f& A) noexcept
+	{
+		return Vec3f(_f4_sub(_f4_splat(0.0f), A.lanes()));
+	}
+
+	// Overload of binary operator +
+	inline Vec3f operator + (Vec3f A, const Vec3f& B) noexcept
+	{
+		return A += B;
+	}
+
+	// Overload of binary operator -
+	inline Vec3f operator - (Vec3f A, const Vec3f& B) noexcept
+	{
+		return A -= B;
+	}
+
+	// Overload of binary operator *
+	inline Vec3f operator * (Vec3f A, const Vec3f& B) noexcept
+	{
+		return A *= B;
+	}
+
+	// Overload of binary operator *
+	inline Vec3f operator * (Vec3f A, float scalar) noexcept
+	{
+		return A *= scalar;
+	}
+
+	// Overload of binary operator *
+	inline Vec3f operator * (float scalar, Vec3f A) noexcept
+	{
+		return A *= scalar;
+	}
+
+	// Overload of binary operator /
+	inline Vec3f operator / (Vec3f A, const Vec3f& B) noexcept
+	{
+		return A /= B;
+	}
+
+	// Overload of binary operator /
+	inline Vec3f operator / (Vec3f A, float scalar) noexcept
+	{
+		return A /= scalar;
+	}
+
+	// Overload of binary operator <<
+	inline std::ostream& operator << (std::ostream& os, const Vec3f& vec)
+	{
+		os << to_string(vec);
+		return os;
+	}
+
+	// Overload of binary operator ==
+	inline bool operator == (const Vec4f& A, const Vec4f& B) noexcept
+	{
+		return _f4_equal(A.lanes(), B.lanes());
+	}
+
+	// Overload of unary operator -
+	inline Vec4f operator - (const Vec4f& A) noexcept
+	{
+		return Vec4f(_f4_sub(_f4_splat(0.0f), A.lanes()));
+	}
+
+	// Overload of binary operator +
+	inline Vec4f operator + (Vec4f A, const Vec4f& B) noexcept
+	{
+		return A += B;
+	}
+
+	// Overload of binary operator -
+	inline Vec4f operator - (Vec4f A, const Vec4f& B) noexcept
+	{
+		return A -= B;
+	}
+
+	// Overload of binary operator *
+	inline Vec4f operator * (Vec4f A, const Vec4f& B) noexcept
+	{
+		return A *= B;
+	}
+
+	// Overload of binary operator *
+	inline Vec4f operator * (Vec4f A, float scalar) noexcept
+	{
+		return A *= scalar;
+	}
+
+	// Overload of binary operator *
+	inline Vec4f operator * (float scalar, Vec4f A) noexcept
+	{
+		return A *= scalar;
+	}
+
+	// Overload of binary operator /
+	inline Vec4f operator / (Vec4f A, const Vec4f& B) noexcept
+	{
+		return A /= B;
+	}
+
+	// Overload of binary operator /
+	inline Vec4f operator / (Vec4f A, float scalar) noexcept
+	{
+		return A /= scalar;
+	}
+
+	// Overload of binary operator <<
+	inline std::ostream& operator << (std::ostream& os, const Vec4f& vec)
+	{
+		os << to_string(vec);
+		return os;
+	}
+}
\ No newline at end of file
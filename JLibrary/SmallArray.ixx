@@ -0,0 +1,724 @@
+// JLibrary
+// SmallArray.ixx
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Module file for the SmallArray template class.
+
+module;
+
+#include "Simd.hpp"
+#include "Uninitialized.hpp"
+
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+export module SmallArray;
+
+import MiscTemplateFunctions;
+
+export namespace jlib
+{
+	// This template class serves as a resizable container with
+	// a small-buffer optimization. Up to N elements are stored inline
+	// inside the SmallArray itself, so small lists never allocate memory.
+	// Past N elements the contents spill to the heap and the SmallArray
+	// grows geometrically, just like an Array.
+	// 
+	// The interface matches Array, so a SmallArray can replace an Array
+	// that usually holds only a handful of elements.
+	template <typename T, std::size_t N> class SmallArray
+	{
+		public:
+
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using iterator = value_type*;
+		using const_iterator = const value_type*;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		private:
+
+		pointer _data;
+		size_type _size;
+		size_type _capacity;
+		alignas(value_type) std::byte _buffer[(N == 0 ? 1 : N) * sizeof(value_type)];
+
+		// Returns a pointer to the inline storage.
+		pointer inlineData() noexcept
+		{
+			return reinterpret_cast<pointer>(_buffer);
+		}
+
+		// Returns true if the elements are stored inline.
+		bool isInline() const noexcept
+		{
+			return _data == reinterpret_cast<const_pointer>(_buffer);
+		}
+
+		// Returns uninitialized heap storage large enough for capacity elements.
+		// It may throw if it fails to do this.
+		static pointer allocateStorage(size_type capacity)
+		{
+			return static_cast<pointer>(::operator new(capacity * sizeof(value_type), std::align_val_t(alignof(value_type))));
+		}
+
+		// Releases the current storage if it is on the heap.
+		void deallocateStorage() noexcept
+		{
+			if (!isInline())
+				::operator delete(_data, std::align_val_t(alignof(value_type)));
+		}
+
+		// Returns the capacity the SmallArray should grow to in order
+		// to hold at least min_capacity elements.
+		constexpr size_type growthCapacity(size_type min_capacity) const noexcept
+		{
+			size_type new_capacity = _capacity * 2;
+
+			if (new_capacity < min_capacity)
+				new_capacity = min_capacity;
+
+			return new_capacity;
+		}
+
+		// Sets the SmallArray to an empty state using the inline storage.
+		void reset() noexcept
+		{
+			_data = inlineData();
+			_size = 0;
+			_capacity = N;
+		}
+
+		// Destroys every element and releases any heap memory.
+		void deallocate() noexcept
+		{
+			std::destroy_n(_data, _size);
+			deallocateStorage();
+			reset();
+		}
+
+		// This function moves the elements into storage for new_capacity elements.
+		// The inline storage is used if new_capacity is at most N.
+		// It may throw if it fails to do this.
+		void relocate(size_type new_capacity)
+		{
+			pointer new_data = new_capacity <= N ? inlineData() : allocateStorage(new_capacity);
+
+			if (new_data == _data)
+				return;
+
+			try
+			{
+				if constexpr (std::is_nothrow_move_constructible_v<value_type> || !std::is_copy_constructible_v<value_type>)
+					std::uninitialized_move_n(_data, _size, new_data);
+				else
+					std::uninitialized_copy_n(_data, _size, new_data);
+			}
+			catch (...)
+			{
+				if (new_data != inlineData())
+					::operator delete(new_data, std::align_val_t(alignof(value_type)));
+				throw;
+			}
+
+			std::destroy_n(_data, _size);
+			deallocateStorage();
+			_data = new_data;
+			_capacity = new_capacity <= N ? N : new_capacity;
+		}
+
+		// Takes the contents of another SmallArray, leaving it empty.
+		// This SmallArray must be empty and use its inline storage.
+		void take(SmallArray& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+		{
+			if (other.isInline())
+			{
+				std::uninitialized_move_n(other._data, other._size, _data);
+				_size = other._size;
+				std::destroy_n(other._data, other._size);
+				other._size = 0;
+			}
+			else
+			{
+				_data = other._data;
+				_size = other._size;
+				_capacity = other._capacity;
+				other.reset();
+			}
+		}
+
+		// Replaces the contents with a copy of the range [first, first + size).
+		// It may throw if it fails to do this.
+		void assignCopy(const_pointer first, size_type size)
+		{
+			if (size > _capacity)
+			{
+				deallocate();
+				relocate(size);
+			}
+
+			if (size <= _size)
+			{
+				std::copy(first, first + size, _data);
+				std::destroy(_data + size, _data + _size);
+			}
+			else
+			{
+				std::copy(first, first + _size, _data);
+				std::uninitialized_copy(first + _size, first + size, _data + _size);
+			}
+
+			_size = size;
+		}
+
+		public:
+
+		// Default constructor.
+		SmallArray()
+		{
+			reset();
+		}
+
+		// Size constructor.
+		// Every element is value-initialized.
+		SmallArray(size_type size)
+		{
+			reset();
+			resize(size);
+		}
+
+		// Uninitialized size constructor.
+		// Trivial elements are left untouched, so their contents must be
+		// written before they are read.
+		SmallArray(size_type size, uninitialized_t)
+		{
+			reset();
+			reserve(size);
+			std::uninitialized_default_construct_n(_data, size);
+			_size = size;
+		}
+
+		// Size and value constructor.
+		SmallArray(size_type size, const_reference value)
+		{
+			reset();
+			resize(size, value);
+		}
+
+		// Constructs the SmallArray with the contents in the range[begin, end).
+		// This DOES NOT move the contents from the given range, it simply
+		// copies its contents into the new SmallArray.
+		SmallArray(const_pointer begin, const_pointer end)
+		{
+			reset();
+			assignCopy(begin, end - begin);
+		}
+
+		// std::initializer_list constructor.
+		SmallArray(std::initializer_list<T> elems)
+		{
+			reset();
+			assignCopy(elems.begin(), elems.size());
+		}
+
+		// Copy constructor.
+		SmallArray(const SmallArray& other)
+		{
+			reset();
+			assignCopy(other._data, other._size);
+		}
+
+		// Constructs the SmallArray from another type of SmallArray.
+		// This constructor doesn't replace the copy constructor,
+		// it's called only when U != T.
+		template <typename U, std::size_t M>
+		explicit SmallArray(const SmallArray<U, M>& other)
+		{
+			reset();
+			resize(other.size());
+			jlib::copy(other.data(), other.dataEnd(), _data);
+		}
+
+		// Move constructor.
+		// Heap memory is taken over, inline elements are moved one by one.
+		SmallArray(SmallArray&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+		{
+			reset();
+			take(other);
+		}
+
+		// std::initializer_list assignment operator.
+		SmallArray& operator = (std::initializer_list<T> elems)
+		{
+			assignCopy(elems.begin(), elems.size());
+			return *this;
+		}
+
+		// Copy assignment operator.
+		SmallArray& operator = (const SmallArray& other)
+		{
+			if (this != &other)
+				assignCopy(other._data, other._size);
+
+			return *this;
+		}
+
+		// Move assignment operator.
+		SmallArray& operator = (SmallArray&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+		{
+			if (this != &other)
+			{
+				deallocate();
+				take(other);
+			}
+
+			return *this;
+		}
+
+		// Destructor.
+		~SmallArray() noexcept
+		{
+			deallocate();
+		}
+
+		// Returns the number of elements stored inline.
+		static constexpr size_type inlineCapacity() noexcept
+		{
+			return N;
+		}
+
+		// Returns true if the elements have spilled to the heap.
+		bool isOnHeap() const noexcept
+		{
+			return !isInline();
+		}
+
+		// Returns the size of the SmallArray.
+		constexpr size_type size() const noexcept
+		{
+			return _size;
+		}
+
+		// Returns the number of elements the SmallArray can hold
+		// before it needs to allocate more memory.
+		constexpr size_type capacity() const noexcept
+		{
+			return _capacity;
+		}
+
+		// Returns true if the SmallArray is empty.
+		constexpr bool isEmpty() const noexcept
+		{
+			return _size == 0;
+		}
+
+		// Returns the first element of the SmallArray.
+		constexpr reference first()
+		{
+			return _data[0];
+		}
+
+		// Returns the first element of the SmallArray.
+		constexpr const_reference first() const
+		{
+			return _data[0];
+		}
+
+		// Returns the last element of the SmallArray.
+		constexpr reference last()
+		{
+			return _data[_size - 1];
+		}
+
+		// Returns the last element of the SmallArray.
+		constexpr const_reference last() const
+		{
+			return _data[_size - 1];
+		}
+
+		// Returns the pointer of the SmallArray.
+		constexpr pointer data() noexcept
+		{
+			return _data;
+		}
+
+		// Returns the pointer of the SmallArray.
+		constexpr const_pointer data() const noexcept
+		{
+			return _data;
+		}
+
+		// Returns a pointer to 1 past the last element of the SmallArray.
+		constexpr pointer dataEnd() noexcept
+		{
+			return _data + _size;
+		}
+
+		// Returns a pointer to 1 past the last element of the SmallArray.
+		constexpr const_pointer dataEnd() const noexcept
+		{
+			return _data + _size;
+		}
+
+		// Returns an iterator pointing to the first element of the SmallArray.
+		constexpr iterator begin() noexcept
+		{
+			return _data;
+		}
+
+		// Returns an iterator pointing to the first element of the SmallArray.
+		constexpr const_iterator begin() const noexcept
+		{
+			return _data;
+		}
+
+		// Returns an iterator pointing to the first element of the SmallArray.
+		constexpr const_iterator cbegin() const noexcept
+		{
+			return _data;
+		}
+
+		// Returns a reverse iterator pointing to the last element of the SmallArray.
+		constexpr reverse_iterator rbegin() noexcept
+		{
+			return reverse_iterator(_data + _size);
+		}
+
+		// Returns a reverse iterator pointing to the last element of the SmallArray.
+		constexpr const_reverse_iterator rbegin() const noexcept
+		{
+			return const_reverse_iterator(_data + _size);
+		}
+
+		// Returns a reverse iterator pointing to the last element of the SmallArray.
+		constexpr const_reverse_iterator crbegin() const noexcept
+		{
+			return const_reverse_iterator(_data + _size);
+		}
+
+		// Returns an iterator pointing to 1 past the last element of the SmallArray.
+		constexpr iterator end() noexcept
+		{
+			return _data + _size;
+		}
+
+		// Returns an iterator pointing to 1 past the last element of the SmallArray.
+		constexpr const_iterator end() const noexcept
+		{
+			return _data + _size;
+		}
+
+		// Returns an iterator pointing to 1 past the last element of the SmallArray.
+		constexpr const_iterator cend() const noexcept
+		{
+			return _data + _size;
+		}
+
+		// Returns a reverse iterator pointing to 1 before the first element of the SmallArray.
+		constexpr reverse_iterator rend() noexcept
+		{
+			return reverse_iterator(_data);
+		}
+
+		// Returns a reverse iterator pointing to 1 before the first element of the SmallArray.
+		constexpr const_reverse_iterator rend() const noexcept
+		{
+			return const_reverse_iterator(_data);
+		}
+
+		// Returns a reverse iterator pointing to 1 before the first element of the SmallArray.
+		constexpr const_reverse_iterator crend() const noexcept
+		{
+			return const_reverse_iterator(_data);
+		}
+
+		// Returns the element at the given index of the SmallArray.
+		// Throws a std::out_of_range if given an invalid index.
+		constexpr reference at(size_type index)
+		{
+			if (index >= _size)
+				throw std::out_of_range("ERROR: Invalid array index.");
+
+			return _data[index];
+		}
+
+		// Returns the element at the given index of the SmallArray.
+		// Throws a std::out_of_range if given an invalid index.
+		constexpr const_reference at(size_type index) const
+		{
+			if (index >= _size)
+				throw std::out_of_range("ERROR: Invalid array index.");
+
+			return _data[index];
+		}
+
+		// Sets the element at the given index to the given value.
+		// Throws a std::out_of_range if given an invalid index.
+		constexpr void set(size_type index, const_reference value)
+		{
+			if (index >= _size)
+				throw std::out_of_range("ERROR: Invalid array index.");
+
+			_data[index] = value;
+		}
+
+		// Sets every element to the given value.
+		constexpr void setAll(const_reference value)
+		{
+			if (std::is_constant_evaluated())
+				std::fill(_data, _data + _size, value);
+			else
+				simd::fill_n(_data, _size, value);
+		}
+
+		// Empties the SmallArray and releases any heap memory.
+		void clear() noexcept
+		{
+			deallocate();
+		}
+
+		// Ensures the SmallArray can hold at least new_capacity elements
+		// without allocating more memory.
+		// It may throw if it fails to do this.
+		void reserve(size_type new_capacity)
+		{
+			if (new_capacity > _capacity)
+				relocate(new_capacity);
+		}
+
+		// Reduces the capacity of the SmallArray to its size, moving
+		// the elements back inline if they fit.
+		// It may throw if it fails to do this.
+		void shrink_to_fit()
+		{
+			if (isInline() || _capacity == _size)
+				return;
+
+			relocate(_size);
+		}
+
+		// Appends a copy of the given value to the end of the SmallArray.
+		// It may throw if it fails to do this.
+		void push_back(const_reference value)
+		{
+			emplace_back(value);
+		}
+
+		// Moves the given value to the end of the SmallArray.
+		// It may throw if it fails to do this.
+		void push_back(value_type&& value)
+		{
+			emplace_back(std::move(value));
+		}
+
+		// Constructs a new element at the end of the SmallArray from the given arguments.
+		// Returns a reference to the new element.
+		// It may throw if it fails to do this.
+		template <typename... Args>
+		reference emplace_back(Args&&... args)
+		{
+			if (_size == _capacity)
+			{
+				// The arguments may refer to an element of this SmallArray,
+				// so the new element is built before relocating.
+				value_type value(std::forward<Args>(args)...);
+				relocate(growthCapacity(_size + 1));
+				std::construct_at(_data + _size, std::move(value));
+			}
+			else
+				std::construct_at(_data + _size, std::forward<Args>(args)...);
+
+			++_size;
+			return _data[_size - 1];
+		}
+
+		// Removes the last element of the SmallArray.
+		// Does NOT check if the SmallArray is empty.
+		void pop_back() noexcept
+		{
+			--_size;
+			std::destroy_at(_data + _size);
+		}
+
+		// Resizes the SmallArray, keeping the first min(size(), new_size) elements.
+		// New elements are value-initialized. The capacity grows
+		// geometrically, like push_back.
+		// It may throw if it fails to do this.
+		void resize(size_type new_size)
+		{
+			if (new_size <= _size)
+			{
+				std::destroy(_data + new_size, _data + _size);
+				_size = new_size;
+				return;
+			}
+
+			if (new_size > _capacity)
+				relocate(growthCapacity(new_size));
+
+			std::uninitialized_value_construct(_data + _size, _data + new_size);
+			_size = new_size;
+		}
+
+		// Resizes the SmallArray, keeping the first min(size(), new_size) elements.
+		// New elements are copies of the given value. The capacity
+		// grows geometrically, like push_back.
+		// It may throw if it fails to do this.
+		void resize(size_type new_size, const_reference value)
+		{
+			if (new_size <= _size)
+			{
+				std::destroy(_data + new_size, _data + _size);
+				_size = new_size;
+				return;
+			}
+
+			value_type copy(value);
+			if (new_size > _capacity)
+				relocate(growthCapacity(new_size));
+
+			std::uninitialized_fill(_data + _size, _data + new_size, copy);
+			_size = new_size;
+		}
+
+		// Swaps the contents of this SmallArray with another SmallArray.
+		void swapWith(SmallArray& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+		{
+			if (this == &other)
+				return;
+
+			SmallArray temp(std::move(other));
+			other.take(*this);
+			take(temp);
+		}
+
+		// Returns the element at the given index the SmallArray.
+		// Does NOT perform bounds-checking.
+		constexpr reference operator [] (size_type index)
+		{
+			return _data[index];
+		}
+
+		// Returns the element at the given index the SmallArray.
+		// Does NOT perform bounds-checking.
+		constexpr const_reference operator [] (size_type index) const
+		{
+			return _data[index];
+		}
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Prints the contents of the SmallArray using the std::cout ostream.
+	// This code will not compile if type T does not overload the
+	// std::ostream insertion operator <<.
+	template <typename T, std::size_t N>
+	void print_array(const SmallArray<T, N>& arr)
+	{
+		jlib::print_array(arr.data(), arr.size());
+	}
+
+	// Prints the contents of the SmallArray using the std::wcout wostream.
+	// This code will not compile if type T does not overload the
+	// std::wostream insertion operator <<.
+	template <typename T, std::size_t N>
+	void print_array_wide(const SmallArray<T, N>& arr)
+	{
+		jlib::print_array_wide(arr.data(), arr.size());
+	}
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Overload of binary operator ==
+	template <std::totally_ordered T, std::size_t N>
+	bool operator == (const SmallArray<T, N>& A, const SmallArray<T, N>& B)
+	{
+		if (A.size() != B.size())
+			return false;
+
+		return simd::equal_n(A.data(), B.data(), A.size());
+	}
+
+	// Overload of binary operator !=
+	template <std::totally_ordered T, std::size_t N>
+	bool operator != (const SmallArray<T, N>& A, const SmallArray<T, N>& B)
+	{
+		return !(A == B);
+	}
+
+	// Overload of binary operator <=>
+	template <std::totally_ordered T, std::size_t N>
+	std::strong_ordering operator <=> (const SmallArray<T, N>& A, const SmallArray<T, N>& B)
+	{
+		if (A.size() < B.size())
+			return std::strong_ordering::less;
+		if (A.size() > B.size())
+			return std::strong_ordering::greater;
+
+		for (std::size_t i = 0; i < A.size(); ++i)
+		{
+			if (A[i] < B[i])
+				return std::strong_ordering::less;
+			else if (A[i] > B[i])
+				return std::strong_ordering::greater;
+		}
+
+		return std::strong_ordering::equal;
+	}
+
+	// Overload of std::ostream operator <<
+	template <typename T, std::size_t N>
+	std::ostream& operator << (std::ostream& os, const SmallArray<T, N>& A)
+	{
+		if (A.isEmpty())
+		{
+			os << "{ }\n";
+			return os;
+		}
+
+		os << "{ ";
+
+		for (std::size_t i = 0; i < A.size() - 1; ++i)
+			os << A[i] << ", ";
+
+		os << A[A.size() - 1] << " }\n";
+		return os;
+	}
+
+	// Overload of std::wostream operator <<
+	template <typename T, std::size_t N>
+	std::wostream& operator << (std::wostream& wos, const SmallArray<T, N>& A)
+	{
+		if (A.isEmpty())
+		{
+			wos << L"{ }\n";
+			return wos;
+		}
+
+		wos << L"{ ";
+
+		for (std::size_t i = 0; i < A.size() - 1; ++i)
+			wos << A[i] << L", ";
+
+		wos << A[A.size() - 1] << L" }\n";
+		return wos;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,576 @@
+// JLibrary
+// SparseMatrix.ixx
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Module file for the SparseMatrix template class.
+
+module;
+
+#include "Arithmetic.hpp"
+#include "Uninitialized.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <execution>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+export module SparseMatrix;
+
+import Array;
+import Matrix;
+import VectorN;
+
+namespace jlib
+{
+	// Products with fewer nonzero elements than this run on a single thread.
+	inline constexpr std::size_t _parallel_spmv = std::size_t(1) << 16;
+
+	// Number of nonzero elements each thread of a product is given.
+	inline constexpr std::size_t _spmv_chunk = std::size_t(1) << 14;
+}
+
+export namespace jlib
+{
+	// The layout of a SparseMatrix.
+	// CSR (compressed sparse row) stores the nonzero elements row by row,
+	// CSC (compressed sparse column) stores them column by column.
+	enum class SparseFormat
+	{
+		CSR,
+		CSC
+	};
+
+	// A nonzero element of a SparseMatrix, used to build one.
+	template <typename T> struct SparseTriplet
+	{
+		std::size_t row;
+		std::size_t col;
+		T value;
+	};
+
+	// Utility template class for representing matrices
+	// whose elements are mostly zero.
+	//
+	// Only the nonzero elements are stored, along with their indices.
+	// The major dimension is the rows for CSR and the columns for CSC.
+	// offsets()[i] is the position of the first stored element of
+	// major line i, and the elements of each line are sorted by their
+	// minor index, which is the column for CSR and the row for CSC.
+	//
+	// The matrix-vector product reads the matrix along its major lines,
+	// in parallel for large matrices, so A * x is fastest with CSR
+	// and transpose(A) * x is fastest with CSC.
+	template <typename T, SparseFormat Format = SparseFormat::CSR, typename Allocator = std::allocator<T>> class SparseMatrix
+	{
+		public:
+
+		using value_type = T;
+		using allocator_type = Allocator;
+		using size_type = std::size_t;
+		using index_allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<std::size_t>;
+
+		static constexpr SparseFormat format = Format;
+
+		private:
+
+		size_type _rows;
+		size_type _cols;
+		Array<size_type, index_allocator_type> _offsets;
+		Array<size_type, index_allocator_type> _indices;
+		Array<T, Allocator> _values;
+
+		// Returns the number of major lines.
+		constexpr size_type majorCount() const noexcept
+		{
+			return Format == SparseFormat::CSR ? _rows : _cols;
+		}
+
+		// Returns the major and minor indices of [row][col].
+		static constexpr std::pair<size_type, size_type> majorMinor(size_type row, size_type col) noexcept
+		{
+			if constexpr (Format == SparseFormat::CSR)
+				return { row, col };
+			else
+				return { col, row };
+		}
+
+		// Builds the matrix from the given triplets with a counting sort
+		// over the major index, then sorts every line by its minor index
+		// and merges the duplicates.
+		template <std::forward_iterator Iter>
+		void build(Iter first, Iter last)
+		{
+			const size_type count = static_cast<size_type>(std::distance(first, last));
+			const size_type major_count = majorCount();
+
+			std::fill(_offsets.begin(), _offsets.end(), size_type(0));
+
+			for (Iter iter = first; iter != last; ++iter)
+			{
+				if (iter->row >= _rows || iter->col >= _cols)
+					throw std::out_of_range("ERROR: Invalid SparseMatrix index.");
+
+				++_offsets[majorMinor(iter->row, iter->col).first + 1];
+			}
+
+			std::partial_sum(_offsets.begin(), _offsets.end(), _offsets.begin());
+
+			_indices = Array<size_type, index_allocator_type>(count, uninitialized, _indices.get_allocator());
+			_values = Array<T, Allocator>(count, _values.get_allocator());
+
+			Array<size_type, index_allocator_type> next(_offsets.begin(), _offsets.end() - 1, _offsets.get_allocator());
+
+			for (Iter iter = first; iter != last; ++iter)
+			{
+				auto [major, minor] = majorMinor(iter->row, iter->col);
+				size_type pos = next[major]++;
+				_indices[pos] = minor;
+				_values[pos] = iter->value;
+			}
+
+			// Sorts each line and sums the elements with the same index,
+			// compacting the arrays as it goes.
+			std::vector<std::pair<size_type, T>> line;
+			size_type write = 0;
+
+			for (size_type major = 0; major < major_count; ++major)
+			{
+				const size_type begin = _offsets[major];
+				const size_type end = _offsets[major + 1];
+				_offsets[major] = write;
+
+				bool sorted = true;
+
+				for (size_type i = begin + 1; i < end && sorted; ++i)
+					sorted = _indices[i - 1] < _indices[i];
+
+				if (sorted)
+				{
+					for (size_type i = begin; i < end; ++i, ++write)
+					{
+						_indices[write] = _indices[i];
+						_values[write] = std::move(_values[i]);
+					}
+
+					continue;
+				}
+
+				line.clear();
+
+				for (size_type i = begin; i < end; ++i)
+					line.emplace_back(_indices[i], std::move(_values[i]));
+
+				std::stable_sort(line.begin(), line.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+				for (size_type i = 0; i < line.size(); ++write)
+				{
+					_indices[write] = line[i].first;
+					_values[write] = std::move(line[i].second);
+
+					for (++i; i < line.size() && line[i].first == _indices[write]; ++i)
+						_values[write] += line[i].second;
+				}
+			}
+
+			_offsets[major_count] = write;
+			_indices.resize(write);
+			_values.resize(write);
+		}
+
+		// Computes y[i] = the dot product of major line i and x.
+		// Large products are split into chunks with about the same
+		// number of nonzero elements, which run in parallel.
+		void gather(const T* x, T* y, bool parallel) const
+		{
+			const size_type major_count = majorCount();
+
+			auto lines = [&](size_type first, size_type last)
+			{
+				for (size_type major = first; major < last; ++major)
+				{
+					T sum = T();
+
+					for (size_type i = _offsets[major]; i < _offsets[major + 1]; ++i)
+						sum += _values[i] * x[_indices[i]];
+
+					y[major] = sum;
+				}
+			};
+
+			if (!parallel || nonZeroCount() < _parallel_spmv)
+			{
+				lines(0, major_count);
+				return;
+			}
+
+			std::vector<size_type> bounds(1, 0);
+
+			for (size_type target = _spmv_chunk; target < nonZeroCount(); target += _spmv_chunk)
+			{
+				size_type major = static_cast<size_type>(std::upper_bound(_offsets.begin(), _offsets.end(), target) - _offsets.begin()) - 1;
+
+				if (major > bounds.back())
+					bounds.push_back(major);
+			}
+
+			bounds.push_back(major_count);
+
+			std::vector<size_type> chunks(bounds.size() - 1);
+			std::iota(chunks.begin(), chunks.end(), size_type(0));
+
+			std::for_each(std::execution::par, chunks.begin(), chunks.end(), [&](size_type chunk)
+			{
+				lines(bounds[chunk], bounds[chunk + 1]);
+			});
+		}
+
+		// Computes y = 0, then y[minor] += element * x[major] for every
+		// stored element. Lines write to overlapping elements of y,
+		// so this runs on a single thread.
+		void scatter(const T* x, T* y, size_type y_size) const
+		{
+			std::fill(y, y + y_size, T());
+
+			for (size_type major = 0; major < majorCount(); ++major)
+			{
+				const T x_major = x[major];
+
+				for (size_type i = _offsets[major]; i < _offsets[major + 1]; ++i)
+					y[_indices[i]] += _values[i] * x_major;
+			}
+		}
+
+		public:
+
+		// Default constructor.
+		// Creates an empty 0 x 0 SparseMatrix.
+		SparseMatrix() : _rows(0), _cols(0), _offsets(1, size_type(0))
+		{
+
+		}
+
+		// Allocator constructor.
+		explicit SparseMatrix(const Allocator& alloc)
+			: _rows(0), _cols(0), _offsets(1, size_type(0), index_allocator_type(alloc)), _indices(index_allocator_type(alloc)), _values(alloc)
+		{
+
+		}
+
+		// Size constructor.
+		// Creates a rows x cols SparseMatrix with no nonzero elements.
+		SparseMatrix(size_type rows, size_type cols, const Allocator& alloc = Allocator())
+			: _rows(rows), _cols(cols), _offsets(majorCount() + 1, size_type(0), index_allocator_type(alloc)),
+			  _indices(index_allocator_type(alloc)), _values(alloc)
+		{
+
+		}
+
+		// Triplet range constructor.
+		// Creates a rows x cols SparseMatrix from the triplets in [first, last),
+		// which may be in any order. Triplets with the same indices are summed.
+		// Throws a std::out_of_range if a triplet is outside of the SparseMatrix.
+		template <std::forward_iterator Iter>
+		SparseMatrix(size_type rows, size_type cols, Iter first, Iter last, const Allocator& alloc = Allocator())
+			: SparseMatrix(rows, cols, alloc)
+		{
+			build(first, last);
+		}
+
+		// Triplet std::initializer_list constructor.
+		// Triplets with the same indices are summed.
+		// Throws a std::out_of_range if a triplet is outside of the SparseMatrix.
+		SparseMatrix(size_type rows, size_type cols, std::initializer_list<SparseTriplet<T>> triplets, const Allocator& alloc = Allocator())
+			: SparseMatrix(rows, cols, alloc)
+		{
+			build(triplets.begin(), triplets.end());
+		}
+
+		// Dense Matrix constructor.
+		// Stores every element of the Matrix that is not equal to T().
+		template <typename OtherAllocator>
+		explicit SparseMatrix(const Matrix<T, OtherAllocator>& M, const Allocator& alloc = Allocator())
+			: SparseMatrix(M.rowCount(), M.colCount(), alloc)
+		{
+			const size_type major_count = majorCount();
+			const size_type minor_count = Format == SparseFormat::CSR ? _cols : _rows;
+			const T zero = T();
+
+			auto element = [&](size_type major, size_type minor) -> const T&
+			{
+				auto [row, col] = majorMinor(major, minor);
+				return M(row, col);
+			};
+
+			size_type count = 0;
+
+			for (size_type i = 0; i < M.size(); ++i)
+				count += M[i] != zero;
+
+			_indices.reserve(count);
+			_values.reserve(count);
+
+			for (size_type major = 0; major < major_count; ++major)
+			{
+				for (size_type minor = 0; minor < minor_count; ++minor)
+				{
+					const T& value = element(major, minor);
+
+					if (value != zero)
+					{
+						_indices.push_back(minor);
+						_values.push_back(value);
+					}
+				}
+
+				_offsets[major + 1] = _values.size();
+			}
+		}
+
+		// Format conversion constructor.
+		// Converts a CSC SparseMatrix to CSR or a CSR SparseMatrix to CSC
+		// with a counting sort, which keeps every line sorted.
+		template <SparseFormat OtherFormat, typename OtherAllocator> requires (OtherFormat != Format)
+		explicit SparseMatrix(const SparseMatrix<T, OtherFormat, OtherAllocator>& other, const Allocator& alloc = Allocator())
+			: SparseMatrix(other.rowCount(), other.colCount(), alloc)
+		{
+			const auto& offsets = other.offsets();
+			const auto& indices = other.indices();
+			const auto& values = other.values();
+			const size_type count = other.nonZeroCount();
+
+			for (size_type i = 0; i < count; ++i)
+				++_offsets[indices[i] + 1];
+
+			std::partial_sum(_offsets.begin(), _offsets.end(), _offsets.begin());
+
+			_indices = Array<size_type, index_allocator_type>(count, uninitialized, _indices.get_allocator());
+			_values = Array<T, Allocator>(count, _values.get_allocator());
+
+			Array<size_type, index_allocator_type> next(_offsets.begin(), _offsets.end() - 1, _offsets.get_allocator());
+
+			for (size_type line = 0; line + 1 < offsets.size(); ++line)
+			{
+				for (size_type i = offsets[line]; i < offsets[line + 1]; ++i)
+				{
+					size_type pos = next[indices[i]]++;
+					_indices[pos] = line;
+					_values[pos] = values[i];
+				}
+			}
+		}
+
+		// Constructs the SparseMatrix from its compressed arrays.
+		// offsets must have one more element than the major dimension,
+		// and every line of indices must be sorted without duplicates.
+		// Throws a std::invalid_argument if the array sizes do not match.
+		SparseMatrix(size_type rows, size_type cols, Array<size_type, index_allocator_type> offsets,
+					 Array<size_type, index_allocator_type> indices, Array<T, Allocator> values)
+			: _rows(rows), _cols(cols), _offsets(std::move(offsets)), _indices(std::move(indices)), _values(std::move(values))
+		{
+			if (_offsets.size() != majorCount() + 1 || _indices.size() != _values.size() || _offsets.last() != _values.size())
+				throw std::invalid_argument("ERROR: SparseMatrix arrays do not match.");
+		}
+
+		// Copy constructor.
+		SparseMatrix(const SparseMatrix& other) = default;
+
+		// Move constructor.
+		SparseMatrix(SparseMatrix&& other) = default;
+
+		// Copy assignment operator.
+		SparseMatrix& operator = (const SparseMatrix& other) = default;
+
+		// Move assignment operator.
+		SparseMatrix& operator = (SparseMatrix&& other) = default;
+
+		// Destructor.
+		~SparseMatrix() = default;
+
+		// Returns a copy of the allocator used by the SparseMatrix.
+		allocator_type get_allocator() const noexcept
+		{
+			return _values.get_allocator();
+		}
+
+		// Returns the number of rows of the SparseMatrix.
+		constexpr size_type rowCount() const noexcept
+		{
+			return _rows;
+		}
+
+		// Returns the number of columns of the SparseMatrix.
+		constexpr size_type colCount() const noexcept
+		{
+			return _cols;
+		}
+
+		// Returns the number of stored elements of the SparseMatrix.
+		constexpr size_type nonZeroCount() const noexcept
+		{
+			return _values.size();
+		}
+
+		// Returns the start of every major line, followed by nonZeroCount().
+		constexpr const Array<size_type, index_allocator_type>& offsets() const noexcept
+		{
+			return _offsets;
+		}
+
+		// Returns the minor index of every stored element.
+		constexpr const Array<size_type, index_allocator_type>& indices() const noexcept
+		{
+			return _indices;
+		}
+
+		// Returns the stored elements.
+		constexpr const Array<T, Allocator>& values() const noexcept
+		{
+			return _values;
+		}
+
+		// Returns the stored elements.
+		// Only their values may be changed, not their positions.
+		constexpr Array<T, Allocator>& values() noexcept
+		{
+			return _values;
+		}
+
+		// Returns true if the element at [row][col] is stored.
+		// Throws a std::out_of_range if given an invalid index.
+		bool contains(size_type row, size_type col) const
+		{
+			if (row >= _rows || col >= _cols)
+				throw std::out_of_range("ERROR: Invalid SparseMatrix index.");
+
+			auto [major, minor] = majorMinor(row, col);
+			return std::binary_search(_indices.begin() + _offsets[major], _indices.begin() + _offsets[major + 1], minor);
+		}
+
+		// Returns the element at [row][col], which is T() if it is not stored.
+		// Finds the element with a binary search of its line.
+		// Throws a std::out_of_range if given an invalid index.
+		T at(size_type row, size_type col) const
+		{
+			if (row >= _rows || col >= _cols)
+				throw std::out_of_range("ERROR: Invalid SparseMatrix index.");
+
+			auto [major, minor] = majorMinor(row, col);
+			auto first = _indices.begin() + _offsets[major];
+			auto last = _indices.begin() + _offsets[major + 1];
+			auto iter = std::lower_bound(first, last, minor);
+
+			if (iter != last && *iter == minor)
+				return _values[static_cast<size_type>(iter - _indices.begin())];
+
+			return T();
+		}
+
+		// Returns the element at [row][col], which is T() if it is not stored.
+		// Throws a std::out_of_range if given an invalid index.
+		T operator () (size_type row, size_type col) const
+		{
+			return at(row, col);
+		}
+
+		// Computes y = A * x, where x has colCount() elements
+		// and y has rowCount() elements. x and y must not overlap.
+		// With CSR, the rows are computed in parallel if parallel is true.
+		void multiply(const T* x, T* y, bool parallel = true) const
+		{
+			if constexpr (Format == SparseFormat::CSR)
+				gather(x, y, parallel);
+			else
+				scatter(x, y, _rows);
+		}
+
+		// Computes y = transpose(A) * x, where x has rowCount() elements
+		// and y has colCount() elements. x and y must not overlap.
+		// With CSC, the columns are computed in parallel if parallel is true.
+		void multiplyTransposed(const T* x, T* y, bool parallel = true) const
+		{
+			if constexpr (Format == SparseFormat::CSC)
+				gather(x, y, parallel);
+			else
+				scatter(x, y, _cols);
+		}
+
+		// Returns the transpose of the SparseMatrix.
+		// The transpose of a CSR matrix is the same data read as CSC,
+		// so this only copies the arrays.
+		SparseMatrix<T, Format == SparseFormat::CSR ? SparseFormat::CSC : SparseFormat::CSR, Allocator> transpose() const
+		{
+			using Transpose = SparseMatrix<T, Format == SparseFormat::CSR ? SparseFormat::CSC : SparseFormat::CSR, Allocator>;
+			return Transpose(_cols, _rows, _offsets, _indices, _values);
+		}
+
+		// Returns the dense Matrix with the same elements.
+		Matrix<T, Allocator> toDense() const
+		{
+			Matrix<T, Allocator> M(_rows, _cols, get_allocator());
+
+			for (size_type major = 0; major < majorCount(); ++major)
+			{
+				for (size_type i = _offsets[major]; i < _offsets[major + 1]; ++i)
+				{
+					auto [row, col] = majorMinor(major, _indices[i]);
+					M(row, col) = _values[i];
+				}
+			}
+
+			return M;
+		}
+	};
+
+	///////////////////////////////////////////////////////////////////////////////////////////////
+	///////////////////////////////////////////////////////////////////////////////////////////////
+
+	// Overload of binary operator *
+	// Returns the product of the SparseMatrix and the column vector x.
+	// Throws a std::invalid_argument if x.size() != A.colCount().
+	template <typename T, SparseFormat Format, typename Allocator>
+	Array<T, Allocator> operator * (const SparseMatrix<T, Format, Allocator>& A, const Array<T, Allocator>& x)
+	{
+		if (x.size() != A.colCount())
+			throw std::invalid_argument("ERROR: Matrix dimensions do not match.");
+
+		Array<T, Allocator> y(A.rowCount(), uninitialized, x.get_allocator());
+		A.multiply(x.data(), y.data());
+		return y;
+	}
+
+	// Overload of binary operator *
+	// Returns the product of the square SparseMatrix and the column vector x.
+	// Throws a std::invalid_argument if A is not N x N.
+	template <arithmetic T, std::size_t N, SparseFormat Format, typename Allocator>
+	VectorN<T, N> operator * (const SparseMatrix<T, Format, Allocator>& A, const VectorN<T, N>& x)
+	{
+		if (A.rowCount() != N || A.colCount() != N)
+			throw std::invalid_argument("ERROR: Matrix dimensions do not match.");
+
+		VectorN<T, N> y;
+		A.multiply(x.data(), y.data());
+		return y;
+	}
+
+	// Sparse matrix in the CSR format.
+	template <typename T, typename Allocator = std::allocator<T>>
+	using CsrMatrix = SparseMatrix<T, SparseFormat::CSR, Allocator>;
+
+	// Sparse matrix in the CSC format.
+	template <typename T, typename Allocator = std::allocator<T>>
+	using CscMatrix = SparseMatrix<T, SparseFormat::CSC, Allocator>;
+
+	namespace pmr
+	{
+		// SparseMatrix that obtains its memory from a std::pmr::memory_resource.
+		template <typename T, SparseFormat Format = SparseFormat::CSR>
+		using SparseMatrix = jlib::SparseMatrix<T, Format, std::pmr::polymorphic_allocator<T>>;
+	}
+}
\ No newline at end of file
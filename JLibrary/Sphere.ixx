@@ -1,7 +1,7 @@
 // JLibrary
 // Sphere.ixx
 // Created on 2022-02-21 by Justyn Durnford
-// Last modified on 2022-02-22 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
 // Module file for the Sphere template class.
 
 module;
@@ -10,8 +10,10 @@ module;
 #include "Constants.hpp"
 
 #include <cmath>
+#include <concepts>
 #include <ostream>
 #include <string>
+#include <type_traits>
 
 export module Sphere;
 
@@ -103,14 +105,26 @@ export namespace jlib
 		// Checks if the given point lies within or on the Sphere.
 		bool contains(T X, T Y, T Z)
 		{
-			return std::powf(X - center.x, 2.f) + std::powf(Y - center.y, 2.0f) + std::powf(Z - center.z, 2.0f) <= std::powf(std::fabsf(radius), 2.0f);
+			using R = std::conditional_t<std::floating_point<T>, T, double>;
+
+			const R dx = static_cast<R>(X) - static_cast<R>(center.x);
+			const R dy = static_cast<R>(Y) - static_cast<R>(center.y);
+			const R dz = static_cast<R>(Z) - static_cast<R>(center.z);
+			const R r = static_cast<R>(radius);
+
+			return dx * dx + dy * dy + dz * dz <= r * r;
 		}
 
 		// Checks if the given point lies within or on the Sphere.
 		template <arithmetic U>
 		bool contains(U X, U Y, U Z)
 		{
-			return std::powf(X - center.x, 2.f) + std::powf(Y - center.y, 2.0f) + std::powf(Z - center.z, 2.0f) <= std::powf(std::fabsf(radius), 2.0f);
+			const float dx = float(X) - float(center.x);
+			const float dy = float(Y) - float(center.y);
+			const float dz = float(Z) - float(center.z);
+			const float r = float(radius);
+
+			return dx * dx + dy * dy + dz * dz <= r * r;
 		}
 
 		// Checks if the given point lies within or on the Sphere.
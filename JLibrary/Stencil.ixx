@@ -0,0 +1,763 @@
+// JLibrary
+// Stencil.ixx
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Module file for the 2D and 3D stencil functions.
+
+module;
+
+#include "Simd.hpp"
+#include "Uninitialized.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <execution>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+export module Stencil;
+
+import FixedGrid;
+import FixedMatrix;
+import GridLayout;
+import Matrix;
+import MatrixView;
+
+export namespace jlib
+{
+	// How a stencil reads the elements outside of its input.
+	enum class BorderMode
+	{
+		Clamp, // The nearest element inside of the input.
+		Wrap,  // The input repeats, so the element on the opposite side.
+		Zero   // 0.
+	};
+}
+
+namespace jlib
+{
+	// How the taps of a stencil are combined.
+	enum class _StencilOp
+	{
+		Sum, // The sum of each tap times its weight.
+		Min, // The smallest tap.
+		Max  // The largest tap.
+	};
+
+	// Stencils of fewer elements than this run on a single thread.
+	inline constexpr std::size_t _parallel_stencil = std::size_t(1) << 16;
+
+	// Sizes of the 3D input and output of a stencil.
+	// Elements along x are contiguous, rows along y are rowStride
+	// elements apart and slices along z are sliceStride elements apart.
+	struct _StencilGrid
+	{
+		std::size_t width;
+		std::size_t height;
+		std::size_t length;
+		std::size_t srcRowStride;
+		std::size_t srcSliceStride;
+		std::size_t dstRowStride;
+		std::size_t dstSliceStride;
+	};
+
+	// The kernel of a stencil, as a dense 3D array or as 1 weight vector per axis.
+	template <typename T> struct _StencilKernel
+	{
+		// Size of the kernel along x, y and z.
+		std::size_t size[3];
+		// Position of the output element in the kernel along x, y and z.
+		std::size_t anchor[3];
+		// The kernel in z, y, x order if it is not separable.
+		std::vector<T> weights;
+		// The weights along each axis if the kernel is separable.
+		std::vector<T> axes[3];
+		bool separable;
+	};
+
+	// Returns the index of the element of an axis of size n that is read
+	// for the index i, or -1 if it reads 0.
+	inline std::ptrdiff_t _border_index(std::ptrdiff_t i, std::size_t n, BorderMode border) noexcept
+	{
+		const std::ptrdiff_t size = static_cast<std::ptrdiff_t>(n);
+
+		if (i >= 0 && i < size)
+			return i;
+
+		switch (border)
+		{
+			case BorderMode::Clamp: return i < 0 ? 0 : size - 1;
+			case BorderMode::Wrap: return ((i % size) + size) % size;
+			default: return -1;
+		}
+	}
+
+	// Sets out[x] to the combination of in[x + offsets[t]] for every tap t, for x in [0, n).
+	// Sums are computed tap by tap in the same order in the SIMD and scalar loops,
+	// so the result does not depend on n. taps must not be 0.
+	template <_StencilOp Op, typename T>
+	void _apply_taps(const T* in, const std::ptrdiff_t* offsets, const T* weights, std::size_t taps, T* out, std::size_t n)
+	{
+		std::size_t x = 0;
+
+		#ifdef JLIB_SIMD_X86
+		if constexpr (std::is_same_v<T, float>)
+		{
+			for (; x + 8 <= n; x += 8)
+			{
+				const float* p = in + x;
+				__m128 acc0;
+				__m128 acc1;
+
+				if constexpr (Op == _StencilOp::Sum)
+				{
+					const __m128 w = _mm_set1_ps(weights[0]);
+					acc0 = _mm_mul_ps(w, _mm_loadu_ps(p + offsets[0]));
+					acc1 = _mm_mul_ps(w, _mm_loadu_ps(p + offsets[0] + 4));
+				}
+				else
+				{
+					acc0 = _mm_loadu_ps(p + offsets[0]);
+					acc1 = _mm_loadu_ps(p + offsets[0] + 4);
+				}
+
+				for (std::size_t t = 1; t < taps; ++t)
+				{
+					const __m128 v0 = _mm_loadu_ps(p + offsets[t]);
+					const __m128 v1 = _mm_loadu_ps(p + offsets[t] + 4);
+
+					if constexpr (Op == _StencilOp::Sum)
+					{
+						const __m128 w = _mm_set1_ps(weights[t]);
+						acc0 = _mm_add_ps(acc0, _mm_mul_ps(w, v0));
+						acc1 = _mm_add_ps(acc1, _mm_mul_ps(w, v1));
+					}
+					else if constexpr (Op == _StencilOp::Min)
+					{
+						acc0 = _mm_min_ps(acc0, v0);
+						acc1 = _mm_min_ps(acc1, v1);
+					}
+					else
+					{
+						acc0 = _mm_max_ps(acc0, v0);
+						acc1 = _mm_max_ps(acc1, v1);
+					}
+				}
+
+				_mm_storeu_ps(out + x, acc0);
+				_mm_storeu_ps(out + x + 4, acc1);
+			}
+		}
+		else if constexpr (std::is_same_v<T, double>)
+		{
+			for (; x + 4 <= n; x += 4)
+			{
+				const double* p = in + x;
+				__m128d acc0;
+				__m128d acc1;
+
+				if constexpr (Op == _StencilOp::Sum)
+				{
+					const __m128d w = _mm_set1_pd(weights[0]);
+					acc0 = _mm_mul_pd(w, _mm_loadu_pd(p + offsets[0]));
+					acc1 = _mm_mul_pd(w, _mm_loadu_pd(p + offsets[0] + 2));
+				}
+				else
+				{
+					acc0 = _mm_loadu_pd(p + offsets[0]);
+					acc1 = _mm_loadu_pd(p + offsets[0] + 2);
+				}
+
+				for (std::size_t t = 1; t < taps; ++t)
+				{
+					const __m128d v0 = _mm_loadu_pd(p + offsets[t]);
+					const __m128d v1 = _mm_loadu_pd(p + offsets[t] + 2);
+
+					if constexpr (Op == _StencilOp::Sum)
+					{
+						const __m128d w = _mm_set1_pd(weights[t]);
+						acc0 = _mm_add_pd(acc0, _mm_mul_pd(w, v0));
+						acc1 = _mm_add_pd(acc1, _mm_mul_pd(w, v1));
+					}
+					else if constexpr (Op == _StencilOp::Min)
+					{
+						acc0 = _mm_min_pd(acc0, v0);
+						acc1 = _mm_min_pd(acc1, v1);
+					}
+					else
+					{
+						acc0 = _mm_max_pd(acc0, v0);
+						acc1 = _mm_max_pd(acc1, v1);
+					}
+				}
+
+				_mm_storeu_pd(out + x, acc0);
+				_mm_storeu_pd(out + x + 2, acc1);
+			}
+		}
+		#endif // JLIB_SIMD_X86
+
+		for (; x < n; ++x)
+		{
+			const T* p = in + x;
+			T acc = (Op == _StencilOp::Sum) ? weights[0] * p[offsets[0]] : p[offsets[0]];
+
+			for (std::size_t t = 1; t < taps; ++t)
+			{
+				// Written to match _mm_min_ps and _mm_max_ps, which return
+				// the second operand if either one is NaN.
+				if constexpr (Op == _StencilOp::Sum)
+					acc += weights[t] * p[offsets[t]];
+				else if constexpr (Op == _StencilOp::Min)
+					acc = (acc < p[offsets[t]]) ? acc : p[offsets[t]];
+				else
+					acc = (acc > p[offsets[t]]) ? acc : p[offsets[t]];
+			}
+
+			out[x] = acc;
+		}
+	}
+
+	// Decides whether the kernel in k.weights is separable,
+	// and fills k.axes if it is and separating it saves work.
+	// For Sum, the kernel is separable if it is the outer product of 3 vectors.
+	// For Min and Max, it is separable if every element is in the neighborhood.
+	template <_StencilOp Op, typename T>
+	void _separate_kernel(_StencilKernel<T>& k)
+	{
+		const std::size_t kw = k.size[0];
+		const std::size_t kh = k.size[1];
+		const std::size_t kl = k.size[2];
+
+		std::size_t nonzero = 0;
+		std::size_t pivot = 0;
+		T largest = T(0);
+
+		for (std::size_t i = 0; i < k.weights.size(); ++i)
+		{
+			if (k.weights[i] != T(0))
+				++nonzero;
+
+			if (std::abs(k.weights[i]) > largest)
+			{
+				largest = std::abs(k.weights[i]);
+				pivot = i;
+			}
+		}
+
+		k.separable = false;
+
+		// The passes along the axes of size 1 are skipped.
+		const std::size_t passes = (kw > 1 ? kw : 0) + (kh > 1 ? kh : 0) + (kl > 1 ? kl : 0);
+
+		if (passes >= nonzero)
+			return;
+
+		if constexpr (Op == _StencilOp::Sum)
+		{
+			const std::size_t px = pivot % kw;
+			const std::size_t py = (pivot / kw) % kh;
+			const std::size_t pz = pivot / (kw * kh);
+			const T p = k.weights[pivot];
+
+			auto at = [&](std::size_t x, std::size_t y, std::size_t z) { return k.weights[(((z * kh) + y) * kw) + x]; };
+
+			// The kernel is a[x] * b[y] * c[z], with the scale in a.
+			std::vector<T> a(kw);
+			std::vector<T> b(kh);
+			std::vector<T> c(kl);
+
+			for (std::size_t x = 0; x < kw; ++x)
+				a[x] = at(x, py, pz);
+			for (std::size_t y = 0; y < kh; ++y)
+				b[y] = at(px, y, pz) / p;
+			for (std::size_t z = 0; z < kl; ++z)
+				c[z] = at(px, py, z) / p;
+
+			const T tolerance = largest * T(16) * std::numeric_limits<T>::epsilon();
+
+			for (std::size_t z = 0; z < kl; ++z)
+			{
+				for (std::size_t y = 0; y < kh; ++y)
+				{
+					for (std::size_t x = 0; x < kw; ++x)
+					{
+						if (std::abs(at(x, y, z) - (a[x] * b[y] * c[z])) > tolerance)
+							return;
+					}
+				}
+			}
+
+			k.axes[0] = std::move(a);
+			k.axes[1] = std::move(b);
+			k.axes[2] = std::move(c);
+		}
+		else
+		{
+			if (nonzero != k.weights.size())
+				return;
+
+			for (std::size_t i = 0; i < 3; ++i)
+				k.axes[i].assign(k.size[i], T(1));
+		}
+
+		k.separable = true;
+	}
+
+	// Applies the stencil to the 3D input at src and writes the output to dst.
+	//
+	// The output is computed in tiles. The input of each tile and the border
+	// around it are first copied into a buffer, so only the copy deals with the
+	// border mode and every tap of the stencil is a fixed offset into the buffer.
+	// Separable kernels are then applied 1 axis at a time through 2 more buffers.
+	// Each tile row is handled by 1 thread.
+	template <_StencilOp Op, typename T>
+	void _run_stencil(const T* src, T* dst, const _StencilGrid& g, const _StencilKernel<T>& k, BorderMode border)
+	{
+		if (g.width == 0 || g.height == 0 || g.length == 0)
+			return;
+
+		const std::size_t kw = k.size[0];
+		const std::size_t kh = k.size[1];
+		const std::size_t kl = k.size[2];
+
+		// Flat tiles for 2D stencils and boxes for 3D stencils.
+		// The buffers of either are a few hundred KB at most.
+		const std::size_t TX = kl == 1 ? 256 : 64;
+		const std::size_t TY = kl == 1 ? 32 : 16;
+		const std::size_t TZ = kl == 1 ? 1 : 8;
+
+		const std::size_t PX = TX + kw - 1;
+		const std::size_t PY = TY + kh - 1;
+		const std::size_t PZ = TZ + kl - 1;
+
+		// The passes of a separable kernel, each with its tap offsets and weights.
+		// Passes of 1 tap that do not change their input are skipped.
+		struct Pass
+		{
+			std::size_t axis;
+			std::vector<std::ptrdiff_t> offsets;
+			std::vector<T> weights;
+		};
+
+		std::vector<Pass> passes;
+		std::vector<std::ptrdiff_t> offsets;
+		std::vector<T> weights;
+
+		if (k.separable)
+		{
+			for (std::size_t axis = 0; axis < 3; ++axis)
+			{
+				if (k.size[axis] == 1 && (Op != _StencilOp::Sum || k.axes[axis][0] == T(1)))
+					continue;
+
+				// The first pass reads the input buffer, whose rows are PX elements long.
+				// The later passes read the intermediate buffers, whose rows are TX elements long.
+				const std::size_t row = passes.empty() ? PX : TX;
+				const std::size_t stride = axis == 0 ? 1 : (axis == 1 ? row : row * PY);
+
+				Pass pass{ axis, {}, k.axes[axis] };
+
+				for (std::size_t t = 0; t < k.size[axis]; ++t)
+					pass.offsets.push_back(static_cast<std::ptrdiff_t>(t * stride));
+
+				passes.push_back(std::move(pass));
+			}
+
+			// A kernel of a single 1 copies its input.
+			if (passes.empty())
+				passes.push_back(Pass{ 0, { 0 }, { T(1) } });
+		}
+		else
+		{
+			for (std::size_t z = 0; z < kl; ++z)
+			{
+				for (std::size_t y = 0; y < kh; ++y)
+				{
+					for (std::size_t x = 0; x < kw; ++x)
+					{
+						const T w = k.weights[(((z * kh) + y) * kw) + x];
+
+						// Zero weights add nothing to a sum, and mark
+						// the elements outside of the neighborhood otherwise.
+						if (w == T(0))
+							continue;
+
+						offsets.push_back(static_cast<std::ptrdiff_t>((((z * PY) + y) * PX) + x));
+						weights.push_back(w);
+					}
+				}
+			}
+
+			// A kernel of only zeros sums to 0 everywhere.
+			if (offsets.empty())
+			{
+				offsets.push_back(0);
+				weights.push_back(T(0));
+			}
+		}
+
+		const std::size_t tiles_x = (g.width + TX - 1) / TX;
+		const std::size_t tiles_y = (g.height + TY - 1) / TY;
+		const std::size_t tiles_z = (g.length + TZ - 1) / TZ;
+
+		std::vector<std::size_t> rows(tiles_y * tiles_z);
+		std::iota(rows.begin(), rows.end(), std::size_t(0));
+
+		auto tile_row = [&](std::size_t r)
+		{
+			const std::size_t y0 = (r % tiles_y) * TY;
+			const std::size_t z0 = (r / tiles_y) * TZ;
+			const std::size_t tyo = std::min(TY, g.height - y0);
+			const std::size_t tzo = std::min(TZ, g.length - z0);
+
+			std::vector<T> pad(PX * PY * PZ);
+			std::vector<T> tmp[2];
+
+			if (k.separable)
+			{
+				tmp[0].resize(TX * PY * PZ);
+				tmp[1].resize(TX * PY * PZ);
+			}
+
+			for (std::size_t tx = 0; tx < tiles_x; ++tx)
+			{
+				const std::size_t x0 = tx * TX;
+				const std::size_t txo = std::min(TX, g.width - x0);
+
+				// Copies the input of the tile into the buffer.
+				const std::size_t nx = txo + kw - 1;
+				const std::size_t ny = tyo + kh - 1;
+				const std::size_t nz = tzo + kl - 1;
+				const std::ptrdiff_t sx0 = static_cast<std::ptrdiff_t>(x0) - static_cast<std::ptrdiff_t>(k.anchor[0]);
+				const std::ptrdiff_t sy0 = static_cast<std::ptrdiff_t>(y0) - static_cast<std::ptrdiff_t>(k.anchor[1]);
+				const std::ptrdiff_t sz0 = static_cast<std::ptrdiff_t>(z0) - static_cast<std::ptrdiff_t>(k.anchor[2]);
+				const std::ptrdiff_t width = static_cast<std::ptrdiff_t>(g.width);
+
+				// The columns of the buffer that are inside of the input.
+				const std::ptrdiff_t lo = std::clamp<std::ptrdiff_t>(-sx0, 0, static_cast<std::ptrdiff_t>(nx));
+				const std::ptrdiff_t hi = std::clamp<std::ptrdiff_t>(width - sx0, lo, static_cast<std::ptrdiff_t>(nx));
+
+				for (std::size_t pz = 0; pz < nz; ++pz)
+				{
+					const std::ptrdiff_t sz = _border_index(sz0 + static_cast<std::ptrdiff_t>(pz), g.length, border);
+
+					for (std::size_t py = 0; py < ny; ++py)
+					{
+						const std::ptrdiff_t sy = _border_index(sy0 + static_cast<std::ptrdiff_t>(py), g.height, border);
+						T* row = pad.data() + (((pz * PY) + py) * PX);
+
+						if (sz < 0 || sy < 0)
+						{
+							std::fill(row, row + nx, T(0));
+							continue;
+						}
+
+						const T* srow = src + (static_cast<std::size_t>(sz) * g.srcSliceStride) + (static_cast<std::size_t>(sy) * g.srcRowStride);
+
+						std::copy(srow + (sx0 + lo), srow + (sx0 + hi), row + lo);
+
+						for (std::ptrdiff_t px = 0; px < lo; ++px)
+						{
+							const std::ptrdiff_t sx = _border_index(sx0 + px, g.width, border);
+							row[px] = sx < 0 ? T(0) : srow[sx];
+						}
+
+						for (std::ptrdiff_t px = hi; px < static_cast<std::ptrdiff_t>(nx); ++px)
+						{
+							const std::ptrdiff_t sx = _border_index(sx0 + px, g.width, border);
+							row[px] = sx < 0 ? T(0) : srow[sx];
+						}
+					}
+				}
+
+				T* out = dst + (z0 * g.dstSliceStride) + (y0 * g.dstRowStride) + x0;
+
+				if (!k.separable)
+				{
+					for (std::size_t z = 0; z < tzo; ++z)
+					{
+						for (std::size_t y = 0; y < tyo; ++y)
+						{
+							_apply_taps<Op>(pad.data() + (((z * PY) + y) * PX), offsets.data(), weights.data(), offsets.size(),
+											out + (z * g.dstSliceStride) + (y * g.dstRowStride), txo);
+						}
+					}
+
+					continue;
+				}
+
+				// The buffer the next pass reads from, and its row and slice strides.
+				// The intermediate buffers have rows of TX elements and slices of PY rows.
+				const T* in = pad.data();
+				std::size_t in_row = PX;
+				std::size_t dy = ny;
+				std::size_t dz = nz;
+
+				for (std::size_t p = 0; p < passes.size(); ++p)
+				{
+					const Pass& pass = passes[p];
+					const bool last = p + 1 == passes.size();
+
+					if (pass.axis == 1)
+						dy = tyo;
+					else if (pass.axis == 2)
+						dz = tzo;
+
+					T* next = tmp[p % 2].data();
+
+					for (std::size_t z = 0; z < dz; ++z)
+					{
+						for (std::size_t y = 0; y < dy; ++y)
+						{
+							T* o = last ? out + (z * g.dstSliceStride) + (y * g.dstRowStride) : next + (((z * PY) + y) * TX);
+							_apply_taps<Op>(in + (((z * PY) + y) * in_row), pass.offsets.data(), pass.weights.data(),
+											pass.weights.size(), o, txo);
+						}
+					}
+
+					in = next;
+					in_row = TX;
+				}
+			}
+		};
+
+		if (g.width * g.height * g.length >= _parallel_stencil && rows.size() > 1)
+			std::for_each(std::execution::par, rows.begin(), rows.end(), tile_row);
+		else
+			std::for_each(rows.begin(), rows.end(), tile_row);
+	}
+
+	// Throws a std::invalid_argument if the count elements at A
+	// and the count elements at B overlap.
+	template <typename T>
+	void _check_overlap(const T* A, std::size_t a_count, const T* B, std::size_t b_count)
+	{
+		const std::less<const T*> less;
+
+		if (a_count != 0 && b_count != 0 && less(A, B + b_count) && less(B, A + a_count))
+			throw std::invalid_argument("ERROR: The input and the output of a stencil overlap.");
+	}
+
+	// Returns the sizes and strides of the 2D views as a 3D grid.
+	template <typename T>
+	_StencilGrid _stencil_grid(MatrixView<const T> src, MatrixView<T> dst)
+	{
+		if (dst.rowCount() != src.rowCount() || dst.colCount() != src.colCount())
+			throw std::invalid_argument("ERROR: Matrix dimensions do not match.");
+
+		if (!src.isEmpty())
+		{
+			_check_overlap(src.data(), ((src.rowCount() - 1) * src.stride()) + src.colCount(),
+						   static_cast<const T*>(dst.data()), ((dst.rowCount() - 1) * dst.stride()) + dst.colCount());
+		}
+
+		return _StencilGrid{ src.colCount(), src.rowCount(), 1, src.stride(), src.rowCount() * src.stride(),
+							 dst.stride(), dst.rowCount() * dst.stride() };
+	}
+
+	// Returns the 2D kernel as a _StencilKernel, decides whether it is separable.
+	template <_StencilOp Op, typename T>
+	_StencilKernel<T> _stencil_kernel(MatrixView<const T> kernel)
+	{
+		if (kernel.isEmpty())
+			throw std::invalid_argument("ERROR: The kernel of a stencil is empty.");
+
+		_StencilKernel<T> k{ { kernel.colCount(), kernel.rowCount(), 1 },
+							 { kernel.colCount() / 2, kernel.rowCount() / 2, 0 }, {}, {}, false };
+
+		k.weights.reserve(kernel.size());
+
+		for (std::size_t row = 0; row < kernel.rowCount(); ++row)
+			k.weights.insert(k.weights.end(), kernel.rowBegin(row), kernel.rowEnd(row));
+
+		_separate_kernel<Op>(k);
+		return k;
+	}
+
+	// Returns the 3D kernel as a _StencilKernel, decides whether it is separable.
+	template <_StencilOp Op, typename T, std::size_t KL, std::size_t KW, std::size_t KH>
+	_StencilKernel<T> _stencil_kernel(const FixedGrid<T, KL, KW, KH>& kernel)
+	{
+		static_assert(KL != 0 && KW != 0 && KH != 0, "The kernel of a stencil must not be empty.");
+
+		_StencilKernel<T> k{ { KW, KH, KL }, { KW / 2, KH / 2, KL / 2 },
+							 std::vector<T>(kernel.data(), kernel.dataEnd()), {}, false };
+
+		_separate_kernel<Op>(k);
+		return k;
+	}
+}
+
+export namespace jlib
+{
+	// Applies the kernel to src and writes the result to dst:
+	// dst(r, c) = sum of kernel(i, j) * src(r + i - (kernel rows / 2), c + j - (kernel cols / 2)).
+	// The kernel is not flipped, so this is a correlation, which equals
+	// the convolution for symmetric kernels. Elements outside of src
+	// are read according to border.
+	//
+	// Kernels that are the outer product of a column and a row, such as
+	// box and Gaussian blurs, are detected and applied as 2 1D passes.
+	// The output is computed in cache-sized tiles, float and double rows
+	// are computed with SSE, and the tile rows are split across threads.
+	// Throws a std::invalid_argument if dst is not the size of src,
+	// if src and dst overlap or if the kernel is empty.
+	template <std::floating_point T>
+	void stencil(MatrixView<const std::type_identity_t<T>> src, MatrixView<T> dst,
+				 MatrixView<const std::type_identity_t<T>> kernel, BorderMode border = BorderMode::Clamp)
+	{
+		const _StencilGrid g = _stencil_grid(src, dst);
+		const _StencilKernel<T> k = _stencil_kernel<_StencilOp::Sum>(kernel);
+		_run_stencil<_StencilOp::Sum>(src.data(), dst.data(), g, k, border);
+	}
+
+	// Returns the result of applying the kernel to the Matrix.
+	// See stencil(MatrixView, MatrixView, MatrixView, BorderMode).
+	template <std::floating_point T, typename Allocator, std::size_t KR, std::size_t KC>
+	Matrix<T, Allocator> stencil(const Matrix<T, Allocator>& src, const FixedMatrix<T, KR, KC>& kernel,
+								 BorderMode border = BorderMode::Clamp)
+	{
+		Matrix<T, Allocator> M(src.rowCount(), src.colCount(), uninitialized, src.get_allocator());
+		stencil<T>(src.view(), M.view(), kernel.view(), border);
+		return M;
+	}
+
+	// Returns the result of applying the kernel to the Matrix.
+	// See stencil(MatrixView, MatrixView, MatrixView, BorderMode).
+	template <std::floating_point T, typename Allocator, typename KernelAllocator>
+	Matrix<T, Allocator> stencil(const Matrix<T, Allocator>& src, const Matrix<T, KernelAllocator>& kernel,
+								 BorderMode border = BorderMode::Clamp)
+	{
+		Matrix<T, Allocator> M(src.rowCount(), src.colCount(), uninitialized, src.get_allocator());
+		stencil<T>(src.view(), M.view(), kernel.view(), border);
+		return M;
+	}
+
+	// Applies the kernel that is the outer product of col_kernel and row_kernel
+	// to src and writes the result to dst, as a horizontal pass of row_kernel
+	// followed by a vertical pass of col_kernel.
+	// See stencil(MatrixView, MatrixView, MatrixView, BorderMode).
+	template <std::floating_point T>
+	void stencil_separable(MatrixView<const std::type_identity_t<T>> src, MatrixView<T> dst,
+						   std::span<const std::type_identity_t<T>> row_kernel,
+						   std::span<const std::type_identity_t<T>> col_kernel, BorderMode border = BorderMode::Clamp)
+	{
+		if (row_kernel.empty() || col_kernel.empty())
+			throw std::invalid_argument("ERROR: The kernel of a stencil is empty.");
+
+		const _StencilGrid g = _stencil_grid(src, dst);
+
+		_StencilKernel<T> k{ { row_kernel.size(), col_kernel.size(), 1 },
+							 { row_kernel.size() / 2, col_kernel.size() / 2, 0 }, {},
+							 { std::vector<T>(row_kernel.begin(), row_kernel.end()),
+							   std::vector<T>(col_kernel.begin(), col_kernel.end()), std::vector<T>(1, T(1)) }, true };
+
+		_run_stencil<_StencilOp::Sum>(src.data(), dst.data(), g, k, border);
+	}
+
+	// Sets each element of dst to the smallest element of src in the neighborhood
+	// given by the nonzero elements of the kernel, centered as in stencil().
+	// Rectangular neighborhoods are applied as 2 1D passes.
+	// Throws a std::invalid_argument if dst is not the size of src,
+	// if src and dst overlap or if the kernel is empty.
+	template <std::floating_point T>
+	void erode(MatrixView<const std::type_identity_t<T>> src, MatrixView<T> dst,
+			   MatrixView<const std::type_identity_t<T>> kernel, BorderMode border = BorderMode::Clamp)
+	{
+		const _StencilGrid g = _stencil_grid(src, dst);
+		const _StencilKernel<T> k = _stencil_kernel<_StencilOp::Min>(kernel);
+		_run_stencil<_StencilOp::Min>(src.data(), dst.data(), g, k, border);
+	}
+
+	// Sets each element of dst to the largest element of src in the neighborhood
+	// given by the nonzero elements of the kernel, centered as in stencil().
+	// Rectangular neighborhoods are applied as 2 1D passes.
+	// Throws a std::invalid_argument if dst is not the size of src,
+	// if src and dst overlap or if the kernel is empty.
+	template <std::floating_point T>
+	void dilate(MatrixView<const std::type_identity_t<T>> src, MatrixView<T> dst,
+				MatrixView<const std::type_identity_t<T>> kernel, BorderMode border = BorderMode::Clamp)
+	{
+		const _StencilGrid g = _stencil_grid(src, dst);
+		const _StencilKernel<T> k = _stencil_kernel<_StencilOp::Max>(kernel);
+		_run_stencil<_StencilOp::Max>(src.data(), dst.data(), g, k, border);
+	}
+
+	// Applies the 3D kernel to src and writes the result to dst:
+	// dst(x, y, z) = sum of kernel(i, j, k) * src(x + i - (KW / 2), y + j - (KH / 2), z + k - (KL / 2)).
+	// Kernels that are the outer product of 3 vectors are applied as 3 1D passes.
+	// See stencil(MatrixView, MatrixView, MatrixView, BorderMode).
+	// Throws a std::invalid_argument if src and dst are the same FixedGrid.
+	template <std::floating_point T, std::size_t L, std::size_t W, std::size_t H, std::size_t KL, std::size_t KW, std::size_t KH>
+	void stencil(const FixedGrid<T, L, W, H>& src, FixedGrid<T, L, W, H>& dst, const FixedGrid<T, KL, KW, KH>& kernel,
+				 BorderMode border = BorderMode::Clamp)
+	{
+		_check_overlap(src.data(), src.size(), static_cast<const T*>(dst.data()), dst.size());
+
+		const _StencilGrid g{ W, H, L, W, W * H, W, W * H };
+		const _StencilKernel<T> k = _stencil_kernel<_StencilOp::Sum>(kernel);
+		_run_stencil<_StencilOp::Sum>(src.data(), dst.data(), g, k, border);
+	}
+
+	// Applies the 3D kernel that is the outer product of x_kernel, y_kernel and z_kernel
+	// to src and writes the result to dst, as 1 pass along each axis.
+	// See stencil(const FixedGrid&, FixedGrid&, const FixedGrid&, BorderMode).
+	// Throws a std::invalid_argument if a kernel is empty or if src and dst are the same FixedGrid.
+	template <std::floating_point T, std::size_t L, std::size_t W, std::size_t H>
+	void stencil_separable(const FixedGrid<T, L, W, H>& src, FixedGrid<T, L, W, H>& dst,
+						   std::span<const std::type_identity_t<T>> x_kernel, std::span<const std::type_identity_t<T>> y_kernel,
+						   std::span<const std::type_identity_t<T>> z_kernel, BorderMode border = BorderMode::Clamp)
+	{
+		if (x_kernel.empty() || y_kernel.empty() || z_kernel.empty())
+			throw std::invalid_argument("ERROR: The kernel of a stencil is empty.");
+
+		_check_overlap(src.data(), src.size(), static_cast<const T*>(dst.data()), dst.size());
+
+		const _StencilGrid g{ W, H, L, W, W * H, W, W * H };
+
+		_StencilKernel<T> k{ { x_kernel.size(), y_kernel.size(), z_kernel.size() },
+							 { x_kernel.size() / 2, y_kernel.size() / 2, z_kernel.size() / 2 }, {},
+							 { std::vector<T>(x_kernel.begin(), x_kernel.end()), std::vector<T>(y_kernel.begin(), y_kernel.end()),
+							   std::vector<T>(z_kernel.begin(), z_kernel.end()) }, true };
+
+		_run_stencil<_StencilOp::Sum>(src.data(), dst.data(), g, k, border);
+	}
+
+	// Sets each element of dst to the smallest element of src in the 3D neighborhood
+	// given by the nonzero elements of the kernel, centered as in stencil().
+	// Box-shaped neighborhoods are applied as 3 1D passes.
+	// Throws a std::invalid_argument if src and dst are the same FixedGrid.
+	template <std::floating_point T, std::size_t L, std::size_t W, std::size_t H, std::size_t KL, std::size_t KW, std::size_t KH>
+	void erode(const FixedGrid<T, L, W, H>& src, FixedGrid<T, L, W, H>& dst, const FixedGrid<T, KL, KW, KH>& kernel,
+			   BorderMode border = BorderMode::Clamp)
+	{
+		_check_overlap(src.data(), src.size(), static_cast<const T*>(dst.data()), dst.size());
+
+		const _StencilGrid g{ W, H, L, W, W * H, W, W * H };
+		const _StencilKernel<T> k = _stencil_kernel<_StencilOp::Min>(kernel);
+		_run_stencil<_StencilOp::Min>(src.data(), dst.data(), g, k, border);
+	}
+
+	// Sets each element of dst to the largest element of src in the 3D neighborhood
+	// given by the nonzero elements of the kernel, centered as in stencil().
+	// Box-shaped neighborhoods are applied as 3 1D passes.
+	// Throws a std::invalid_argument if src and dst are the same FixedGrid.
+	template <std::floating_point T, std::size_t L, std::size_t W, std::size_t H, std::size_t KL, std::size_t KW, std::size_t KH>
+	void dilate(const FixedGrid<T, L, W, H>& src, FixedGrid<T, L, W, H>& dst, const FixedGrid<T, KL, KW, KH>& kernel,
+				BorderMode border = BorderMode::Clamp)
+	{
+		_check_overlap(src.data(), src.size(), static_cast<const T*>(dst.data()), dst.size());
+
+		const _StencilGrid g{ W, H, L, W, W * H, W, W * H };
+		const _StencilKernel<T> k = _stencil_kernel<_StencilOp::Max>(kernel);
+		_run_stencil<_StencilOp::Max>(src.data(), dst.data(), g, k, border);
+	}
+}
\ No newline at end of file
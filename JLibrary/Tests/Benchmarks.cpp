@@ -0,0 +1,664 @@
+// JLibrary
+// Benchmarks.cpp
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Benchmarks run by "Tests.exe bench".
+
+#include "Tests.hpp"
+#include "../Buffer.hpp"
+#include "../FrameArena.hpp"
+#include "../IntegerTypedefs.hpp"
+#include "../Simd.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <vector>
+
+import Array;
+import BroadPhase;
+import Circle;
+import FixedGrid;
+import FixedMatrix;
+import GridLayout;
+import Matrix;
+import SimdVector;
+import Stencil;
+import Vector3;
+
+namespace jlib::tests
+{
+	// Counts the moves made of it.
+	struct MoveCounted
+	{
+		static inline long moves = 0;
+
+		int value = 0;
+
+		MoveCounted() = default;
+
+		MoveCounted(int n) : value(n)
+		{
+
+		}
+
+		MoveCounted(MoveCounted&& other) noexcept : value(other.value)
+		{
+			++moves;
+		}
+
+		MoveCounted& operator = (MoveCounted&& other) noexcept
+		{
+			value = other.value;
+			++moves;
+			return *this;
+		}
+	};
+
+	// Appending 10M elements one at a time.
+	// Geometric growth keeps the number of moves per element constant.
+	void bench_array_growth()
+	{
+		const int n = 10000000;
+		std::puts("Array growth: appending 10M elements");
+
+		auto start = std::chrono::steady_clock::now();
+		Array<int> ints;
+		for (int i = 0; i < n; ++i)
+			ints.push_back(i);
+		std::printf("  jlib::Array<int>  %8.1f ms\n", milliseconds_since(start));
+
+		start = std::chrono::steady_clock::now();
+		std::vector<int> vector;
+		for (int i = 0; i < n; ++i)
+			vector.push_back(i);
+		std::printf("  std::vector<int>  %8.1f ms\n", milliseconds_since(start));
+
+		MoveCounted::moves = 0;
+		Array<MoveCounted> counted;
+		for (int i = 0; i < n; ++i)
+			counted.emplace_back(i);
+		std::printf("  moves per element %8.2f\n", static_cast<double>(MoveCounted::moves) / n);
+	}
+
+	// Builds the scratch containers of a frame from the given resource and
+	// destroys them again: an array of floats for each of the given sizes,
+	// 64 arrays grown by push_back and 64 buffers of 4 KB.
+	static float build_frame(std::pmr::memory_resource* resource, const std::vector<std::uint32_t>& sizes, std::vector<pmr::Array<float>>& arrays)
+	{
+		float sum = 0.0f;
+		for (std::uint32_t size : sizes)
+		{
+			arrays.emplace_back(size, uninitialized, resource);
+			arrays.back()[0] = static_cast<float>(size);
+		}
+
+		for (int i = 0; i < 64; ++i)
+		{
+			pmr::Array<int> grown(resource);
+			for (int j = 0; j < 100; ++j)
+				grown.push_back(j);
+
+			Buffer buffer(4096, uninitialized, resource);
+			buffer[4095] = std::byte{ 1 };
+			sum += static_cast<float>(grown[99] + std::to_integer<int>(buffer[4095]));
+		}
+
+		for (const pmr::Array<float>& array : arrays)
+			sum += array[0];
+		arrays.clear();
+		return sum;
+	}
+
+	// 1000 frames of scratch allocations from the default memory_resource,
+	// and from a FrameArena that is reset at the end of every frame.
+	void bench_frame_arena()
+	{
+		std::puts("FrameArena: ms per frame of 1000 arrays, 64 grown arrays and 64 buffers");
+
+		std::mt19937 rng(1);
+		std::vector<std::uint32_t> sizes(1000);
+		for (std::uint32_t& size : sizes)
+			size = 16 + rng() % 497;
+
+		std::vector<pmr::Array<float>> arrays;
+		arrays.reserve(sizes.size());
+		float sum = 0.0f;
+
+		auto start = std::chrono::steady_clock::now();
+		for (int frame = 0; frame < 1000; ++frame)
+			sum += build_frame(std::pmr::get_default_resource(), sizes, arrays);
+		std::printf("  default resource %8.4f ms\n", milliseconds_since(start) / 1000.0);
+
+		// The arena starts too small, so the first frame overflows into extra blocks.
+		FrameArena arena(65536);
+		start = std::chrono::steady_clock::now();
+		for (int frame = 0; frame < 1000; ++frame)
+		{
+			sum += build_frame(&arena, sizes, arrays);
+			arena.reset();
+		}
+		std::printf("  FrameArena       %8.4f ms   (peak %zu KB, %g)\n", milliseconds_since(start) / 1000.0, arena.peak() / 1024, sum);
+	}
+
+	// Runs op on every index of n elements, 1000 times, and returns the time in milliseconds.
+	template <typename Op>
+	static double time_elements(std::size_t n, Op op)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		for (int rep = 0; rep < 1000; ++rep)
+			for (std::size_t i = 0; i < n; ++i)
+				op(i);
+		return milliseconds_since(start);
+	}
+
+	// 4x4 float matrix stored the way FixedArray stored its elements
+	// before they were made inline: behind a pointer from new[].
+	struct HeapMatrix4
+	{
+		float* data;
+
+		HeapMatrix4() : data(new float[16]())
+		{
+
+		}
+
+		HeapMatrix4(const HeapMatrix4& other) : data(new float[16])
+		{
+			std::copy(other.data, other.data + 16, data);
+		}
+
+		HeapMatrix4& operator = (const HeapMatrix4& other)
+		{
+			std::copy(other.data, other.data + 16, data);
+			return *this;
+		}
+
+		~HeapMatrix4()
+		{
+			delete[] data;
+		}
+	};
+
+	// The FixedMatrix multiply before FixedArray was made inline,
+	// which copied a row and a column out for every element of the product.
+	static HeapMatrix4 heap_product(const HeapMatrix4& A, const HeapMatrix4& B)
+	{
+		HeapMatrix4 M;
+
+		for (std::size_t r = 0; r < 4; ++r)
+		{
+			std::array<float, 4> row;
+			std::copy(A.data + (r * 4), A.data + (r * 4) + 4, row.begin());
+
+			for (std::size_t s = 0; s < 4; ++s)
+			{
+				std::array<float, 4> col;
+				for (std::size_t c = 0; c < 4; ++c)
+					col[c] = B.data[(c * 4) + s];
+
+				float value = 0.0f;
+				for (std::size_t c = 0; c < 4; ++c)
+					value += row[c] * col[c];
+
+				M.data[(r * 4) + s] = value;
+			}
+		}
+
+		return M;
+	}
+
+	// 1M FixedMatrix<float, 4, 4> multiplies with the heap storage and loop
+	// used before, with inline storage and the unrolled generic loop, and
+	// with inline storage and the SSE kernel.
+	void bench_fixed_matrix_multiply()
+	{
+		std::puts("FixedMatrix<float, 4, 4> multiply: 1M products");
+
+		const std::size_t n = 1024;
+		std::mt19937 rng(1);
+		std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+		std::vector<HeapMatrix4> heap_a(n);
+		std::vector<HeapMatrix4> heap_b(n);
+		std::vector<HeapMatrix4> heap_c(n);
+		std::vector<FixedMatrix<float, 4, 4>> a(n);
+		std::vector<FixedMatrix<float, 4, 4>> b(n);
+		std::vector<FixedMatrix<float, 4, 4>> c(n);
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			for (std::size_t j = 0; j < 16; ++j)
+			{
+				a[i][j] = heap_a[i].data[j] = dist(rng);
+				b[i][j] = heap_b[i].data[j] = dist(rng);
+			}
+		}
+
+		const double before = time_elements(n, [&](std::size_t i) { heap_c[i] = heap_product(heap_a[i], heap_b[i]); });
+		const double unrolled = time_elements(n, [&](std::size_t i) { c[i] = dot_product<float, 4, 4, 4>(a[i], b[i]); });
+		const double simd = time_elements(n, [&](std::size_t i) { c[i] = a[i] * b[i]; });
+		std::printf("  heap storage, row/column copies %8.2f ms\n", before);
+		std::printf("  inline storage, unrolled loop   %8.2f ms\n", unrolled);
+		std::printf("  inline storage, SSE             %8.2f ms   (%g %g)\n", simd, heap_c[n - 1].data[15], c[n - 1][15]);
+	}
+
+	// Runs op 1000 times and returns the GB/s when each run touches the given bytes.
+	template <typename Op>
+	static double gigabytes_per_second(std::size_t bytes, Op op)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		for (int rep = 0; rep < 1000; ++rep)
+			op();
+		return (bytes * 1000.0) / (milliseconds_since(start) * 1e6);
+	}
+
+	// Every Simd kernel at every dispatch level the CPU supports, over 32K
+	// elements so that the data stays in the L2 cache. The bytes counted are
+	// the ones each kernel reads and writes.
+	void bench_simd_kernels()
+	{
+		std::puts("Simd kernels: GB/s over 32K elements    Scalar     SSE2     AVX2");
+
+		const std::size_t n = 32768;
+		std::mt19937 rng(1);
+		std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+		std::vector<float> floats(n);
+		std::vector<double> doubles(n);
+		std::vector<i32> ints(n);
+		std::vector<u8> bytes(n);
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			floats[i] = dist(rng);
+			doubles[i] = dist(rng);
+			ints[i] = static_cast<i32>(rng());
+			bytes[i] = static_cast<u8>(rng());
+		}
+
+		std::vector<float> floats_copy(floats);
+		std::vector<double> doubles_copy(doubles);
+		std::vector<float> float_out(n);
+		std::vector<double> double_out(n);
+		std::vector<i32> int_out(n);
+		std::vector<u64> mask((n + 63) / 64);
+		const float* x = floats.data();
+		const float* y = floats_copy.data();
+		const double* dx = doubles.data();
+		const double* dy = doubles_copy.data();
+		double sink = 0.0;
+
+		auto report = [&](const char* name, std::size_t bytes_per_run, auto op)
+		{
+			std::printf("  %-38s", name);
+			for (simd::Level level : { simd::Level::Scalar, simd::Level::SSE2, simd::Level::AVX2 })
+			{
+				if (simd::set_dispatch_level(level) == level)
+					std::printf(" %8.2f", gigabytes_per_second(bytes_per_run, op));
+				else
+					std::printf("        -");
+			}
+			std::printf("\n");
+		};
+
+		report("fill_32", n * 4, [&] { simd::fill_32(float_out.data(), n, 0x3f800000u); });
+		report("fill_64", n * 8, [&] { simd::fill_64(double_out.data(), n, 0x3ff0000000000000u); });
+		report("equal float", n * 8, [&] { sink += simd::equal(x, y, n); });
+		report("equal double", n * 16, [&] { sink += simd::equal(dx, dy, n); });
+		report("convert i32 -> float", n * 8, [&] { simd::convert(ints.data(), float_out.data(), n); });
+		report("convert u8 -> float", n * 5, [&] { simd::convert(bytes.data(), float_out.data(), n); });
+		report("convert float -> i32", n * 8, [&] { simd::convert(x, int_out.data(), n); });
+		report("convert float -> double", n * 12, [&] { simd::convert(x, double_out.data(), n); });
+		report("convert double -> float", n * 12, [&] { simd::convert(dx, float_out.data(), n); });
+		report("min float", n * 4, [&] { sink += simd::min(x, n); });
+		report("max float", n * 4, [&] { sink += simd::max(x, n); });
+		report("min double", n * 8, [&] { sink += simd::min(dx, n); });
+		report("max double", n * 8, [&] { sink += simd::max(dx, n); });
+		report("min i32", n * 4, [&] { sink += simd::min(ints.data(), n); });
+		report("max i32", n * 4, [&] { sink += simd::max(ints.data(), n); });
+		report("dot float", n * 8, [&] { sink += simd::dot(x, y, n); });
+		report("dot double", n * 16, [&] { sink += simd::dot(dx, dy, n); });
+		report("distance_squared float", n * 8, [&] { sink += simd::distance_squared(x, y, n); });
+		report("distance_squared double", n * 16, [&] { sink += simd::distance_squared(dx, dy, n); });
+		report("within_radius float", n * 12 + n / 8, [&] { simd::within_radius(x, y, x, n, 0.1f, 0.2f, 0.3f, 0.25f, mask.data()); });
+		report("within_radius double", n * 24 + n / 8, [&] { simd::within_radius(dx, dy, dx, n, 0.1, 0.2, 0.3, 0.25, mask.data()); });
+		report("within_bounds float", n * 8 + n / 8, [&] { simd::within_bounds(x, y, n, -0.5f, -0.5f, 0.5f, 0.5f, mask.data()); });
+		report("within_bounds double", n * 16 + n / 8, [&] { simd::within_bounds(dx, dy, n, -0.5, -0.5, 0.5, 0.5, mask.data()); });
+
+		simd::set_dispatch_level(simd::Level::AVX2);
+		std::printf("  (%g %g %g %d %llu)\n", sink, float_out[n - 1], double_out[n - 1], int_out[n - 1], static_cast<unsigned long long>(mask[0]));
+	}
+
+	// Returns the GFLOP/s of C = A * B for n x n matrices of T,
+	// repeating the product until at least 200 ms have passed.
+	template <typename T>
+	static double gemm_gflops(std::size_t n, bool parallel)
+	{
+		Matrix<T> A(n, n, T(0.5));
+		Matrix<T> B(n, n, T(0.25));
+		Matrix<T> C(n, n);
+
+		int reps = 0;
+		double ms = 0.0;
+		const auto start = std::chrono::steady_clock::now();
+		do
+		{
+			gemm(T(1), A, B, T(0), C, parallel);
+			++reps;
+			ms = milliseconds_since(start);
+		} while (ms < 200.0);
+
+		return (2.0 * n * n * n * reps) / (ms * 1e6);
+	}
+
+	// jlib::gemm on square float and double matrices from 64 to 4096,
+	// on one thread and split across threads.
+	void bench_gemm()
+	{
+		std::puts("GEMM: GFLOP/s of n x n products    float 1 thread   threaded   double 1 thread   threaded");
+
+		for (std::size_t n = 64; n <= 4096; n *= 2)
+		{
+			std::printf("  n = %-4zu %36.1f %10.1f", n, gemm_gflops<float>(n, false), gemm_gflops<float>(n, true));
+			std::printf(" %17.1f %10.1f\n", gemm_gflops<double>(n, false), gemm_gflops<double>(n, true));
+		}
+	}
+
+	// Sums the 3 x 3 x 3 block around every cell of the grid but the border,
+	// with x innermost, and returns the time of a sweep in milliseconds.
+	template <typename Grid>
+	static double sweep_neighborhoods(const Grid& src, Grid& dst)
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		for (std::size_t z = 1; z + 1 < Grid::length(); ++z)
+		{
+			for (std::size_t y = 1; y + 1 < Grid::height(); ++y)
+			{
+				for (std::size_t x = 1; x + 1 < Grid::width(); ++x)
+				{
+					float sum = 0.0f;
+					for (std::size_t k = z - 1; k <= z + 1; ++k)
+						for (std::size_t j = y - 1; j <= y + 1; ++j)
+							for (std::size_t i = x - 1; i <= x + 1; ++i)
+								sum += src(i, j, k);
+					dst(x, y, z) = sum / 27.0f;
+				}
+			}
+		}
+
+		return milliseconds_since(start);
+	}
+
+	// Sums the 3 x 3 x 3 blocks around the given cells, which are packed
+	// as 8 bits per coordinate, and returns the time in milliseconds.
+	template <typename Grid>
+	static double scatter_neighborhoods(const Grid& src, const std::vector<std::uint32_t>& cells, float& total)
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		float sum = 0.0f;
+		for (std::uint32_t cell : cells)
+		{
+			const std::size_t x = 1 + (cell & 0xff) % (Grid::width() - 2);
+			const std::size_t y = 1 + ((cell >> 8) & 0xff) % (Grid::height() - 2);
+			const std::size_t z = 1 + ((cell >> 16) & 0xff) % (Grid::length() - 2);
+			for (std::size_t k = z - 1; k <= z + 1; ++k)
+				for (std::size_t j = y - 1; j <= y + 1; ++j)
+					for (std::size_t i = x - 1; i <= x + 1; ++i)
+						sum += src(i, j, k);
+		}
+		total += sum;
+
+		return milliseconds_since(start);
+	}
+
+	template <typename Grid>
+	static void bench_grid_layout(const char* name, const std::vector<std::uint32_t>& cells)
+	{
+		auto src = std::make_unique<Grid>();
+		auto dst = std::make_unique<Grid>(0.0f);
+		for (std::size_t z = 0; z < Grid::length(); ++z)
+			for (std::size_t y = 0; y < Grid::height(); ++y)
+				for (std::size_t x = 0; x < Grid::width(); ++x)
+					(*src)(x, y, z) = static_cast<float>(((x * 7) + (y * 3) + z) % 11);
+
+		float total = 0.0f;
+		const double sweep = sweep_neighborhoods(*src, *dst);
+		const double scatter = scatter_neighborhoods(*src, cells, total);
+		std::printf("  %-14s sweep %8.1f ms   scattered %8.1f ms   (%g)\n", name, sweep, scatter, total + (*dst)(1, 1, 1));
+	}
+
+	// 3 x 3 x 3 neighborhoods of a 256^3 float grid under each layout,
+	// once for every cell in order and once for 4M random cells.
+	void bench_grid_layouts()
+	{
+		std::puts("FixedGrid layouts: 3x3x3 neighborhoods of a 256^3 float grid");
+
+		std::mt19937 rng(1);
+		std::vector<std::uint32_t> cells(4000000);
+		for (std::uint32_t& cell : cells)
+			cell = static_cast<std::uint32_t>(rng());
+
+		bench_grid_layout<FixedGrid<float, 256, 256, 256>>("LinearLayout", cells);
+		bench_grid_layout<FixedGrid<float, 256, 256, 256, MortonLayout>>("MortonLayout", cells);
+		bench_grid_layout<FixedGrid<float, 256, 256, 256, BrickLayout<8>>>("BrickLayout<8>", cells);
+	}
+
+	// Applies the kernel to src with clamped borders, one element and one tap
+	// at a time, or takes the minimum over the kernel's neighborhood if erode
+	// is true, and returns the time in milliseconds.
+	static double naive_stencil(const Matrix<float>& src, Matrix<float>& dst, const Matrix<float>& kernel, bool erode)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		const long rows = static_cast<long>(src.rowCount());
+		const long cols = static_cast<long>(src.colCount());
+		const long krows = static_cast<long>(kernel.rowCount());
+		const long kcols = static_cast<long>(kernel.colCount());
+
+		for (long r = 0; r < rows; ++r)
+		{
+			for (long c = 0; c < cols; ++c)
+			{
+				float result = erode ? src(r, c) : 0.0f;
+				for (long i = 0; i < krows; ++i)
+				{
+					const long sr = std::clamp(r + i - krows / 2, 0L, rows - 1);
+					for (long j = 0; j < kcols; ++j)
+					{
+						const float v = src(sr, std::clamp(c + j - kcols / 2, 0L, cols - 1));
+						result = erode ? std::min(result, v) : result + kernel(i, j) * v;
+					}
+				}
+				dst(r, c) = result;
+			}
+		}
+
+		return milliseconds_since(start);
+	}
+
+	// stencil() and erode() on a 4096 x 4096 float Matrix against a naive
+	// clamped loop, for a box blur, a separable Gaussian blur, a dense kernel
+	// and a 3 x 3 erosion.
+	void bench_stencil()
+	{
+		std::puts("Stencils: ms per pass over a 4096 x 4096 float Matrix");
+
+		constexpr std::size_t n = 4096;
+		std::mt19937 rng(1);
+		std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+		Matrix<float> src(n, n);
+		for (std::size_t r = 0; r < n; ++r)
+			for (std::size_t c = 0; c < n; ++c)
+				src(r, c) = dist(rng);
+
+		Matrix<float> expected(n, n);
+		Matrix<float> dst(n, n);
+
+		const Matrix<float> box(3, 3, 1.0f / 9.0f);
+
+		const std::array<float, 5> binomial = { 1.0f, 4.0f, 6.0f, 4.0f, 1.0f };
+		Matrix<float> gaussian(5, 5);
+		for (std::size_t i = 0; i < 5; ++i)
+			for (std::size_t j = 0; j < 5; ++j)
+				gaussian(i, j) = binomial[i] * binomial[j] / 256.0f;
+
+		Matrix<float> dense(5, 5);
+		for (std::size_t i = 0; i < 5; ++i)
+			for (std::size_t j = 0; j < 5; ++j)
+				dense(i, j) = dist(rng) - 0.5f;
+
+		const Matrix<float> neighborhood(3, 3, 1.0f);
+
+		struct Case
+		{
+			const char* name;
+			const Matrix<float>* kernel;
+			bool erode;
+		};
+
+		for (const Case& test : { Case{ "box 3x3", &box, false }, Case{ "Gaussian 5x5", &gaussian, false },
+								  Case{ "dense 5x5", &dense, false }, Case{ "erode 3x3", &neighborhood, true } })
+		{
+			const double naive = naive_stencil(src, expected, *test.kernel, test.erode);
+
+			const auto start = std::chrono::steady_clock::now();
+			if (test.erode)
+				erode<float>(src.view(), dst.view(), test.kernel->view());
+			else
+				stencil<float>(src.view(), dst.view(), test.kernel->view());
+			const double engine = milliseconds_since(start);
+
+			float difference = 0.0f;
+			for (std::size_t r = 0; r < n; ++r)
+				for (std::size_t c = 0; c < n; ++c)
+					difference = std::max(difference, std::abs(dst(r, c) - expected(r, c)));
+
+			std::printf("  %-13s naive %8.1f ms   stencil %7.1f ms   (max difference %g)\n",
+						test.name, naive, engine, difference);
+		}
+	}
+
+	// Vec3f against the scalar Vector3<float> for 1M dot products,
+	// cross products, normalizations and distances.
+	void bench_simd_vectors()
+	{
+		std::puts("Vec3f against Vector3<float>: 1M operations each");
+
+		const std::size_t n = 1024;
+		std::mt19937 rng(1);
+		std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+		std::vector<Vector3<float>> a(n);
+		std::vector<Vector3<float>> b(n);
+		std::vector<Vector3<float>> c(n);
+		std::vector<Vec3f> A;
+		std::vector<Vec3f> B;
+		std::vector<Vec3f> C(n);
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			a[i] = Vector3<float>(dist(rng), dist(rng), dist(rng));
+			b[i] = Vector3<float>(dist(rng), dist(rng), dist(rng));
+			A.emplace_back(a[i]);
+			B.emplace_back(b[i]);
+		}
+
+		float scalar_sum = 0.0f;
+		float simd_sum = 0.0f;
+		double scalar = time_elements(n, [&](std::size_t i) { scalar_sum += dot_product(a[i], b[i]); });
+		double simd = time_elements(n, [&](std::size_t i) { simd_sum += dot_product(A[i], B[i]); });
+		std::printf("  dot_product    Vector3 %8.2f ms   Vec3f %8.2f ms\n", scalar, simd);
+
+		scalar = time_elements(n, [&](std::size_t i) { c[i] = cross_product(a[i], b[i]); });
+		simd = time_elements(n, [&](std::size_t i) { C[i] = cross_product(A[i], B[i]); });
+		std::printf("  cross_product  Vector3 %8.2f ms   Vec3f %8.2f ms\n", scalar, simd);
+
+		scalar = time_elements(n, [&](std::size_t i) { c[i] = unit_vector(a[i]); });
+		simd = time_elements(n, [&](std::size_t i) { C[i] = unit_vector(A[i]); });
+		std::printf("  unit_vector    Vector3 %8.2f ms   Vec3f %8.2f ms\n", scalar, simd);
+
+		scalar = time_elements(n, [&](std::size_t i) { scalar_sum += distance(a[i], c[i]); });
+		simd = time_elements(n, [&](std::size_t i) { simd_sum += distance(A[i], C[i]); });
+		std::printf("  distance       Vector3 %8.2f ms   Vec3f %8.2f ms   (%g %g)\n", scalar, simd, scalar_sum, simd_sum);
+	}
+
+	// Moves every circle, updates the broad phase and counts the pairs that
+	// really intersect, for 10 frames. Returns the time of a frame in milliseconds.
+	template <typename BroadPhase>
+	static double simulate_frames(BroadPhase& broad_phase, std::vector<Circle<float>>& circles, std::mt19937& rng, std::size_t& contacts)
+	{
+		std::uniform_real_distribution<float> step(-0.3f, 0.3f);
+		double total = 0.0;
+
+		for (int frame = 0; frame < 10; ++frame)
+		{
+			for (Circle<float>& circle : circles)
+				circle.center.set(circle.center.x + step(rng), circle.center.y + step(rng));
+
+			const auto start = std::chrono::steady_clock::now();
+			for (std::size_t i = 0; i < circles.size(); ++i)
+				broad_phase.update(i, circles[i]);
+
+			contacts = 0;
+			broad_phase.findPairs([&](std::size_t A, std::size_t B) { contacts += intersection(circles[A], circles[B]); });
+			total += milliseconds_since(start);
+		}
+
+		return total / 10.0;
+	}
+
+	// SweepAndPrune and SpatialHash against testing every pair,
+	// for 1k to 100k moving circles at a constant density.
+	void bench_broad_phase()
+	{
+		std::puts("Broad phase: ms per frame of moving circles");
+
+		for (int n : { 1000, 10000, 20000, 100000 })
+		{
+			std::mt19937 rng(1);
+			std::uniform_real_distribution<float> position(0.0f, std::sqrt(static_cast<float>(n)) * 10.0f);
+			std::uniform_real_distribution<float> radius(0.5f, 2.0f);
+			std::vector<Circle<float>> circles;
+			for (int i = 0; i < n; ++i)
+				circles.emplace_back(position(rng), position(rng), radius(rng));
+
+			// Every pair is only tested up to 20k circles, past which it takes seconds.
+			double brute = 0.0;
+			std::size_t brute_contacts = 0;
+			if (n <= 20000)
+			{
+				const auto start = std::chrono::steady_clock::now();
+				for (int i = 0; i < n; ++i)
+					for (int j = i + 1; j < n; ++j)
+						brute_contacts += intersection(circles[i], circles[j]);
+				brute = milliseconds_since(start);
+			}
+
+			SweepAndPrune<float, 2> sweep;
+			SpatialHash<float, 2> hash(4.0f);
+			for (const Circle<float>& circle : circles)
+			{
+				sweep.insert(circle);
+				hash.insert(circle);
+			}
+			sweep.findPairs();
+
+			std::vector<Circle<float>> moved = circles;
+			std::mt19937 sweep_rng(2);
+			std::mt19937 hash_rng(2);
+			std::size_t sweep_contacts = 0;
+			std::size_t hash_contacts = 0;
+			const double sweep_ms = simulate_frames(sweep, circles, sweep_rng, sweep_contacts);
+			const double hash_ms = simulate_frames(hash, moved, hash_rng, hash_contacts);
+
+			if (n <= 20000)
+				std::printf("  %6d circles   every pair %8.1f ms (%zu)", n, brute, brute_contacts);
+			else
+				std::printf("  %6d circles   every pair        - ms", n);
+			std::printf("   SweepAndPrune %6.2f ms   SpatialHash %6.2f ms   (%zu %zu)\n", sweep_ms, hash_ms, sweep_contacts, hash_contacts);
+		}
+	}
+}
\ No newline at end of file
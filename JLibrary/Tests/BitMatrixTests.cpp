@@ -0,0 +1,196 @@
+// JLibrary
+// BitMatrixTests.cpp
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Tests for the fixed-size and dynamic bit matrices.
+
+#include "Tests.hpp"
+
+#include <bitset>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+import BitMatrix;
+
+namespace jlib::tests
+{
+	using BitRows = std::vector<std::vector<bool>>;
+
+	static std::mt19937 bit_rng(9);
+
+	template <typename M>
+	static bool equals(const M& m, const BitRows& ref)
+	{
+		for (std::size_t r = 0; r < ref.size(); ++r)
+			for (std::size_t c = 0; c < ref[r].size(); ++c)
+				if (m(r, c) != ref[r][c])
+					return false;
+		return true;
+	}
+
+	// Sets each bit with the given percent chance and returns the reference copy.
+	template <typename M>
+	static BitRows randomize(M& m, std::size_t rows, std::size_t cols, unsigned percent)
+	{
+		BitRows ref(rows, std::vector<bool>(cols));
+		for (std::size_t r = 0; r < rows; ++r)
+		{
+			for (std::size_t c = 0; c < cols; ++c)
+			{
+				bool bit = bit_rng() % 100 < percent;
+				ref[r][c] = bit;
+				m.set(r, c, bit);
+			}
+		}
+		return ref;
+	}
+
+	static BitRows closure(BitRows ref)
+	{
+		const std::size_t n = ref.size();
+		for (std::size_t k = 0; k < n; ++k)
+			for (std::size_t i = 0; i < n; ++i)
+				if (ref[i][k])
+					for (std::size_t j = 0; j < n; ++j)
+						if (ref[k][j])
+							ref[i][j] = true;
+		return ref;
+	}
+
+	template <typename M>
+	static void test_bit_operations(M A, M B, std::size_t rows, std::size_t cols)
+	{
+		BitRows a = randomize(A, rows, cols, 30);
+		BitRows b = randomize(B, rows, cols, 50);
+
+		BitRows both = a;
+		BitRows either = a;
+		BitRows differ = a;
+		BitRows inverse = a;
+		std::size_t set = 0;
+		for (std::size_t r = 0; r < rows; ++r)
+		{
+			for (std::size_t c = 0; c < cols; ++c)
+			{
+				both[r][c] = a[r][c] && b[r][c];
+				either[r][c] = a[r][c] || b[r][c];
+				differ[r][c] = a[r][c] != b[r][c];
+				inverse[r][c] = !a[r][c];
+				set += inverse[r][c];
+			}
+		}
+
+		JLIB_CHECK(equals(A & B, both));
+		JLIB_CHECK(equals(A | B, either));
+		JLIB_CHECK(equals(A ^ B, differ));
+		JLIB_CHECK(equals(~A, inverse));
+		JLIB_CHECK((~A).popcount() == set);
+
+		for (std::size_t r = 0; r < rows; ++r)
+		{
+			std::size_t count = 0;
+			std::size_t first = cols;
+			for (std::size_t c = 0; c < cols; ++c)
+			{
+				count += a[r][c];
+				if (a[r][c] && first == cols)
+					first = c;
+			}
+
+			std::size_t visited = 0;
+			for (std::size_t c = A.findFirstInRow(r); c < cols; c = A.findNextInRow(r, c))
+				++visited;
+
+			JLIB_CHECK(A.rowPopcount(r) == count && A.findFirstInRow(r) == first && visited == count);
+		}
+
+		for (std::ptrdiff_t shift : { 0, 1, 5, 63, 64, 65, 130, -1, -7, -64, -100, 1000, -1000 })
+		{
+			M S = A;
+			S.shiftCols(shift);
+			BitRows ref(rows, std::vector<bool>(cols));
+			for (std::size_t r = 0; r < rows; ++r)
+			{
+				for (std::size_t c = 0; c < cols; ++c)
+				{
+					std::ptrdiff_t source = static_cast<std::ptrdiff_t>(c) - shift;
+					ref[r][c] = source >= 0 && source < static_cast<std::ptrdiff_t>(cols) && a[r][source];
+				}
+			}
+			JLIB_CHECK(equals(S, ref));
+		}
+
+		M F = A;
+		F.rowOr(0, rows - 1);
+		F.rowFlip(1);
+		BitRows f = a;
+		for (std::size_t c = 0; c < cols; ++c)
+		{
+			f[0][c] = f[0][c] || a[rows - 1][c];
+			f[1][c] = !f[1][c];
+		}
+		JLIB_CHECK(equals(F, f));
+	}
+
+	void test_bit_matrices()
+	{
+		test_bit_operations(FixedBitMatrix<13, 70>(), FixedBitMatrix<13, 70>(), 13, 70);
+		test_bit_operations(FixedBitMatrix<5, 64>(), FixedBitMatrix<5, 64>(), 5, 64);
+		test_bit_operations(DynamicBitMatrix(13, 70), DynamicBitMatrix(13, 70), 13, 70);
+		test_bit_operations(DynamicBitMatrix(9, 600), DynamicBitMatrix(9, 600), 9, 600);
+		test_bit_operations(DynamicBitMatrix(4, 3), DynamicBitMatrix(4, 3), 4, 3);
+
+		FixedBitMatrix<3, 3> ones(true);
+		JLIB_CHECK(ones.popcount() == 9);
+
+		// The former name of FixedBitMatrix still works.
+		static_assert(std::is_same_v<BitMatrix<3, 3>, FixedBitMatrix<3, 3>>);
+		BitMatrix<2, 5> old(true);
+		old.set(1, 4, false);
+		JLIB_CHECK(old.at(1, 3) && !old.at(1, 4) && old.size() == 10);
+
+		// It converts to and from the std::bitset that data() used to return.
+		std::bitset<10> bits = old.toBitset();
+		JLIB_CHECK(bits.count() == 9 && bits[8] && !bits[9]);
+		bits.flip(0);
+		BitMatrix<2, 5> converted(bits);
+		JLIB_CHECK(!converted(0, 0) && converted(1, 3) && !converted(1, 4) && converted.popcount() == 8);
+		FixedBitMatrix<3, 70> wide;
+		wide.set(2, 69, true);
+		wide.set(1, 64, true);
+		JLIB_CHECK((FixedBitMatrix<3, 70>(wide.toBitset()) == wide));
+
+		for (std::size_t n : { 5, 70, 300 })
+		{
+			DynamicBitMatrix G(n, n);
+			BitRows g = randomize(G, n, n, n < 10 ? 30 : 2);
+
+			BitRows square(n, std::vector<bool>(n));
+			for (std::size_t i = 0; i < n; ++i)
+				for (std::size_t k = 0; k < n; ++k)
+					if (g[i][k])
+						for (std::size_t j = 0; j < n; ++j)
+							if (g[k][j])
+								square[i][j] = true;
+
+			JLIB_CHECK(equals(G * G, square));
+			JLIB_CHECK(equals(transitive_closure(G), closure(g)));
+		}
+
+		FixedBitMatrix<70, 70> fixed;
+		BitRows f = randomize(fixed, 70, 70, 3);
+		JLIB_CHECK(equals(transitive_closure(fixed), closure(f)));
+		JLIB_CHECK(equals(DynamicBitMatrix(fixed), f));
+
+		// A chain reaches every later vertex.
+		DynamicBitMatrix chain(2048, 2048);
+		for (std::size_t i = 0; i + 1 < 2048; ++i)
+			chain.set(i, i + 1, true);
+		JLIB_CHECK(transitive_closure(chain).popcount() == std::size_t(2047) * 2048 / 2);
+
+		JLIB_CHECK_THROWS(DynamicBitMatrix(2, 2) & DynamicBitMatrix(2, 3), std::invalid_argument);
+	}
+}
\ No newline at end of file
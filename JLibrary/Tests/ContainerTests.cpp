@@ -0,0 +1,337 @@
+// JLibrary
+// ContainerTests.cpp
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Tests for Array, FixedArray, SmallArray, Buffer, FrameArena,
+// the reductions in MiscTemplateFunctions and the Simd dispatch levels.
+
+#include "Tests.hpp"
+#include "../Buffer.hpp"
+#include "../FrameArena.hpp"
+#include "../IntegerTypedefs.hpp"
+#include "../Simd.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+import Array;
+import FixedArray;
+import Matrix;
+import MiscTemplateFunctions;
+import SmallArray;
+
+namespace jlib::tests
+{
+	// Counts the copies and moves made of it.
+	struct Counted
+	{
+		static inline long copies = 0;
+		static inline long moves = 0;
+
+		int value = 0;
+
+		Counted() = default;
+
+		Counted(int n) : value(n)
+		{
+
+		}
+
+		Counted(const Counted& other) : value(other.value)
+		{
+			++copies;
+		}
+
+		Counted(Counted&& other) noexcept : value(other.value)
+		{
+			++moves;
+		}
+
+		Counted& operator = (const Counted& other)
+		{
+			value = other.value;
+			++copies;
+			return *this;
+		}
+
+		Counted& operator = (Counted&& other) noexcept
+		{
+			value = other.value;
+			++moves;
+			return *this;
+		}
+	};
+
+	static void test_array()
+	{
+		Counted::copies = 0;
+		Counted::moves = 0;
+		Array<Counted> counted;
+		for (int i = 0; i < 100000; ++i)
+			counted.emplace_back(i);
+
+		// Growth moves elements, and 1.5x growth moves each one about twice.
+		JLIB_CHECK(Counted::copies == 0);
+		JLIB_CHECK(Counted::moves < 3 * 100000);
+		JLIB_CHECK(counted.capacity() >= counted.size());
+		JLIB_CHECK(counted[99999].value == 99999);
+
+		// Growing one element at a time through resize is geometric as well.
+		Counted::moves = 0;
+		Array<Counted> resized;
+		std::size_t reallocations = 0;
+		for (std::size_t i = 1; i <= 100000; ++i)
+		{
+			std::size_t capacity = resized.capacity();
+			resized.resize(i);
+			if (resized.capacity() != capacity)
+				++reallocations;
+		}
+		JLIB_CHECK(reallocations < 30);
+		JLIB_CHECK(Counted::moves < 3 * 100000);
+		resized.resize(resized.capacity() + 1, Counted(7));
+		JLIB_CHECK(resized.capacity() >= resized.size() + resized.size() / 3);
+		JLIB_CHECK(resized[resized.size() - 1].value == 7);
+
+		Array<std::string> strings{ "a", "b" };
+		strings.push_back(strings[0]);
+		strings.push_back("xyz");
+		strings.resize(10, "q");
+		strings.resize(3);
+		JLIB_CHECK(strings.size() == 3 && strings[2] == "a");
+
+		Array<std::string> copy;
+		copy = strings;
+		JLIB_CHECK(copy == strings);
+		copy.shrink_to_fit();
+		JLIB_CHECK(copy.capacity() == 3);
+
+		Array<int> zeros(5);
+		for (int n : zeros)
+			JLIB_CHECK(n == 0);
+		zeros.clear();
+		JLIB_CHECK(zeros.isEmpty());
+
+		Array<float> converted(Array<int>{ 1, 2 });
+		JLIB_CHECK(converted[1] == 2.0f);
+
+		Array<std::string> raw(3, uninitialized);
+		JLIB_CHECK(raw[0].empty());
+		JLIB_CHECK_THROWS(zeros.at(0), std::out_of_range);
+	}
+
+	static void test_small_array()
+	{
+		using Strings = SmallArray<std::string, 4>;
+
+		Strings a{ "a", "b" };
+		JLIB_CHECK(!a.isOnHeap());
+		for (int i = 0; i < 10; ++i)
+			a.push_back(std::to_string(i));
+		JLIB_CHECK(a.isOnHeap() && a.size() == 12);
+
+		Strings b{ "x" };
+		a.swapWith(b);
+		JLIB_CHECK(b.size() == 12 && a.size() == 1 && a[0] == "x" && !a.isOnHeap());
+
+		b.resize(3);
+		b.shrink_to_fit();
+		JLIB_CHECK(!b.isOnHeap() && b[2] == "0");
+
+		Strings c(b);
+		JLIB_CHECK(c == b);
+		Strings d(std::move(c));
+		JLIB_CHECK(d == b && c.isEmpty());
+
+		d = Strings{ "1", "2", "3", "4", "5" };
+		JLIB_CHECK(d.isOnHeap());
+		d = b;
+		JLIB_CHECK(d == b);
+
+		SmallArray<int, 2> ints(5, uninitialized);
+		ints.setAll(7);
+		JLIB_CHECK(ints.at(4) == 7);
+		SmallArray<double, 8> doubles(ints);
+		JLIB_CHECK(doubles[0] == 7.0);
+
+		SmallArray<int, 2> grown;
+		std::size_t reallocations = 0;
+		for (std::size_t i = 1; i <= 100000; ++i)
+		{
+			std::size_t capacity = grown.capacity();
+			grown.resize(i, 1);
+			if (grown.capacity() != capacity)
+				++reallocations;
+		}
+		JLIB_CHECK(reallocations < 20 && grown[99999] == 1);
+
+		std::ostringstream out;
+		std::wostringstream wout;
+		out << SmallArray<int, 2>() << ints;
+		wout << SmallArray<int, 2>();
+		JLIB_CHECK(out.str() == "{ }\n{ 7, 7, 7, 7, 7 }\n");
+		JLIB_CHECK(wout.str() == L"{ }\n");
+	}
+
+	static void test_fixed_array_and_buffer()
+	{
+		FixedArray<short, 9> f;
+		f.setAll(4);
+		FixedArray<short, 9> g = f;
+		JLIB_CHECK(f == g);
+		g[8] = 1;
+		JLIB_CHECK(f != g);
+
+		Buffer a(100, uninitialized);
+		Buffer b(10, 0);
+		JLIB_CHECK(reinterpret_cast<std::uintptr_t>(a.pointer()) % 64 == 0);
+		JLIB_CHECK(b[9] == std::byte{ 0 });
+
+		a = b;
+		JLIB_CHECK(a.size() == 10 && a == b);
+		b.fill(3);
+		JLIB_CHECK(a != b);
+	}
+
+	static void test_frame_arena()
+	{
+		FrameArena arena(1024);
+		std::size_t first_capacity = 0;
+
+		for (int frame = 0; frame < 3; ++frame)
+		{
+			{
+				pmr::Array<int> a(&arena);
+				for (int i = 0; i < 1000; ++i)
+					a.push_back(i);
+
+				pmr::Matrix<float> m(8, 8, 1.0f, &arena);
+				Buffer buffer(256, uninitialized, &arena);
+				pmr::Array<std::string> strings({ "a", "b" }, &arena);
+				strings.push_back("c");
+
+				JLIB_CHECK(a[999] == 999 && m(7, 7) == 1.0f && strings[2] == "c");
+				JLIB_CHECK(arena.used() > 0);
+			}
+
+			arena.reset();
+			JLIB_CHECK(arena.used() == 0);
+
+			// After the first frame the arena holds a frame's worth of memory.
+			if (frame == 0)
+				first_capacity = arena.capacity();
+			else
+				JLIB_CHECK(arena.capacity() == first_capacity);
+		}
+	}
+
+	static void test_reductions()
+	{
+		const std::size_t n = 1000003;
+		Array<float> a(n);
+		std::mt19937 rng(1);
+		std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+		for (float& x : a)
+			x = dist(rng);
+
+		long double sum = 0.0L;
+		for (float x : a)
+			sum += x;
+		const long double mean = sum / n;
+
+		long double var = 0.0L;
+		for (float x : a)
+			var += (x - mean) * (x - mean);
+		var /= n;
+
+		JLIB_CHECK(std::abs(add_all(a) - sum) / sum < 1e-6);
+		JLIB_CHECK(std::abs(add_all(a, Summation::Kahan) - sum) / sum < 1e-6);
+		JLIB_CHECK(std::abs(average(a) - mean) < 1e-6);
+		JLIB_CHECK(std::abs(variance(a) - var) < 1e-9);
+
+		Array<int> ints(n);
+		for (std::size_t i = 0; i < n; ++i)
+			ints[i] = static_cast<int>(i % 1000) - 500;
+		ints[12345] = -9999;
+		ints[5] = 99999;
+		JLIB_CHECK(min_value(ints) == -9999 && max_value(ints) == 99999);
+
+		long long squares = 0;
+		for (int x : ints)
+			squares += static_cast<long long>(x) * x;
+		JLIB_CHECK(dot(ints, ints) == squares);
+
+		Array<int> large(3, 2000000000);
+		JLIB_CHECK(add_all(large) == 6000000000LL);
+
+		Array<double> small{ 1.0, 2.0, 3.0, 4.0 };
+		JLIB_CHECK(variance(small) == 1.25 && add_all(small) == 10.0);
+
+		unsigned char bytes[5] = { 1, 2, 3, 4, 250 };
+		float floats[5];
+		copy(bytes, bytes + 5, floats);
+		JLIB_CHECK(floats[4] == 250.0f);
+	}
+
+	// Every dispatch level must give the same results as the scalar code.
+	static void test_simd_levels()
+	{
+		const std::size_t n = 1001;
+		std::mt19937 rng(2);
+		std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+		Array<float> a(n);
+		Array<i32> ints(n);
+		Array<u8> bytes(n);
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			a[i] = dist(rng);
+			ints[i] = static_cast<i32>(rng());
+			bytes[i] = static_cast<u8>(rng());
+		}
+
+		Array<float> b(a);
+		b[n - 1] += 1.0f;
+
+		for (simd::Level level : { simd::Level::Scalar, simd::Level::SSE2, simd::Level::AVX2 })
+		{
+			if (simd::set_dispatch_level(level) != level)
+				continue;
+
+			JLIB_CHECK(simd::min(a.data(), n) == *std::min_element(a.begin(), a.end()));
+			JLIB_CHECK(simd::max(a.data(), n) == *std::max_element(a.begin(), a.end()));
+			JLIB_CHECK(simd::min(ints.data(), n) == *std::min_element(ints.begin(), ints.end()));
+			JLIB_CHECK(simd::equal(a.data(), a.data(), n) && !simd::equal(a.data(), b.data(), n));
+
+			Array<float> converted(n);
+			Array<i32> truncated(n);
+			Array<u32> filled(n);
+			simd::convert(bytes.data(), converted.data(), n);
+			simd::convert(a.data(), truncated.data(), n);
+			simd::fill_32(filled.data(), n, 7u);
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				JLIB_CHECK(converted[i] == bytes[i]);
+				JLIB_CHECK(truncated[i] == static_cast<i32>(a[i]));
+				JLIB_CHECK(filled[i] == 7u);
+			}
+		}
+
+		simd::set_dispatch_level(simd::Level::AVX2);
+	}
+
+	void test_containers()
+	{
+		test_array();
+		test_small_array();
+		test_fixed_array_and_buffer();
+		test_frame_arena();
+		test_reductions();
+		test_simd_levels();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,592 @@
+// JLibrary
+// GeometryTests.cpp
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Tests for VectorArray, the SIMD vectors, the batch VectorN functions,
+// KdTree, the broad phases, Bvh and the point queries.
+
+#include "Tests.hpp"
+#include "../IntegerTypedefs.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+import Box;
+import BroadPhase;
+import Bvh;
+import Circle;
+import FixedMatrix;
+import KdTree;
+import PointQueries;
+import Rect;
+import SimdVector;
+import Sphere;
+import Square;
+import Vector2;
+import Vector3;
+import VectorArray;
+import VectorN;
+
+namespace jlib::tests
+{
+	static std::mt19937 geometry_rng(4);
+
+	static float random_float(float min, float max)
+	{
+		return std::uniform_real_distribution<float>(min, max)(geometry_rng);
+	}
+
+	static bool near(float a, float b)
+	{
+		return std::abs(a - b) <= 1e-4f * (1.0f + std::abs(a) + std::abs(b));
+	}
+
+	static void test_vector_arrays()
+	{
+		for (std::size_t n : { 0, 1, 3, 4, 7, 33, 1001 })
+		{
+			Vector3Array<float> A;
+			Vector3Array<float> B;
+			std::vector<Vector3<float>> a;
+			std::vector<Vector3<float>> b;
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				Vector3<float> p(random_float(-10.0f, 10.0f), random_float(-10.0f, 10.0f), random_float(-10.0f, 10.0f));
+				Vector3<float> q(random_float(-10.0f, 10.0f), random_float(-10.0f, 10.0f), random_float(-10.0f, 10.0f));
+				A.push_back(p);
+				B.push_back(q);
+				a.push_back(p);
+				b.push_back(q);
+			}
+
+			std::vector<float> out(n);
+			dot_product(A, B, std::span<float>(out));
+			for (std::size_t i = 0; i < n; ++i)
+				JLIB_CHECK(near(out[i], dot_product(a[i], b[i])));
+
+			magnitude(A, std::span<float>(out));
+			for (std::size_t i = 0; i < n; ++i)
+				JLIB_CHECK(near(out[i], magnitude(a[i])));
+
+			Vector3Array<float> C;
+			cross_product(A, B, C);
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				const Vector3<float> expected = cross_product(a[i], b[i]);
+				const Vector3<float> actual = C[i];
+				JLIB_CHECK(near(actual.x, expected.x) && near(actual.y, expected.y) && near(actual.z, expected.z));
+			}
+
+			normalize(C);
+			for (std::size_t i = 0; i < n; ++i)
+				JLIB_CHECK(near(magnitude(static_cast<Vector3<float>>(C[i])), 1.0f));
+
+			// The spans are not deduced, so a std::vector converts to one.
+			distance_squared(A, B, out);
+			for (std::size_t i = 0; i < n; ++i)
+				JLIB_CHECK(near(out[i], distance_squared(a[i], b[i])));
+
+			Vector2Array<float> A2;
+			Vector2Array<float> B2;
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				A2.push_back(Vector2<float>(a[i].x, a[i].y));
+				B2.push_back(Vector2<float>(b[i].x, b[i].y));
+			}
+
+			dot_product(A2, B2, out);
+			for (std::size_t i = 0; i < n; ++i)
+				JLIB_CHECK(near(out[i], (a[i].x * b[i].x) + (a[i].y * b[i].y)));
+
+			cross_product(A2, B2, out);
+			for (std::size_t i = 0; i < n; ++i)
+				JLIB_CHECK(near(out[i], (a[i].x * b[i].y) - (a[i].y * b[i].x)));
+
+			distance_squared(A2, B2, out);
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				const float dx = a[i].x - b[i].x;
+				const float dy = a[i].y - b[i].y;
+				JLIB_CHECK(near(out[i], (dx * dx) + (dy * dy)));
+			}
+
+			magnitude(A2, out);
+			for (std::size_t i = 0; i < n; ++i)
+				JLIB_CHECK(near(out[i], std::sqrt((a[i].x * a[i].x) + (a[i].y * a[i].y))));
+
+			normalize(A2);
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				const Vector2<float> v = A2[i];
+				JLIB_CHECK(near(std::sqrt((v.x * v.x) + (v.y * v.y)), 1.0f));
+				JLIB_CHECK(near(v.x * a[i].y, v.y * a[i].x));
+			}
+
+			// An affine matrix, where points are translated and directions are not,
+			// and a projective one, where points are divided by w.
+			const FixedMatrix<float, 4, 4> affine{ { 0.5f, -1.0f, 0.0f, 3.0f }, { 1.0f, 0.5f, 0.25f, -2.0f },
+												   { 0.0f, 2.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 0.0f, 1.0f } };
+			const FixedMatrix<float, 4, 4> projective{ { 1.0f, 0.0f, 0.5f, 1.0f }, { 0.0f, 2.0f, 0.0f, -1.0f },
+													   { 0.25f, 0.0f, 1.0f, 0.0f }, { 0.01f, 0.02f, -0.01f, 2.0f } };
+
+			for (const FixedMatrix<float, 4, 4>* M : { &affine, &projective })
+			{
+				Vector3Array<float> points = A;
+				Vector3Array<float> directions = A;
+				transform_points(points, *M);
+				transform_directions(directions, *M);
+
+				bool ok = true;
+				for (std::size_t i = 0; i < n; ++i)
+				{
+					float p[4];
+					float d[4];
+					for (std::size_t r = 0; r < 4; ++r)
+					{
+						d[r] = ((*M)(r, 0) * a[i].x) + ((*M)(r, 1) * a[i].y) + ((*M)(r, 2) * a[i].z);
+						p[r] = d[r] + (*M)(r, 3);
+					}
+
+					const Vector3<float> point = points[i];
+					const Vector3<float> direction = directions[i];
+					ok &= near(point.x, p[0] / p[3]) && near(point.y, p[1] / p[3]) && near(point.z, p[2] / p[3]);
+					ok &= near(direction.x, d[0]) && near(direction.y, d[1]) && near(direction.z, d[2]);
+				}
+				JLIB_CHECK(ok);
+			}
+		}
+
+		Vector3Array<int> ints(3);
+		std::vector<int> out(2);
+		JLIB_CHECK_THROWS(dot_product(ints, ints, std::span<int>(out)), std::invalid_argument);
+
+		Vector2Array<float> floats(3);
+		std::vector<float> too_long(4);
+		JLIB_CHECK_THROWS(cross_product(floats, floats, too_long), std::invalid_argument);
+		JLIB_CHECK_THROWS(magnitude(floats, too_long), std::invalid_argument);
+	}
+
+	static void test_simd_vectors()
+	{
+		for (int i = 0; i < 1000; ++i)
+		{
+			Vector3<float> a(random_float(-5.0f, 5.0f), random_float(-5.0f, 5.0f), random_float(-5.0f, 5.0f));
+			Vector3<float> b(random_float(-5.0f, 5.0f), random_float(-5.0f, 5.0f), random_float(-5.0f, 5.0f));
+			Vec3f A(a);
+			Vec3f B(b);
+
+			JLIB_CHECK(near(dot_product(A, B), dot_product(a, b)));
+			JLIB_CHECK(near(magnitude(A), magnitude(a)) && near(distance(A, B), distance(a, b)));
+
+			const Vector3<float> c = cross_product(a, b);
+			const Vector3<float> C = static_cast<Vector3<float>>(cross_product(A, B));
+			JLIB_CHECK(near(c.x, C.x) && near(c.y, C.y) && near(c.z, C.z));
+
+			JLIB_CHECK(near(unit_vector(A).magnitude(), 1.0f));
+			JLIB_CHECK(near(dot_product(A - vector_proj(A, B), B) / 10.0f, 0.0f));
+
+			Vec3f S = (A + B) * 2.0f - B / 0.5f;
+			JLIB_CHECK(near(S.x(), 2.0f * a.x) && near(S.z(), 2.0f * a.z));
+
+			Vec4f V(A, 1.0f);
+			JLIB_CHECK(V.w() == 1.0f && V.xyz() == A);
+			JLIB_CHECK(-A + A == Vec3f());
+		}
+
+		// The w lane stays 0 after a scale by infinity, so it does not leak into a Vec4f.
+		const float infinity = std::numeric_limits<float>::infinity();
+		Vec3f I(Vector3<float>(1.0f, 0.0f, -1.0f));
+		I *= infinity;
+		JLIB_CHECK(Vec4f(I, 1.0f).w() == 1.0f && Vec4f(I * infinity, 1.0f).w() == 1.0f);
+
+		float f[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+		Vec4f q = Vec4f::load(f);
+		q *= 2.0f;
+		q.store(f);
+		JLIB_CHECK(f[3] == 8.0f);
+	}
+
+	static void test_vector_n()
+	{
+		std::vector<VectorN<double, 64>> points(100);
+		std::uniform_real_distribution<double> dist(0.0, 1.0);
+		for (auto& p : points)
+			for (double& c : p)
+				c = dist(geometry_rng);
+
+		VectorN<double, 64> query;
+		for (double& c : query)
+			c = dist(geometry_rng);
+
+		std::vector<double> out(100);
+		distance_squared(points, query, std::span<double>(out));
+		std::size_t best = 0;
+		for (std::size_t i = 0; i < 100; ++i)
+		{
+			JLIB_CHECK(out[i] == distance_squared(points[i], query));
+			if (out[i] < out[best])
+				best = i;
+		}
+		JLIB_CHECK(nearest(points, query) == best);
+
+		dot_product(points, query, std::span<double>(out));
+		JLIB_CHECK(out[7] == dot_product(points[7], query));
+
+		magnitude<double, 64>(points, std::span<double>(out));
+		JLIB_CHECK(out[3] == magnitude(points[3]));
+
+		std::vector<double> small(3);
+		JLIB_CHECK_THROWS(dot_product(points, query, std::span<double>(small)), std::invalid_argument);
+
+		VectorN<u8, 3> x{ 200, 10, 0 };
+		VectorN<u8, 3> y{ 10, 200, 255 };
+		JLIB_CHECK(distance_squared(x, y) == 190ull * 190 * 2 + 255 * 255);
+		JLIB_CHECK(dot_product(x, y) == 4000ull);
+	}
+
+	static void test_kd_tree()
+	{
+		std::vector<VectorN<float, 3>> points(2000);
+		for (auto& p : points)
+			for (float& c : p)
+				c = random_float(-10.0f, 10.0f);
+
+		KdTree<float, 3> tree(points, 8);
+		JLIB_CHECK(tree.size() == points.size());
+
+		for (int i = 0; i < 50; ++i)
+		{
+			VectorN<float, 3> q;
+			for (float& c : q)
+				c = random_float(-10.0f, 10.0f);
+
+			std::vector<float> d(points.size());
+			for (std::size_t j = 0; j < points.size(); ++j)
+				d[j] = distance_squared(points[j], q);
+			std::vector<float> sorted = d;
+			std::sort(sorted.begin(), sorted.end());
+
+			auto neighbors = tree.nearest(q, 7);
+			JLIB_CHECK(neighbors.size() == 7);
+			for (std::size_t j = 0; j < neighbors.size(); ++j)
+				JLIB_CHECK(neighbors[j].distanceSquared == sorted[j] && d[neighbors[j].index] == sorted[j]);
+
+			auto within = tree.withinRadius(q, 6.0f);
+			JLIB_CHECK(within.size() == static_cast<std::size_t>(std::count_if(d.begin(), d.end(), [](float x) { return x <= 36.0f; })));
+		}
+
+		std::vector<Vector3<float>> line;
+		for (int i = 0; i < 100; ++i)
+			line.emplace_back(static_cast<float>(i), 0.0f, 0.0f);
+		KdTree<float, 3> line_tree(line);
+		JLIB_CHECK(line_tree.nearest(Vector3<float>(41.2f, 0.0f, 0.0f)).index == 41);
+		JLIB_CHECK_THROWS(line_tree.setEpsilon(-1.0f), std::invalid_argument);
+	}
+
+	// Returns the pairs of overlapping boxes by testing all of them.
+	template <std::size_t D>
+	static std::set<std::pair<std::size_t, std::size_t>> brute_force_pairs(const std::vector<BoundingBox<float, D>>& boxes, const std::vector<bool>& alive)
+	{
+		std::set<std::pair<std::size_t, std::size_t>> pairs;
+		for (std::size_t i = 0; i < boxes.size(); ++i)
+			if (alive[i])
+				for (std::size_t j = i + 1; j < boxes.size(); ++j)
+					if (alive[j] && overlaps(boxes[i], boxes[j]))
+						pairs.insert({ i, j });
+		return pairs;
+	}
+
+	template <std::size_t D, typename BroadPhase>
+	static void test_broad_phase(BroadPhase& system, std::size_t n, float world)
+	{
+		std::vector<BoundingBox<float, D>> boxes(n);
+		std::vector<bool> alive(n, true);
+		std::vector<std::size_t> dead;
+
+		auto random_box = [&]
+		{
+			BoundingBox<float, D> box;
+			for (std::size_t k = 0; k < D; ++k)
+			{
+				box.min[k] = random_float(-world / 2.0f, world / 2.0f);
+				box.max[k] = box.min[k] + random_float(0.1f, 3.0f);
+			}
+			return box;
+		};
+
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			boxes[i] = random_box();
+			JLIB_CHECK(system.insert(boxes[i]) == i);
+		}
+
+		for (int frame = 0; frame < 12; ++frame)
+		{
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				if (alive[i] && geometry_rng() % 3 == 0)
+				{
+					for (std::size_t k = 0; k < D; ++k)
+					{
+						const float step = random_float(-0.5f, 0.5f) * (frame == 5 ? 50.0f : 1.0f);
+						boxes[i].min[k] += step;
+						boxes[i].max[k] += step;
+					}
+					system.update(i, boxes[i]);
+				}
+			}
+
+			if (frame % 4 == 1)
+			{
+				for (int k = 0; k < 5; ++k)
+				{
+					const std::size_t i = geometry_rng() % n;
+					if (alive[i])
+					{
+						system.erase(i);
+						alive[i] = false;
+						dead.push_back(i);
+					}
+				}
+			}
+			else if (frame % 4 == 3)
+			{
+				// Erased ids are handed out again.
+				while (!dead.empty())
+				{
+					const std::size_t i = dead.back();
+					dead.pop_back();
+					boxes[i] = random_box();
+					JLIB_CHECK(system.insert(boxes[i]) == i);
+					alive[i] = true;
+				}
+			}
+
+			const auto pairs = system.findPairs();
+			const std::set<std::pair<std::size_t, std::size_t>> unique(pairs.begin(), pairs.end());
+			JLIB_CHECK(unique.size() == pairs.size());
+			JLIB_CHECK(unique == brute_force_pairs<D>(boxes, alive));
+		}
+	}
+
+	static void test_broad_phases()
+	{
+		SweepAndPrune<float, 2> sap2;
+		test_broad_phase<2>(sap2, 1000, 100.0f);
+		SweepAndPrune<float, 3> sap3;
+		test_broad_phase<3>(sap3, 1000, 40.0f);
+		SpatialHash<float, 2> hash2(2.0f);
+		test_broad_phase<2>(hash2, 1000, 100.0f);
+		SpatialHash<float, 3> hash3(1.5f);
+		test_broad_phase<3>(hash3, 1000, 40.0f);
+
+		// The shapes go through the same systems as their bounding boxes.
+		SweepAndPrune<float, 2> sap;
+		SpatialHash<float, 2> hash(4.0f);
+		const std::vector<Circle<float>> circles{ Circle<float>(0.0f, 0.0f, 1.0f), Circle<float>(1.5f, 0.0f, 1.0f), Circle<float>(10.0f, 10.0f, 1.0f) };
+		for (const auto& c : circles)
+		{
+			sap.insert(c);
+			hash.insert(c);
+		}
+		sap.insert(Rect<float>(0.5f, 0.5f, -3.0f, 2.0f));
+		hash.insert(Square<float>(0.5f, 0.5f, -3.0f));
+		JLIB_CHECK(sap.findPairs().size() == hash.findPairs().size());
+
+		Box<float> b1(0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f);
+		Box<float> b2(0.5f, 0.5f, 0.5f, 1.0f, 1.0f, 1.0f);
+		Box<float> b3(0.0f, 0.0f, 2.0f, 1.0f, 1.0f, -0.5f);
+		SpatialHash<float, 3> boxes(1.0f);
+		boxes.insert(b1);
+		boxes.insert(b2);
+		boxes.insert(b3);
+		JLIB_CHECK(boxes.findPairs().size() == 2);
+
+		JLIB_CHECK_THROWS(sap.erase(99), std::out_of_range);
+		JLIB_CHECK_THROWS((SpatialHash<float, 2>(0.0f)), std::invalid_argument);
+	}
+
+	// Moller-Trumbore ray and triangle intersection used as the reference.
+	static float ray_triangle(const Vector3<float>& o, const Vector3<float>& d, const Vector3<float>& a, const Vector3<float>& b, const Vector3<float>& c)
+	{
+		const float miss = std::numeric_limits<float>::infinity();
+		const Vector3<float> e1 = b - a;
+		const Vector3<float> e2 = c - a;
+		const Vector3<float> p = cross_product(d, e2);
+		const float det = dot_product(e1, p);
+		if (det == 0.0f)
+			return miss;
+
+		const float inv = 1.0f / det;
+		const Vector3<float> s = o - a;
+		const float u = dot_product(s, p) * inv;
+		if (u < 0.0f || u > 1.0f)
+			return miss;
+
+		const Vector3<float> q = cross_product(s, e1);
+		const float v = dot_product(d, q) * inv;
+		if (v < 0.0f || u + v > 1.0f)
+			return miss;
+
+		const float t = dot_product(e2, q) * inv;
+		return t >= 0.0f ? t : miss;
+	}
+
+	static void test_bvh()
+	{
+		const std::size_t n = 5000;
+		std::vector<Vector3<float>> vertices;
+		std::vector<u32> indices;
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			const Vector3<float> center(random_float(-100.0f, 100.0f), random_float(-100.0f, 100.0f), random_float(-100.0f, 100.0f));
+			for (u32 k = 0; k < 3; ++k)
+			{
+				vertices.push_back(center + Vector3<float>(random_float(-2.0f, 2.0f), random_float(-2.0f, 2.0f), random_float(-2.0f, 2.0f)));
+				indices.push_back(static_cast<u32>(3 * i + k));
+			}
+		}
+
+		Bvh<float> bvh(vertices, indices);
+		JLIB_CHECK(bvh.primitiveCount() == n);
+
+		for (int round = 0; round < 2; ++round)
+		{
+			for (int i = 0; i < 300; ++i)
+			{
+				const Vector3<float> o(random_float(-120.0f, 120.0f), random_float(-120.0f, 120.0f), random_float(-120.0f, 120.0f));
+				const Vector3<float> d(random_float(-1.0f, 1.0f), random_float(-1.0f, 1.0f), random_float(-1.0f, 1.0f));
+				const float max_distance = i % 3 == 0 ? 50.0f : std::numeric_limits<float>::infinity();
+
+				float best = std::numeric_limits<float>::infinity();
+				for (std::size_t t = 0; t < n; ++t)
+					best = std::min(best, ray_triangle(o, d, vertices[3 * t], vertices[3 * t + 1], vertices[3 * t + 2]));
+				const bool expected = best <= max_distance && best != std::numeric_limits<float>::infinity();
+
+				const auto hit = bvh.raycast(o, d, max_distance);
+				JLIB_CHECK((hit.primitive != n) == expected);
+				if (expected)
+					JLIB_CHECK(std::abs(hit.distance - best) <= 1e-3f * std::max(1.0f, best));
+				JLIB_CHECK(bvh.occluded(o, d, max_distance) == expected);
+			}
+
+			// Moving the vertices and refitting keeps the queries exact.
+			for (auto& v : vertices)
+				v += Vector3<float>(random_float(-5.0f, 5.0f), random_float(-5.0f, 5.0f), random_float(-5.0f, 5.0f));
+			bvh.refit(vertices);
+		}
+
+		std::vector<Box<float>> boxes;
+		for (int i = 0; i < 1000; ++i)
+			boxes.emplace_back(random_float(-100.0f, 100.0f), random_float(-100.0f, 100.0f), random_float(-100.0f, 100.0f), 1.0f, 1.0f, 1.0f);
+
+		Bvh<float> box_bvh(boxes);
+		const Box<float> query(-10.0f, -10.0f, -10.0f, 20.0f, 20.0f, 20.0f);
+		std::vector<std::size_t> found = box_bvh.overlapping(query);
+		std::sort(found.begin(), found.end());
+
+		std::vector<std::size_t> expected;
+		for (std::size_t i = 0; i < boxes.size(); ++i)
+			if (intersection(boxes[i], query))
+				expected.push_back(i);
+		JLIB_CHECK(found == expected);
+
+		std::vector<Vector3<float>> three(3);
+		std::vector<u32> bad{ 0, 1, 5 };
+		JLIB_CHECK_THROWS(Bvh<float>(three, bad), std::out_of_range);
+	}
+
+	template <typename T>
+	static void test_point_queries(std::size_t n)
+	{
+		auto value = [](double min, double max)
+		{
+			if constexpr (std::is_floating_point_v<T>)
+				return static_cast<T>(std::uniform_real_distribution<double>(min, max)(geometry_rng));
+			else
+				return static_cast<T>(std::uniform_int_distribution<long long>(static_cast<long long>(min), static_cast<long long>(max))(geometry_rng));
+		};
+
+		Vector2Array<T> points2;
+		Vector3Array<T> points3;
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			points2.push_back(Vector2<T>(value(-100, 100), value(-100, 100)));
+			points3.push_back(Vector3<T>(value(-100, 100), value(-100, 100), value(-100, 100)));
+		}
+
+		for (int i = 0; i < 20; ++i)
+		{
+			Circle<T> circle;
+			circle.center = Vector2<T>(value(-50, 50), value(-50, 50));
+			circle.radius = value(-10, 60);
+
+			Rect<T> rect;
+			rect.vertex = Vector2<T>(value(-50, 50), value(-50, 50));
+			rect.length = value(-60, 60);
+			rect.height = value(-60, 60);
+
+			Sphere<T> sphere;
+			sphere.center = Vector3<T>(value(-50, 50), value(-50, 50), value(-50, 50));
+			sphere.radius = value(-60, 60);
+
+			// Bits past the last point are cleared.
+			std::vector<u64> mask(mask_size(n) + 1, ~u64(0));
+			contains(circle, points2, std::span<u64>(mask));
+			bool ok = n % 64 == 0 || (mask[n / 64] >> (n % 64)) == 0;
+			for (std::size_t p = 0; p < n; ++p)
+				ok &= ((mask[p / 64] >> (p % 64)) & 1) == circle.contains(points2[p]);
+			JLIB_CHECK(ok);
+
+			std::vector<std::size_t> expected;
+			for (std::size_t p = 0; p < n; ++p)
+				if (rect.contains(points2[p]))
+					expected.push_back(p);
+			JLIB_CHECK(contained_points(rect, points2) == expected);
+
+			expected.clear();
+			for (std::size_t p = 0; p < n; ++p)
+				if (sphere.contains(points3[p]))
+					expected.push_back(p);
+			JLIB_CHECK(contained_points(sphere, points3) == expected);
+		}
+
+		std::vector<Circle<T>> circles(n);
+		for (auto& c : circles)
+		{
+			c.center = Vector2<T>(value(-100, 100), value(-100, 100));
+			c.radius = value(-5, 30);
+		}
+
+		const Vector2<T> point(value(-100, 100), value(-100, 100));
+		std::vector<std::size_t> expected;
+		for (std::size_t i = 0; i < n; ++i)
+			if (circles[i].contains(point))
+				expected.push_back(i);
+		JLIB_CHECK(containing_shapes<T>(circles, point) == expected);
+	}
+
+	void test_geometry()
+	{
+		test_vector_arrays();
+		test_simd_vectors();
+		test_vector_n();
+		test_kd_tree();
+		test_broad_phases();
+		test_bvh();
+
+		for (std::size_t n : { 0, 1, 63, 64, 65, 1000, 70001 })
+		{
+			test_point_queries<float>(n);
+			test_point_queries<double>(n);
+			test_point_queries<int>(n);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,244 @@
+// JLibrary
+// GridTests.cpp
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Tests for FixedGrid and its layouts, ChunkedGrid and the stencils.
+
+#include "Tests.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+import ChunkedGrid;
+import FixedGrid;
+import FixedMatrix;
+import GridLayout;
+import Matrix;
+import MatrixView;
+import Stencil;
+
+namespace jlib::tests
+{
+	// Every cell has its own index in memory, and the index maps back to the cell.
+	template <typename Grid>
+	static void test_layout()
+	{
+		auto grid = std::make_unique<Grid>();
+		std::set<std::size_t> seen;
+		bool ok = true;
+
+		for (std::size_t z = 0; z < Grid::length(); ++z)
+		{
+			for (std::size_t y = 0; y < Grid::height(); ++y)
+			{
+				for (std::size_t x = 0; x < Grid::width(); ++x)
+				{
+					const std::size_t i = Grid::index(x, y, z);
+					const auto c = Grid::coordinates(i);
+					ok &= i < Grid::storageSize() && seen.insert(i).second;
+					ok &= c.x == x && c.y == y && c.z == z;
+					(*grid)(x, y, z) = static_cast<float>(x + 100 * y + 10000 * z);
+				}
+			}
+		}
+		JLIB_CHECK(ok);
+		JLIB_CHECK(grid->size() == Grid::storageSize());
+		JLIB_CHECK(static_cast<std::size_t>(std::distance(grid->begin(), grid->end())) == grid->size());
+		JLIB_CHECK(std::as_const(*grid).end() == grid->data() + grid->size());
+
+		std::size_t count = 0;
+		for (auto it = grid->neighbors(1, 1, 1, GridConnectivity::Face).begin(); it != grid->neighbors(1, 1, 1).end(); ++it)
+		{
+			const auto p = it.position();
+			JLIB_CHECK(*it == static_cast<float>(p.x + 100 * p.y + 10000 * p.z));
+			++count;
+		}
+		JLIB_CHECK(count == 6);
+
+		count = 0;
+		for ([[maybe_unused]] const float& v : std::as_const(*grid).neighbors(1, 1, 1, GridConnectivity::Edge))
+			++count;
+		JLIB_CHECK(count == 18);
+
+		count = 0;
+		for ([[maybe_unused]] float& v : grid->neighbors(0, 0, 0))
+			++count;
+		JLIB_CHECK(count == 7);
+	}
+
+	static void test_fixed_grid()
+	{
+		test_layout<FixedGrid<float, 3, 5, 7>>();
+		test_layout<FixedGrid<float, 3, 5, 7, MortonLayout>>();
+		test_layout<FixedGrid<float, 4, 37, 3, MortonLayout>>();
+		test_layout<FixedGrid<float, 3, 9, 17, BrickLayout<8>>>();
+		test_layout<FixedGrid<float, 16, 16, 16, BrickLayout<4>>>();
+
+		static_assert(FixedGrid<int, 8, 8, 8, MortonLayout>::storageSize() == 512);
+		static_assert(FixedGrid<float, 2, 1024, 2, MortonLayout>::storageSize() == 4096);
+		static_assert(FixedGrid<float, 16, 64, 32, MortonLayout>::storageSize() == 16 * 64 * 32);
+		static_assert(MortonLayout::encode(1, 1, 1) == 7);
+		static_assert(MortonLayout::encode(2, 0, 0) == 8);
+
+		FixedGrid<int, 2, 3, 4> grid(3);
+		JLIB_CHECK(grid(2, 3, 1) == 3 && grid.size() == 24);
+		JLIB_CHECK(std::count(grid.begin(), grid.end(), 3) == 24);
+
+		// The padding is part of the storage, so the fill value reaches it too.
+		FixedGrid<int, 3, 5, 7, MortonLayout> padded(2);
+		static_assert(FixedGrid<int, 3, 5, 7, MortonLayout>::storageSize() > 3 * 5 * 7);
+		JLIB_CHECK(std::count(padded.cbegin(), padded.cend(), 2) == static_cast<std::ptrdiff_t>(padded.size()));
+		JLIB_CHECK_THROWS(grid.at(3, 0, 0), std::out_of_range);
+	}
+
+	static void test_chunked_grid()
+	{
+		ChunkedGrid<int, 8> g(7);
+		JLIB_CHECK(g.get(-100, 5, 3) == 7 && g.chunkCount() == 0);
+
+		g(-1, -1, -1) = 3;
+		g.set(0, 0, 0, 4);
+		g.set(7, 7, 7, 5);
+		g.set(8, 0, 0, 6);
+		JLIB_CHECK(g.chunkCount() == 3);
+		JLIB_CHECK(g.get(-1, -1, -1) == 3 && g.get(0, 0, 0) == 4 && g.get(7, 7, 7) == 5);
+		JLIB_CHECK(g.get(8, 0, 0) == 6 && g.get(1, 0, 0) == 7);
+		JLIB_CHECK(g.isAllocated(-1, -1, -1) && (*g.findChunk(-1, -1, -1))(7, 7, 7) == 3);
+
+		std::size_t count = 0;
+		for ([[maybe_unused]] auto entry : g)
+			++count;
+		JLIB_CHECK(count == 3);
+
+		// A chunk that only holds the fill value is pruned.
+		g.set(8, 0, 0, 7);
+		JLIB_CHECK(g.prune() == 1 && g.chunkCount() == 2);
+
+		auto chunk = g.extract(0, 0, 0);
+		JLIB_CHECK(chunk && (*chunk)(0, 0, 0) == 4 && g.get(0, 0, 0) == 7);
+		g.insert(5, 5, 5, std::move(chunk));
+		JLIB_CHECK(g.get(40, 40, 40) == 4);
+		JLIB_CHECK(g.evict(5, 5, 5) && !g.evict(5, 5, 5));
+
+		ChunkedGrid<long, 16, MortonLayout> h([](std::int64_t x, std::int64_t y, std::int64_t z) { return x * 10000 + y * 100 + z; });
+		JLIB_CHECK(h.get(-3, 4, 5) == -30000 + 400 + 5);
+		h(-3, 4, 5) += 1;
+		JLIB_CHECK(h.get(-3, 4, 5) == -30000 + 400 + 6 && h.get(-4, 4, 5) == -40000 + 405);
+	}
+
+	// Reference convolution of a row-major w x h x l block.
+	static void reference_stencil(const double* src, double* dst, long w, long h, long l,
+								  const double* kernel, long kw, long kh, long kl, BorderMode border)
+	{
+		auto at = [&](long x, long y, long z)
+		{
+			long c[3] = { x, y, z };
+			const long n[3] = { w, h, l };
+			for (int i = 0; i < 3; ++i)
+			{
+				if (c[i] >= 0 && c[i] < n[i])
+					continue;
+				if (border == BorderMode::Zero)
+					return 0.0;
+				if (border == BorderMode::Clamp)
+					c[i] = c[i] < 0 ? 0 : n[i] - 1;
+				else
+					c[i] = ((c[i] % n[i]) + n[i]) % n[i];
+			}
+			return src[(c[2] * h + c[1]) * w + c[0]];
+		};
+
+		for (long z = 0; z < l; ++z)
+		{
+			for (long y = 0; y < h; ++y)
+			{
+				for (long x = 0; x < w; ++x)
+				{
+					double sum = 0.0;
+					for (long k = 0; k < kl; ++k)
+						for (long j = 0; j < kh; ++j)
+							for (long i = 0; i < kw; ++i)
+								sum += kernel[(k * kh + j) * kw + i] * at(x + i - kw / 2, y + j - kh / 2, z + k - kl / 2);
+					dst[(z * h + y) * w + x] = sum;
+				}
+			}
+		}
+	}
+
+	static double max_difference(std::span<const double> A, std::span<const double> B)
+	{
+		double d = 0.0;
+		for (std::size_t i = 0; i < A.size(); ++i)
+			d = std::max(d, std::abs(A[i] - B[i]));
+		return d;
+	}
+
+	static void test_stencils()
+	{
+		std::mt19937 rng(3);
+		std::uniform_real_distribution<double> dist(-1.0, 1.0);
+
+		for (BorderMode border : { BorderMode::Clamp, BorderMode::Wrap, BorderMode::Zero })
+		{
+			Matrix<double> A(37, 300);
+			Matrix<double> B(37, 300);
+			Matrix<double> K(5, 3);
+			for (double& x : A)
+				x = dist(rng);
+			for (double& x : K)
+				x = dist(rng);
+
+			std::vector<double> expected(A.size());
+			stencil<double>(A.view(), B.view(), std::as_const(K).view(), border);
+			reference_stencil(A.data(), expected.data(), 300, 37, 1, K.data(), 3, 5, 1, border);
+			JLIB_CHECK(max_difference(std::span<const double>(B.data(), B.size()), expected) < 1e-12);
+
+			// A separable kernel gives the same result through both paths.
+			const double row[5] = { 1.0, 2.0, 3.0, 2.0, 1.0 };
+			const double col[3] = { 1.0, -2.0, 1.0 };
+			Matrix<double> S(3, 5);
+			for (std::size_t i = 0; i < 3; ++i)
+				for (std::size_t j = 0; j < 5; ++j)
+					S(i, j) = col[i] * row[j];
+
+			Matrix<double> C(37, 300);
+			stencil_separable<double>(A.view(), B.view(), std::span<const double>(row), std::span<const double>(col), border);
+			stencil<double>(A.view(), C.view(), std::as_const(S).view(), border);
+			JLIB_CHECK(max_difference(std::span<const double>(B.data(), B.size()), std::span<const double>(C.data(), C.size())) < 1e-12);
+
+			auto src = std::make_unique<FixedGrid<double, 9, 20, 13>>();
+			auto dst = std::make_unique<FixedGrid<double, 9, 20, 13>>();
+			for (std::size_t i = 0; i < src->size(); ++i)
+				(*src)[i] = dist(rng);
+
+			FixedGrid<double, 3, 3, 3> kernel;
+			for (std::size_t i = 0; i < kernel.size(); ++i)
+				kernel[i] = dist(rng);
+
+			std::vector<double> grid_expected(src->size());
+			stencil(*src, *dst, kernel, border);
+			reference_stencil(src->data(), grid_expected.data(), 20, 13, 9, kernel.data(), 3, 3, 3, border);
+			JLIB_CHECK(max_difference(std::span<const double>(dst->data(), dst->size()), grid_expected) < 1e-12);
+		}
+
+		Matrix<double> A(50, 70, 1.0);
+		Matrix<double> K(3, 3, 1.0);
+		JLIB_CHECK_THROWS(stencil<double>(A.view(), A.view(), std::as_const(K).view()), std::invalid_argument);
+	}
+
+	void test_grids()
+	{
+		test_fixed_grid();
+		test_chunked_grid();
+		test_stencils();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,571 @@
+// JLibrary
+// MatrixTests.cpp
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Tests for Matrix and FixedMatrix, their expressions, views,
+// decompositions, gemm and SparseMatrix.
+
+#include "Tests.hpp"
+#include "../Gemm.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+import Array;
+import FixedMatrix;
+import Matrix;
+import MatrixDecomposition;
+import MatrixView;
+import SparseMatrix;
+import VectorN;
+
+namespace jlib::tests
+{
+	static std::mt19937 matrix_rng(5);
+
+	static Matrix<double> random_matrix(std::size_t rows, std::size_t cols)
+	{
+		std::uniform_real_distribution<double> dist(-1.0, 1.0);
+		Matrix<double> M(rows, cols);
+		for (double& x : M)
+			x = dist(matrix_rng);
+		return M;
+	}
+
+	// Reference product with the textbook triple loop.
+	static Matrix<double> naive_product(const Matrix<double>& A, const Matrix<double>& B)
+	{
+		Matrix<double> C(A.rowCount(), B.colCount(), 0.0);
+		for (std::size_t i = 0; i < A.rowCount(); ++i)
+			for (std::size_t k = 0; k < A.colCount(); ++k)
+				for (std::size_t j = 0; j < B.colCount(); ++j)
+					C(i, j) += A(i, k) * B(k, j);
+		return C;
+	}
+
+	static double max_difference(const Matrix<double>& A, const Matrix<double>& B)
+	{
+		if (A.rowCount() != B.rowCount() || A.colCount() != B.colCount())
+			return INFINITY;
+
+		double d = 0.0;
+		for (std::size_t i = 0; i < A.size(); ++i)
+			d = std::max(d, std::abs(A[i] - B[i]));
+		return d;
+	}
+
+	static Matrix<double> identity(std::size_t n)
+	{
+		Matrix<double> I(n, n, 0.0);
+		for (std::size_t i = 0; i < n; ++i)
+			I(i, i) = 1.0;
+		return I;
+	}
+
+	template <typename T, std::size_t R, std::size_t C>
+	static FixedMatrix<T, R, C> random_fixed_matrix()
+	{
+		std::uniform_int_distribution<int> dist(-8, 8);
+		FixedMatrix<T, R, C> M;
+		for (std::size_t i = 0; i < R * C; ++i)
+			M[i] = static_cast<T>(dist(matrix_rng)) / T(4);
+		return M;
+	}
+
+	// Reference product of FixedMatrices with the textbook triple loop.
+	template <typename T, std::size_t R, std::size_t C, std::size_t S>
+	static FixedMatrix<T, R, S> naive_product(const FixedMatrix<T, R, C>& A, const FixedMatrix<T, C, S>& B)
+	{
+		FixedMatrix<T, R, S> M(T(0));
+		for (std::size_t i = 0; i < R; ++i)
+			for (std::size_t k = 0; k < C; ++k)
+				for (std::size_t j = 0; j < S; ++j)
+					M(i, j) += A(i, k) * B(k, j);
+		return M;
+	}
+
+	template <typename T, std::size_t R, std::size_t C>
+	static double max_difference(const FixedMatrix<T, R, C>& A, const FixedMatrix<T, R, C>& B)
+	{
+		double d = 0.0;
+		for (std::size_t i = 0; i < R * C; ++i)
+			d = std::max(d, std::abs(static_cast<double>(A[i]) - static_cast<double>(B[i])));
+		return d;
+	}
+
+	// Checks dot_product, operator *, transform and transpose for one shape.
+	template <typename T, std::size_t R, std::size_t C, std::size_t S>
+	static void check_fixed_kernels()
+	{
+		FixedMatrix<T, R, C> A = random_fixed_matrix<T, R, C>();
+		FixedMatrix<T, C, S> B = random_fixed_matrix<T, C, S>();
+
+		// The elements are multiples of 1/4, so every product and sum is exact.
+		JLIB_CHECK(max_difference(dot_product(A, B), naive_product(A, B)) == 0.0);
+		JLIB_CHECK(max_difference(A * B, naive_product(A, B)) == 0.0);
+
+		VectorN<T, C> v;
+		for (std::size_t c = 0; c < C; ++c)
+			v[c] = static_cast<T>(c) - T(1.5);
+
+		VectorN<T, R> w = A * v;
+		bool same = true;
+		for (std::size_t r = 0; r < R; ++r)
+		{
+			T value = 0;
+			for (std::size_t c = 0; c < C; ++c)
+				value += A(r, c) * v[c];
+			same &= w[r] == value;
+		}
+		JLIB_CHECK(same);
+
+		FixedMatrix<T, C, R> At = transpose(A);
+		same = true;
+		for (std::size_t r = 0; r < R; ++r)
+			for (std::size_t c = 0; c < C; ++c)
+				same &= At(c, r) == A(r, c);
+		JLIB_CHECK(same);
+	}
+
+	static void test_matrix_storage()
+	{
+		Matrix<int> M;
+		std::vector<std::vector<int>> ref;
+		std::size_t rows = 0;
+		std::size_t cols = 0;
+		std::mt19937 rng(7);
+
+		// Resizing keeps the overlapping elements and reuses the storage when it fits.
+		for (int i = 0; i < 500; ++i)
+		{
+			std::size_t r = rng() % 12;
+			std::size_t c = rng() % 12;
+			if (rng() % 7 == 0)
+				M.reserve(rng() % 15, rng() % 15);
+
+			const int* before = M.data();
+			std::size_t capacity = M.capacity();
+			M.resize(r, c);
+			if (r * c != 0 && r * c <= capacity)
+				JLIB_CHECK(M.data() == before);
+
+			if (r * c == 0)
+				r = c = 0;
+
+			std::vector<std::vector<int>> next(r, std::vector<int>(c, 0));
+			for (std::size_t y = 0; y < std::min(r, rows); ++y)
+				for (std::size_t x = 0; x < std::min(c, cols); ++x)
+					next[y][x] = ref[y][x];
+
+			rows = r;
+			cols = c;
+			ref = next;
+			JLIB_CHECK(M.rowCount() == rows && M.colCount() == cols && M.size() == rows * cols);
+
+			for (std::size_t y = 0; y < rows; ++y)
+			{
+				for (std::size_t x = 0; x < cols; ++x)
+				{
+					JLIB_CHECK(M(y, x) == ref[y][x]);
+					M(y, x) = ref[y][x] = static_cast<int>(rng() % 1000);
+				}
+			}
+		}
+
+		Matrix<std::string> S(3, 5);
+		for (std::size_t i = 0; i < S.size(); ++i)
+			S[i] = std::to_string(i);
+		S.resize(2, 2);
+		JLIB_CHECK(S(1, 1) == "6");
+	}
+
+	static void test_fixed_matrix()
+	{
+		// The float 4x4 case uses the SSE kernels, and 9x9 is past the unroll limit.
+		check_fixed_kernels<float, 4, 4, 4>();
+		check_fixed_kernels<double, 4, 4, 4>();
+		check_fixed_kernels<float, 2, 3, 5>();
+		check_fixed_kernels<int, 5, 2, 3>();
+		check_fixed_kernels<float, 1, 1, 1>();
+		check_fixed_kernels<double, 1, 7, 1>();
+		check_fixed_kernels<double, 7, 1, 7>();
+		check_fixed_kernels<float, 8, 8, 8>();
+		check_fixed_kernels<double, 9, 9, 9>();
+
+		constexpr FixedMatrix<float, 4, 4> P{ { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 }, { 1, 0, 0, 0 } };
+		static_assert(dot_product(P, P)(0, 2) == 1.0f && transpose(P)(0, 3) == 1.0f);
+
+		FixedMatrix<int, 3, 5> M;
+		for (std::size_t i = 0; i < 15; ++i)
+			M[i] = static_cast<int>(i);
+
+		JLIB_CHECK((M.getRow(2) == std::array<int, 5>{ 10, 11, 12, 13, 14 }));
+		JLIB_CHECK((M.getCol(0) == std::array<int, 3>{ 0, 5, 10 }));
+		JLIB_CHECK((M.getCol(4) == std::array<int, 3>{ 4, 9, 14 }));
+		JLIB_CHECK_THROWS(M.getRow(3), std::out_of_range);
+		JLIB_CHECK_THROWS(M.getCol(5), std::out_of_range);
+
+		FixedMatrix<int, 2, 3> sub = M.submatrix<2, 3>(1, 2);
+		JLIB_CHECK(sub(0, 0) == 7 && sub(0, 2) == 9 && sub(1, 0) == 12 && sub(1, 2) == 14);
+		JLIB_CHECK((M.submatrix<1, 1>(2, 4)(0, 0) == 14));
+		JLIB_CHECK((M.submatrix<3, 5>(0, 0) == M));
+		JLIB_CHECK_THROWS((M.submatrix<2, 2>(2, 0)), std::out_of_range);
+		JLIB_CHECK_THROWS((M.submatrix<1, 2>(0, 4)), std::out_of_range);
+	}
+
+	static void test_matrix_expressions()
+	{
+		Matrix<double> X(200, 300, 1.0);
+		Matrix<double> Y(200, 300, 2.0);
+		Matrix<double> Z(200, 300, 3.0);
+
+		Matrix<double> W = X + Y * 2.0 - Z / 3.0;
+		JLIB_CHECK(W.rowCount() == 200 && W(199, 299) == 4.0);
+
+		// Assigning an expression of the same shape reuses the storage.
+		const double* storage = W.data();
+		W = W * 2.0 - X;
+		JLIB_CHECK(W.data() == storage && W(0, 0) == 7.0);
+
+		W += X;
+		W -= Y;
+		W *= 2.0;
+		W /= 4.0;
+		JLIB_CHECK(W(5, 5) == 3.0);
+
+		Matrix<double> V;
+		V = -X;
+		JLIB_CHECK(V(1, 1) == -1.0 && V.colCount() == 300);
+
+		// Assigning an expression of another shape replaces the elements.
+		V = Matrix<double>(3, 4, 1.0) * 2.0;
+		JLIB_CHECK(V.rowCount() == 3 && V.colCount() == 4 && V.size() == 12 && V(2, 3) == 2.0);
+
+		// Assigning an empty expression empties the Matrix.
+		Matrix<double> E;
+		V = E + E;
+		JLIB_CHECK(V.rowCount() == 0 && V.colCount() == 0 && V.size() == 0);
+		Matrix<double> F(E - E);
+		JLIB_CHECK(F.size() == 0);
+
+		JLIB_CHECK_THROWS(Matrix<double> Q = X + Matrix<double>(2, 2), std::invalid_argument);
+
+		Matrix<int> a{ { 1, 2 }, { 3, 4 } };
+		Matrix<int> b{ { 5, 6 }, { 7, 8 } };
+		Matrix<int> c = a * b;
+		JLIB_CHECK(c(0, 0) == 19 && c(0, 1) == 22 && c(1, 0) == 43 && c(1, 1) == 50);
+		JLIB_CHECK_THROWS(a * Matrix<int>(3, 2), std::invalid_argument);
+	}
+
+	static void test_fixed_matrix_expressions()
+	{
+		using Matrix3 = FixedMatrix<double, 3, 3>;
+		const Matrix3 A = random_fixed_matrix<double, 3, 3>();
+		const Matrix3 B = random_fixed_matrix<double, 3, 3>();
+		const Matrix3 C = random_fixed_matrix<double, 3, 3>();
+
+		// The elements are multiples of 1/4, so every result below is exact.
+		Matrix3 D = A + B * 2.0 - C / 4.0;
+		Matrix3 E = -A + 0.5 * B;
+		bool same = true;
+		for (std::size_t i = 0; i < 9; ++i)
+			same &= D[i] == A[i] + (B[i] * 2.0) - (C[i] / 4.0) && E[i] == -A[i] + (0.5 * B[i]);
+		JLIB_CHECK(same);
+
+		// The product is evaluated into a temporary before the sum,
+		// so X can be on both sides.
+		Matrix3 expected = naive_product(A, B);
+		for (std::size_t i = 0; i < 9; ++i)
+			expected[i] += A[i];
+
+		Matrix3 X = A;
+		X = X * B + X;
+		JLIB_CHECK(X == expected);
+
+		// Element n of an element-wise expression only reads element n of its operands.
+		X = A;
+		X = X * 3.0 - X / 2.0 + X;
+		JLIB_CHECK(X == Matrix3(A * 3.5));
+
+		X = A;
+		X += X * 2.0;
+		JLIB_CHECK(X == Matrix3(A * 3.0));
+		X -= B + X;
+		JLIB_CHECK(X == Matrix3(-B));
+		X *= 2;
+		X /= 4;
+		JLIB_CHECK(X == Matrix3(B * -0.5));
+
+		// FixedMatrix and Matrix operands mix, with the dimensions checked at runtime.
+		Matrix<double> M(3, 3, 1.0);
+		Matrix3 F = A + M;
+		Matrix<double> G = A - M;
+		JLIB_CHECK(F(2, 2) == A(2, 2) + 1.0 && G.rowCount() == 3 && G(0, 1) == A(0, 1) - 1.0);
+		JLIB_CHECK_THROWS(F = A + Matrix<double>(3, 2), std::invalid_argument);
+		JLIB_CHECK_THROWS(F += Matrix<double>(2, 3), std::invalid_argument);
+
+		constexpr FixedMatrix<int, 2, 2> I{ { 1, 0 }, { 0, 1 } };
+		static_assert(FixedMatrix<int, 2, 2>(I * 3 - I)(1, 1) == 2);
+	}
+
+	static void test_gemm()
+	{
+		std::mt19937 rng(3);
+		for (int i = 0; i < 20; ++i)
+		{
+			std::size_t m = 1 + rng() % 130;
+			std::size_t n = 1 + rng() % 140;
+			std::size_t k = 1 + rng() % 300;
+
+			Matrix<double> A = random_matrix(m, k);
+			Matrix<double> B = random_matrix(k, n);
+			Matrix<double> C = random_matrix(m, n);
+			Matrix<double> expected = naive_product(A, B) * 1.5 + C * 0.5;
+
+			gemm(1.5, A, B, 0.5, C, i % 2 == 0);
+			JLIB_CHECK(max_difference(C, expected) < 1e-10 * k);
+
+			Matrix<float> Af(m, k, 1.0f);
+			Matrix<float> Bf(k, n, 2.0f);
+			Matrix<float> Cf(m, n);
+			gemm(1.0f, Af, Bf, 0.0f, Cf, i % 2 == 1);
+			JLIB_CHECK(Cf(m - 1, n - 1) == 2.0f * k);
+		}
+
+		// Large enough for the threaded path.
+		Matrix<double> A = random_matrix(200, 300);
+		Matrix<double> B = random_matrix(300, 2050);
+		Matrix<double> C(200, 2050);
+		gemm(1.0, A, B, 0.0, C, true);
+		JLIB_CHECK(max_difference(C, naive_product(A, B)) < 1e-9);
+	}
+
+	static void test_decompositions()
+	{
+		for (std::size_t n : { 1, 2, 3, 7, 33, 100 })
+		{
+			Matrix<double> A = random_matrix(n, n);
+			Matrix<double> B = random_matrix(n, 3);
+
+			LUDecomposition<double> lu(A);
+			JLIB_CHECK(max_difference(naive_product(A, lu.solve(B)), B) < 1e-8);
+			JLIB_CHECK(max_difference(naive_product(A, inverse(A)), identity(n)) < 1e-8);
+
+			Array<double> b(n);
+			for (double& x : b)
+				x = std::uniform_real_distribution<double>(-1.0, 1.0)(matrix_rng);
+			Array<double> x = solve(A, b);
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				double s = 0.0;
+				for (std::size_t j = 0; j < n; ++j)
+					s += A(i, j) * x[j];
+				JLIB_CHECK(std::abs(s - b[i]) < 1e-8);
+			}
+
+			Matrix<double> S = naive_product(A, transpose(A));
+			for (std::size_t i = 0; i < n; ++i)
+				S(i, i) += static_cast<double>(n);
+
+			CholeskyDecomposition<double> cholesky(S);
+			JLIB_CHECK(cholesky.isPositiveDefinite());
+			JLIB_CHECK(max_difference(naive_product(cholesky.lower(), transpose(cholesky.lower())), S) < 1e-8);
+			JLIB_CHECK(std::abs(cholesky.determinant() - determinant(S)) <= 1e-8 * std::abs(determinant(S)));
+
+			Matrix<double> tall = random_matrix(n + 5, n);
+			QRDecomposition<double> qr(tall);
+			JLIB_CHECK(max_difference(naive_product(qr.q(), qr.r()), tall) < 1e-8);
+			JLIB_CHECK(max_difference(naive_product(transpose(qr.q()), qr.q()), identity(n)) < 1e-8);
+		}
+
+		Matrix<double> singular{ { 1.0, 2.0 }, { 2.0, 4.0 } };
+		LUDecomposition<double> lu(singular);
+		JLIB_CHECK(lu.isSingular());
+		JLIB_CHECK_THROWS(lu.solve(Array<double>{ 1.0, 2.0 }), std::domain_error);
+
+		Matrix<double> indefinite{ { 1.0, 2.0 }, { 2.0, 1.0 } };
+		JLIB_CHECK(!CholeskyDecomposition<double>(indefinite).isPositiveDefinite());
+	}
+
+	// A random N x N FixedMatrix with a dominant diagonal, which keeps it well conditioned.
+	template <typename T, std::size_t N>
+	static FixedMatrix<T, N, N> random_invertible()
+	{
+		FixedMatrix<T, N, N> A = random_fixed_matrix<T, N, N>();
+		for (std::size_t i = 0; i < N; ++i)
+			A(i, i) += static_cast<T>(2 * N);
+		return A;
+	}
+
+	template <typename T, std::size_t N>
+	static void check_fixed_inverse(double tolerance)
+	{
+		for (int i = 0; i < 20; ++i)
+		{
+			FixedMatrix<T, N, N> A = random_invertible<T, N>();
+			FixedMatrix<T, N, N> I(T(0));
+			for (std::size_t j = 0; j < N; ++j)
+				I(j, j) = T(1);
+
+			JLIB_CHECK(max_difference(naive_product(A, inverse(A)), I) < tolerance);
+			JLIB_CHECK(max_difference(naive_product(inverse(A), A), I) < tolerance);
+
+			// The closed forms agree with LU on the same matrix.
+			Matrix<double> M(N, N);
+			for (std::size_t j = 0; j < N * N; ++j)
+				M[j] = static_cast<double>(A[j]);
+			JLIB_CHECK(std::abs(determinant(A) - determinant(M)) <= tolerance * std::abs(determinant(M)));
+
+			VectorN<T, N> b;
+			for (std::size_t j = 0; j < N; ++j)
+				b[j] = static_cast<T>(j) - T(1);
+
+			VectorN<T, N> x = solve(A, b);
+			VectorN<T, N> residual = A * x;
+			double largest = 0.0;
+			for (std::size_t j = 0; j < N; ++j)
+				largest = std::max(largest, std::abs(static_cast<double>(residual[j] - b[j])));
+			JLIB_CHECK(largest < tolerance);
+		}
+	}
+
+	static void test_fixed_matrix_inverse()
+	{
+		check_fixed_inverse<double, 2>(1e-12);
+		check_fixed_inverse<double, 3>(1e-12);
+		check_fixed_inverse<double, 4>(1e-12);
+		check_fixed_inverse<float, 4>(1e-5);
+
+		// Known determinants, the 4x4 one through _sub_determinants.
+		FixedMatrix<double, 2, 2> A2{ { 1.0, 2.0 }, { 3.0, 4.0 } };
+		FixedMatrix<double, 3, 3> A3{ { 6.0, 1.0, 1.0 }, { 4.0, -2.0, 5.0 }, { 2.0, 8.0, 7.0 } };
+		FixedMatrix<double, 4, 4> A4{ { 1.0, 0.0, 2.0, -1.0 }, { 3.0, 0.0, 0.0, 5.0 }, { 2.0, 1.0, 4.0, -3.0 }, { 1.0, 0.0, 5.0, 0.0 } };
+		JLIB_CHECK(determinant(A2) == -2.0 && determinant(A3) == -306.0 && determinant(A4) == 30.0);
+		static_assert(determinant(FixedMatrix<int, 4, 4>{ { 2, 0, 0, 0 }, { 0, 3, 0, 0 }, { 0, 0, 4, 0 }, { 0, 0, 0, 5 } }) == 120);
+
+		FixedMatrix<double, 2, 2> expected2{ { -2.0, 1.0 }, { 1.5, -0.5 } };
+		JLIB_CHECK(max_difference(inverse(A2), expected2) < 1e-15);
+
+		// Singular input: the determinant is 0, inverse is not finite and solve throws.
+		FixedMatrix<double, 4, 4> S = A4;
+		for (std::size_t c = 0; c < 4; ++c)
+			S(3, c) = S(0, c) + S(1, c);
+		JLIB_CHECK(determinant(S) == 0.0);
+		JLIB_CHECK(!std::isfinite(inverse(S)(0, 0)));
+		JLIB_CHECK(!std::isfinite(inverse(FixedMatrix<double, 3, 3>(1.0))(1, 1)));
+		JLIB_CHECK_THROWS(solve(S, VectorN<double, 4>(1.0)), std::domain_error);
+
+		// solve pivots, so a zero on the diagonal is fine.
+		FixedMatrix<double, 3, 3> P{ { 0.0, 2.0, 0.0 }, { 1.0, 0.0, 0.0 }, { 0.0, 0.0, 4.0 } };
+		VectorN<double, 3> x = solve(P, VectorN<double, 3>{ 4.0, 3.0, 8.0 });
+		JLIB_CHECK(x[0] == 3.0 && x[1] == 2.0 && x[2] == 2.0);
+	}
+
+	static void test_transpose()
+	{
+		for (std::size_t rows : { 1, 4, 5, 33, 130 })
+		{
+			for (std::size_t cols : { 1, 7, 32, 100 })
+			{
+				Matrix<int> A(rows, cols);
+				for (std::size_t i = 0; i < A.size(); ++i)
+					A[i] = static_cast<int>(i);
+
+				Matrix<int> T = transpose(A);
+				Matrix<int> P(A);
+				P.transposeInPlace();
+				JLIB_CHECK(T.rowCount() == cols && T.colCount() == rows && T == P);
+
+				bool same = true;
+				for (std::size_t r = 0; r < rows; ++r)
+					for (std::size_t c = 0; c < cols; ++c)
+						same &= T(c, r) == A(r, c);
+				JLIB_CHECK(same);
+			}
+		}
+
+		Matrix<double> A(6, 5);
+		for (std::size_t i = 0; i < A.size(); ++i)
+			A[i] = static_cast<double>(i);
+
+		MatrixView<double> sub = A.view().subview(1, 1, 4, 3);
+		JLIB_CHECK(sub(0, 0) == 6.0 && sub(3, 2) == 23.0 && !sub.isContiguous());
+
+		std::sort(A.colBegin(0), A.colEnd(0), std::greater<>());
+		JLIB_CHECK(A(0, 0) == 25.0 && A(5, 0) == 0.0);
+	}
+
+	static void test_sparse()
+	{
+		std::mt19937 rng(3);
+		const std::size_t rows = 57;
+		const std::size_t cols = 43;
+
+		Matrix<double> D(rows, cols, 0.0);
+		std::vector<SparseTriplet<double>> triplets;
+		for (int i = 0; i < 400; ++i)
+		{
+			std::size_t r = rng() % rows;
+			std::size_t c = rng() % cols;
+			double v = static_cast<double>(rng() % 100) / 7.0;
+			D(r, c) += v;
+			triplets.push_back({ r, c, v });
+		}
+
+		CsrMatrix<double> A(rows, cols, triplets.begin(), triplets.end());
+		CscMatrix<double> B(rows, cols, triplets.begin(), triplets.end());
+		JLIB_CHECK(max_difference(A.toDense(), D) < 1e-12);
+		JLIB_CHECK(max_difference(B.toDense(), D) < 1e-12);
+		JLIB_CHECK(max_difference(CsrMatrix<double>(D).toDense(), D) == 0.0);
+		JLIB_CHECK(max_difference(A.transpose().toDense(), transpose(D)) < 1e-12);
+
+		Array<double> x(cols);
+		for (double& v : x)
+			v = static_cast<double>(rng() % 10);
+
+		Array<double> y = A * x;
+		Array<double> z = B * x;
+		for (std::size_t i = 0; i < rows; ++i)
+		{
+			double s = 0.0;
+			for (std::size_t j = 0; j < cols; ++j)
+				s += D(i, j) * x[j];
+			JLIB_CHECK(std::abs(s - y[i]) < 1e-9 && std::abs(s - z[i]) < 1e-9);
+		}
+
+		JLIB_CHECK_THROWS(CsrMatrix<float>(2, 2, { { 2, 0, 1.0f } }), std::out_of_range);
+
+		// The parallel product matches the serial one.
+		const std::size_t n = 100000;
+		std::vector<SparseTriplet<double>> graph;
+		for (std::size_t i = 0; i < n; ++i)
+			for (int k = 0; k < 10; ++k)
+				graph.push_back({ i, rng() % n, 1.0 });
+
+		CsrMatrix<double> G(n, n, graph.begin(), graph.end());
+		Array<double> ones(n, 1.0);
+		Array<double> parallel(n);
+		Array<double> serial(n);
+		G.multiply(ones.data(), parallel.data(), true);
+		G.multiply(ones.data(), serial.data(), false);
+		JLIB_CHECK(parallel == serial);
+	}
+
+	void test_matrices()
+	{
+		test_matrix_storage();
+		test_fixed_matrix();
+		test_matrix_expressions();
+		test_fixed_matrix_expressions();
+		test_gemm();
+		test_decompositions();
+		test_fixed_matrix_inverse();
+		test_transpose();
+		test_sparse();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+// JLibrary
+// Tests.hpp
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Header file for the JLibrary tests and benchmarks.
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+namespace jlib::tests
+{
+	// Number of checks that have failed so far.
+	inline int failures = 0;
+
+	// Prints a failed check and counts it.
+	inline void report_failure(const char* expression, const char* file, int line)
+	{
+		std::printf("FAILED: %s (%s:%d)\n", expression, file, line);
+		++failures;
+	}
+
+	// Returns the number of milliseconds since the given time point.
+	inline double milliseconds_since(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	void test_containers();
+	void test_matrices();
+	void test_bit_matrices();
+	void test_grids();
+	void test_geometry();
+
+	void bench_array_growth();
+	void bench_frame_arena();
+	void bench_fixed_matrix_multiply();
+	void bench_simd_kernels();
+	void bench_gemm();
+	void bench_grid_layouts();
+	void bench_stencil();
+	void bench_simd_vectors();
+	void bench_broad_phase();
+}
+
+// Counts a failure if the expression is false.
+#define JLIB_CHECK(expression) \
+	((expression) ? (void)0 : jlib::tests::report_failure(#expression, __FILE__, __LINE__))
+
+// Counts a failure if the statement does not throw the given exception type.
+#define JLIB_CHECK_THROWS(statement, exception)                                          \
+	do                                                                                   \
+	{                                                                                    \
+		bool _thrown = false;                                                            \
+		try { statement; } catch (const exception&) { _thrown = true; }                  \
+		if (!_thrown)                                                                    \
+			jlib::tests::report_failure(#statement " throws " #exception, __FILE__, __LINE__); \
+	} while (false)
\ No newline at end of file
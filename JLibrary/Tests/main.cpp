@@ -0,0 +1,45 @@
+// JLibrary
+// main.cpp
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Runs the JLibrary tests, or the benchmarks when given "bench".
+// Benchmarks are only meaningful in a Release build.
+
+#include "Tests.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+int main(int argc, char** argv)
+{
+	using namespace jlib::tests;
+
+	if (argc > 1 && std::strcmp(argv[1], "bench") == 0)
+	{
+		bench_array_growth();
+		bench_frame_arena();
+		bench_fixed_matrix_multiply();
+		bench_simd_kernels();
+		bench_gemm();
+		bench_grid_layouts();
+		bench_stencil();
+		bench_simd_vectors();
+		bench_broad_phase();
+		return 0;
+	}
+
+	test_containers();
+	test_matrices();
+	test_bit_matrices();
+	test_grids();
+	test_geometry();
+
+	if (failures != 0)
+	{
+		std::printf("%d check(s) failed.\n", failures);
+		return 1;
+	}
+
+	std::puts("All tests passed.");
+	return 0;
+}
\ No newline at end of file
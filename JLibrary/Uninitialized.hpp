@@ -0,0 +1,23 @@
+// JLibrary
+// Uninitialized.hpp
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Header file for the uninitialized tag.
+
+#pragma once
+
+namespace jlib
+{
+	// Tag type used to select the constructors of containers
+	// that allocate memory without initializing it.
+	struct uninitialized_t
+	{
+		explicit uninitialized_t() = default;
+	};
+
+	// Passing this to a container constructor allocates its memory
+	// without initializing it. Trivial elements are left untouched, and
+	// class types are only default-constructed. The caller is expected
+	// to overwrite the contents before reading them.
+	inline constexpr uninitialized_t uninitialized{};
+}
\ No newline at end of file
@@ -0,0 +1,1187 @@
+// JLibrary
+// VectorArray.ixx
+// Created on 2026-10-17 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
+// Module file for the Vector2Array and Vector3Array template classes.
+
+module;
+
+#include "Arithmetic.hpp"
+#include "Simd.hpp"
+
+#include <cmath>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+export module VectorArray;
+
+import Array;
+import FixedMatrix;
+import Vector2;
+import Vector3;
+
+namespace jlib
+{
+	// Throws a std::invalid_argument if the sizes are not equal.
+	inline void _check_sizes(std::size_t A, std::size_t B)
+	{
+		if (A != B)
+			throw std::invalid_argument("ERROR: Array sizes do not match.");
+	}
+
+	// Random access iterator over the elements of a Vector2Array or Vector3Array.
+	// Dereferencing it gives a proxy that refers to the components of the element.
+	template <typename Container, bool IsConst> class _VectorArrayIterator
+	{
+		public:
+
+		using container_type = std::conditional_t<IsConst, const Container, Container>;
+		using value_type = typename Container::value_type;
+		using reference = std::conditional_t<IsConst, typename Container::const_reference, typename Container::reference>;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::random_access_iterator_tag;
+
+		private:
+
+		container_type* _container;
+		std::size_t _index;
+
+		public:
+
+		// Default constructor.
+		_VectorArrayIterator() noexcept : _container(nullptr), _index(0)
+		{
+
+		}
+
+		// Constructs an iterator pointing to the element at index of the container.
+		_VectorArrayIterator(container_type* container, std::size_t index) noexcept : _container(container), _index(index)
+		{
+
+		}
+
+		// Constructs a const iterator from a non-const one.
+		template <bool OtherConst> requires (IsConst && !OtherConst)
+		_VectorArrayIterator(const _VectorArrayIterator<Container, OtherConst>& other) noexcept
+			: _container(other.container()), _index(other.index())
+		{
+
+		}
+
+		// Returns the container of the iterator.
+		container_type* container() const noexcept
+		{
+			return _container;
+		}
+
+		// Returns the index of the element the iterator points to.
+		std::size_t index() const noexcept
+		{
+			return _index;
+		}
+
+		// Overload of unary operator *
+		reference operator * () const
+		{
+			return (*_container)[_index];
+		}
+
+		// Overload of operator []
+		reference operator [] (difference_type n) const
+		{
+			return (*_container)[_index + n];
+		}
+
+		// Overload of prefix operator ++
+		_VectorArrayIterator& operator ++ () noexcept
+		{
+			++_index;
+			return *this;
+		}
+
+		// Overload of postfix operator ++
+		_VectorArrayIterator operator ++ (int) noexcept
+		{
+			_VectorArrayIterator tmp = *this;
+			++_index;
+			return tmp;
+		}
+
+		// Overload of prefix operator --
+		_VectorArrayIterator& operator -- () noexcept
+		{
+			--_index;
+			return *this;
+		}
+
+		// Overload of postfix operator --
+		_VectorArrayIterator operator -- (int) noexcept
+		{
+			_VectorArrayIterator tmp = *this;
+			--_index;
+			return tmp;
+		}
+
+		// Overload of binary operator +=
+		_VectorArrayIterator& operator += (difference_type n) noexcept
+		{
+			_index += n;
+			return *this;
+		}
+
+		// Overload of binary operator -=
+		_VectorArrayIterator& operator -= (difference_type n) noexcept
+		{
+			_index -= n;
+			return *this;
+		}
+
+		// Overload of binary operator +
+		friend _VectorArrayIterator operator + (_VectorArrayIterator iter, difference_type n) noexcept
+		{
+			return iter += n;
+		}
+
+		// Overload of binary operator +
+		friend _VectorArrayIterator operator + (difference_type n, _VectorArrayIterator iter) noexcept
+		{
+			return iter += n;
+		}
+
+		// Overload of binary operator -
+		friend _VectorArrayIterator operator - (_VectorArrayIterator iter, difference_type n) noexcept
+		{
+			return iter -= n;
+		}
+
+		// Overload of binary operator -
+		friend difference_type operator - (const _VectorArrayIterator& A, const _VectorArrayIterator& B) noexcept
+		{
+			return static_cast<difference_type>(A._index) - static_cast<difference_type>(B._index);
+		}
+
+		// Overload of binary operator ==
+		friend bool operator == (const _VectorArrayIterator& A, const _VectorArrayIterator& B) noexcept
+		{
+			return A._index == B._index;
+		}
+
+		// Overload of binary operator <=>
+		friend std::strong_ordering operator <=> (const _VectorArrayIterator& A, const _VectorArrayIterator& B) noexcept
+		{
+			return A._index <=> B._index;
+		}
+	};
+}
+
+export namespace jlib
+{
+	// Proxy that refers to the components of an element of a Vector2Array.
+	// T is const qualified for the elements of a const Vector2Array.
+	template <typename T> struct Vector2Ref
+	{
+		T& x;
+		T& y;
+
+		// Returns a copy of the element.
+		operator Vector2<std::remove_const_t<T>>() const
+		{
+			return Vector2<std::remove_const_t<T>>(x, y);
+		}
+
+		// Sets the element to vec.
+		const Vector2Ref& operator = (const Vector2<std::remove_const_t<T>>& vec) const requires (!std::is_const_v<T>)
+		{
+			x = vec.x;
+			y = vec.y;
+			return *this;
+		}
+
+		// Sets the element to the element other refers to.
+		const Vector2Ref& operator = (const Vector2Ref& other) const requires (!std::is_const_v<T>)
+		{
+			x = other.x;
+			y = other.y;
+			return *this;
+		}
+
+		// Adds the components of vec onto the element.
+		const Vector2Ref& operator += (const Vector2<std::remove_const_t<T>>& vec) const requires (!std::is_const_v<T>)
+		{
+			x += vec.x;
+			y += vec.y;
+			return *this;
+		}
+
+		// Subtracts the components of vec from the element.
+		const Vector2Ref& operator -= (const Vector2<std::remove_const_t<T>>& vec) const requires (!std::is_const_v<T>)
+		{
+			x -= vec.x;
+			y -= vec.y;
+			return *this;
+		}
+
+		// Multiplies each component of the element by the given scalar value.
+		template <arithmetic U>
+		const Vector2Ref& operator *= (U scalar) const requires (!std::is_const_v<T>)
+		{
+			x *= scalar;
+			y *= scalar;
+			return *this;
+		}
+
+		// Swaps the elements A and B refer to.
+		friend void swap(const Vector2Ref& A, const Vector2Ref& B) requires (!std::is_const_v<T>)
+		{
+			using std::swap;
+			swap(A.x, B.x);
+			swap(A.y, B.y);
+		}
+	};
+
+	// Proxy that refers to the components of an element of a Vector3Array.
+	// T is const qualified for the elements of a const Vector3Array.
+	template <typename T> struct Vector3Ref
+	{
+		T& x;
+		T& y;
+		T& z;
+
+		// Returns a copy of the element.
+		operator Vector3<std::remove_const_t<T>>() const
+		{
+			return Vector3<std::remove_const_t<T>>(x, y, z);
+		}
+
+		// Sets the element to vec.
+		const Vector3Ref& operator = (const Vector3<std::remove_const_t<T>>& vec) const requires (!std::is_const_v<T>)
+		{
+			x = vec.x;
+			y = vec.y;
+			z = vec.z;
+			return *this;
+		}
+
+		// Sets the element to the element other refers to.
+		const Vector3Ref& operator = (const Vector3Ref& other) const requires (!std::is_const_v<T>)
+		{
+			x = other.x;
+			y = other.y;
+			z = other.z;
+			return *this;
+		}
+
+		// Adds the components of vec onto the element.
+		const Vector3Ref& operator += (const Vector3<std::remove_const_t<T>>& vec) const requires (!std::is_const_v<T>)
+		{
+			x += vec.x;
+			y += vec.y;
+			z += vec.z;
+			return *this;
+		}
+
+		// Subtracts the components of vec from the element.
+		const Vector3Ref& operator -= (const Vector3<std::remove_const_t<T>>& vec) const requires (!std::is_const_v<T>)
+		{
+			x -= vec.x;
+			y -= vec.y;
+			z -= vec.z;
+			return *this;
+		}
+
+		// Multiplies each component of the element by the given scalar value.
+		template <arithmetic U>
+		const Vector3Ref& operator *= (U scalar) const requires (!std::is_const_v<T>)
+		{
+			x *= scalar;
+			y *= scalar;
+			z *= scalar;
+			return *this;
+		}
+
+		// Swaps the elements A and B refer to.
+		friend void swap(const Vector3Ref& A, const Vector3Ref& B) requires (!std::is_const_v<T>)
+		{
+			using std::swap;
+			swap(A.x, B.x);
+			swap(A.y, B.y);
+			swap(A.z, B.z);
+		}
+	};
+
+	// Container of Vector2s stored as a structure of arrays:
+	// the x and y components each live in their own contiguous lane,
+	// so the batch functions below run over whole lanes with SIMD.
+	// Elements are accessed through Vector2Ref proxies.
+	template <arithmetic T, typename Allocator = std::allocator<T>> class Vector2Array
+	{
+		public:
+
+		using value_type = Vector2<T>;
+		using component_type = T;
+		using allocator_type = Allocator;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = Vector2Ref<T>;
+		using const_reference = Vector2Ref<const T>;
+		using iterator = _VectorArrayIterator<Vector2Array, false>;
+		using const_iterator = _VectorArrayIterator<Vector2Array, true>;
+
+		private:
+
+		Array<T, Allocator> _x;
+		Array<T, Allocator> _y;
+
+		public:
+
+		// Default constructor.
+		Vector2Array() = default;
+
+		// Constructs an empty Vector2Array that uses the given allocator.
+		explicit Vector2Array(const Allocator& alloc) : _x(alloc), _y(alloc)
+		{
+
+		}
+
+		// Constructs a Vector2Array of size elements set to 0.
+		Vector2Array(size_type size, const Allocator& alloc = Allocator()) : _x(size, T(0), alloc), _y(size, T(0), alloc)
+		{
+
+		}
+
+		// Constructs a Vector2Array of size elements set to value.
+		Vector2Array(size_type size, const Vector2<T>& value, const Allocator& alloc = Allocator())
+			: _x(size, value.x, alloc), _y(size, value.y, alloc)
+		{
+
+		}
+
+		// Constructs the Vector2Array from the Vector2s in [first, last).
+		template <std::input_iterator Iterator>
+		Vector2Array(Iterator first, Iterator last, const Allocator& alloc = Allocator()) : _x(alloc), _y(alloc)
+		{
+			for (; first != last; ++first)
+				push_back(*first);
+		}
+
+		// Returns a copy of the allocator used by the Vector2Array.
+		allocator_type get_allocator() const noexcept
+		{
+			return _x.get_allocator();
+		}
+
+		// Returns the number of elements in the Vector2Array.
+		size_type size() const noexcept
+		{
+			return _x.size();
+		}
+
+		// Returns the number of elements the Vector2Array can hold without reallocating.
+		size_type capacity() const noexcept
+		{
+			return _x.capacity();
+		}
+
+		// Returns true if the Vector2Array has no elements.
+		bool isEmpty() const noexcept
+		{
+			return _x.isEmpty();
+		}
+
+		// Returns a pointer to the x components.
+		T* xData() noexcept
+		{
+			return _x.data();
+		}
+
+		// Returns a pointer to the x components.
+		const T* xData() const noexcept
+		{
+			return _x.data();
+		}
+
+		// Returns a pointer to the y components.
+		T* yData() noexcept
+		{
+			return _y.data();
+		}
+
+		// Returns a pointer to the y components.
+		const T* yData() const noexcept
+		{
+			return _y.data();
+		}
+
+		// Returns an iterator pointing to the first element.
+		iterator begin() noexcept
+		{
+			return iterator(this, 0);
+		}
+
+		// Returns an iterator pointing to the first element.
+		const_iterator begin() const noexcept
+		{
+			return const_iterator(this, 0);
+		}
+
+		// Returns an iterator pointing to 1 past the last element.
+		iterator end() noexcept
+		{
+			return iterator(this, size());
+		}
+
+		// Returns an iterator pointing to 1 past the last element.
+		const_iterator end() const noexcept
+		{
+			return const_iterator(this, size());
+		}
+
+		// Returns a copy of the element at the given index.
+		// Throws a std::out_of_range if given an invalid index.
+		Vector2<T> at(size_type index) const
+		{
+			if (index >= size())
+				throw std::out_of_range("ERROR: Invalid Vector2Array index.");
+
+			return Vector2<T>(_x[index], _y[index]);
+		}
+
+		// Sets the element at the given index to value.
+		// Throws a std::out_of_range if given an invalid index.
+		void set(size_type index, const Vector2<T>& value)
+		{
+			if (index >= size())
+				throw std::out_of_range("ERROR: Invalid Vector2Array index.");
+
+			_x[index] = value.x;
+			_y[index] = value.y;
+		}
+
+		// Reserves memory for at least new_capacity elements.
+		void reserve(size_type new_capacity)
+		{
+			_x.reserve(new_capacity);
+			_y.reserve(new_capacity);
+		}
+
+		// Resizes the Vector2Array, setting any new elements to 0.
+		void resize(size_type new_size)
+		{
+			_x.resize(new_size, T(0));
+			_y.resize(new_size, T(0));
+		}
+
+		// Removes every element.
+		void clear() noexcept
+		{
+			_x.clear();
+			_y.clear();
+		}
+
+		// Appends value to the Vector2Array.
+		void push_back(const Vector2<T>& value)
+		{
+			emplace_back(value.x, value.y);
+		}
+
+		// Appends the Vector2 (x, y) to the Vector2Array.
+		void emplace_back(T x, T y)
+		{
+			_x.push_back(x);
+			_y.push_back(y);
+		}
+
+		// Removes the last element.
+		void pop_back() noexcept
+		{
+			_x.pop_back();
+			_y.pop_back();
+		}
+
+		// Swaps the contents of this Vector2Array with another.
+		void swapWith(Vector2Array& other) noexcept
+		{
+			_x.swapWith(other._x);
+			_y.swapWith(other._y);
+		}
+
+		// Returns a proxy referring to the element at the given index.
+		// Does NOT perform bounds-checking.
+		reference operator [] (size_type index) noexcept
+		{
+			return reference{ _x[index], _y[index] };
+		}
+
+		// Returns a proxy referring to the element at the given index.
+		// Does NOT perform bounds-checking.
+		const_reference operator [] (size_type index) const noexcept
+		{
+			return const_reference{ _x[index], _y[index] };
+		}
+	};
+
+	// Container of Vector3s stored as a structure of arrays:
+	// the x, y and z components each live in their own contiguous lane,
+	// so the batch functions below run over whole lanes with SIMD.
+	// Elements are accessed through Vector3Ref proxies.
+	template <arithmetic T, typename Allocator = std::allocator<T>> class Vector3Array
+	{
+		public:
+
+		using value_type = Vector3<T>;
+		using component_type = T;
+		using allocator_type = Allocator;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = Vector3Ref<T>;
+		using const_reference = Vector3Ref<const T>;
+		using iterator = _VectorArrayIterator<Vector3Array, false>;
+		using const_iterator = _VectorArrayIterator<Vector3Array, true>;
+
+		private:
+
+		Array<T, Allocator> _x;
+		Array<T, Allocator> _y;
+		Array<T, Allocator> _z;
+
+		public:
+
+		// Default constructor.
+		Vector3Array() = default;
+
+		// Constructs an empty Vector3Array that uses the given allocator.
+		explicit Vector3Array(const Allocator& alloc) : _x(alloc), _y(alloc), _z(alloc)
+		{
+
+		}
+
+		// Constructs a Vector3Array of size elements set to 0.
+		Vector3Array(size_type size, const Allocator& alloc = Allocator())
+			: _x(size, T(0), alloc), _y(size, T(0), alloc), _z(size, T(0), alloc)
+		{
+
+		}
+
+		// Constructs a Vector3Array of size elements set to value.
+		Vector3Array(size_type size, const Vector3<T>& value, const Allocator& alloc = Allocator())
+			: _x(size, value.x, alloc), _y(size, value.y, alloc), _z(size, value.z, alloc)
+		{
+
+		}
+
+		// Constructs the Vector3Array from the Vector3s in [first, last).
+		template <std::input_iterator Iterator>
+		Vector3Array(Iterator first, Iterator last, const Allocator& alloc = Allocator()) : _x(alloc), _y(alloc), _z(alloc)
+		{
+			for (; first != last; ++first)
+				push_back(*first);
+		}
+
+		// Returns a copy of the allocator used by the Vector3Array.
+		allocator_type get_allocator() const noexcept
+		{
+			return _x.get_allocator();
+		}
+
+		// Returns the number of elements in the Vector3Array.
+		size_type size() const noexcept
+		{
+			return _x.size();
+		}
+
+		// Returns the number of elements the Vector3Array can hold without reallocating.
+		size_type capacity() const noexcept
+		{
+			return _x.capacity();
+		}
+
+		// Returns true if the Vector3Array has no elements.
+		bool isEmpty() const noexcept
+		{
+			return _x.isEmpty();
+		}
+
+		// Returns a pointer to the x components.
+		T* xData() noexcept
+		{
+			return _x.data();
+		}
+
+		// Returns a pointer to the x components.
+		const T* xData() const noexcept
+		{
+			return _x.data();
+		}
+
+		// Returns a pointer to the y components.
+		T* yData() noexcept
+		{
+			return _y.data();
+		}
+
+		// Returns a pointer to the y components.
+		const T* yData() const noexcept
+		{
+			return _y.data();
+		}
+
+		// Returns a pointer to the z components.
+		T* zData() noexcept
+		{
+			return _z.data();
+		}
+
+		// Returns a pointer to the z components.
+		const T* zData() const noexcept
+		{
+			return _z.data();
+		}
+
+		// Returns an iterator pointing to the first element.
+		iterator begin() noexcept
+		{
+			return iterator(this, 0);
+		}
+
+		// Returns an iterator pointing to the first element.
+		const_iterator begin() const noexcept
+		{
+			return const_iterator(this, 0);
+		}
+
+		// Returns an iterator pointing to 1 past the last element.
+		iterator end() noexcept
+		{
+			return iterator(this, size());
+		}
+
+		// Returns an iterator pointing to 1 past the last element.
+		const_iterator end() const noexcept
+		{
+			return const_iterator(this, size());
+		}
+
+		// Returns a copy of the element at the given index.
+		// Throws a std::out_of_range if given an invalid index.
+		Vector3<T> at(size_type index) const
+		{
+			if (index >= size())
+				throw std::out_of_range("ERROR: Invalid Vector3Array index.");
+
+			return Vector3<T>(_x[index], _y[index], _z[index]);
+		}
+
+		// Sets the element at the given index to value.
+		// Throws a std::out_of_range if given an invalid index.
+		void set(size_type index, const Vector3<T>& value)
+		{
+			if (index >= size())
+				throw std::out_of_range("ERROR: Invalid Vector3Array index.");
+
+			_x[index] = value.x;
+			_y[index] = value.y;
+			_z[index] = value.z;
+		}
+
+		// Reserves memory for at least new_capacity elements.
+		void reserve(size_type new_capacity)
+		{
+			_x.reserve(new_capacity);
+			_y.reserve(new_capacity);
+			_z.reserve(new_capacity);
+		}
+
+		// Resizes the Vector3Array, setting any new elements to 0.
+		void resize(size_type new_size)
+		{
+			_x.resize(new_size, T(0));
+			_y.resize(new_size, T(0));
+			_z.resize(new_size, T(0));
+		}
+
+		// Removes every element.
+		void clear() noexcept
+		{
+			_x.clear();
+			_y.clear();
+			_z.clear();
+		}
+
+		// Appends value to the Vector3Array.
+		void push_back(const Vector3<T>& value)
+		{
+			emplace_back(value.x, value.y, value.z);
+		}
+
+		// Appends the Vector3 (x, y, z) to the Vector3Array.
+		void emplace_back(T x, T y, T z)
+		{
+			_x.push_back(x);
+			_y.push_back(y);
+			_z.push_back(z);
+		}
+
+		// Removes the last element.
+		void pop_back() noexcept
+		{
+			_x.pop_back();
+			_y.pop_back();
+			_z.pop_back();
+		}
+
+		// Swaps the contents of this Vector3Array with another.
+		void swapWith(Vector3Array& other) noexcept
+		{
+			_x.swapWith(other._x);
+			_y.swapWith(other._y);
+			_z.swapWith(other._z);
+		}
+
+		// Returns a proxy referring to the element at the given index.
+		// Does NOT perform bounds-checking.
+		reference operator [] (size_type index) noexcept
+		{
+			return reference{ _x[index], _y[index], _z[index] };
+		}
+
+		// Returns a proxy referring to the element at the given index.
+		// Does NOT perform bounds-checking.
+		const_reference operator [] (size_type index) const noexcept
+		{
+			return const_reference{ _x[index], _y[index], _z[index] };
+		}
+	};
+
+	namespace pmr
+	{
+		// Vector2Array that obtains its memory from a std::pmr::memory_resource.
+		template <typename T> using Vector2Array = jlib::Vector2Array<T, std::pmr::polymorphic_allocator<T>>;
+
+		// Vector3Array that obtains its memory from a std::pmr::memory_resource.
+		template <typename T> using Vector3Array = jlib::Vector3Array<T, std::pmr::polymorphic_allocator<T>>;
+	}
+}
+
+namespace jlib
+{
+	// The batch kernels below work on raw lanes of n elements.
+	// The float versions handle 4 elements at a time in SSE registers,
+	// and the scalar loops handle the rest and every other type.
+	// Each output lane may be one of the input lanes.
+
+	// out[i] = (ax[i] * bx[i]) + (ay[i] * by[i]) + (az[i] * bz[i]).
+	// Pass nullptr as az and bz for 2 components.
+	template <typename T>
+	void _dot_lanes(const T* ax, const T* ay, const T* az, const T* bx, const T* by, const T* bz, T* out, std::size_t n)
+	{
+		std::size_t i = 0;
+
+		#ifdef JLIB_SIMD_X86
+		if constexpr (std::is_same_v<T, float>)
+		{
+			for (; i + 4 <= n; i += 4)
+			{
+				__m128 sum = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(ax + i), _mm_loadu_ps(bx + i)),
+										_mm_mul_ps(_mm_loadu_ps(ay + i), _mm_loadu_ps(by + i)));
+
+				if (az != nullptr)
+					sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(az + i), _mm_loadu_ps(bz + i)));
+
+				_mm_storeu_ps(out + i, sum);
+			}
+		}
+		#endif // JLIB_SIMD_X86
+
+		for (; i < n; ++i)
+		{
+			T sum = (ax[i] * bx[i]) + (ay[i] * by[i]);
+
+			if (az != nullptr)
+				sum += az[i] * bz[i];
+
+			out[i] = sum;
+		}
+	}
+
+	// out[i] = (ax[i] - bx[i])^2 + (ay[i] - by[i])^2 + (az[i] - bz[i])^2.
+	// Pass nullptr as az and bz for 2 components.
+	template <typename T>
+	void _distance_squared_lanes(const T* ax, const T* ay, const T* az, const T* bx, const T* by, const T* bz, T* out, std::size_t n)
+	{
+		std::size_t i = 0;
+
+		#ifdef JLIB_SIMD_X86
+		if constexpr (std::is_same_v<T, float>)
+		{
+			for (; i + 4 <= n; i += 4)
+			{
+				const __m128 dx = _mm_sub_ps(_mm_loadu_ps(bx + i), _mm_loadu_ps(ax + i));
+				const __m128 dy = _mm_sub_ps(_mm_loadu_ps(by + i), _mm_loadu_ps(ay + i));
+				__m128 sum = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+
+				if (az != nullptr)
+				{
+					const __m128 dz = _mm_sub_ps(_mm_loadu_ps(bz + i), _mm_loadu_ps(az + i));
+					sum = _mm_add_ps(sum, _mm_mul_ps(dz, dz));
+				}
+
+				_mm_storeu_ps(out + i, sum);
+			}
+		}
+		#endif // JLIB_SIMD_X86
+
+		for (; i < n; ++i)
+		{
+			const T dx = bx[i] - ax[i];
+			const T dy = by[i] - ay[i];
+			T sum = (dx * dx) + (dy * dy);
+
+			if (az != nullptr)
+			{
+				const T dz = bz[i] - az[i];
+				sum += dz * dz;
+			}
+
+			out[i] = sum;
+		}
+	}
+
+	// out[i] = sqrt((x[i] * x[i]) + (y[i] * y[i]) + (z[i] * z[i])).
+	// Pass nullptr as z for 2 components.
+	template <std::floating_point T>
+	void _magnitude_lanes(const T* x, const T* y, const T* z, T* out, std::size_t n)
+	{
+		std::size_t i = 0;
+
+		#ifdef JLIB_SIMD_X86
+		if constexpr (std::is_same_v<T, float>)
+		{
+			for (; i + 4 <= n; i += 4)
+			{
+				const __m128 vx = _mm_loadu_ps(x + i);
+				const __m128 vy = _mm_loadu_ps(y + i);
+				__m128 sum = _mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy));
+
+				if (z != nullptr)
+				{
+					const __m128 vz = _mm_loadu_ps(z + i);
+					sum = _mm_add_ps(sum, _mm_mul_ps(vz, vz));
+				}
+
+				_mm_storeu_ps(out + i, _mm_sqrt_ps(sum));
+			}
+		}
+		#endif // JLIB_SIMD_X86
+
+		for (; i < n; ++i)
+		{
+			T sum = (x[i] * x[i]) + (y[i] * y[i]);
+
+			if (z != nullptr)
+				sum += z[i] * z[i];
+
+			out[i] = std::sqrt(sum);
+		}
+	}
+
+	// Divides each vector by its magnitude. Vectors of magnitude 0 are left unchanged.
+	// Pass nullptr as z for 2 components.
+	template <std::floating_point T>
+	void _normalize_lanes(T* x, T* y, T* z, std::size_t n)
+	{
+		std::size_t i = 0;
+
+		#ifdef JLIB_SIMD_X86
+		if constexpr (std::is_same_v<T, float>)
+		{
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 one = _mm_set1_ps(1.0f);
+
+			for (; i + 4 <= n; i += 4)
+			{
+				const __m128 vx = _mm_loadu_ps(x + i);
+				const __m128 vy = _mm_loadu_ps(y + i);
+				__m128 vz = zero;
+				__m128 sum = _mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy));
+
+				if (z != nullptr)
+				{
+					vz = _mm_loadu_ps(z + i);
+					sum = _mm_add_ps(sum, _mm_mul_ps(vz, vz));
+				}
+
+				// 1 / magnitude, or 1 where the magnitude is 0.
+				const __m128 nonzero = _mm_cmpneq_ps(sum, zero);
+				const __m128 magnitude = _mm_or_ps(_mm_and_ps(nonzero, _mm_sqrt_ps(sum)), _mm_andnot_ps(nonzero, one));
+				const __m128 scale = _mm_div_ps(one, magnitude);
+
+				_mm_storeu_ps(x + i, _mm_mul_ps(vx, scale));
+				_mm_storeu_ps(y + i, _mm_mul_ps(vy, scale));
+
+				if (z != nullptr)
+					_mm_storeu_ps(z + i, _mm_mul_ps(vz, scale));
+			}
+		}
+		#endif // JLIB_SIMD_X86
+
+		for (; i < n; ++i)
+		{
+			T sum = (x[i] * x[i]) + (y[i] * y[i]);
+
+			if (z != nullptr)
+				sum += z[i] * z[i];
+
+			if (sum == T(0))
+				continue;
+
+			const T scale = T(1) / std::sqrt(sum);
+			x[i] *= scale;
+			y[i] *= scale;
+
+			if (z != nullptr)
+				z[i] *= scale;
+		}
+	}
+
+	// Sets (ox, oy, oz)[i] to the cross product of (ax, ay, az)[i] and (bx, by, bz)[i].
+	template <typename T>
+	void _cross_lanes(const T* ax, const T* ay, const T* az, const T* bx, const T* by, const T* bz,
+					  T* ox, T* oy, T* oz, std::size_t n)
+	{
+		std::size_t i = 0;
+
+		#ifdef JLIB_SIMD_X86
+		if constexpr (std::is_same_v<T, float>)
+		{
+			for (; i + 4 <= n; i += 4)
+			{
+				const __m128 vax = _mm_loadu_ps(ax + i);
+				const __m128 vay = _mm_loadu_ps(ay + i);
+				const __m128 vaz = _mm_loadu_ps(az + i);
+				const __m128 vbx = _mm_loadu_ps(bx + i);
+				const __m128 vby = _mm_loadu_ps(by + i);
+				const __m128 vbz = _mm_loadu_ps(bz + i);
+
+				_mm_storeu_ps(ox + i, _mm_sub_ps(_mm_mul_ps(vay, vbz), _mm_mul_ps(vaz, vby)));
+				_mm_storeu_ps(oy + i, _mm_sub_ps(_mm_mul_ps(vaz, vbx), _mm_mul_ps(vax, vbz)));
+				_mm_storeu_ps(oz + i, _mm_sub_ps(_mm_mul_ps(vax, vby), _mm_mul_ps(vay, vbx)));
+			}
+		}
+		#endif // JLIB_SIMD_X86
+
+		for (; i < n; ++i)
+		{
+			const T x = (ay[i] * bz[i]) - (az[i] * by[i]);
+			const T y = (az[i] * bx[i]) - (ax[i] * bz[i]);
+			const T z = (ax[i] * by[i]) - (ay[i] * bx[i]);
+			ox[i] = x;
+			oy[i] = y;
+			oz[i] = z;
+		}
+	}
+
+	// Multiplies each (x, y, z, w) by the 4 x 4 matrix M in place.
+	// w is 1 for points and 0 for directions. Points are divided by the
+	// resulting w unless the bottom row of M is (0, 0, 0, 1).
+	template <typename T>
+	void _transform_lanes(const FixedMatrix<T, 4, 4>& M, T* x, T* y, T* z, std::size_t n, bool points)
+	{
+		const T w = points ? T(1) : T(0);
+		const bool affine = M(3, 0) == T(0) && M(3, 1) == T(0) && M(3, 2) == T(0) && M(3, 3) == T(1);
+		const bool divide = points && !affine;
+		std::size_t i = 0;
+
+		#ifdef JLIB_SIMD_X86
+		if constexpr (std::is_same_v<T, float>)
+		{
+			__m128 m[4][4];
+
+			for (std::size_t r = 0; r < 4; ++r)
+			{
+				for (std::size_t c = 0; c < 4; ++c)
+					m[r][c] = _mm_set1_ps(M(r, c));
+			}
+
+			const __m128 vw = _mm_set1_ps(w);
+
+			for (; i + 4 <= n; i += 4)
+			{
+				const __m128 vx = _mm_loadu_ps(x + i);
+				const __m128 vy = _mm_loadu_ps(y + i);
+				const __m128 vz = _mm_loadu_ps(z + i);
+				__m128 out[4];
+
+				for (std::size_t r = 0; r < (divide ? 4 : 3); ++r)
+				{
+					out[r] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[r][0], vx), _mm_mul_ps(m[r][1], vy)),
+										_mm_add_ps(_mm_mul_ps(m[r][2], vz), _mm_mul_ps(m[r][3], vw)));
+				}
+
+				if (divide)
+				{
+					const __m128 scale = _mm_div_ps(_mm_set1_ps(1.0f), out[3]);
+					out[0] = _mm_mul_ps(out[0], scale);
+					out[1] = _mm_mul_ps(out[1], scale);
+					out[2] = _mm_mul_ps(out[2], scale);
+				}
+
+				_mm_storeu_ps(x + i, out[0]);
+				_mm_storeu_ps(y + i, out[1]);
+				_mm_storeu_ps(z + i, out[2]);
+			}
+		}
+		#endif // JLIB_SIMD_X86
+
+		for (; i < n; ++i)
+		{
+			T out[4];
+
+			for (std::size_t r = 0; r < 4; ++r)
+				out[r] = ((M(r, 0) * x[i]) + (M(r, 1) * y[i])) + ((M(r, 2) * z[i]) + (M(r, 3) * w));
+
+			if (divide)
+			{
+				const T scale = T(1) / out[3];
+				out[0] *= scale;
+				out[1] *= scale;
+				out[2] *= scale;
+			}
+
+			x[i] = out[0];
+			y[i] = out[1];
+			z[i] = out[2];
+		}
+	}
+}
+
+export namespace jlib
+{
+	// Sets out[i] to the dot product of A[i] and B[i].
+	// Throws a std::invalid_argument if the sizes of A, B and out are not equal.
+	template <arithmetic T, typename Allocator>
+	void dot_product(const Vector2Array<T, Allocator>& A, const Vector2Array<T, Allocator>& B, std::type_identity_t<std::span<T>> out)
+	{
+		_check_sizes(A.size(), B.size());
+		_check_sizes(A.size(), out.size());
+		_dot_lanes<T>(A.xData(), A.yData(), nullptr, B.xData(), B.yData(), nullptr, out.data(), A.size());
+	}
+
+	// Sets out[i] to the dot product of A[i] and B[i].
+	// Throws a std::invalid_argument if the sizes of A, B and out are not equal.
+	template <arithmetic T, typename Allocator>
+	void dot_product(const Vector3Array<T, Allocator>& A, const Vector3Array<T, Allocator>& B, std::type_identity_t<std::span<T>> out)
+	{
+		_check_sizes(A.size(), B.size());
+		_check_sizes(A.size(), out.size());
+		_dot_lanes<T>(A.xData(), A.yData(), A.zData(), B.xData(), B.yData(), B.zData(), out.data(), A.size());
+	}
+
+	// Sets out[i] to the z component of the cross product of A[i] and B[i],
+	// treated as Vector3s with a z component of 0.
+	// Throws a std::invalid_argument if the sizes of A, B and out are not equal.
+	template <arithmetic T, typename Allocator>
+	void cross_product(const Vector2Array<T, Allocator>& A, const Vector2Array<T, Allocator>& B, std::type_identity_t<std::span<T>> out)
+	{
+		_check_sizes(A.size(), B.size());
+		_check_sizes(A.size(), out.size());
+
+		const T* ax = A.xData();
+		const T* ay = A.yData();
+		const T* bx = B.xData();
+		const T* by = B.yData();
+
+		for (std::size_t i = 0; i < A.size(); ++i)
+			out[i] = (ax[i] * by[i]) - (ay[i] * bx[i]);
+	}
+
+	// Sets out[i] to the cross product of A[i] and B[i].
+	// out is resized to the size of A, and may be A or B.
+	// Throws a std::invalid_argument if the sizes of A and B are not equal.
+	template <arithmetic T, typename Allocator>
+	void cross_product(const Vector3Array<T, Allocator>& A, const Vector3Array<T, Allocator>& B, Vector3Array<T, Allocator>& out)
+	{
+		_check_sizes(A.size(), B.size());
+		out.resize(A.size());
+		_cross_lanes<T>(A.xData(), A.yData(), A.zData(), B.xData(), B.yData(), B.zData(),
+						out.xData(), out.yData(), out.zData(), A.size());
+	}
+
+	// Sets out[i] to the distance squared between A[i] and B[i], treated as points.
+	// Throws a std::invalid_argument if the sizes of A, B and out are not equal.
+	template <arithmetic T, typename Allocator>
+	void distance_squared(const Vector2Array<T, Allocator>& A, const Vector2Array<T, Allocator>& B, std::type_identity_t<std::span<T>> out)
+	{
+		_check_sizes(A.size(), B.size());
+		_check_sizes(A.size(), out.size());
+		_distance_squared_lanes<T>(A.xData(), A.yData(), nullptr, B.xData(), B.yData(), nullptr, out.data(), A.size());
+	}
+
+	// Sets out[i] to the distance squared between A[i] and B[i], treated as points.
+	// Throws a std::invalid_argument if the sizes of A, B and out are not equal.
+	template <arithmetic T, typename Allocator>
+	void distance_squared(const Vector3Array<T, Allocator>& A, const Vector3Array<T, Allocator>& B, std::type_identity_t<std::span<T>> out)
+	{
+		_check_sizes(A.size(), B.size());
+		_check_sizes(A.size(), out.size());
+		_distance_squared_lanes<T>(A.xData(), A.yData(), A.zData(), B.xData(), B.yData(), B.zData(), out.data(), A.size());
+	}
+
+	// Sets out[i] to the magnitude of A[i].
+	// Throws a std::invalid_argument if the sizes of A and out are not equal.
+	template <std::floating_point T, typename Allocator>
+	void magnitude(const Vector2Array<T, Allocator>& A, std::type_identity_t<std::span<T>> out)
+	{
+		_check_sizes(A.size(), out.size());
+		_magnitude_lanes<T>(A.xData(), A.yData(), nullptr, out.data(), A.size());
+	}
+
+	// Sets out[i] to the magnitude of A[i].
+	// Throws a std::invalid_argument if the sizes of A and out are not equal.
+	template <std::floating_point T, typename Allocator>
+	void magnitude(const Vector3Array<T, Allocator>& A, std::type_identity_t<std::span<T>> out)
+	{
+		_check_sizes(A.size(), out.size());
+		_magnitude_lanes<T>(A.xData(), A.yData(), A.zData(), out.data(), A.size());
+	}
+
+	// Normalizes each element of A so that it has a magnitude of 1.
+	// Elements with a magnitude of 0 are left unchanged.
+	template <std::floating_point T, typename Allocator>
+	void normalize(Vector2Array<T, Allocator>& A)
+	{
+		_normalize_lanes<T>(A.xData(), A.yData(), nullptr, A.size());
+	}
+
+	// Normalizes each element of A so that it has a magnitude of 1.
+	// Elements with a magnitude of 0 are left unchanged.
+	template <std::floating_point T, typename Allocator>
+	void normalize(Vector3Array<T, Allocator>& A)
+	{
+		_normalize_lanes<T>(A.xData(), A.yData(), A.zData(), A.size());
+	}
+
+	// Transforms each element of A in place as a point (x, y, z, 1) by the matrix M,
+	// so translations apply. If the bottom row of M is not (0, 0, 0, 1),
+	// the result is divided by its w component.
+	template <std::floating_point T, typename Allocator>
+	void transform_points(Vector3Array<T, Allocator>& A, const FixedMatrix<T, 4, 4>& M)
+	{
+		_transform_lanes<T>(M, A.xData(), A.yData(), A.zData(), A.size(), true);
+	}
+
+	// Transforms each element of A in place as a direction (x, y, z, 0) by the matrix M,
+	// so translations do not apply.
+	template <std::floating_point T, typename Allocator>
+	void transform_directions(Vector3Array<T, Allocator>& A, const FixedMatrix<T, 4, 4>& M)
+	{
+		_transform_lanes<T>(M, A.xData(), A.yData(), A.zData(), A.size(), false);
+	}
+}
\ No newline at end of file
@@ -1,25 +1,131 @@
 // JLibrary
 // VectorN.ixx
 // Created on 2022-01-08 by Justyn Durnford
-// Last modified on 2022-05-18 by Justyn Durnford
+// Last modified on 2026-10-17 by Justyn Durnford
 // Module file for the VectorN template class.
 
 module;
 
 #include "Arithmetic.hpp"
 #include "IntegerTypedefs.hpp"
+#include "Simd.hpp"
 
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <iostream>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 
 export module VectorN;
 
 import MiscTemplateFunctions;
 
+namespace jlib
+{
+	// Type the dot products and squared distances of VectorN<T, N>s are returned in.
+	// Integers are widened to 64 bits so that the sums are exact.
+	template <typename T>
+	using _vector_sum_t = std::conditional_t<std::is_floating_point_v<T>, T, std::conditional_t<std::is_signed_v<T>, i64, u64>>;
+
+	// Type the magnitudes, distances and projections of VectorN<T, N>s are returned in.
+	template <typename T>
+	using _vector_real_t = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+
+	// Float and double reductions over at least this many elements
+	// call the SIMD kernels. Shorter ones are cheaper to unroll inline.
+	inline constexpr std::size_t _simd_reduction_min = 16;
+
+	// Returns A - B, or |A - B| for unsigned types, in the sum type of T.
+	template <typename T>
+	constexpr _vector_sum_t<T> _difference(T A, T B) noexcept
+	{
+		using S = _vector_sum_t<T>;
+
+		if constexpr (std::is_unsigned_v<T>)
+			return A > B ? static_cast<S>(A - B) : static_cast<S>(B - A);
+		else
+			return static_cast<S>(A) - static_cast<S>(B);
+	}
+
+	// Returns the sum of A[i] * B[i] for every i in [0, N).
+	// Uses 4 independent sums so that the additions overlap.
+	template <typename T, std::size_t N>
+	constexpr _vector_sum_t<T> _dot_product(const T* A, const T* B) noexcept
+	{
+		using S = _vector_sum_t<T>;
+
+		if constexpr ((std::is_same_v<T, float> || std::is_same_v<T, double>) && N >= _simd_reduction_min)
+		{
+			if (!std::is_constant_evaluated())
+				return simd::dot(A, B, N);
+		}
+
+		S sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+		std::size_t i = 0;
+
+		for (; i + 4 <= N; i += 4)
+		{
+			sum0 += static_cast<S>(A[i]) * static_cast<S>(B[i]);
+			sum1 += static_cast<S>(A[i + 1]) * static_cast<S>(B[i + 1]);
+			sum2 += static_cast<S>(A[i + 2]) * static_cast<S>(B[i + 2]);
+			sum3 += static_cast<S>(A[i + 3]) * static_cast<S>(B[i + 3]);
+		}
+
+		for (; i < N; ++i)
+			sum0 += static_cast<S>(A[i]) * static_cast<S>(B[i]);
+
+		return (sum0 + sum1) + (sum2 + sum3);
+	}
+
+	// Returns the sum of (A[i] - B[i])^2 for every i in [0, N).
+	// Uses 4 independent sums so that the additions overlap.
+	template <typename T, std::size_t N>
+	constexpr _vector_sum_t<T> _distance_squared(const T* A, const T* B) noexcept
+	{
+		using S = _vector_sum_t<T>;
+
+		if constexpr ((std::is_same_v<T, float> || std::is_same_v<T, double>) && N >= _simd_reduction_min)
+		{
+			if (!std::is_constant_evaluated())
+				return simd::distance_squared(A, B, N);
+		}
+
+		S sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+		std::size_t i = 0;
+
+		for (; i + 4 <= N; i += 4)
+		{
+			const S d0 = _difference(A[i], B[i]);
+			const S d1 = _difference(A[i + 1], B[i + 1]);
+			const S d2 = _difference(A[i + 2], B[i + 2]);
+			const S d3 = _difference(A[i + 3], B[i + 3]);
+			sum0 += d0 * d0;
+			sum1 += d1 * d1;
+			sum2 += d2 * d2;
+			sum3 += d3 * d3;
+		}
+
+		for (; i < N; ++i)
+		{
+			const S d = _difference(A[i], B[i]);
+			sum0 += d * d;
+		}
+
+		return (sum0 + sum1) + (sum2 + sum3);
+	}
+
+	// Throws a std::invalid_argument if the sizes are not equal.
+	inline void _check_span_sizes(std::size_t A, std::size_t B)
+	{
+		if (A != B)
+			throw std::invalid_argument("ERROR: Array sizes do not match.");
+	}
+}
+
 export namespace jlib
 {
 	// Utility template class for representing, manipulating
@@ -235,65 +341,93 @@ export namespace jlib
 	///////////////////////////////////////////////////////////////////////////////////////////////
 	///////////////////////////////////////////////////////////////////////////////////////////////
 
+	// The reductions below return T for floating-point types. Integer types
+	// are summed exactly in i64 or u64, and their magnitudes, distances and
+	// projections are returned as double.
+
 	// Returns a VectorN whose elements are the absolute values of 
 	// each of the specified VectorN's elements.
 	template <arithmetic T, std::size_t N>
-	const VectorN<T, N>& abs(const VectorN<T, N>& vec)
+	VectorN<T, N> abs(const VectorN<T, N>& vec)
 	{
 		VectorN<T, N> new_vec;
 
 		for (std::size_t i = 0; i < N; ++i)
 			new_vec[i] = std::abs(vec[i]);
+
+		return new_vec;
 	}
 
 	// Returns the scalar projection of A onto B.
 	template <arithmetic T, std::size_t N>
-	constexpr float comp_proj(const VectorN<T, N>& A, const VectorN<T, N>& B)
+	_vector_real_t<T> comp_proj(const VectorN<T, N>& A, const VectorN<T, N>& B)
 	{
-		return dot_product(A, B) / magnitude(B);
+		return static_cast<_vector_real_t<T>>(dot_product(A, B)) / magnitude(B);
 	}
 
 	// Returns the distance between the 2 given VectorNs.
 	template <arithmetic T, std::size_t N>
-	constexpr float distance(const VectorN<T, N>& A, const VectorN<T, N>& B)
+	_vector_real_t<T> distance(const VectorN<T, N>& A, const VectorN<T, N>& B)
 	{
-		return std::sqrtf(distance_squared(A, B));
+		return std::sqrt(static_cast<_vector_real_t<T>>(distance_squared(A, B)));
 	}
 
-	// Returns the distance squared between the 2 given Vector2s, treated as points.
+	// Returns the distance squared between the 2 given VectorNs, treated as points.
 	template <arithmetic T, std::size_t N>
-	constexpr float distance_squared(const VectorN<T, N>& A, const VectorN<T, N>& B)
+	constexpr _vector_sum_t<T> distance_squared(const VectorN<T, N>& A, const VectorN<T, N>& B)
 	{
-		float result = 0.0f;
+		return _distance_squared<T, N>(A.data(), B.data());
+	}
 
-		for (std::size_t i = 0; i < N; ++i)
-			result += std::powf(static_cast<float>(B[i] - A[i]), 2.0f);
+	// Sets out[i] to the distance squared between points[i] and query.
+	// Throws a std::invalid_argument if the sizes of points and out are not equal.
+	template <arithmetic T, std::size_t N>
+	void distance_squared(std::type_identity_t<std::span<const VectorN<T, N>>> points, const VectorN<T, N>& query,
+						  std::span<_vector_sum_t<T>> out)
+	{
+		_check_span_sizes(points.size(), out.size());
 
-		return result;
+		for (std::size_t i = 0; i < points.size(); ++i)
+			out[i] = _distance_squared<T, N>(points[i].data(), query.data());
 	}
 
 	// Returns the dot product of the 2 given VectorNs.
 	template <arithmetic T, std::size_t N>
-	constexpr float dot_product(const VectorN<T, N>& A, const VectorN<T, N>& B)
+	constexpr _vector_sum_t<T> dot_product(const VectorN<T, N>& A, const VectorN<T, N>& B)
 	{
-		float value = 0.0f;
+		return _dot_product<T, N>(A.data(), B.data());
+	}
 
-		for (std::size_t i(0); i < N; ++i)
-			value += (A[i] * B[i]);
+	// Sets out[i] to the dot product of vectors[i] and query.
+	// Throws a std::invalid_argument if the sizes of vectors and out are not equal.
+	template <arithmetic T, std::size_t N>
+	void dot_product(std::type_identity_t<std::span<const VectorN<T, N>>> vectors, const VectorN<T, N>& query,
+					 std::span<_vector_sum_t<T>> out)
+	{
+		_check_span_sizes(vectors.size(), out.size());
 
-		return value;
+		for (std::size_t i = 0; i < vectors.size(); ++i)
+			out[i] = _dot_product<T, N>(vectors[i].data(), query.data());
 	}
 
 	// Returns the magnitude of the given VectorN.
 	template <arithmetic T, std::size_t N>
-	constexpr float magnitude(const VectorN<T, N>& vec)
+	_vector_real_t<T> magnitude(const VectorN<T, N>& vec)
 	{
-		float value = 0.0f;
+		return std::sqrt(static_cast<_vector_real_t<T>>(dot_product(vec, vec)));
+	}
 
-		for (std::size_t i = 0; i < N; ++i)
-			value += std::powf(static_cast<float>(vec[i]), 2);
+	// Sets out[i] to the magnitude of vectors[i].
+	// T and N are not deduced, so vectors may be any contiguous range of
+	// VectorN<T, N>s, such as magnitude<float, 8>(vectors, out).
+	// Throws a std::invalid_argument if the sizes of vectors and out are not equal.
+	template <arithmetic T, std::size_t N>
+	void magnitude(std::type_identity_t<std::span<const VectorN<T, N>>> vectors, std::span<_vector_real_t<T>> out)
+	{
+		_check_span_sizes(vectors.size(), out.size());
 
-		return std::sqrtf(value);
+		for (std::size_t i = 0; i < vectors.size(); ++i)
+			out[i] = magnitude(vectors[i]);
 	}
 
 	// Returns a VectorN whose elements are the maximum of each of the 
@@ -322,15 +456,37 @@ export namespace jlib
 		return C;
 	}
 
+	// Returns the index of the point in points that is closest to query.
+	// Returns points.size() if points is empty.
+	template <arithmetic T, std::size_t N>
+	std::size_t nearest(std::type_identity_t<std::span<const VectorN<T, N>>> points, const VectorN<T, N>& query)
+	{
+		std::size_t index = points.size();
+		_vector_sum_t<T> best = 0;
+
+		for (std::size_t i = 0; i < points.size(); ++i)
+		{
+			const _vector_sum_t<T> value = _distance_squared<T, N>(points[i].data(), query.data());
+
+			if (index == points.size() || value < best)
+			{
+				index = i;
+				best = value;
+			}
+		}
+
+		return index;
+	}
+
 	// Normalizes the VectorN by scaling each of its components so that it
 	// has a magnitude of 1.
 	template <arithmetic T, std::size_t N>
 	void normalize(VectorN<T, N>& vec)
 	{
-		const float m = magnitude(vec);
+		const _vector_real_t<T> m = magnitude(vec);
 
 		for (std::size_t i = 0; i < N; ++i)
-			vec[i] /= m;
+			vec[i] = static_cast<T>(vec[i] / m);
 	}
 
 	// Prints the given VectorN to std::cout.
@@ -387,10 +543,10 @@ export namespace jlib
 
 	// Returns a unit vector of the given VectorN.
 	template <arithmetic T, std::size_t N>
-	VectorN<float, N> unit_vector(const VectorN<T, N>& vec)
+	VectorN<_vector_real_t<T>, N> unit_vector(const VectorN<T, N>& vec)
 	{
-		const float m = magnitude(vec);
-		VectorN<float, N> new_vec(vec);
+		const _vector_real_t<T> m = magnitude(vec);
+		VectorN<_vector_real_t<T>, N> new_vec(vec);
 
 		for (std::size_t i = 0; i < N; ++i)
 			new_vec[i] /= m;
@@ -400,13 +556,15 @@ export namespace jlib
 
 	// Returns the vector projection of A onto B.
 	template <arithmetic T, std::size_t N>
-	VectorN<float, N> vector_proj(const VectorN<T, N>& A, const VectorN<T, N>& B)
+	VectorN<_vector_real_t<T>, N> vector_proj(const VectorN<T, N>& A, const VectorN<T, N>& B)
 	{
-		const float f = (dot_product(A, B) / dot_product(A, A));
-		VectorN<float, N> V;
+		using R = _vector_real_t<T>;
+
+		const R f = static_cast<R>(dot_product(A, B)) / static_cast<R>(dot_product(B, B));
+		VectorN<R, N> V;
 
 		for (std::size_t i(0); i < N; ++i)
-			V[i] *= f;
+			V[i] = static_cast<R>(B[i]) * f;
 
 		return V;
 	}
@@ -460,28 +618,28 @@ export namespace jlib
 	template <arithmetic T, std::size_t N>
 	bool operator < (const VectorN<T, N>& A, const VectorN<T, N>& B)
 	{
-		return magnitude(A) < magnitude(B);
+		return dot_product(A, A) < dot_product(B, B);
 	}
 
 	// Overload of binary operator <=
 	template <arithmetic T, std::size_t N>
 	bool operator <= (const VectorN<T, N>& A, const VectorN<T, N>& B)
 	{
-		return magnitude(A) <= magnitude(B);
+		return dot_product(A, A) <= dot_product(B, B);
 	}
 
 	// Overload of binary operator >
 	template <arithmetic T, std::size_t N>
 	bool operator > (const VectorN<T, N>& A, const VectorN<T, N>& B)
 	{
-		return magnitude(A) > magnitude(B);
+		return dot_product(A, A) > dot_product(B, B);
 	}
 
 	// Overload of binary operator >=
 	template <arithmetic T, std::size_t N>
 	bool operator >= (const VectorN<T, N>& A, const VectorN<T, N>& B)
 	{
-		return magnitude(A) >= magnitude(B);
+		return dot_product(A, A) >= dot_product(B, B);
 	}
 
 	// Overload of unary operator -